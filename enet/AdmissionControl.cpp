@@ -0,0 +1,145 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/AdmissionControl.hpp>
+
+enet::AdmissionControl::AdmissionControl(uint32_t _maxConnection,
+                                         uint32_t _maxRequestInProgress,
+                                         echrono::Duration _target,
+                                         echrono::Duration _interval) :
+  m_maxConnection(_maxConnection),
+  m_maxRequestInProgress(_maxRequestInProgress),
+  m_nbConnection(0),
+  m_nbRequestInProgress(0),
+  m_target(_target),
+  m_interval(_interval),
+  m_intervalEnd(),
+  m_minDelay(),
+  m_overloaded(false),
+  m_nbReject(0),
+  m_rejectAnswer(enet::HTTPAnswerCode::c503_serviceUnavailable) {
+	m_rejectAnswer.setProtocol(enet::HTTPProtocol::http_1_1);
+	m_rejectAnswer.setKey(enet::HTTPHeaderId::connection, "close");
+	m_rejectAnswer.setKey(enet::HTTPHeaderId::retryAfter, "1");
+	m_rejectAnswer.setContentLength(0);
+	m_rejectCanned = ememory::makeShared<enet::HttpCannedAnswer>(m_rejectAnswer);
+}
+
+void enet::AdmissionControl::setMaxConnection(uint32_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_maxConnection = _value;
+}
+
+void enet::AdmissionControl::setMaxRequestInProgress(uint32_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_maxRequestInProgress = _value;
+}
+
+void enet::AdmissionControl::setDelay(echrono::Duration _target, echrono::Duration _interval) {
+	ethread::UniqueLock lock(m_mutex);
+	m_target = _target;
+	m_interval = _interval;
+	m_intervalEnd = echrono::Steady();
+	m_overloaded = false;
+}
+
+void enet::AdmissionControl::setRejectAnswer(const enet::HttpAnswer& _answer) {
+	ethread::UniqueLock lock(m_mutex);
+	m_rejectAnswer = _answer;
+	m_rejectAnswer.setKey(enet::HTTPHeaderId::connection, "close");
+	m_rejectCanned = ememory::makeShared<enet::HttpCannedAnswer>(m_rejectAnswer);
+}
+
+enet::HttpAnswer enet::AdmissionControl::getRejectAnswer() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_rejectAnswer;
+}
+
+ememory::SharedPtr<enet::HttpCannedAnswer> enet::AdmissionControl::getRejectCannedAnswer() {
+	ethread::UniqueLock lock(m_mutex);
+	return m_rejectCanned;
+}
+
+bool enet::AdmissionControl::connectionOpen() {
+	ethread::UniqueLock lock(m_mutex);
+	if (    m_maxConnection != 0
+	     && m_nbConnection >= m_maxConnection) {
+		m_nbReject++;
+		ENET_WARNING("Reject connection: too many connection (" << m_nbConnection << ")");
+		return false;
+	}
+	m_nbConnection++;
+	return true;
+}
+
+void enet::AdmissionControl::connectionClose() {
+	ethread::UniqueLock lock(m_mutex);
+	if (m_nbConnection == 0) {
+		ENET_ERROR("Release a connection that has never been opened ...");
+		return;
+	}
+	m_nbConnection--;
+}
+
+bool enet::AdmissionControl::requestStart(echrono::Duration _queueDelay) {
+	echrono::Steady now = echrono::Steady::now();
+	ethread::UniqueLock lock(m_mutex);
+	// Update the observation window: the queue is "standing" when the minimum delay never go under the target.
+	if (now >= m_intervalEnd) {
+		if (m_intervalEnd != echrono::Steady()) {
+			m_overloaded = m_minDelay > m_target;
+		}
+		m_minDelay = _queueDelay;
+		m_intervalEnd = now + m_interval;
+	} else if (_queueDelay < m_minDelay) {
+		m_minDelay = _queueDelay;
+	}
+	// In overload mode we only accept the work that did not wait more than the target, otherwise the interval.
+	echrono::Duration maxDelay = m_overloaded == true ? m_target : m_interval;
+	if (_queueDelay > maxDelay) {
+		m_nbReject++;
+		ENET_WARNING("Reject request: queue delay=" << _queueDelay << " > " << maxDelay);
+		return false;
+	}
+	if (    m_maxRequestInProgress != 0
+	     && m_nbRequestInProgress >= m_maxRequestInProgress) {
+		m_nbReject++;
+		ENET_WARNING("Reject request: too many request in progress (" << m_nbRequestInProgress << ")");
+		return false;
+	}
+	m_nbRequestInProgress++;
+	return true;
+}
+
+void enet::AdmissionControl::requestEnd() {
+	ethread::UniqueLock lock(m_mutex);
+	if (m_nbRequestInProgress == 0) {
+		ENET_ERROR("Release a request that has never been started ...");
+		return;
+	}
+	m_nbRequestInProgress--;
+}
+
+uint32_t enet::AdmissionControl::getNumberConnection() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_nbConnection;
+}
+
+uint32_t enet::AdmissionControl::getNumberRequestInProgress() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_nbRequestInProgress;
+}
+
+uint64_t enet::AdmissionControl::getNumberReject() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_nbReject;
+}
+
+bool enet::AdmissionControl::isOverloaded() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_overloaded;
+}
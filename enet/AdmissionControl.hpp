@@ -0,0 +1,127 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/types.hpp>
+#include <ethread/Mutex.hpp>
+#include <echrono/Steady.hpp>
+#include <echrono/Duration.hpp>
+#include <enet/Http.hpp>
+#include <enet/HttpCanned.hpp>
+
+namespace enet {
+	/**
+	 * @brief Overload controller shared by all the server connections.
+	 * It limit the number of connection and the number of request in progress, and measure the
+	 * queueing delay (time between the accept (or the end of the header) and the start of the handler).
+	 * When the minimum delay stay over the target during a full interval, the new work is rejected
+	 * early (CoDel like) with a pre-build answer (503 + close).
+	 */
+	class AdmissionControl {
+		private:
+			mutable ethread::Mutex m_mutex; //!< Protect the counters
+			uint32_t m_maxConnection; //!< Maximum connection opened at the same time (0: no limit)
+			uint32_t m_maxRequestInProgress; //!< Maximum request processing at the same time (0: no limit)
+			uint32_t m_nbConnection; //!< Current number of connection
+			uint32_t m_nbRequestInProgress; //!< Current number of request in the handlers
+			echrono::Duration m_target; //!< Acceptable standing queue delay
+			echrono::Duration m_interval; //!< Duration of the observation window
+			echrono::Steady m_intervalEnd; //!< End of the current observation window
+			echrono::Duration m_minDelay; //!< Minimum delay measured in the current window
+			bool m_overloaded; //!< The previous window never go under the target
+			uint64_t m_nbReject; //!< Number of work rejected (statistic)
+			enet::HttpAnswer m_rejectAnswer; //!< Answer send when a work is rejected
+			ememory::SharedPtr<enet::HttpCannedAnswer> m_rejectCanned; //!< Encoded reject answer (sent without formatting)
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _maxConnection Maximum connection opened at the same time (0: no limit)
+			 * @param[in] _maxRequestInProgress Maximum request processing at the same time (0: no limit)
+			 * @param[in] _target Acceptable standing queue delay
+			 * @param[in] _interval Duration of the observation window
+			 */
+			AdmissionControl(uint32_t _maxConnection=0,
+			                 uint32_t _maxRequestInProgress=0,
+			                 echrono::Duration _target=echrono::milliseconds(10),
+			                 echrono::Duration _interval=echrono::milliseconds(100));
+			virtual ~AdmissionControl() = default;
+		public:
+			/**
+			 * @brief Set the maximum connection opened at the same time
+			 * @param[in] _value New limit (0: no limit)
+			 */
+			void setMaxConnection(uint32_t _value);
+			/**
+			 * @brief Set the maximum request processing at the same time
+			 * @param[in] _value New limit (0: no limit)
+			 */
+			void setMaxRequestInProgress(uint32_t _value);
+			/**
+			 * @brief Set the CoDel parameters
+			 * @param[in] _target Acceptable standing queue delay
+			 * @param[in] _interval Duration of the observation window
+			 */
+			void setDelay(echrono::Duration _target, echrono::Duration _interval);
+			/**
+			 * @brief Set the answer send to the remote when the work is rejected.
+			 * @param[in] _answer New answer (a "Connection: close" is alway added)
+			 */
+			void setRejectAnswer(const enet::HttpAnswer& _answer);
+			/**
+			 * @brief Get the answer send to the remote when the work is rejected.
+			 * @return A copy of the answer
+			 */
+			enet::HttpAnswer getRejectAnswer() const;
+			/**
+			 * @brief Get the encoded answer send to the remote when the work is rejected.
+			 * @return The pre-encoded answer
+			 */
+			ememory::SharedPtr<enet::HttpCannedAnswer> getRejectCannedAnswer();
+		public:
+			/**
+			 * @brief Request to open a new connection.
+			 * @return true The connection is accepted (need to call connectionClose() at the end)
+			 * @return false The connection must be rejected
+			 */
+			bool connectionOpen();
+			/**
+			 * @brief Release a connection accepted with connectionOpen()
+			 */
+			void connectionClose();
+			/**
+			 * @brief Request to start processing a request.
+			 * @param[in] _queueDelay Time the work wait before reaching the handler.
+			 * @return true The request is accepted (need to call requestEnd() at the end)
+			 * @return false The request must be rejected
+			 */
+			bool requestStart(echrono::Duration _queueDelay);
+			/**
+			 * @brief Release a request accepted with requestStart()
+			 */
+			void requestEnd();
+		public:
+			/**
+			 * @brief Get the current number of connection
+			 * @return Number of connection
+			 */
+			uint32_t getNumberConnection() const;
+			/**
+			 * @brief Get the current number of request in the handlers
+			 * @return Number of request
+			 */
+			uint32_t getNumberRequestInProgress() const;
+			/**
+			 * @brief Get the number of work rejected since the start
+			 * @return Number of reject
+			 */
+			uint64_t getNumberReject() const;
+			/**
+			 * @brief Check if the controller is currently in overload mode
+			 * @return true if the new work with a delay over the target is rejected
+			 */
+			bool isOverloaded() const;
+	};
+}
@@ -0,0 +1,277 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/ConnectionPool.hpp>
+#include <enet/TcpClient.hpp>
+#include <etk/stdTools.hpp>
+#include <ethread/tools.hpp>
+
+static etk::String getHostKey(const etk::String& _hostname, uint16_t _port) {
+	return _hostname + ":" + etk::toString(_port);
+}
+
+enet::ConnectionPool::ConnectionPool(uint32_t _minIdle, uint32_t _maxIdle, echrono::Duration _idleTimeOut) :
+  m_minIdle(_minIdle),
+  m_maxIdle(_maxIdle),
+  m_idleTimeOut(_idleTimeOut),
+  m_connectTimeOut(echrono::seconds(1)),
+  m_thread(null),
+  m_threadRunning(false) {
+
+}
+
+enet::ConnectionPool::~ConnectionPool() {
+	stop();
+	clear();
+}
+
+void enet::ConnectionPool::setMinIdle(uint32_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_minIdle = _value;
+}
+
+void enet::ConnectionPool::setMaxIdle(uint32_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_maxIdle = _value;
+}
+
+void enet::ConnectionPool::setIdleTimeOut(echrono::Duration _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_idleTimeOut = _value;
+}
+
+void enet::ConnectionPool::setConnectTimeOut(echrono::Duration _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_connectTimeOut = _value;
+}
+
+enet::Tcp enet::ConnectionPool::connect(const etk::String& _hostname, uint16_t _port) {
+	echrono::Duration timeOut;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		timeOut = m_connectTimeOut;
+	}
+	return etk::move(enet::connectTcpClient(_hostname, _port, 1, timeOut));
+}
+
+enet::Tcp enet::ConnectionPool::get(const etk::String& _hostname, uint16_t _port) {
+	etk::String key = getHostKey(_hostname, _port);
+	echrono::Steady now = echrono::Steady::now();
+	while (true) {
+		ememory::SharedPtr<enet::Tcp> connection;
+		{
+			ethread::UniqueLock lock(m_mutex);
+			auto it = m_list.find(key);
+			if (it == m_list.end()) {
+				Host host;
+				host.m_hostname = _hostname;
+				host.m_port = _port;
+				m_list.add(key, host);
+				break;
+			}
+			if (it->second.m_idle.size() == 0) {
+				break;
+			}
+			// Use the last released connection: it is the most likely to be alive.
+			Element& element = it->second.m_idle.back();
+			bool expired = now - element.m_releaseTime > m_idleTimeOut;
+			connection = element.m_connection;
+			it->second.m_idle.popBack();
+			if (expired == true) {
+				ENET_DEBUG("Drop expired idle connection on " << key);
+				continue;
+			}
+		}
+		// health check out of the lock (the connection is no more shared)
+		if (    connection != null
+		     && connection->checkLink() == true) {
+			ENET_DEBUG("Reuse idle connection on " << key);
+			return etk::move(*connection);
+		}
+		ENET_DEBUG("Drop dead idle connection on " << key);
+	}
+	ENET_DEBUG("No idle connection on " << key << " ==> connect");
+	return etk::move(connect(_hostname, _port));
+}
+
+void enet::ConnectionPool::addIdle(const etk::String& _hostname, uint16_t _port, enet::Tcp _connection) {
+	etk::String key = getHostKey(_hostname, _port);
+	ememory::SharedPtr<enet::Tcp> connection = ememory::makeShared<enet::Tcp>(etk::move(_connection));
+	ethread::UniqueLock lock(m_mutex);
+	auto it = m_list.find(key);
+	if (it == m_list.end()) {
+		Host host;
+		host.m_hostname = _hostname;
+		host.m_port = _port;
+		m_list.add(key, host);
+		it = m_list.find(key);
+	}
+	if (it->second.m_idle.size() >= m_maxIdle) {
+		ENET_DEBUG("Pool full on " << key << " ==> close the connection");
+		return;
+	}
+	Element element;
+	element.m_connection = connection;
+	element.m_releaseTime = echrono::Steady::now();
+	it->second.m_idle.pushBack(element);
+}
+
+void enet::ConnectionPool::release(enet::Tcp _connection) {
+	if (_connection.checkLink() == false) {
+		ENET_DEBUG("Release a connection not usable ==> close it");
+		return;
+	}
+	// The name of a client connection is "hostname:port"
+	etk::String name = _connection.getName();
+	size_t pos = name.rfind(':');
+	if (pos == etk::String::npos) {
+		ENET_ERROR("Release a connection that does not come from a client: '" << name << "'");
+		return;
+	}
+	addIdle(name.extract(0, pos), etk::string_to_uint16_t(name.extract(pos+1)), etk::move(_connection));
+}
+
+void enet::ConnectionPool::warmup(const etk::String& _hostname, uint16_t _port, uint32_t _count) {
+	etk::String key = getHostKey(_hostname, _port);
+	uint32_t nbConnection = 0;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		if (_count == 0) {
+			_count = m_minIdle;
+		}
+		_count = etk::min(_count, m_maxIdle);
+		auto it = m_list.find(key);
+		if (it == m_list.end()) {
+			Host host;
+			host.m_hostname = _hostname;
+			host.m_port = _port;
+			m_list.add(key, host);
+		} else {
+			nbConnection = it->second.m_idle.size();
+		}
+	}
+	ENET_INFO("Warmup " << key << " : " << nbConnection << "/" << _count);
+	for (; nbConnection < _count; ++nbConnection) {
+		enet::Tcp connection = connect(_hostname, _port);
+		if (connection.getConnectionStatus() != enet::Tcp::status::link) {
+			ENET_WARNING("Can not warmup connection on " << key);
+			return;
+		}
+		addIdle(_hostname, _port, etk::move(connection));
+	}
+}
+
+void enet::ConnectionPool::update() {
+	echrono::Steady now = echrono::Steady::now();
+	etk::Vector<Host> listRefill;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		for (auto &it : m_list) {
+			etk::Vector<Element> idle;
+			for (auto &itElement : it.second.m_idle) {
+				// Detect the connections closed by the remote (in the lock: get() can take the connection)
+				if (itElement.m_connection->checkLink() == false) {
+					continue;
+				}
+				if (now - itElement.m_releaseTime > m_idleTimeOut) {
+					// keep the minimum of warm connection: restart the idle time
+					if (idle.size() < m_minIdle) {
+						itElement.m_releaseTime = now;
+						idle.pushBack(itElement);
+					}
+					continue;
+				}
+				idle.pushBack(itElement);
+			}
+			it.second.m_idle = idle;
+			if (it.second.m_idle.size() < m_minIdle) {
+				listRefill.pushBack(it.second);
+			}
+		}
+	}
+	// Open one connection per host at each call: a host that does not answer block the maintenance only for one connection time out.
+	for (auto &it : listRefill) {
+		{
+			ethread::UniqueLock lock(m_mutex);
+			if (    m_thread != null
+			     && m_threadRunning == false) {
+				// stop() is waiting the end of the maintenance
+				return;
+			}
+		}
+		enet::Tcp connection = connect(it.m_hostname, it.m_port);
+		if (connection.getConnectionStatus() != enet::Tcp::status::link) {
+			ENET_WARNING("Can not refill the idle connections on " << getHostKey(it.m_hostname, it.m_port));
+			continue;
+		}
+		addIdle(it.m_hostname, it.m_port, etk::move(connection));
+	}
+}
+
+void enet::ConnectionPool::clear() {
+	ethread::UniqueLock lock(m_mutex);
+	for (auto &it : m_list) {
+		it.second.m_idle.clear();
+	}
+}
+
+uint32_t enet::ConnectionPool::getNumberIdle(const etk::String& _hostname, uint16_t _port) const {
+	ethread::UniqueLock lock(m_mutex);
+	auto it = m_list.find(getHostKey(_hostname, _port));
+	if (it == m_list.end()) {
+		return 0;
+	}
+	return it->second.m_idle.size();
+}
+
+void enet::ConnectionPool::start() {
+	ethread::UniqueLock lock(m_mutex);
+	if (m_thread != null) {
+		return;
+	}
+	m_threadRunning = true;
+	m_thread = ETK_NEW(ethread::Thread, [&](){ threadCallback();});
+	if (m_thread == null) {
+		m_threadRunning = false;
+		ENET_ERROR("creating connection pool thread!");
+	}
+}
+
+void enet::ConnectionPool::stop() {
+	ethread::Thread* thread = null;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		m_threadRunning = false;
+		thread = m_thread;
+	}
+	if (thread == null) {
+		return;
+	}
+	thread->join();
+	ETK_DELETE(ethread::Thread, thread);
+	ethread::UniqueLock lock(m_mutex);
+	m_thread = null;
+}
+
+bool enet::ConnectionPool::isThreadRunning() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_threadRunning;
+}
+
+void enet::ConnectionPool::threadCallback() {
+	ethread::setName("enet-pool");
+	int32_t count = 0;
+	while (isThreadRunning() == true) {
+		// Sleep by small step to stop quickly
+		ethread::sleepMilliSeconds(100);
+		if (++count < 10) {
+			continue;
+		}
+		count = 0;
+		update();
+	}
+}
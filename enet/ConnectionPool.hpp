@@ -0,0 +1,126 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <enet/Tcp.hpp>
+#include <etk/Map.hpp>
+#include <etk/Vector.hpp>
+#include <ememory/memory.hpp>
+#include <ethread/Mutex.hpp>
+#include <ethread/Thread.hpp>
+#include <echrono/Steady.hpp>
+#include <echrono/Duration.hpp>
+
+namespace enet {
+	/**
+	 * @brief Pool of outbound TCP connections keyed by "host:port".
+	 * A connection is taken with get() and given back with release(): the connections are health checked
+	 * when they are taken, the idle ones are closed after a timeout and a minimum number of idle
+	 * connections can be kept warm (warmup at start and refill by the maintenance).
+	 */
+	class ConnectionPool {
+		private:
+			class Element {
+				public:
+					ememory::SharedPtr<enet::Tcp> m_connection; //!< Idle connection
+					echrono::Steady m_releaseTime; //!< Time when the connection has been released in the pool
+			};
+			class Host {
+				public:
+					etk::String m_hostname; //!< Host name to connect with
+					uint16_t m_port; //!< Port to connect with
+					etk::Vector<Element> m_idle; //!< Idle connections (the last released is at the end)
+			};
+			mutable ethread::Mutex m_mutex; //!< Protect the list of host
+			etk::Map<etk::String, Host> m_list; //!< All the hosts known by the pool
+			uint32_t m_minIdle; //!< Number of idle connection to keep warm per host
+			uint32_t m_maxIdle; //!< Maximum number of idle connection per host
+			echrono::Duration m_idleTimeOut; //!< Time before closing an idle connection
+			echrono::Duration m_connectTimeOut; //!< Timeout of a new connection
+			ethread::Thread* m_thread; //!< Maintenance thread (protected by m_mutex)
+			bool m_threadRunning; //!< Maintenance thread is running (protected by m_mutex)
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _minIdle Number of idle connection to keep warm per host.
+			 * @param[in] _maxIdle Maximum number of idle connection per host.
+			 * @param[in] _idleTimeOut Time before closing an idle connection.
+			 */
+			ConnectionPool(uint32_t _minIdle=0, uint32_t _maxIdle=8, echrono::Duration _idleTimeOut=echrono::seconds(60));
+			virtual ~ConnectionPool();
+		public:
+			/**
+			 * @brief Set the number of idle connection to keep warm per host.
+			 * @param[in] _value New value.
+			 */
+			void setMinIdle(uint32_t _value);
+			/**
+			 * @brief Set the maximum number of idle connection per host.
+			 * @param[in] _value New value.
+			 */
+			void setMaxIdle(uint32_t _value);
+			/**
+			 * @brief Set the time before closing an idle connection.
+			 * @param[in] _value New value.
+			 */
+			void setIdleTimeOut(echrono::Duration _value);
+			/**
+			 * @brief Set the timeout of the new connections.
+			 * @param[in] _value New value.
+			 */
+			void setConnectTimeOut(echrono::Duration _value);
+		public:
+			/**
+			 * @brief Get a connection on a host (reuse an idle one if possible, otherwise connect a new one)
+			 * @param[in] _hostname Name or IP of the host.
+			 * @param[in] _port Port of the host.
+			 * @return The connection (status error if the connection can not be done)
+			 */
+			enet::Tcp get(const etk::String& _hostname, uint16_t _port);
+			/**
+			 * @brief Give back a connection taken with get() (closed if not usable or if the pool is full)
+			 * @param[in] _connection Connection to release.
+			 */
+			void release(enet::Tcp _connection);
+			/**
+			 * @brief Open the connections to have at least _count idle connections on a host.
+			 * @param[in] _hostname Name or IP of the host.
+			 * @param[in] _port Port of the host.
+			 * @param[in] _count Number of connection requested (0 to use the minimum idle value)
+			 */
+			void warmup(const etk::String& _hostname, uint16_t _port, uint32_t _count=0);
+			/**
+			 * @brief Close the expired and closed idle connections and refill the hosts under the minimum idle.
+			 * @note Only one connection is opened per host at each call (the minimum is reached after some calls).
+			 */
+			void update();
+			/**
+			 * @brief Remove all the idle connections.
+			 */
+			void clear();
+			/**
+			 * @brief Get the number of idle connection on a host.
+			 * @param[in] _hostname Name or IP of the host.
+			 * @param[in] _port Port of the host.
+			 * @return Number of idle connection
+			 */
+			uint32_t getNumberIdle(const etk::String& _hostname, uint16_t _port) const;
+		public:
+			/**
+			 * @brief Start a thread that call update() every second.
+			 */
+			void start();
+			/**
+			 * @brief Stop the maintenance thread.
+			 */
+			void stop();
+		private:
+			bool isThreadRunning() const;
+			void threadCallback();
+			enet::Tcp connect(const etk::String& _hostname, uint16_t _port);
+			void addIdle(const etk::String& _hostname, uint16_t _port, enet::Tcp _connection);
+	};
+}
@@ -0,0 +1,636 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/Coroutine.hpp>
+
+#ifdef ENET_COROUTINE
+
+#include <enet/debug.hpp>
+#include <enet/Resolver.hpp>
+#include <etk/stdTools.hpp>
+#include <ethread/tools.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <errno.h>
+	#include <unistd.h>
+	#include <string.h>
+}
+
+#ifdef __TARGET_OS__Windows
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+#else
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <netinet/tcp.h>
+	#include <arpa/inet.h>
+	#include <fcntl.h>
+	#include <poll.h>
+#endif
+
+namespace enet {
+	namespace coroutine {
+		#ifdef __TARGET_OS__Windows
+			using PollFd = WSAPOLLFD;
+			static const SOCKET INVALID = INVALID_SOCKET;
+			static const int32_t MAX_POLL_MS = 10; //!< No wake up pipe: the posted coroutines are resumed at least every 10ms
+		#else
+			using PollFd = struct pollfd;
+			static const int32_t INVALID = -1;
+			static const int32_t MAX_POLL_MS = 1000;
+		#endif
+		static void closeSocket(Socket _socket) {
+			#ifdef __TARGET_OS__Windows
+				closesocket(_socket);
+			#else
+				::close(_socket);
+			#endif
+		}
+		static bool setBlocking(Socket _socket, bool _blocking) {
+			#ifdef __TARGET_OS__Windows
+				u_long mode = _blocking == true ? 0 : 1;
+				return ioctlsocket(_socket, FIONBIO, &mode) == 0;
+			#else
+				int flags = fcntl(_socket, F_GETFL, 0);
+				if (flags < 0) {
+					return false;
+				}
+				if (_blocking == true) {
+					flags &= ~O_NONBLOCK;
+				} else {
+					flags |= O_NONBLOCK;
+				}
+				return fcntl(_socket, F_SETFL, flags) == 0;
+			#endif
+		}
+		static bool isWouldBlock() {
+			#ifdef __TARGET_OS__Windows
+				return WSAGetLastError() == WSAEWOULDBLOCK;
+			#else
+				return    errno == EAGAIN
+				       || errno == EWOULDBLOCK
+				       || errno == EINTR;
+			#endif
+		}
+		static int32_t getPollTimeOut(const echrono::Steady& _event, const echrono::Steady& _now) {
+			if (_event <= _now) {
+				return 0;
+			}
+			// round up to not wake up before the event
+			int64_t delay = ((_event - _now).get() + 999999) / 1000000;
+			if (delay > MAX_POLL_MS) {
+				return MAX_POLL_MS;
+			}
+			return int32_t(delay);
+		}
+		/**
+		 * @brief Set the options of a connected socket (non-blocking, no delay).
+		 */
+		static bool configureSocket(Socket _socket) {
+			if (setBlocking(_socket, false) == false) {
+				return false;
+			}
+			int flag = 1;
+			setsockopt(_socket, IPPROTO_TCP, TCP_NODELAY, (char*)&flag, sizeof(flag));
+			#ifdef SO_NOSIGPIPE
+				setsockopt(_socket, SOL_SOCKET, SO_NOSIGPIPE, (char*)&flag, sizeof(flag));
+			#endif
+			return true;
+		}
+		static enet::EventLoop*& getCurrentLoop() {
+			static thread_local enet::EventLoop* loop = null;
+			return loop;
+		}
+	}
+}
+
+void enet::coroutine::PromiseBase::unhandled_exception() {
+	ENET_CRITICAL("Exception in a coroutine");
+}
+
+enet::EventLoop::Wait::Wait(enet::EventLoop* _loop, enet::coroutine::Socket _socket, bool _write, echrono::Duration _timeOut) :
+  m_loop(_loop),
+  m_socket(_socket),
+  m_write(_write),
+  m_timeOut(_timeOut),
+  m_result(false) {
+
+}
+
+bool enet::EventLoop::Wait::await_ready() {
+	ethread::UniqueLock lock(m_loop->m_mutex);
+	// No wait when the loop is stopping: the coroutines end
+	return m_loop->m_stop;
+}
+
+void enet::EventLoop::Wait::await_suspend(std::coroutine_handle<> _handle) {
+	Waiter waiter;
+	waiter.m_socket = m_socket;
+	waiter.m_write = m_write;
+	waiter.m_hasTimeOut = m_timeOut.get() > 0;
+	if (waiter.m_hasTimeOut == true) {
+		waiter.m_timeOut = echrono::Steady::now() + m_timeOut;
+	}
+	waiter.m_handle = _handle;
+	waiter.m_result = &m_result;
+	if (m_loop->addWaiter(waiter) == false) {
+		m_loop->post(_handle);
+	}
+}
+
+enet::EventLoop::EventLoop() :
+  m_thread(null),
+  m_running(false),
+  m_stop(false) {
+	m_wakeUp[0] = enet::coroutine::INVALID;
+	m_wakeUp[1] = enet::coroutine::INVALID;
+	#ifndef __TARGET_OS__Windows
+		if (pipe(m_wakeUp) != 0) {
+			ENET_ERROR("can not create the wake up pipe: " << strerror(errno));
+			m_wakeUp[0] = enet::coroutine::INVALID;
+			m_wakeUp[1] = enet::coroutine::INVALID;
+		} else {
+			enet::coroutine::setBlocking(m_wakeUp[0], false);
+			enet::coroutine::setBlocking(m_wakeUp[1], false);
+		}
+	#endif
+}
+
+enet::EventLoop::~EventLoop() {
+	stop();
+	if (m_thread != null) {
+		m_thread->join();
+		ETK_DELETE(ethread::Thread, m_thread);
+		m_thread = null;
+	}
+	if (    m_ready.size() != 0
+	     || m_waiter.size() != 0) {
+		ENET_WARNING("Event loop removed with " << m_ready.size() + m_waiter.size() << " suspended coroutine(s)");
+	}
+	#ifndef __TARGET_OS__Windows
+		for (size_t iii=0; iii<2; ++iii) {
+			if (m_wakeUp[iii] != enet::coroutine::INVALID) {
+				enet::coroutine::closeSocket(m_wakeUp[iii]);
+				m_wakeUp[iii] = enet::coroutine::INVALID;
+			}
+		}
+	#endif
+}
+
+bool enet::EventLoop::start() {
+	ethread::UniqueLock lock(m_mutex);
+	if (    m_thread != null
+	     || m_running == true) {
+		ENET_ERROR("The event loop is already running");
+		return false;
+	}
+	m_thread = ETK_NEW(ethread::Thread, [&](){ run();});
+	if (m_thread == null) {
+		ENET_ERROR("creating event loop thread!");
+		return false;
+	}
+	return true;
+}
+
+void enet::EventLoop::stop() {
+	{
+		ethread::UniqueLock lock(m_mutex);
+		m_stop = true;
+	}
+	wakeUp();
+}
+
+enet::EventLoop* enet::EventLoop::getCurrent() {
+	return enet::coroutine::getCurrentLoop();
+}
+
+void enet::EventLoop::spawn(enet::Task<void> _task) {
+	std::coroutine_handle<enet::Task<void>::promise_type> handle = _task.release();
+	if (!handle) {
+		return;
+	}
+	handle.promise().m_detached = true;
+	post(handle);
+}
+
+void enet::EventLoop::post(std::coroutine_handle<> _handle) {
+	{
+		ethread::UniqueLock lock(m_mutex);
+		m_ready.pushBack(_handle);
+	}
+	if (enet::coroutine::getCurrentLoop() != this) {
+		wakeUp();
+	}
+}
+
+enet::EventLoop::Wait enet::EventLoop::sleep(echrono::Duration _time) {
+	if (_time.get() <= 0) {
+		// 0 is no limit for a wait
+		_time = echrono::nanoseconds(1);
+	}
+	return Wait(this, enet::coroutine::INVALID, false, _time);
+}
+
+bool enet::EventLoop::addWaiter(const Waiter& _waiter) {
+	{
+		ethread::UniqueLock lock(m_mutex);
+		if (m_stop == true) {
+			return false;
+		}
+		m_waiter.pushBack(_waiter);
+	}
+	if (enet::coroutine::getCurrentLoop() != this) {
+		wakeUp();
+	}
+	return true;
+}
+
+void enet::EventLoop::wakeUp() {
+	#ifndef __TARGET_OS__Windows
+		if (m_wakeUp[1] != enet::coroutine::INVALID) {
+			char value = 0;
+			if (::write(m_wakeUp[1], &value, 1) < 0) {
+				// The pipe is full: the loop is already waked up
+			}
+		}
+	#endif
+}
+
+void enet::EventLoop::resume(etk::Vector<std::coroutine_handle<>>& _list) {
+	for (auto &it : _list) {
+		it.resume();
+	}
+	_list.clear();
+}
+
+void enet::EventLoop::run() {
+	{
+		ethread::UniqueLock lock(m_mutex);
+		if (m_running == true) {
+			ENET_ERROR("The event loop is already running");
+			return;
+		}
+		m_running = true;
+	}
+	if (m_thread != null) {
+		ethread::setName("enet-event-loop");
+	}
+	enet::EventLoop* previous = enet::coroutine::getCurrentLoop();
+	enet::coroutine::getCurrentLoop() = this;
+	etk::Vector<enet::coroutine::PollFd> fds;
+	etk::Vector<int32_t> fdId;
+	etk::Vector<std::coroutine_handle<>> listResume;
+	etk::Vector<Waiter> listKeep;
+	while (true) {
+		// Resume the posted coroutines
+		{
+			ethread::UniqueLock lock(m_mutex);
+			etk::swap(listResume, m_ready);
+		}
+		resume(listResume);
+		echrono::Steady now = echrono::Steady::now();
+		echrono::Steady nextEvent = now + echrono::milliseconds(enet::coroutine::MAX_POLL_MS);
+		fds.clear();
+		fdId.clear();
+		size_t nbWaiter = 0;
+		{
+			ethread::UniqueLock lock(m_mutex);
+			if (m_stop == true) {
+				// The waits end with a time out: the coroutines can finish
+				if (    m_waiter.size() == 0
+				     && m_ready.size() == 0) {
+					break;
+				}
+				for (auto &it : m_waiter) {
+					*it.m_result = false;
+					listResume.pushBack(it.m_handle);
+				}
+				m_waiter.clear();
+				lock.unlock();
+				resume(listResume);
+				continue;
+			}
+			if (m_ready.size() != 0) {
+				// Posted during the resume: no wait
+				nextEvent = now;
+			}
+			#ifndef __TARGET_OS__Windows
+				enet::coroutine::PollFd wakeUpElement;
+				wakeUpElement.fd = m_wakeUp[0];
+				wakeUpElement.events = POLLIN;
+				wakeUpElement.revents = 0;
+				fds.pushBack(wakeUpElement);
+			#endif
+			nbWaiter = m_waiter.size();
+			for (auto &it : m_waiter) {
+				if (    it.m_hasTimeOut == true
+				     && it.m_timeOut < nextEvent) {
+					nextEvent = it.m_timeOut;
+				}
+				if (it.m_socket == enet::coroutine::INVALID) {
+					fdId.pushBack(-1);
+					continue;
+				}
+				fdId.pushBack(fds.size());
+				enet::coroutine::PollFd element;
+				element.fd = it.m_socket;
+				element.events = it.m_write == true ? POLLOUT : POLLIN;
+				element.revents = 0;
+				fds.pushBack(element);
+			}
+		}
+		int32_t timeOut = enet::coroutine::getPollTimeOut(nextEvent, now);
+		int32_t ret = 0;
+		if (fds.size() == 0) {
+			ethread::sleepMilliSeconds(timeOut);
+		} else {
+			#ifdef __TARGET_OS__Windows
+				ret = WSAPoll(&fds[0], fds.size(), timeOut);
+			#else
+				ret = ::poll(&fds[0], fds.size(), timeOut);
+			#endif
+		}
+		if (    ret < 0
+		     && enet::coroutine::isWouldBlock() == false) {
+			ENET_ERROR("poll() failed : errno=" << errno << "," << strerror(errno));
+			ethread::sleepMilliSeconds(1);
+			continue;
+		}
+		#ifndef __TARGET_OS__Windows
+			if (fds[0].revents != 0) {
+				char buffer[256];
+				while (::read(m_wakeUp[0], buffer, sizeof(buffer)) > 0) {
+					// empty the pipe
+				}
+			}
+		#endif
+		now = echrono::Steady::now();
+		{
+			ethread::UniqueLock lock(m_mutex);
+			// Only this thread remove the waiters: the first ones are the polled ones
+			listKeep.clear();
+			for (size_t iii=0; iii<m_waiter.size(); ++iii) {
+				Waiter& waiter = m_waiter[iii];
+				if (    iii < nbWaiter
+				     && fdId[iii] >= 0
+				     && fds[fdId[iii]].revents != 0) {
+					*waiter.m_result = true;
+					listResume.pushBack(waiter.m_handle);
+				} else if (    waiter.m_hasTimeOut == true
+				            && waiter.m_timeOut <= now) {
+					*waiter.m_result = false;
+					listResume.pushBack(waiter.m_handle);
+				} else {
+					listKeep.pushBack(waiter);
+				}
+			}
+			etk::swap(listKeep, m_waiter);
+		}
+		resume(listResume);
+	}
+	enet::coroutine::getCurrentLoop() = previous;
+	ethread::UniqueLock lock(m_mutex);
+	m_running = false;
+}
+
+enet::AsyncTcp::AsyncTcp() :
+  m_loop(null),
+  m_socket(enet::coroutine::INVALID),
+  m_timeOut(echrono::seconds(30)) {
+
+}
+
+enet::AsyncTcp::AsyncTcp(enet::EventLoop* _loop, enet::coroutine::Socket _socket, const etk::String& _remoteAddress) :
+  m_loop(_loop),
+  m_socket(_socket),
+  m_remoteAddress(_remoteAddress),
+  m_timeOut(echrono::seconds(30)) {
+	if (    m_socket != enet::coroutine::INVALID
+	     && enet::coroutine::configureSocket(m_socket) == false) {
+		ENET_ERROR("can not set socket non-blocking: " << strerror(errno));
+		close();
+	}
+}
+
+enet::AsyncTcp::AsyncTcp(AsyncTcp&& _obj) :
+  m_loop(_obj.m_loop),
+  m_socket(_obj.m_socket),
+  m_remoteAddress(etk::move(_obj.m_remoteAddress)),
+  m_timeOut(_obj.m_timeOut) {
+	_obj.m_socket = enet::coroutine::INVALID;
+}
+
+enet::AsyncTcp& enet::AsyncTcp::operator= (AsyncTcp&& _obj) {
+	if (this != &_obj) {
+		close();
+		m_loop = _obj.m_loop;
+		m_socket = _obj.m_socket;
+		m_remoteAddress = etk::move(_obj.m_remoteAddress);
+		m_timeOut = _obj.m_timeOut;
+		_obj.m_socket = enet::coroutine::INVALID;
+	}
+	return *this;
+}
+
+enet::AsyncTcp::~AsyncTcp() {
+	close();
+}
+
+bool enet::AsyncTcp::isAlive() const {
+	return m_socket != enet::coroutine::INVALID;
+}
+
+void enet::AsyncTcp::close() {
+	if (m_socket == enet::coroutine::INVALID) {
+		return;
+	}
+	enet::coroutine::closeSocket(m_socket);
+	m_socket = enet::coroutine::INVALID;
+}
+
+enet::Task<int32_t> enet::AsyncTcp::read(void* _data, int32_t _maxLen) {
+	while (m_socket != enet::coroutine::INVALID) {
+		int32_t len = ::recv(m_socket, (char*)_data, _maxLen, 0);
+		if (len >= 0) {
+			co_return len;
+		}
+		if (enet::coroutine::isWouldBlock() == false) {
+			ENET_DEBUG("recv() failed on " << m_remoteAddress << ": " << strerror(errno));
+			co_return -1;
+		}
+		if (co_await m_loop->wait(m_socket, false, m_timeOut) == false) {
+			ENET_DEBUG("Read time out on " << m_remoteAddress);
+			co_return -1;
+		}
+	}
+	co_return -1;
+}
+
+enet::Task<int32_t> enet::AsyncTcp::write(const void* _data, int32_t _len) {
+	int32_t offset = 0;
+	while (    offset < _len
+	        && m_socket != enet::coroutine::INVALID) {
+		int flags = 0;
+		#ifdef MSG_NOSIGNAL
+			flags = MSG_NOSIGNAL;
+		#endif
+		int32_t len = ::send(m_socket, (const char*)_data + offset, _len - offset, flags);
+		if (len >= 0) {
+			offset += len;
+			continue;
+		}
+		if (enet::coroutine::isWouldBlock() == false) {
+			ENET_DEBUG("send() failed on " << m_remoteAddress << ": " << strerror(errno));
+			co_return -1;
+		}
+		if (co_await m_loop->wait(m_socket, true, m_timeOut) == false) {
+			ENET_DEBUG("Write time out on " << m_remoteAddress);
+			co_return -1;
+		}
+	}
+	if (offset < _len) {
+		co_return -1;
+	}
+	co_return _len;
+}
+
+enet::AsyncTcpServer::AsyncTcpServer() :
+  m_loop(null),
+  m_socket(enet::coroutine::INVALID) {
+
+}
+
+enet::AsyncTcpServer::~AsyncTcpServer() {
+	unlink();
+}
+
+bool enet::AsyncTcpServer::link(enet::EventLoop* _loop, const etk::String& _host, uint16_t _port, int32_t _backlog) {
+	unlink();
+	etk::Vector<enet::Address> listAddress;
+	if (enet::resolver::resolve(_host, _port, listAddress) == false) {
+		ENET_ERROR("Can not resolve the host: '" << _host << "'");
+		return false;
+	}
+	for (auto &it : listAddress) {
+		enet::coroutine::Socket socketId = socket(it.getFamily(), SOCK_STREAM, IPPROTO_TCP);
+		if (socketId == enet::coroutine::INVALID) {
+			continue;
+		}
+		int flag = 1;
+		setsockopt(socketId, SOL_SOCKET, SO_REUSEADDR, (char*)&flag, sizeof(flag));
+		if (    bind(socketId, (const struct sockaddr *)it.getData(), it.getSize()) != 0
+		     || listen(socketId, _backlog) != 0
+		     || enet::coroutine::setBlocking(socketId, false) == false) {
+			ENET_ERROR("Can not listen on " << it.getName() << ": " << strerror(errno));
+			enet::coroutine::closeSocket(socketId);
+			continue;
+		}
+		ENET_INFO("Listen on " << it.getName());
+		m_loop = _loop;
+		m_socket = socketId;
+		return true;
+	}
+	return false;
+}
+
+void enet::AsyncTcpServer::unlink() {
+	if (m_socket == enet::coroutine::INVALID) {
+		return;
+	}
+	enet::coroutine::closeSocket(m_socket);
+	m_socket = enet::coroutine::INVALID;
+}
+
+uint16_t enet::AsyncTcpServer::getPort() const {
+	if (m_socket == enet::coroutine::INVALID) {
+		return 0;
+	}
+	struct sockaddr_storage data;
+	socklen_t size = sizeof(data);
+	if (getsockname(m_socket, (struct sockaddr*)&data, &size) != 0) {
+		return 0;
+	}
+	return enet::Address(&data, size).getPort();
+}
+
+enet::Task<enet::AsyncTcp> enet::AsyncTcpServer::accept() {
+	while (m_socket != enet::coroutine::INVALID) {
+		struct sockaddr_storage data;
+		socklen_t size = sizeof(data);
+		enet::coroutine::Socket socketId = ::accept(m_socket, (struct sockaddr*)&data, &size);
+		if (socketId != enet::coroutine::INVALID) {
+			co_return enet::AsyncTcp(m_loop, socketId, enet::Address(&data, size).getName());
+		}
+		if (    enet::coroutine::isWouldBlock() == false
+		     #ifndef __TARGET_OS__Windows
+		     && errno != ECONNABORTED
+		     #endif
+		     ) {
+			ENET_ERROR("accept() failed: " << strerror(errno));
+			co_return enet::AsyncTcp();
+		}
+		if (co_await m_loop->wait(m_socket, false, echrono::Duration()) == false) {
+			// The loop is stopping
+			co_return enet::AsyncTcp();
+		}
+	}
+	co_return enet::AsyncTcp();
+}
+
+enet::Task<enet::AsyncTcp> enet::connect(etk::String _hostname, uint16_t _port, echrono::Duration _timeOut, enet::EventLoop* _loop) {
+	if (_loop == null) {
+		_loop = enet::EventLoop::getCurrent();
+		if (_loop == null) {
+			ENET_ERROR("Can not connect '" << _hostname << "': no event loop in the current thread");
+			co_return enet::AsyncTcp();
+		}
+	}
+	etk::Vector<enet::Address> listAddress;
+	if (enet::resolver::resolve(_hostname, _port, listAddress) == false) {
+		ENET_ERROR("Can not resolve the host: '" << _hostname << "'");
+		co_return enet::AsyncTcp();
+	}
+	for (auto &it : listAddress) {
+		enet::coroutine::Socket socketId = socket(it.getFamily(), SOCK_STREAM, IPPROTO_TCP);
+		if (socketId == enet::coroutine::INVALID) {
+			continue;
+		}
+		enet::AsyncTcp connection(_loop, socketId, it.getName());
+		if (connection.isAlive() == false) {
+			continue;
+		}
+		if (::connect(socketId, (const struct sockaddr *)it.getData(), it.getSize()) == 0) {
+			co_return etk::move(connection);
+		}
+		#ifdef __TARGET_OS__Windows
+			bool inProgress = WSAGetLastError() == WSAEWOULDBLOCK;
+		#else
+			bool inProgress = errno == EINPROGRESS;
+		#endif
+		if (inProgress == false) {
+			ENET_DEBUG("Connection failed on " << it.getName() << ": " << strerror(errno));
+			continue;
+		}
+		if (co_await _loop->wait(socketId, true, _timeOut) == false) {
+			ENET_DEBUG("Connection time out on " << it.getName());
+			continue;
+		}
+		int error = 0;
+		socklen_t errorSize = sizeof(error);
+		if (getsockopt(socketId, SOL_SOCKET, SO_ERROR, (char*)&error, &errorSize) != 0) {
+			error = errno;
+		}
+		if (error != 0) {
+			ENET_DEBUG("Connection failed on " << it.getName() << ": " << strerror(error));
+			continue;
+		}
+		co_return etk::move(connection);
+	}
+	ENET_ERROR("Can not connect '" << _hostname << ":" << _port << "'");
+	co_return enet::AsyncTcp();
+}
+
+#endif
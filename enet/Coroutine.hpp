@@ -0,0 +1,493 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+#include <etk/Vector.hpp>
+#include <ethread/Mutex.hpp>
+#include <ethread/Thread.hpp>
+#include <echrono/Steady.hpp>
+#include <echrono/Duration.hpp>
+#ifdef __TARGET_OS__Windows
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+#endif
+
+// The coroutines need a C++20 compiler ("-std=c++20", or "-std=c++17 -fcoroutines" with gcc 10)
+#if    defined(__cpp_impl_coroutine) \
+    && __cpp_impl_coroutine >= 201902L
+	#define ENET_COROUTINE
+#endif
+
+#ifdef ENET_COROUTINE
+
+#include <coroutine>
+
+namespace enet {
+	template<class TYPE> class Task;
+	class EventLoop;
+	namespace coroutine {
+		#ifdef __TARGET_OS__Windows
+			using Socket = SOCKET;
+		#else
+			using Socket = int32_t;
+		#endif
+		/**
+		 * @brief Common part of the promise of the tasks.
+		 */
+		class PromiseBase {
+			public:
+				std::coroutine_handle<> m_continuation; //!< Coroutine that wait the end of this one
+				bool m_detached = false; //!< Started with EventLoop::spawn(): nobody wait the end (destroyed at the end)
+			public:
+				/**
+				 * @brief Resume the waiting coroutine at the end of the task (or destroy the detached task).
+				 */
+				class FinalAwaiter {
+					public:
+						bool await_ready() const noexcept {
+							return false;
+						}
+						template<class PROMISE>
+						std::coroutine_handle<> await_suspend(std::coroutine_handle<PROMISE> _handle) noexcept {
+							PromiseBase& promise = _handle.promise();
+							if (promise.m_continuation) {
+								return promise.m_continuation;
+							}
+							if (promise.m_detached == true) {
+								_handle.destroy();
+							}
+							return std::noop_coroutine();
+						}
+						void await_resume() const noexcept {
+
+						}
+				};
+				std::suspend_always initial_suspend() const noexcept {
+					return {};
+				}
+				FinalAwaiter final_suspend() const noexcept {
+					return {};
+				}
+				void unhandled_exception();
+		};
+	}
+	/**
+	 * @brief Coroutine that return a value: it start when it is awaited (co_await) or with EventLoop::spawn().
+	 * @code
+	 *   enet::Task<int32_t> getSize(enet::AsyncTcp& _connection) {
+	 *       uint8_t data[1024];
+	 *       co_return co_await _connection.read(data, sizeof(data));
+	 *   }
+	 * @endcode
+	 * @note The value type must be default constructible and movable.
+	 */
+	template<class TYPE>
+	class Task {
+		public:
+			class promise_type : public enet::coroutine::PromiseBase {
+				public:
+					TYPE m_value; //!< Value given with co_return
+				public:
+					Task get_return_object() {
+						return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+					}
+					void return_value(TYPE _value) {
+						m_value = etk::move(_value);
+					}
+			};
+		private:
+			std::coroutine_handle<promise_type> m_handle; //!< Coroutine of the task (destroyed with the task)
+		public:
+			Task() = default;
+			explicit Task(std::coroutine_handle<promise_type> _handle) :
+			  m_handle(_handle) {
+
+			}
+			Task(Task&& _obj) :
+			  m_handle(_obj.m_handle) {
+				_obj.m_handle = null;
+			}
+			Task& operator= (Task&& _obj) {
+				if (this != &_obj) {
+					if (m_handle) {
+						m_handle.destroy();
+					}
+					m_handle = _obj.m_handle;
+					_obj.m_handle = null;
+				}
+				return *this;
+			}
+			Task(const Task& _obj) = delete;
+			Task& operator= (const Task& _obj) = delete;
+			~Task() {
+				if (m_handle) {
+					m_handle.destroy();
+				}
+			}
+			/**
+			 * @brief Give the coroutine (the task does not destroy it anymore).
+			 * @return Handle of the coroutine.
+			 */
+			std::coroutine_handle<promise_type> release() {
+				std::coroutine_handle<promise_type> out = m_handle;
+				m_handle = null;
+				return out;
+			}
+		public:
+			bool await_ready() const noexcept {
+				return false;
+			}
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> _caller) noexcept {
+				m_handle.promise().m_continuation = _caller;
+				return m_handle;
+			}
+			TYPE await_resume() {
+				return etk::move(m_handle.promise().m_value);
+			}
+	};
+	/**
+	 * @brief Coroutine without return value.
+	 */
+	template<>
+	class Task<void> {
+		public:
+			class promise_type : public enet::coroutine::PromiseBase {
+				public:
+					Task get_return_object() {
+						return Task(std::coroutine_handle<promise_type>::from_promise(*this));
+					}
+					void return_void() {
+
+					}
+			};
+		private:
+			std::coroutine_handle<promise_type> m_handle; //!< Coroutine of the task (destroyed with the task)
+		public:
+			Task() = default;
+			explicit Task(std::coroutine_handle<promise_type> _handle) :
+			  m_handle(_handle) {
+
+			}
+			Task(Task&& _obj) :
+			  m_handle(_obj.m_handle) {
+				_obj.m_handle = null;
+			}
+			Task& operator= (Task&& _obj) {
+				if (this != &_obj) {
+					if (m_handle) {
+						m_handle.destroy();
+					}
+					m_handle = _obj.m_handle;
+					_obj.m_handle = null;
+				}
+				return *this;
+			}
+			Task(const Task& _obj) = delete;
+			Task& operator= (const Task& _obj) = delete;
+			~Task() {
+				if (m_handle) {
+					m_handle.destroy();
+				}
+			}
+			/**
+			 * @brief Give the coroutine (the task does not destroy it anymore).
+			 * @return Handle of the coroutine.
+			 */
+			std::coroutine_handle<promise_type> release() {
+				std::coroutine_handle<promise_type> out = m_handle;
+				m_handle = null;
+				return out;
+			}
+		public:
+			bool await_ready() const noexcept {
+				return false;
+			}
+			std::coroutine_handle<> await_suspend(std::coroutine_handle<> _caller) noexcept {
+				m_handle.promise().m_continuation = _caller;
+				return m_handle;
+			}
+			void await_resume() const noexcept {
+
+			}
+	};
+	/**
+	 * @brief Loop that resume the coroutines when their sockets are ready (poll).
+	 * All the coroutines of a loop run in its thread: the handler code is sequential and thousands of connections
+	 * share the same thread (use one loop per core, the connections can be moved on an other loop with schedule()).
+	 * @code
+	 *   enet::EventLoop loop;
+	 *   loop.spawn(session(etk::move(connection)));
+	 *   loop.run();
+	 * @endcode
+	 */
+	class EventLoop {
+		public:
+			/**
+			 * @brief Wait of a coroutine on a socket or a time (see wait() and sleep()).
+			 */
+			class Wait {
+				private:
+					enet::EventLoop* m_loop; //!< Loop that resume the coroutine
+					enet::coroutine::Socket m_socket; //!< Socket to wait (invalid: only wait the time)
+					bool m_write; //!< Wait the socket can be written (else readable)
+					echrono::Duration m_timeOut; //!< Maximum time to wait (0: no limit)
+					bool m_result; //!< The event happen before the time out
+				public:
+					Wait(enet::EventLoop* _loop, enet::coroutine::Socket _socket, bool _write, echrono::Duration _timeOut);
+					bool await_ready();
+					void await_suspend(std::coroutine_handle<> _handle);
+					bool await_resume() const noexcept {
+						return m_result;
+					}
+			};
+			/**
+			 * @brief Move a coroutine on a loop (see schedule()).
+			 */
+			class Schedule {
+				private:
+					enet::EventLoop* m_loop; //!< Loop that resume the coroutine
+				public:
+					Schedule(enet::EventLoop* _loop) :
+					  m_loop(_loop) {
+
+					}
+					bool await_ready() const noexcept {
+						return false;
+					}
+					void await_suspend(std::coroutine_handle<> _handle) {
+						m_loop->post(_handle);
+					}
+					void await_resume() const noexcept {
+
+					}
+			};
+		private:
+			/**
+			 * @brief Coroutine suspended until an event.
+			 */
+			class Waiter {
+				public:
+					enet::coroutine::Socket m_socket; //!< Socket to wait (invalid: only wait the time)
+					bool m_write; //!< Wait the socket can be written (else readable)
+					bool m_hasTimeOut; //!< The wait is limited
+					echrono::Steady m_timeOut; //!< End of the wait
+					std::coroutine_handle<> m_handle; //!< Coroutine to resume
+					bool* m_result; //!< Set to true if the event happen before the time out
+			};
+			mutable ethread::Mutex m_mutex; //!< Protect the lists (a coroutine can be posted from an other thread)
+			etk::Vector<std::coroutine_handle<>> m_ready; //!< Coroutines to resume
+			etk::Vector<Waiter> m_waiter; //!< Coroutines waiting an event
+			ethread::Thread* m_thread; //!< Thread started with start() (null when run() is used)
+			bool m_running; //!< The loop is running
+			bool m_stop; //!< A stop is requested: the waits end immediately
+			enet::coroutine::Socket m_wakeUp[2]; //!< Pipe to wake up the poll when a coroutine is added from an other thread
+		public:
+			EventLoop();
+			virtual ~EventLoop();
+			EventLoop(const EventLoop& _obj) = delete;
+			EventLoop& operator= (const EventLoop& _obj) = delete;
+		public:
+			/**
+			 * @brief Run the loop in a new thread.
+			 * @return true if the thread is started.
+			 */
+			bool start();
+			/**
+			 * @brief Run the loop in the current thread (until stop()).
+			 */
+			void run();
+			/**
+			 * @brief Stop the loop: the waits in progress end (time out) to let the coroutines finish, then run() return.
+			 */
+			void stop();
+			/**
+			 * @brief Get the loop of the current thread.
+			 * @return The loop or null if the thread does not run a loop.
+			 */
+			static enet::EventLoop* getCurrent();
+			/**
+			 * @brief Start a coroutine in the loop (it is destroyed at its end).
+			 * @param[in] _task Coroutine to start.
+			 */
+			void spawn(enet::Task<void> _task);
+			/**
+			 * @brief Resume a coroutine in the loop thread.
+			 * @param[in] _handle Coroutine to resume.
+			 */
+			void post(std::coroutine_handle<> _handle);
+			/**
+			 * @brief Continue the current coroutine in the thread of this loop (co_await loop.schedule()).
+			 * @return Awaitable.
+			 */
+			Schedule schedule() {
+				return Schedule(this);
+			}
+			/**
+			 * @brief Wait a socket is readable or writable (co_await).
+			 * @param[in] _socket Socket to wait.
+			 * @param[in] _write Wait the socket can be written (else readable).
+			 * @param[in] _timeOut Maximum time to wait (0: no limit).
+			 * @return Awaitable that give false if the time out is reached (or the loop is stopped).
+			 */
+			Wait wait(enet::coroutine::Socket _socket, bool _write, echrono::Duration _timeOut) {
+				return Wait(this, _socket, _write, _timeOut);
+			}
+			/**
+			 * @brief Suspend the current coroutine during a time (co_await).
+			 * @param[in] _time Time to wait.
+			 * @return Awaitable (give false).
+			 */
+			Wait sleep(echrono::Duration _time);
+		private:
+			friend class Wait;
+			/**
+			 * @brief Add a suspended coroutine in the waiting list.
+			 * @param[in] _waiter Event to wait.
+			 * @return false if the loop is stopping (the coroutine is not suspended).
+			 */
+			bool addWaiter(const Waiter& _waiter);
+			/**
+			 * @brief Wake up the poll of the loop thread.
+			 */
+			void wakeUp();
+			/**
+			 * @brief Resume all the coroutines of a list.
+			 * @param[in,out] _list Coroutines (cleared).
+			 */
+			static void resume(etk::Vector<std::coroutine_handle<>>& _list);
+	};
+	/**
+	 * @brief TCP connection used by the coroutines of an event loop (non-blocking socket).
+	 * @code
+	 *   enet::Task<void> echo(enet::AsyncTcp _connection) {
+	 *       uint8_t data[4096];
+	 *       while (true) {
+	 *           int32_t len = co_await _connection.read(data, sizeof(data));
+	 *           if (    len <= 0
+	 *                || co_await _connection.write(data, len) < 0) {
+	 *               co_return;
+	 *           }
+	 *       }
+	 *   }
+	 * @endcode
+	 */
+	class AsyncTcp {
+		private:
+			enet::EventLoop* m_loop; //!< Loop of the coroutines that use the connection
+			enet::coroutine::Socket m_socket; //!< Non-blocking socket
+			etk::String m_remoteAddress; //!< "ip:port" of the remote
+			echrono::Duration m_timeOut; //!< Maximum time to wait the remote on a read or a write
+		public:
+			AsyncTcp();
+			/**
+			 * @brief Contructor
+			 * @param[in] _loop Loop of the coroutines that use the connection.
+			 * @param[in] _socket Connected socket (set non-blocking, closed with the object).
+			 * @param[in] _remoteAddress "ip:port" of the remote.
+			 */
+			AsyncTcp(enet::EventLoop* _loop, enet::coroutine::Socket _socket, const etk::String& _remoteAddress);
+			AsyncTcp(AsyncTcp&& _obj);
+			AsyncTcp& operator= (AsyncTcp&& _obj);
+			AsyncTcp(const AsyncTcp& _obj) = delete;
+			AsyncTcp& operator= (const AsyncTcp& _obj) = delete;
+			virtual ~AsyncTcp();
+		public:
+			/**
+			 * @brief Check if the connection is open.
+			 * @return true if the socket is open.
+			 */
+			bool isAlive() const;
+			/**
+			 * @brief Close the connection.
+			 */
+			void close();
+			const etk::String& getRemoteAddress() const {
+				return m_remoteAddress;
+			}
+			enet::EventLoop* getLoop() const {
+				return m_loop;
+			}
+			/**
+			 * @brief Set the loop of the coroutines that use the connection (see EventLoop::schedule()).
+			 * @param[in] _loop New loop.
+			 */
+			void setLoop(enet::EventLoop* _loop) {
+				m_loop = _loop;
+			}
+			/**
+			 * @brief Set the maximum time to wait the remote on a read or a write.
+			 * @param[in] _value Time out (default 30s, 0: no limit).
+			 */
+			void setTimeOut(echrono::Duration _value) {
+				m_timeOut = _value;
+			}
+			/**
+			 * @brief Read the available data (wait if there is no data).
+			 * @param[out] _data Output buffer.
+			 * @param[in] _maxLen Size of the buffer.
+			 * @return Number of byte read, 0 if the connection is closed by the remote, -1 on error or time out.
+			 */
+			enet::Task<int32_t> read(void* _data, int32_t _maxLen);
+			/**
+			 * @brief Write all the data (wait while the socket is full).
+			 * @param[in] _data Data to send.
+			 * @param[in] _len Number of byte.
+			 * @return Number of byte written or -1 on error or time out.
+			 */
+			enet::Task<int32_t> write(const void* _data, int32_t _len);
+	};
+	/**
+	 * @brief TCP server that accept the connections in a coroutine.
+	 */
+	class AsyncTcpServer {
+		private:
+			enet::EventLoop* m_loop; //!< Loop of the accept
+			enet::coroutine::Socket m_socket; //!< Listening socket
+		public:
+			AsyncTcpServer();
+			virtual ~AsyncTcpServer();
+			AsyncTcpServer(const AsyncTcpServer& _obj) = delete;
+			AsyncTcpServer& operator= (const AsyncTcpServer& _obj) = delete;
+		public:
+			/**
+			 * @brief Open the listening socket.
+			 * @param[in] _loop Loop of the coroutine that call accept().
+			 * @param[in] _host IP to listen ("0.0.0.0" for all).
+			 * @param[in] _port Port to listen.
+			 * @param[in] _backlog Maximum number of connection waiting the accept.
+			 * @return true if the socket is listening.
+			 */
+			bool link(enet::EventLoop* _loop, const etk::String& _host, uint16_t _port, int32_t _backlog=1024);
+			/**
+			 * @brief Close the listening socket.
+			 */
+			void unlink();
+			/**
+			 * @brief Get the port of the listening socket (useful with the port 0).
+			 * @return The port or 0.
+			 */
+			uint16_t getPort() const;
+			/**
+			 * @brief Wait a new connection.
+			 * @return The connection (not alive if the server is unlinked or the loop is stopped).
+			 */
+			enet::Task<enet::AsyncTcp> accept();
+	};
+	/**
+	 * @brief Connect to a host in a coroutine (co_await enet::connect("example.com", 80)).
+	 * The addresses of the host are tried in the order of the resolver.
+	 * @param[in] _hostname Name or IP of the host (resolved with enet::resolver, the call can block on a DNS request).
+	 * @param[in] _port Port of the host.
+	 * @param[in] _timeOut Maximum time to connect each address.
+	 * @param[in] _loop Loop of the connection (null: loop of the current thread).
+	 * @return The connection (not alive if it fails).
+	 */
+	enet::Task<enet::AsyncTcp> connect(etk::String _hostname, uint16_t _port, echrono::Duration _timeOut=echrono::seconds(10), enet::EventLoop* _loop=null);
+}
+
+#endif
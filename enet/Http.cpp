@@ -11,88 +11,201 @@
 #include <etk/stdTools.hpp>
 #include <enet/TcpClient.hpp>
 #include <enet/pourcentEncoding.hpp>
+#include <enet/AdmissionControl.hpp>
+#include <enet/ConnectionPool.hpp>
+#include <enet/RateLimiter.hpp>
+#include <enet/HttpCanned.hpp>
+#include <enet/HttpCompression.hpp>
+#include <enet/HttpCache.hpp>
 extern "C" {
 	#include <string.h>
 }
 
 
-static etk::String escapeChar(const etk::String& _value) {
-	return _value;
+namespace enet {
+	namespace httpTable {
+		// Name of the protocols (same order than enet::HTTPProtocol)
+		static constexpr const char* g_protocolName[] = {
+			"HTTP/0.1",
+			"HTTP/0.2",
+			"HTTP/0.3",
+			"HTTP/0.4",
+			"HTTP/0.5",
+			"HTTP/0.6",
+			"HTTP/0.7",
+			"HTTP/0.8",
+			"HTTP/0.9",
+			"HTTP/0.10",
+			"HTTP/1.0",
+			"HTTP/1.1",
+			"HTTP/1.2",
+			"HTTP/1.3",
+			"HTTP/1.4",
+			"HTTP/1.5",
+			"HTTP/1.6",
+			"HTTP/1.7",
+			"HTTP/1.8",
+			"HTTP/1.9",
+			"HTTP/1.10",
+			"HTTP/2.0",
+			"HTTP/2.1",
+			"HTTP/2.2",
+			"HTTP/2.3",
+			"HTTP/2.4",
+			"HTTP/2.5",
+			"HTTP/2.6",
+			"HTTP/2.7",
+			"HTTP/2.8",
+			"HTTP/2.9",
+			"HTTP/2.10",
+			"HTTP/3.0",
+			"HTTP/3.1",
+			"HTTP/3.2",
+			"HTTP/3.3",
+			"HTTP/3.4",
+			"HTTP/3.5",
+			"HTTP/3.6",
+			"HTTP/3.7",
+			"HTTP/3.8",
+			"HTTP/3.9",
+			"HTTP/3.10",
+		};
+		static_assert(sizeof(g_protocolName) / sizeof(g_protocolName[0]) == size_t(enet::HTTPProtocol::http_3_10) + 1, "The name list must match enet::HTTPProtocol");
+		// Name of the methods (same order than enet::HTTPReqType)
+		static constexpr const char* g_reqTypeName[] = {
+			"GET",
+			"HEAD",
+			"POST",
+			"PUT",
+			"DELETE",
+			"OPTIONS"
+		};
+		static_assert(sizeof(g_reqTypeName) / sizeof(g_reqTypeName[0]) == size_t(enet::HTTPReqType::HTTP_OPTIONS) + 1, "The name list must match enet::HTTPReqType");
+		static inline bool isDigit(char _value) {
+			return    _value >= '0'
+			       && _value <= '9';
+		}
+		/**
+		 * @brief Parse "HTTP/x.y": the id of the protocol is computed from the version.
+		 */
+		static const char* getProtocolName(enum enet::HTTPProtocol _value) {
+			if (size_t(_value) > size_t(enet::HTTPProtocol::http_3_10)) {
+				return "HTTP/0.1";
+			}
+			return g_protocolName[size_t(_value)];
+		}
+		static bool parseProtocol(const char* _data, size_t _size, enum enet::HTTPProtocol& _value) {
+			_value = enet::HTTPProtocol::http_0_1;
+			if (    _size < 8
+			     || _size > 9
+			     || memcmp(_data, "HTTP/", 5) != 0
+			     || _data[5] < '0'
+			     || _data[5] > '3'
+			     || _data[6] != '.'
+			     || isDigit(_data[7]) == false) {
+				return false;
+			}
+			int32_t major = _data[5] - '0';
+			int32_t minor = _data[7] - '0';
+			if (_size == 9) {
+				// Only "x.10" have 2 digits
+				if (    _data[7] != '1'
+				     || _data[8] != '0') {
+					return false;
+				}
+				minor = 10;
+			}
+			if (major == 0) {
+				// There is no "HTTP/0.0"
+				if (minor == 0) {
+					return false;
+				}
+				_value = enet::HTTPProtocol(minor - 1);
+				return true;
+			}
+			_value = enet::HTTPProtocol(size_t(enet::HTTPProtocol::http_1_0) + (major - 1) * 11 + minor);
+			return true;
+		}
+		static bool parseReqType(const char* _data, size_t _size, enum enet::HTTPReqType& _value) {
+			_value = enet::HTTPReqType::HTTP_GET;
+			for (size_t iii=0; iii<sizeof(g_reqTypeName) / sizeof(g_reqTypeName[0]); ++iii) {
+				if (    strlen(g_reqTypeName[iii]) == _size
+				     && memcmp(g_reqTypeName[iii], _data, _size) == 0) {
+					_value = enet::HTTPReqType(iii);
+					return true;
+				}
+			}
+			return false;
+		}
+		static bool parseAnswerCode(const char* _data, size_t _size, enum enet::HTTPAnswerCode& _value) {
+			_value = enet::HTTPAnswerCode::c000_unknow;
+			if (    _size != 3
+			     || isDigit(_data[0]) == false
+			     || isDigit(_data[1]) == false
+			     || isDigit(_data[2]) == false) {
+				return false;
+			}
+			enum enet::HTTPAnswerCode code = enet::HTTPAnswerCode((_data[0] - '0') * 100 + (_data[1] - '0') * 10 + (_data[2] - '0'));
+			if (enet::getHTTPAnswerReason(code) == null) {
+				return false;
+			}
+			_value = code;
+			return true;
+		}
+	}
 }
-static etk::String unEscapeChar(const etk::String& _value) {
-	return _value;
+
+const char* enet::getHTTPAnswerReason(enum enet::HTTPAnswerCode _value) {
+	switch (_value) {
+		case enet::HTTPAnswerCode::c100_continue: return "Continue";
+		case enet::HTTPAnswerCode::c101_switchingProtocols: return "Switching Protocols";
+		case enet::HTTPAnswerCode::c103_checkpoint: return "Checkpoint";
+		case enet::HTTPAnswerCode::c200_ok: return "OK";
+		case enet::HTTPAnswerCode::c201_created: return "Created";
+		case enet::HTTPAnswerCode::c202_accepted: return "Accepted";
+		case enet::HTTPAnswerCode::c203_nonAuthoritativeInformation: return "Non-Authoritative Information";
+		case enet::HTTPAnswerCode::c204_noContent: return "No Content";
+		case enet::HTTPAnswerCode::c205_resetContent: return "Reset Content";
+		case enet::HTTPAnswerCode::c206_partialContent: return "Partial Content";
+		case enet::HTTPAnswerCode::c300_multipleChoices: return "Multiple Choices";
+		case enet::HTTPAnswerCode::c301_movedPermanently: return "Moved Permanently";
+		case enet::HTTPAnswerCode::c302_found: return "Found";
+		case enet::HTTPAnswerCode::c303_seeOther: return "See Other";
+		case enet::HTTPAnswerCode::c304_notModified: return "Not Modified";
+		case enet::HTTPAnswerCode::c306_switchProxy: return "Switch Proxy";
+		case enet::HTTPAnswerCode::c307_temporaryRedirect: return "Temporary Redirect";
+		case enet::HTTPAnswerCode::c308_resumeIncomplete: return "Resume Incomplete";
+		case enet::HTTPAnswerCode::c400_badRequest: return "Bad Request";
+		case enet::HTTPAnswerCode::c401_unauthorized: return "Unauthorized";
+		case enet::HTTPAnswerCode::c402_paymentRequired: return "Payment Required";
+		case enet::HTTPAnswerCode::c403_forbidden: return "Forbidden";
+		case enet::HTTPAnswerCode::c404_notFound: return "Not Found";
+		case enet::HTTPAnswerCode::c405_methodNotAllowed: return "Method Not Allowed";
+		case enet::HTTPAnswerCode::c406_notAcceptable: return "Not Acceptable";
+		case enet::HTTPAnswerCode::c407_proxyAuthenticationRequired: return "Proxy Authentication Required";
+		case enet::HTTPAnswerCode::c408_requestTimeout: return "Request Timeout";
+		case enet::HTTPAnswerCode::c409_conflict: return "Conflict";
+		case enet::HTTPAnswerCode::c410_gone: return "Gone";
+		case enet::HTTPAnswerCode::c411_lengthRequired: return "Length Required";
+		case enet::HTTPAnswerCode::c412_preconditionFailed: return "Precondition Failed";
+		case enet::HTTPAnswerCode::c413_requestEntityTooLarge: return "Request Entity Too Large";
+		case enet::HTTPAnswerCode::c414_requestURITooLong: return "Request-URI Too Long";
+		case enet::HTTPAnswerCode::c415_unsupportedMediaType: return "Unsupported Media Type";
+		case enet::HTTPAnswerCode::c416_requestedRangeNotSatisfiable: return "Requested Range Not Satisfiable";
+		case enet::HTTPAnswerCode::c417_expectationFailed: return "Expectation Failed";
+		case enet::HTTPAnswerCode::c429_tooManyRequests: return "Too Many Requests";
+		case enet::HTTPAnswerCode::c500_internalServerError: return "Internal Server Error";
+		case enet::HTTPAnswerCode::c501_notImplemented: return "Not Implemented";
+		case enet::HTTPAnswerCode::c502_badGateway: return "Bad Gateway";
+		case enet::HTTPAnswerCode::c503_serviceUnavailable: return "Service Unavailable";
+		case enet::HTTPAnswerCode::c504_gatewayTimeout: return "Gateway Timeout";
+		case enet::HTTPAnswerCode::c505_httpVersionNotSupported: return "HTTP Version Not Supported";
+		case enet::HTTPAnswerCode::c511_networkAuthenticationRequired: return "Network Authentication Required";
+		default:
+			break;
+	}
+	return null;
 }
-static etk::String removeStartAndStopSpace(const etk::String& _value) {
-	etk::String out;
-	out.reserve(_value.size());
-	bool findSpace = false;
-	for (auto &it : _value) {
-		if (it != ' ') {
-			if (    findSpace == true
-			     && out.size() != 0) {
-				out += ' ';
-			}
-			out += it;
-			findSpace = false;
-		} else {
-			findSpace = true;
-		}
-	}
-	return out;
-}
-
-static const etk::Map<enet::HTTPAnswerCode, etk::String>& getProtocolName() {
-	static etk::Map<enet::HTTPAnswerCode, etk::String> protocolName;
-	static bool isInit = false;
-	if (isInit == true) {
-		return protocolName;
-	}
-	isInit = true;
-	protocolName.add(enet::HTTPAnswerCode::c100_continue, "Continue");
-	protocolName.add(enet::HTTPAnswerCode::c101_switchingProtocols, "Switching Protocols");
-	protocolName.add(enet::HTTPAnswerCode::c103_checkpoint, "Checkpoint");
-	protocolName.add(enet::HTTPAnswerCode::c200_ok, "OK");
-	protocolName.add(enet::HTTPAnswerCode::c201_created, "Created");
-	protocolName.add(enet::HTTPAnswerCode::c202_accepted, "Accepted");
-	protocolName.add(enet::HTTPAnswerCode::c203_nonAuthoritativeInformation, "Non-Authoritative Information");
-	protocolName.add(enet::HTTPAnswerCode::c204_noContent, "No Content");
-	protocolName.add(enet::HTTPAnswerCode::c205_resetContent, "Reset Content");
-	protocolName.add(enet::HTTPAnswerCode::c206_partialContent, "Partial Content");
-	protocolName.add(enet::HTTPAnswerCode::c300_multipleChoices, "Multiple Choices");
-	protocolName.add(enet::HTTPAnswerCode::c301_movedPermanently, "Moved Permanently");
-	protocolName.add(enet::HTTPAnswerCode::c302_found, "Found");
-	protocolName.add(enet::HTTPAnswerCode::c303_seeOther, "See Other");
-	protocolName.add(enet::HTTPAnswerCode::c304_notModified, "Not Modified");
-	protocolName.add(enet::HTTPAnswerCode::c306_switchProxy, "Switch Proxy");
-	protocolName.add(enet::HTTPAnswerCode::c307_temporaryRedirect, "Temporary Redirect");
-	protocolName.add(enet::HTTPAnswerCode::c308_resumeIncomplete, "Resume Incomplete");
-	protocolName.add(enet::HTTPAnswerCode::c400_badRequest, "Bad Request");
-	protocolName.add(enet::HTTPAnswerCode::c401_unauthorized, "Unauthorized");
-	protocolName.add(enet::HTTPAnswerCode::c402_paymentRequired, "Payment Required");
-	protocolName.add(enet::HTTPAnswerCode::c403_forbidden, "Forbidden");
-	protocolName.add(enet::HTTPAnswerCode::c404_notFound, "Not Found");
-	protocolName.add(enet::HTTPAnswerCode::c405_methodNotAllowed, "Method Not Allowed");
-	protocolName.add(enet::HTTPAnswerCode::c406_notAcceptable, "Not Acceptable");
-	protocolName.add(enet::HTTPAnswerCode::c407_proxyAuthenticationRequired, "Proxy Authentication Required");
-	protocolName.add(enet::HTTPAnswerCode::c408_requestTimeout, "Request Timeout");
-	protocolName.add(enet::HTTPAnswerCode::c409_conflict, "Conflict");
-	protocolName.add(enet::HTTPAnswerCode::c410_gone, "Gone");
-	protocolName.add(enet::HTTPAnswerCode::c411_lengthRequired, "Length Required");
-	protocolName.add(enet::HTTPAnswerCode::c412_preconditionFailed, "Precondition Failed");
-	protocolName.add(enet::HTTPAnswerCode::c413_requestEntityTooLarge, "Request Entity Too Large");
-	protocolName.add(enet::HTTPAnswerCode::c414_requestURITooLong, "Request-URI Too Long");
-	protocolName.add(enet::HTTPAnswerCode::c415_unsupportedMediaType, "Unsupported Media Type");
-	protocolName.add(enet::HTTPAnswerCode::c416_requestedRangeNotSatisfiable, "Requested Range Not Satisfiable");
-	protocolName.add(enet::HTTPAnswerCode::c417_expectationFailed, "Expectation Failed");
-	protocolName.add(enet::HTTPAnswerCode::c500_internalServerError, "Internal Server Error");
-	protocolName.add(enet::HTTPAnswerCode::c501_notImplemented, "Not Implemented");
-	protocolName.add(enet::HTTPAnswerCode::c502_badGateway, "Bad Gateway");
-	protocolName.add(enet::HTTPAnswerCode::c503_serviceUnavailable, "Service Unavailable");
-	protocolName.add(enet::HTTPAnswerCode::c504_gatewayTimeout, "Gateway Timeout");
-	protocolName.add(enet::HTTPAnswerCode::c505_httpVersionNotSupported, "HTTP Version Not Supported");
-	protocolName.add(enet::HTTPAnswerCode::c511_networkAuthenticationRequired, "Network Authentication Required");
-	return protocolName;
-};
 
 
 
@@ -106,7 +219,20 @@ enet::Http::Http(enet::Tcp _connection, bool _isServer) :
   m_connection(etk::move(_connection)),
   m_headerIsSend(false),
   m_thread(null),
-  m_threadRunning(false) {
+  m_threadRunning(false),
+  m_admissionControl(null),
+  m_connectionAdmitted(false),
+  m_rateLimiter(null),
+  m_compression(null),
+  m_inflater(null),
+  m_cache(null),
+  m_idleTimeOut(echrono::seconds(10)),
+  m_maxRequest(100),
+  m_nbRequest(0),
+  m_keepAlive(false),
+  m_bodySize(-1),
+  m_bodyChunked(false),
+  m_answerWait(false) {
 	//setSendHeaderProperties("User-Agent", "e-net (ewol network interface)");
 	/*
 	if (m_keepAlive == true) {
@@ -122,33 +248,307 @@ enet::Http::~Http() {
 void enet::Http::threadCallback() {
 	ENET_DEBUG("Start of thread HTTP");
 	ethread::setName("TcpString-input");
+	if (    m_isServer == true
+	     && m_admissionControl != null) {
+		m_queueDelay = echrono::Steady::now() - m_connection.getLinkTime();
+		bool admitted = m_admissionControl->connectionOpen();
+		__atomic_store_n(&m_connectionAdmitted, admitted, __ATOMIC_RELEASE);
+		if (admitted == false) {
+			rejectWork();
+			m_threadRunning = false;
+			ENET_DEBUG("End of thread HTTP (rejected)");
+			return;
+		}
+	}
 	// get datas:
 	while (    m_threadRunning == true
 	        && m_connection.getConnectionStatus() == enet::Tcp::status::link) {
 		// READ section data:
 		if (m_headerIsSend == false) {
+			if (    m_isServer == true
+			     && m_connection.waitData(m_idleTimeOut) == false) {
+				if (m_connection.getConnectionStatus() == enet::Tcp::status::link) {
+					ENET_DEBUG("Close idle connection FROM " << getRemoteAddress() << " after " << m_nbRequest << " request(s)");
+					stop(true);
+				}
+				break;
+			}
+			if (    m_pool != null
+			     && m_connection.waitData(echrono::milliseconds(100)) == false) {
+				// Do not stay blocked in the read: stop() can give back the connection to the pool
+				continue;
+			}
 			getHeader();
-			if (m_headerIsSend == false) {
+			if (    m_headerIsSend == false
+			     || m_threadRunning == false) {
 				continue;
 			}
 		}
 		if (m_observerRaw != null) {
 			m_observerRaw(m_connection);
 		} else {
-			m_temporaryBuffer.resize(67000);
-			int32_t len = m_connection.read(&m_temporaryBuffer[0], m_temporaryBuffer.size());
-			if (len > 0) {
-				ENET_INFO("Call client with datas ...");
-				if (m_observer != null) {
-					m_observer(m_temporaryBuffer);
-				}
-			}
+			readBody();
 		}
 	}
+	if (    m_headerIsSend == true
+	     && m_observerRaw == null
+	     && m_bodyChunked == false
+	     && m_bodySize < 0
+	     && m_observerBody != null) {
+		// The body without size end with the connection
+		m_observerBody(null, 0, true);
+	}
+	// The remote can close the connection without any call of stop()
+	releaseAdmission();
 	m_threadRunning = false;
 	ENET_DEBUG("End of thread HTTP");
 }
 
+void enet::Http::readBody() {
+	// Read only the body of the current message, the next message stay in the socket
+	int64_t maxSize = 67000;
+	if (    m_bodyChunked == false
+	     && m_bodySize > 0) {
+		maxSize = etk::min(maxSize, m_bodySize);
+	}
+	m_temporaryBuffer.resize(maxSize);
+	int32_t len = m_connection.read(&m_temporaryBuffer[0], m_temporaryBuffer.size());
+	if (len <= 0) {
+		return;
+	}
+	size_t bodySize = len;
+	bool end = false;
+	if (m_bodyChunked == true) {
+		size_t consumed = 0;
+		enum enet::HttpChunkDecoder::status status = m_chunkDecoder.decode(&m_temporaryBuffer[0], len, consumed, bodySize);
+		if (status == enet::HttpChunkDecoder::status::error) {
+			ENET_ERROR("Malformed chunked body FROM " << getRemoteAddress());
+			stop(true);
+			return;
+		}
+		if (status == enet::HttpChunkDecoder::status::done) {
+			// The data after the last chunk is the next message
+			m_connection.putBack(&m_temporaryBuffer[consumed], len - consumed);
+			end = true;
+		}
+	} else if (m_bodySize > 0) {
+		m_bodySize -= len;
+		end = m_bodySize == 0;
+	}
+	etk::Vector<uint8_t>* body = &m_temporaryBuffer;
+	if (    bodySize > 0
+	     && m_inflater != null
+	     && m_inflater->isInit() == true) {
+		enum enet::HttpInflater::status status = m_inflater->decompress(&m_temporaryBuffer[0], bodySize, m_inflateBuffer);
+		if (status == enet::HttpInflater::status::error) {
+			ENET_ERROR("Malformed compressed body FROM " << getRemoteAddress());
+			stop(true);
+			return;
+		}
+		if (status == enet::HttpInflater::status::tooBig) {
+			ENET_ERROR("Decompressed body too big FROM " << getRemoteAddress() << " (limit " << m_compression->getMaxInflateSize() << " byte(s))");
+			enet::HttpAnswer answer(enet::HTTPAnswerCode::c413_requestEntityTooLarge);
+			answer.setProtocol(enet::HTTPProtocol::http_1_1);
+			m_keepAlive = false;
+			setAnswer(answer, null, 0);
+			stop(true);
+			return;
+		}
+		body = &m_inflateBuffer;
+		bodySize = m_inflateBuffer.size();
+	}
+	if (bodySize > 0) {
+		if (m_observerBody != null) {
+			m_observerBody(&(*body)[0], bodySize, false);
+		}
+		if (m_observer != null) {
+			body->resize(bodySize);
+			m_observer(*body);
+		}
+	}
+	if (end == true) {
+		endBody();
+	}
+}
+
+void enet::Http::updateBodyFraming(const enet::HttpHeader& _header, bool _hasBody) {
+	m_bodyChunked = false;
+	m_chunkDecoder.reset();
+	if (_hasBody == false) {
+		m_bodySize = 0;
+		return;
+	}
+	// RFC 7230 3.3.3: the transfer encoding is used before the content length
+	if (_header.existKey(enet::HTTPHeaderId::transferEncoding) == true) {
+		m_bodyChunked = _header.isChunked();
+		// Other encoding: the end of the body is the close of the connection
+		m_bodySize = -1;
+		return;
+	}
+	if (_header.existKey(enet::HTTPHeaderId::contentLength) == true) {
+		// Invalid size (-1) ==> can not find the next message
+		m_bodySize = _header.getContentLength();
+		return;
+	}
+	if (m_isServer == true) {
+		// A request without size has no body
+		m_bodySize = 0;
+		return;
+	}
+	// An answer without size end with the connection
+	m_bodySize = -1;
+}
+
+void enet::Http::endBody() {
+	if (m_observerBody != null) {
+		m_observerBody(null, 0, true);
+	}
+	if (m_inflater != null) {
+		m_inflater->reset();
+	}
+	if (m_isServer == true) {
+		endRequest();
+		return;
+	}
+	if (m_keepAlive == false) {
+		ENET_DEBUG("connection closed by remote :");
+		stop(true);
+		return;
+	}
+	// Wait the next answer
+	m_headerIsSend = false;
+	m_answerWait = false;
+}
+
+void enet::Http::updateKeepAlive() {
+	m_keepAlive = false;
+	m_bodySize = -1;
+	m_bodyChunked = false;
+	if (m_observerRaw != null) {
+		// The connection is used for an other protocol after the header
+		return;
+	}
+	updateBodyFraming(m_requestHeader, true);
+	if (    m_bodyChunked == false
+	     && m_bodySize < 0) {
+		// The end of the body is not known ==> can not find the next request
+		return;
+	}
+	if (    m_maxRequest > 0
+	     && m_nbRequest + 1 >= m_maxRequest) {
+		return;
+	}
+	// HTTP/1.1 is persistent by default, HTTP/1.0 only on request
+	if (m_requestHeader.getProtocol() >= enet::HTTPProtocol::http_1_1) {
+		m_keepAlive = m_requestHeader.isKeyEqual(enet::HTTPHeaderId::connection, "close") == false;
+	} else {
+		m_keepAlive = m_requestHeader.isKeyEqual(enet::HTTPHeaderId::connection, "keep-alive");
+	}
+}
+
+void enet::Http::updateAnswerFraming() {
+	m_keepAlive = false;
+	m_bodySize = -1;
+	m_bodyChunked = false;
+	if (m_observerRaw != null) {
+		// The connection is used for an other protocol after the header
+		return;
+	}
+	enum enet::HTTPAnswerCode code = m_answerHeader.getErrorCode();
+	// RFC 7230 3.3.3: no body for the answer of HEAD, 1xx, 204 and 304
+	bool hasBody =    m_requestHeader.getType() != enet::HTTPReqType::HTTP_HEAD
+	               && int32_t(code) >= 200
+	               && code != enet::HTTPAnswerCode::c204_noContent
+	               && code != enet::HTTPAnswerCode::c304_notModified;
+	updateBodyFraming(m_answerHeader, hasBody);
+	if (    m_bodyChunked == false
+	     && m_bodySize < 0) {
+		return;
+	}
+	if (m_answerHeader.getProtocol() >= enet::HTTPProtocol::http_1_1) {
+		m_keepAlive = m_answerHeader.isKeyEqual(enet::HTTPHeaderId::connection, "close") == false;
+	} else {
+		m_keepAlive = m_answerHeader.isKeyEqual(enet::HTTPHeaderId::connection, "keep-alive");
+	}
+}
+
+void enet::Http::updateAnswerConnection() {
+	enum enet::HTTPAnswerCode code = m_answerHeader.getErrorCode();
+	if (code == enet::HTTPAnswerCode::c101_switchingProtocols) {
+		return;
+	}
+	if (m_answerHeader.isKeyEqual(enet::HTTPHeaderId::connection, "close") == true) {
+		m_keepAlive = false;
+	}
+	if (    m_keepAlive == true
+	     && m_answerHeader.existKey(enet::HTTPHeaderId::contentLength) == false
+	     && (    m_answerHeader.existKey(enet::HTTPHeaderId::transferEncoding) == false
+	          || m_answerHeader.isChunked() == false)
+	     && m_requestHeader.getType() != enet::HTTPReqType::HTTP_HEAD
+	     && int32_t(code) >= 200
+	     && code != enet::HTTPAnswerCode::c204_noContent
+	     && code != enet::HTTPAnswerCode::c304_notModified) {
+		// The end of the body is the close of the connection
+		m_keepAlive = false;
+	}
+	if (m_keepAlive == false) {
+		if (m_answerHeader.existKey(enet::HTTPHeaderId::connection) == false) {
+			m_answerHeader.setKey(enet::HTTPHeaderId::connection, "close");
+		}
+		return;
+	}
+	if (    (    m_requestHeader.getProtocol() < enet::HTTPProtocol::http_1_1
+	          || m_answerHeader.getProtocol() < enet::HTTPProtocol::http_1_1)
+	     && m_answerHeader.existKey(enet::HTTPHeaderId::connection) == false) {
+		m_answerHeader.setKey(enet::HTTPHeaderId::connection, "keep-alive");
+	}
+}
+
+void enet::Http::endRequest() {
+	m_nbRequest++;
+	if (m_keepAlive == false) {
+		ENET_DEBUG("Close connection FROM " << getRemoteAddress() << " after " << m_nbRequest << " request(s)");
+		stop(true);
+		return;
+	}
+	// Wait the next request (it can already be received: pipelining)
+	m_headerIsSend = false;
+	m_requestHeader.clearKeys();
+	m_requestHeader.setQuery(etk::Map<etk::String, etk::String>());
+	m_answerHeader.clearKeys();
+	m_answerHeader.setHelp("");
+}
+
+namespace enet {
+	namespace httpCanned {
+		/**
+		 * @brief Create the answer of a request rejected by the rate limiter.
+		 */
+		static ememory::SharedPtr<enet::HttpCannedAnswer> createTooManyRequests() {
+			enet::HttpAnswer answer(enet::HTTPAnswerCode::c429_tooManyRequests);
+			answer.setProtocol(enet::HTTPProtocol::http_1_1);
+			answer.setKey(enet::HTTPHeaderId::connection, "close");
+			answer.setKey(enet::HTTPHeaderId::retryAfter, "1");
+			return ememory::makeShared<enet::HttpCannedAnswer>(answer);
+		}
+	}
+}
+
+void enet::Http::rejectWork() {
+	if (m_admissionControl == null) {
+		return;
+	}
+	setAnswer(*m_admissionControl->getRejectCannedAnswer());
+	stop(true);
+}
+
+void enet::Http::releaseAdmission() {
+	// stop() and the end of the processing thread can run at the same time
+	if (__atomic_exchange_n(&m_connectionAdmitted, false, __ATOMIC_ACQ_REL) == true) {
+		m_admissionControl->connectionClose();
+	}
+}
+
 void enet::Http::redirectTo(const etk::String& _addressRedirect, bool _inThreadStop) {
 	if (m_isServer == true) {
 		ENET_ERROR("Request a redirect in Server mode ==> not authorised");
@@ -156,6 +556,10 @@ void enet::Http::redirectTo(const etk::String& _addressRedirect, bool _inThreadS
 	}
 	stop(_inThreadStop);
 	m_headerIsSend = false;
+	if (m_retryPolicy != null) {
+		m_connection = etk::move(connectTcpClient(_addressRedirect, *m_retryPolicy, echrono::seconds(1)));
+		return;
+	}
 	m_connection = etk::move(connectTcpClient(_addressRedirect, 5, echrono::seconds(1)));
 }
 
@@ -179,6 +583,22 @@ void enet::Http::start() {
 void enet::Http::stop(bool _inThreadStop){
 	ENET_DEBUG("disconnect [START]");
 	m_threadRunning = false;
+	if (    m_pool != null
+	     && _inThreadStop == false) {
+		// The thread does not wait more than 100ms in the read: wait its end before using the connection
+		if (m_thread != null) {
+			m_thread->join();
+			ETK_DELETE(ethread::Thread, m_thread);
+			m_thread = null;
+		}
+		if (    m_connection.getConnectionStatus() == enet::Tcp::status::link
+		     && m_answerWait == false
+		     && m_headerIsSend == false) {
+			ENET_DEBUG("Give back the connection to the pool");
+			m_pool->release(etk::move(m_connection));
+		}
+		m_pool.reset();
+	}
 	/*
 	if (m_connection.getConnectionStatus() == enet::Tcp::status::link) {
 		uint32_t size = 0xFFFFFFFF;
@@ -188,6 +608,7 @@ void enet::Http::stop(bool _inThreadStop){
 	if (m_connection.getConnectionStatus() != enet::Tcp::status::unlink) {
 		m_connection.unlink();
 	}
+	releaseAdmission();
 	if (_inThreadStop == false) {
 		if (m_thread != null) {
 			ENET_DEBUG("wait join Thread ...");
@@ -204,11 +625,12 @@ void enet::Http::writeAnswerHeader(enum enet::HTTPAnswerCode _value) {
 	etk::String out;
 	out = "HTTP/1.1 ";
 	out += etk::toString(int32_t(_value));
-	auto it = getProtocolName().find(_value);
-	if (it == getProtocolName().end() ) {
+	const char* reason = getHTTPAnswerReason(_value);
+	if (reason == null) {
 		out += " ???";
 	} else {
-		out += " " + it->second;
+		out += " ";
+		out += reason;
 	}
 	out += "\r\n\r\n";
 	ENET_WARNING("Write header :" << out);
@@ -218,14 +640,7 @@ void enet::Http::writeAnswerHeader(enum enet::HTTPAnswerCode _value) {
 namespace etk {
 	template <>
 	bool from_string<enum enet::HTTPAnswerCode>(enum enet::HTTPAnswerCode& _variableRet, const etk::String& _value) {
-		_variableRet = enet::HTTPAnswerCode::c000_unknow;
-		for (auto &it : getProtocolName()) {
-			if (etk::toString(int32_t(it.first)) == _value) {
-				_variableRet = it.first;
-				return true;
-			}
-		}
-		return false;
+		return enet::httpTable::parseAnswerCode(_value.c_str(), _value.size(), _variableRet);
 	}
 	template <>
 	etk::String toString<enum enet::HTTPAnswerCode>(const enum enet::HTTPAnswerCode& _value) {
@@ -233,327 +648,343 @@ namespace etk {
 	}
 	template <>
 	bool from_string<enum enet::HTTPReqType>(enum enet::HTTPReqType& _variableRet, const etk::String& _value) {
-		_variableRet = enet::HTTPReqType::HTTP_GET;
-		if (_value == "GET") {
-			_variableRet = enet::HTTPReqType::HTTP_GET;
-			return true;
-		} else if (_value == "HEAD") {
-			_variableRet = enet::HTTPReqType::HTTP_HEAD;
-			return true;
-		} else if (_value == "POST") {
-			_variableRet = enet::HTTPReqType::HTTP_POST;
-			return true;
-		} else if (_value == "PUT") {
-			_variableRet = enet::HTTPReqType::HTTP_PUT;
-			return true;
-		} else if (_value == "DELETE") {
-			_variableRet = enet::HTTPReqType::HTTP_DELETE;
-			return true;
-		} else if (_value == "OPTIONS") {
-			_variableRet = enet::HTTPReqType::HTTP_OPTIONS;
-			return true;
-		}
-		return false;
+		return enet::httpTable::parseReqType(_value.c_str(), _value.size(), _variableRet);
 	}
 	template <>
 	etk::String toString<enum enet::HTTPReqType>(const enum enet::HTTPReqType& _value) {
-		switch (_value) {
-			case enet::HTTPReqType::HTTP_GET: return "GET";
-			case enet::HTTPReqType::HTTP_HEAD: return "HEAD";
-			case enet::HTTPReqType::HTTP_POST: return "POST";
-			case enet::HTTPReqType::HTTP_PUT: return "PUT";
-			case enet::HTTPReqType::HTTP_DELETE: return "DELETE";
-			case enet::HTTPReqType::HTTP_OPTIONS: return "OPTIONS";
+		if (size_t(_value) > size_t(enet::HTTPReqType::HTTP_OPTIONS)) {
+			return "UNKNOW";
 		}
-		return "UNKNOW";
+		return enet::httpTable::g_reqTypeName[size_t(_value)];
 	}
 	template <>
 	bool from_string<enum enet::HTTPProtocol>(enum enet::HTTPProtocol& _variableRet, const etk::String& _value) {
-		_variableRet = enet::HTTPProtocol::http_0_1;
-		if (_value == "HTTP/0.1") { _variableRet = enet::HTTPProtocol::http_0_1; return true; }
-		if (_value == "HTTP/0.2") { _variableRet = enet::HTTPProtocol::http_0_2; return true; }
-		if (_value == "HTTP/0.3") { _variableRet = enet::HTTPProtocol::http_0_3; return true; }
-		if (_value == "HTTP/0.4") { _variableRet = enet::HTTPProtocol::http_0_4; return true; }
-		if (_value == "HTTP/0.5") { _variableRet = enet::HTTPProtocol::http_0_5; return true; }
-		if (_value == "HTTP/0.6") { _variableRet = enet::HTTPProtocol::http_0_6; return true; }
-		if (_value == "HTTP/0.7") { _variableRet = enet::HTTPProtocol::http_0_7; return true; }
-		if (_value == "HTTP/0.8") { _variableRet = enet::HTTPProtocol::http_0_8; return true; }
-		if (_value == "HTTP/0.9") { _variableRet = enet::HTTPProtocol::http_0_9; return true; }
-		if (_value == "HTTP/0.10") { _variableRet = enet::HTTPProtocol::http_0_10; return true; }
-		if (_value == "HTTP/1.0") { _variableRet = enet::HTTPProtocol::http_1_0; return true; }
-		if (_value == "HTTP/1.1") { _variableRet = enet::HTTPProtocol::http_1_1; return true; }
-		if (_value == "HTTP/1.2") { _variableRet = enet::HTTPProtocol::http_1_2; return true; }
-		if (_value == "HTTP/1.3") { _variableRet = enet::HTTPProtocol::http_1_3; return true; }
-		if (_value == "HTTP/1.4") { _variableRet = enet::HTTPProtocol::http_1_4; return true; }
-		if (_value == "HTTP/1.5") { _variableRet = enet::HTTPProtocol::http_1_5; return true; }
-		if (_value == "HTTP/1.6") { _variableRet = enet::HTTPProtocol::http_1_6; return true; }
-		if (_value == "HTTP/1.7") { _variableRet = enet::HTTPProtocol::http_1_7; return true; }
-		if (_value == "HTTP/1.8") { _variableRet = enet::HTTPProtocol::http_1_8; return true; }
-		if (_value == "HTTP/1.9") { _variableRet = enet::HTTPProtocol::http_1_9; return true; }
-		if (_value == "HTTP/1.10") { _variableRet = enet::HTTPProtocol::http_1_10; return true; }
-		if (_value == "HTTP/2.0") { _variableRet = enet::HTTPProtocol::http_2_0; return true; }
-		if (_value == "HTTP/2.1") { _variableRet = enet::HTTPProtocol::http_2_1; return true; }
-		if (_value == "HTTP/2.2") { _variableRet = enet::HTTPProtocol::http_2_2; return true; }
-		if (_value == "HTTP/2.3") { _variableRet = enet::HTTPProtocol::http_2_3; return true; }
-		if (_value == "HTTP/2.4") { _variableRet = enet::HTTPProtocol::http_2_4; return true; }
-		if (_value == "HTTP/2.5") { _variableRet = enet::HTTPProtocol::http_2_5; return true; }
-		if (_value == "HTTP/2.6") { _variableRet = enet::HTTPProtocol::http_2_6; return true; }
-		if (_value == "HTTP/2.7") { _variableRet = enet::HTTPProtocol::http_2_7; return true; }
-		if (_value == "HTTP/2.8") { _variableRet = enet::HTTPProtocol::http_2_8; return true; }
-		if (_value == "HTTP/2.9") { _variableRet = enet::HTTPProtocol::http_2_9; return true; }
-		if (_value == "HTTP/2.10") { _variableRet = enet::HTTPProtocol::http_2_10; return true; }
-		if (_value == "HTTP/3.0") { _variableRet = enet::HTTPProtocol::http_3_0; return true; }
-		if (_value == "HTTP/3.1") { _variableRet = enet::HTTPProtocol::http_3_1; return true; }
-		if (_value == "HTTP/3.2") { _variableRet = enet::HTTPProtocol::http_3_2; return true; }
-		if (_value == "HTTP/3.3") { _variableRet = enet::HTTPProtocol::http_3_3; return true; }
-		if (_value == "HTTP/3.4") { _variableRet = enet::HTTPProtocol::http_3_4; return true; }
-		if (_value == "HTTP/3.5") { _variableRet = enet::HTTPProtocol::http_3_5; return true; }
-		if (_value == "HTTP/3.6") { _variableRet = enet::HTTPProtocol::http_3_6; return true; }
-		if (_value == "HTTP/3.7") { _variableRet = enet::HTTPProtocol::http_3_7; return true; }
-		if (_value == "HTTP/3.8") { _variableRet = enet::HTTPProtocol::http_3_8; return true; }
-		if (_value == "HTTP/3.9") { _variableRet = enet::HTTPProtocol::http_3_9; return true; }
-		if (_value == "HTTP/3.10") { _variableRet = enet::HTTPProtocol::http_3_10; return true; }
-		return false;
+		return enet::httpTable::parseProtocol(_value.c_str(), _value.size(), _variableRet);
 	}
 	template <>
 	etk::String toString<enum enet::HTTPProtocol>(const enum enet::HTTPProtocol& _value) {
-		switch (_value) {
-			case enet::HTTPProtocol::http_0_1:  return "HTTP/0.1";
-			case enet::HTTPProtocol::http_0_2:  return "HTTP/0.2";
-			case enet::HTTPProtocol::http_0_3:  return "HTTP/0.3";
-			case enet::HTTPProtocol::http_0_4:  return "HTTP/0.4";
-			case enet::HTTPProtocol::http_0_5:  return "HTTP/0.5";
-			case enet::HTTPProtocol::http_0_6:  return "HTTP/0.6";
-			case enet::HTTPProtocol::http_0_7:  return "HTTP/0.7";
-			case enet::HTTPProtocol::http_0_8:  return "HTTP/0.8";
-			case enet::HTTPProtocol::http_0_9:  return "HTTP/0.9";
-			case enet::HTTPProtocol::http_0_10: return "HTTP/0.10";
-			case enet::HTTPProtocol::http_1_0:  return "HTTP/1.0";
-			case enet::HTTPProtocol::http_1_1:  return "HTTP/1.1";
-			case enet::HTTPProtocol::http_1_2:  return "HTTP/1.2";
-			case enet::HTTPProtocol::http_1_3:  return "HTTP/1.3";
-			case enet::HTTPProtocol::http_1_4:  return "HTTP/1.4";
-			case enet::HTTPProtocol::http_1_5:  return "HTTP/1.5";
-			case enet::HTTPProtocol::http_1_6:  return "HTTP/1.6";
-			case enet::HTTPProtocol::http_1_7:  return "HTTP/1.7";
-			case enet::HTTPProtocol::http_1_8:  return "HTTP/1.8";
-			case enet::HTTPProtocol::http_1_9:  return "HTTP/1.9";
-			case enet::HTTPProtocol::http_1_10: return "HTTP/1.10";
-			case enet::HTTPProtocol::http_2_0:  return "HTTP/2.0";
-			case enet::HTTPProtocol::http_2_1:  return "HTTP/2.1";
-			case enet::HTTPProtocol::http_2_2:  return "HTTP/2.2";
-			case enet::HTTPProtocol::http_2_3:  return "HTTP/2.3";
-			case enet::HTTPProtocol::http_2_4:  return "HTTP/2.4";
-			case enet::HTTPProtocol::http_2_5:  return "HTTP/2.5";
-			case enet::HTTPProtocol::http_2_6:  return "HTTP/2.6";
-			case enet::HTTPProtocol::http_2_7:  return "HTTP/2.7";
-			case enet::HTTPProtocol::http_2_8:  return "HTTP/2.8";
-			case enet::HTTPProtocol::http_2_9:  return "HTTP/2.9";
-			case enet::HTTPProtocol::http_2_10: return "HTTP/2.10";
-			case enet::HTTPProtocol::http_3_0:  return "HTTP/3.0";
-			case enet::HTTPProtocol::http_3_1:  return "HTTP/3.1";
-			case enet::HTTPProtocol::http_3_2:  return "HTTP/3.2";
-			case enet::HTTPProtocol::http_3_3:  return "HTTP/3.3";
-			case enet::HTTPProtocol::http_3_4:  return "HTTP/3.4";
-			case enet::HTTPProtocol::http_3_5:  return "HTTP/3.5";
-			case enet::HTTPProtocol::http_3_6:  return "HTTP/3.6";
-			case enet::HTTPProtocol::http_3_7:  return "HTTP/3.7";
-			case enet::HTTPProtocol::http_3_8:  return "HTTP/3.8";
-			case enet::HTTPProtocol::http_3_9:  return "HTTP/3.9";
-			case enet::HTTPProtocol::http_3_10: return "HTTP/3.10";
-		}
-		return "HTTP/0.1";
+		return enet::httpTable::getProtocolName(_value);
 	}
 }
 
 
 void enet::Http::setRequestHeader(const enet::HttpRequest& _req) {
 	m_requestHeader = _req;
+	updateRequestHeader();
+	writeHeader(m_requestHeader);
+}
+
+int32_t enet::Http::setRequest(const enet::HttpRequest& _req, const void* _data, int32_t _len) {
+	m_requestHeader = _req;
+	if (    m_requestHeader.existKey(enet::HTTPHeaderId::contentLength) == false
+	     && m_requestHeader.existKey(enet::HTTPHeaderId::transferEncoding) == false) {
+		m_requestHeader.setContentLength(_len);
+	}
+	updateRequestHeader();
+	return writeHeader(m_requestHeader, _data, _len);
+}
+
+void enet::Http::updateRequestHeader() {
 	if (m_isServer == true) {
-		if (m_requestHeader.getKey("Server") == "") {
-			m_requestHeader.setKey("Server", "e-net (ewol network interface)");
+		if (m_requestHeader.existKey(enet::HTTPHeaderId::server) == false) {
+			m_requestHeader.setKey(enet::HTTPHeaderId::server, "e-net (ewol network interface)");
 		}
 	} else {
-		if (m_requestHeader.getKey("User-Agent") == "") {
-			m_requestHeader.setKey("User-Agent", "e-net (ewol network interface)");
+		if (m_requestHeader.existKey(enet::HTTPHeaderId::userAgent) == false) {
+			m_requestHeader.setKey(enet::HTTPHeaderId::userAgent, "e-net (ewol network interface)");
 		}
+		m_answerWait = true;
 	}
-	etk::String value = m_requestHeader.generate();
-	write(value, false);
 }
 
 void enet::Http::setAnswerHeader(const enet::HttpAnswer& _req) {
 	m_answerHeader = _req;
-	if (m_isServer == true) {
-		if (m_requestHeader.getKey("Server") == "") {
-			m_requestHeader.setKey("Server", "e-net (ewol network interface)");
+	updateAnswerHeader();
+	writeHeader(m_answerHeader);
+}
+
+int32_t enet::Http::setAnswer(const enet::HttpAnswer& _req, const void* _data, int32_t _len) {
+	m_answerHeader = _req;
+	if (    m_isServer == true
+	     && m_compression != null
+	     && _data != null
+	     && _len > 0
+	     && m_answerHeader.existKey(enet::HTTPHeaderId::transferEncoding) == false) {
+		enum enet::httpCompression::encoding encoding = m_compression->select(m_requestHeader, m_answerHeader, _len);
+		if (    encoding != enet::httpCompression::encoding::identity
+		     && m_compression->compress(_data, _len, encoding, m_compressBuffer) == true) {
+			enet::HttpCompression::updateHeader(m_answerHeader, encoding);
+			_data = &m_compressBuffer[0];
+			_len = m_compressBuffer.size();
 		}
-	} else {
-		if (m_requestHeader.getKey("User-Agent") == "") {
-			m_requestHeader.setKey("User-Agent", "e-net (ewol network interface)");
+	}
+	if (    m_answerHeader.existKey(enet::HTTPHeaderId::contentLength) == false
+	     && m_answerHeader.existKey(enet::HTTPHeaderId::transferEncoding) == false) {
+		m_answerHeader.setContentLength(_len);
+	}
+	if (    m_isServer == true
+	     && m_cache != null
+	     && m_cacheKey.size() != 0
+	     && m_requestHeader.getType() != enet::HTTPReqType::HTTP_HEAD) {
+		m_cache->store(m_cacheKey, m_answerHeader, _data, _len);
+	}
+	m_cacheKey.clear();
+	updateAnswerHeader();
+	if (    m_isServer == true
+	     && m_requestHeader.getType() == enet::HTTPReqType::HTTP_HEAD) {
+		// The answer of a HEAD request has no body (only its size)
+		return writeHeader(m_answerHeader);
+	}
+	return writeHeader(m_answerHeader, _data, _len);
+}
+
+void enet::Http::updateAnswerHeader() {
+	if (m_isServer == false) {
+		return;
+	}
+	updateAnswerConnection();
+	// "Date" and "Server" are formatted one time per second
+	enet::httpDate::setKeys(m_answerHeader);
+}
+
+int32_t enet::Http::setAnswer(const enet::HttpCannedAnswer& _answer) {
+	// Only the state of the answer is kept: the keys are already encoded
+	m_answerHeader.clearKeys();
+	m_answerHeader.setErrorCode(_answer.getCode());
+	m_answerHeader.setProtocol(_answer.getProtocol());
+	const char* connection = null;
+	if (    m_isServer == true
+	     && _answer.getCode() != enet::HTTPAnswerCode::c101_switchingProtocols) {
+		if (_answer.isClose() == true) {
+			m_keepAlive = false;
 		}
+		if (m_keepAlive == false) {
+			connection = "Connection: close\r\n";
+		} else if (    m_requestHeader.getProtocol() < enet::HTTPProtocol::http_1_1
+		            || _answer.getProtocol() < enet::HTTPProtocol::http_1_1) {
+			connection = "Connection: keep-alive\r\n";
+		}
+	}
+	char date[enet::httpDate::MAX_SIZE];
+	enet::Tcp::Buffer list[4];
+	list[0].m_data = &_answer.getHead()[0];
+	list[0].m_size = _answer.getHead().size();
+	list[1].m_data = date;
+	list[1].m_size = enet::httpDate::getLines(date);
+	list[2].m_data = connection;
+	list[2].m_size = connection == null ? 0 : strlen(connection);
+	list[3].m_data = &_answer.getBody()[0];
+	list[3].m_size = _answer.getBody().size();
+	if (    m_isServer == true
+	     && m_requestHeader.getType() == enet::HTTPReqType::HTTP_HEAD) {
+		// The answer of a HEAD request has no body: only the end of the header
+		list[3].m_size = 2;
 	}
-	etk::String value = m_answerHeader.generate();
-	write(value, false);
+	return m_connection.writeMultiple(list, 4);
+}
+
+int32_t enet::Http::writeHeader(const enet::HttpHeader& _header, const void* _data, int32_t _len, bool _more) {
+	// The buffer keep its memory: no allocation when the header is not bigger than the previous ones
+	m_sendBuffer.resize(0);
+	_header.generate(m_sendBuffer);
+	enet::Tcp::Buffer list[2];
+	list[0].m_data = &m_sendBuffer[0];
+	list[0].m_size = m_sendBuffer.size();
+	list[1].m_data = _data;
+	list[1].m_size = _data == null ? 0 : _len;
+	return m_connection.writeMultiple(list, 2, _more);
 }
 
 void enet::Http::getHeader() {
 	ENET_VERBOSE("Read HTTP Header [START]");
-	bool headerEnded = false;
-	etk::String header;
+	m_keepAlive = false;
+	m_parser.reset();
+	size_t used = 0;
+	enum enet::HttpParser::status parseStatus = enet::HttpParser::status::incomplete;
 	while (m_connection.getConnectionStatus() == enet::Tcp::status::link) {
-		char type = '?';
-		int32_t len = m_connection.read(&type, 1);
-		if (len == 0) {
+		if (used == m_headerBuffer.size()) {
+			// Read by chunk, the buffer grow only for the big headers.
+			m_headerBuffer.resize(etk::max(m_headerBuffer.size() * 2, size_t(4096)));
+		}
+		int32_t len = m_connection.read(&m_headerBuffer[used], m_headerBuffer.size() - used);
+		if (len <= 0) {
 			ethread::sleepMilliSeconds(1);
 			continue;
 		}
-		header += type;
-		if (    header.size() > 4
-		     && header[header.size()-1] == '\n'
-		     && header[header.size()-2] == '\r'
-		     && header[header.size()-3] == '\n'
-		     && header[header.size()-4] == '\r') {
-			// Normal end case ...
-			break;
-		} else if (    header.size() > 2
-		           && header[header.size()-1] == '\n'
-		           && header[header.size()-2] == '\n') {
-			// linux end case
-			break;
-		} else if (    header.size() > 2
-		           && header[header.size()-1] == '\r'
-		           && header[header.size()-2] == '\r') {
-			// Mac end case
+		used += len;
+		parseStatus = m_parser.parse(&m_headerBuffer[0], used);
+		if (parseStatus != enet::HttpParser::status::incomplete) {
 			break;
 		}
 	}
 	if (m_connection.getConnectionStatus() != enet::Tcp::status::link) {
-		ENET_ERROR("Read HTTP Header [STOP] : '" << header << "' ==> status move in unlink ...");
+		if (used == 0) {
+			// The buffer can be empty: the connection is closed before the first read
+			ENET_DEBUG("Read HTTP Header [STOP] : no data ==> status move in unlink ...");
+			return;
+		}
+		ENET_ERROR("Read HTTP Header [STOP] : '" << etk::String(&m_headerBuffer[0], used) << "' ==> status move in unlink ...");
 		return;
 	}
-	ENET_VERBOSE("Read HTTP Header [STOP] : '" << header << "'");
+	const char* data = &m_headerBuffer[0];
+	ENET_VERBOSE("Read HTTP Header [STOP] : '" << etk::String(data, m_parser.getHeaderSize()) << "'");
+	echrono::Steady headerTime = echrono::Steady::now();
 	m_headerIsSend = true;
-	// parse header :
-	etk::Vector<etk::String> list = etk::split(header, '\n');
-	for (auto &it : list) {
-		if (    it.size()>0
-		     && it[it.size()-1] == '\r') {
-			it.resize(it.size()-1);
-		}
-	}
-	//parse first element:
-	etk::Vector<etk::String> listLineOne = etk::split(list[0], ' ');
-	if (listLineOne.size() < 2) {
-		ENET_ERROR("can not parse answear : " << listLineOne);
-		// answer bad request and close connection ...
-		
+	// Check the rate before doing any parsing/processing.
+	if (    m_isServer == true
+	     && m_rateLimiter != null
+	     && m_rateLimiter->check(getRemoteAddress()) == false) {
+		ENET_WARNING("Reject request FROM " << getRemoteAddress() << " ==> rate limit");
+		static ememory::SharedPtr<enet::HttpCannedAnswer> answer = enet::httpCanned::createTooManyRequests();
+		setAnswer(*answer);
+		stop(true);
 		return;
 	}
-	if (    listLineOne.size() >= 3
-	     && (    listLineOne[0] == "GET"
-	          || listLineOne[0] == "POST"
-	          || listLineOne[0] == "HEAD"
-	          || listLineOne[0] == "DELETE"
-	          || listLineOne[0] == "PUT"
-	          || listLineOne[0] == "OPTIONS" ) ) {
+	if (parseStatus == enet::HttpParser::status::error) {
+		ENET_ERROR("Malformed HTTP header : '" << etk::String(data, used) << "'");
+		m_answerHeader.setErrorCode(enet::HTTPAnswerCode::c400_badRequest);
+		m_answerHeader.setHelp("Malformed header ...");
+		setAnswerHeader(m_answerHeader);
+		stop(true);
+		return;
+	}
+	// The data after the header is the start of the body (or of the next message)
+	if (used > m_parser.getHeaderSize()) {
+		m_connection.putBack(&m_headerBuffer[m_parser.getHeaderSize()], used - m_parser.getHeaderSize());
+	}
+	if (m_parser.isAnswer() == false) {
 		// HTTP CALL
 		if (m_isServer == false) {
 			// can not have call in client mode
-			ENET_ERROR("can not parse call in client mode ..." << listLineOne);
+			ENET_ERROR("can not parse call in client mode ..." << enet::HttpParser::extract(data, m_parser.getMethod()));
 			m_answerHeader.setErrorCode(enet::HTTPAnswerCode::c400_badRequest);
 			m_answerHeader.setHelp("Call a client with a request from server ...");
 			setAnswerHeader(m_answerHeader);
 			stop(true);
 			return;
 		}
-		// get type call:
-		enum enet::HTTPReqType valueType;
-		etk::from_string(valueType, listLineOne[0]);
-		m_requestHeader.setType(valueType);
-		// get URI:
-		etk::String basicUri = listLineOne[1];
-		size_t pos = basicUri.find('?');
-		if (pos == etk::String::npos) {
-			m_requestHeader.setUri(listLineOne[1]);
-		} else {
-			m_requestHeader.setUri(basicUri.extract(0, pos));
-			m_requestHeader.setQuery(pourcentUriDecode(basicUri.extract(pos+1)));
-		}
-		// Get http version:
-		enum enet::HTTPProtocol valueProtocol;
-		etk::from_string(valueProtocol, listLineOne[2]);
-		m_requestHeader.setProtocol(valueProtocol);
-	} else if (    listLineOne.size() >= 3
-	            && etk::start_with(listLineOne[0],"HTTP/") == true) {
+		if (m_requestHeader.setFirstLine(data, m_parser) == false) {
+			ENET_ERROR("Un understand method ..." << enet::HttpParser::extract(data, m_parser.getMethod()));
+			m_answerHeader.setErrorCode(enet::HTTPAnswerCode::c400_badRequest);
+			m_answerHeader.setHelp("Un understand message ...");
+			setAnswerHeader(m_answerHeader);
+			stop(true);
+			return;
+		}
+	} else {
 		// HTTP answer
 		if (m_isServer == true) {
 			// can not have anser ==> need to be a get ot something like this ...
-			ENET_ERROR("can not parse answer in server mode ..." << listLineOne);
+			ENET_ERROR("can not parse answer in server mode ..." << enet::HttpParser::extract(data, m_parser.getProtocol()));
 			m_answerHeader.setErrorCode(enet::HTTPAnswerCode::c400_badRequest);
 			m_answerHeader.setHelp("Call a client with a request from server ...");
 			setAnswerHeader(m_answerHeader);
 			stop(true);
 			return;
 		}
-		// Get http version:
-		enum enet::HTTPProtocol valueProtocol;
-		etk::from_string(valueProtocol, listLineOne[0]);
-		m_answerHeader.setProtocol(valueProtocol);
-		
-		enum HTTPAnswerCode valueErrorCode;
-		etk::from_string(valueErrorCode, listLineOne[1]);
-		m_answerHeader.setErrorCode(valueErrorCode);
-		
-		// get comment:
-		etk::String comment;
-		for (size_t iii=2; iii<listLineOne.size(); ++iii) {
-			if (comment.size() != 0) {
-				comment += " ";
-			}
-			comment += listLineOne[iii];
-		}
-		m_answerHeader.setHelp(comment);
-	} else {
-		// can not have anser ==> need to be a get ot something like this ...
-		ENET_ERROR("Un understand message ..." << listLineOne);
-		m_answerHeader.setErrorCode(enet::HTTPAnswerCode::c400_badRequest);
-		m_answerHeader.setHelp("Un understand message ...");
-		setAnswerHeader(m_answerHeader);
-		stop(true);
-		return;
+		m_answerHeader.setFirstLine(data, m_parser);
 	}
-	for (size_t iii=1; iii<list.size(); ++iii) {
-		size_t found = list[iii].find(":");
-		if (found == etk::String::npos) {
-			// nothing
-			continue;
-		}
-		etk::String key = unEscapeChar(etk::String(list[iii], 0, found));
-		key = removeStartAndStopSpace(key);
-		etk::String value = unEscapeChar(etk::String(list[iii], found+2));
-		value = removeStartAndStopSpace(value);
-		ENET_VERBOSE("header : key='" << key << "' value='" << value << "'");
-		if (m_isServer == false) {
-			m_answerHeader.setKey(key,value);
-		} else {
-			m_requestHeader.setKey(key,value);
+	if (m_isServer == false) {
+		if (    m_answerHeader.setKeys(data, m_parser) == false
+		     || m_answerHeader.isBodyFramingValid(false) == false) {
+			ENET_ERROR("Can not find the end of the answer body FROM " << getRemoteAddress());
+			stop(true);
+			return;
 		}
-		if (    key == "Connection"
-		     && value == "close") {
-			ENET_DEBUG("connection closed by remote :");
-			m_connection.unlink();
+	} else {
+		if (    m_requestHeader.setKeys(data, m_parser) == false
+		     || m_requestHeader.isBodyFramingValid(true) == false) {
+			// RFC 7230 3.3.3: the next request can not be found
+			ENET_ERROR("Can not find the end of the request body FROM " << getRemoteAddress());
+			m_answerHeader.setErrorCode(enet::HTTPAnswerCode::c400_badRequest);
+			m_answerHeader.setHelp("Wrong body size ...");
+			setAnswerHeader(m_answerHeader);
+			stop(true);
+			return;
 		}
 	}
 	m_headerIsSend = true;
 	if (m_isServer == false) {
+		updateAnswerFraming();
 		if (m_observerAnswer != null) {
 			m_observerAnswer(m_answerHeader);
 		}
+		if (    m_threadRunning == true
+		     && m_observerRaw == null
+		     && m_bodyChunked == false
+		     && m_bodySize == 0) {
+			endBody();
+		}
 	} else {
+		updateKeepAlive();
+		if (    m_compression != null
+		     && m_requestHeader.existKey(enet::HTTPHeaderId::contentEncoding) == true) {
+			enum enet::httpCompression::encoding encoding;
+			if (enet::httpCompression::parseName(m_requestHeader.getKey(enet::HTTPHeaderId::contentEncoding), encoding) == false) {
+				// RFC 7694: list the supported encodings
+				ENET_ERROR("Unsupported request 'Content-Encoding' FROM " << getRemoteAddress() << ": '" << m_requestHeader.getKey(enet::HTTPHeaderId::contentEncoding) << "'");
+				enet::HttpAnswer answer(enet::HTTPAnswerCode::c415_unsupportedMediaType);
+				answer.setProtocol(enet::HTTPProtocol::http_1_1);
+				answer.setKey(enet::HTTPHeaderId::acceptEncoding, "gzip, deflate");
+				m_keepAlive = false;
+				setAnswer(answer, null, 0);
+				stop(true);
+				return;
+			}
+			if (encoding != enet::httpCompression::encoding::identity) {
+				if (m_inflater == null) {
+					m_inflater = ememory::makeShared<enet::HttpInflater>();
+				}
+				if (    m_inflater == null
+				     || m_inflater->init(m_compression->getMaxInflateSize()) == false) {
+					ENET_ERROR("Can not decompress the request body");
+					stop(true);
+					return;
+				}
+			}
+		} else if (m_inflater != null) {
+			m_inflater->reset();
+		}
+		m_cacheKey.clear();
+		if (    m_cache != null
+		     && m_bodyChunked == false
+		     && m_bodySize == 0) {
+			m_cacheKey = m_cache->getKey(m_requestHeader);
+			if (m_cacheKey.size() != 0) {
+				ememory::SharedPtr<enet::HttpCannedAnswer> answer = m_cache->get(m_cacheKey, m_requestHeader);
+				if (answer != null) {
+					// The request observer is not called
+					m_cacheKey.clear();
+					setAnswer(*answer);
+					if (    m_threadRunning == true
+					     && m_observerRaw == null) {
+						endBody();
+					}
+					return;
+				}
+			}
+		}
+		if (m_admissionControl != null) {
+			// The queue delay is the time waiting before the thread start plus the time waiting after the header is received.
+			echrono::Duration queueDelay = m_queueDelay + (echrono::Steady::now() - headerTime);
+			m_queueDelay = echrono::Duration();
+			if (m_admissionControl->requestStart(queueDelay) == false) {
+				rejectWork();
+				return;
+			}
+		}
 		if (m_observerRequest != null) {
 			m_observerRequest(m_requestHeader);
 		}
+		if (m_admissionControl != null) {
+			m_admissionControl->requestEnd();
+		}
+		if (    m_threadRunning == true
+		     && m_observerRaw == null
+		     && m_bodyChunked == false
+		     && m_bodySize == 0) {
+			endBody();
+		}
 	}
 }
 
@@ -632,48 +1063,818 @@ int32_t enet::Http::write(const void* _data, int32_t _len) {
 	return m_connection.write(_data, _len);
 }
 
+int32_t enet::Http::writeChunk(const void* _data, int32_t _len) {
+	if (_len <= 0) {
+		// An empty chunk is the end of the body: use writeChunkEnd()
+		return 0;
+	}
+	char header[20];
+	// Size line, data and end of the chunk in one system call (one TCP segment for the small chunks)
+	enet::Tcp::Buffer list[3];
+	list[0].m_data = header;
+	list[0].m_size = enet::generateChunkHeader(header, _len);
+	list[1].m_data = _data;
+	list[1].m_size = _len;
+	list[2].m_data = "\r\n";
+	list[2].m_size = 2;
+	int32_t total = list[0].m_size + _len + 2;
+	if (m_connection.writeMultiple(list, 3) != total) {
+		return -1;
+	}
+	return _len;
+}
+
+int32_t enet::Http::writeChunkEnd() {
+	if (m_connection.write("0\r\n\r\n", 5) != 5) {
+		return -1;
+	}
+	return 0;
+}
+
+enet::HttpResponseWriter::HttpResponseWriter() :
+  m_interface(null),
+  m_chunked(false),
+  m_noBody(false),
+  m_remaining(-1),
+  m_checkSpace(false) {
+	
+}
+
+enet::HttpResponseWriter::HttpResponseWriter(enet::Http* _interface, bool _chunked, bool _noBody, int64_t _size, ememory::SharedPtr<enet::HttpDeflater> _deflater) :
+  m_interface(_interface),
+  m_chunked(_chunked),
+  m_noBody(_noBody),
+  m_remaining(_size),
+  m_checkSpace(false),
+  m_deflater(_deflater) {
+	
+}
+
+enet::HttpResponseWriter::HttpResponseWriter(HttpResponseWriter&& _obj) :
+  m_interface(_obj.m_interface),
+  m_chunked(_obj.m_chunked),
+  m_noBody(_obj.m_noBody),
+  m_remaining(_obj.m_remaining),
+  m_checkSpace(_obj.m_checkSpace),
+  m_spaceTimeOut(_obj.m_spaceTimeOut),
+  m_deflater(etk::move(_obj.m_deflater)),
+  m_buffer(etk::move(_obj.m_buffer)) {
+	_obj.m_interface = null;
+}
+
+enet::HttpResponseWriter& enet::HttpResponseWriter::operator= (HttpResponseWriter&& _obj) {
+	if (this != &_obj) {
+		finish();
+		m_interface = _obj.m_interface;
+		m_chunked = _obj.m_chunked;
+		m_noBody = _obj.m_noBody;
+		m_remaining = _obj.m_remaining;
+		m_checkSpace = _obj.m_checkSpace;
+		m_spaceTimeOut = _obj.m_spaceTimeOut;
+		m_deflater = etk::move(_obj.m_deflater);
+		m_buffer = etk::move(_obj.m_buffer);
+		_obj.m_interface = null;
+	}
+	return *this;
+}
+
+enet::HttpResponseWriter::~HttpResponseWriter() {
+	finish();
+}
+
+bool enet::HttpResponseWriter::canWrite(echrono::Duration _timeOut) const {
+	if (m_interface == null) {
+		return false;
+	}
+	return m_interface->waitWrite(_timeOut);
+}
+
+int32_t enet::HttpResponseWriter::writeChunk(const void* _data, int32_t _len) {
+	if (m_interface == null) {
+		ENET_ERROR("Write on a finished answer body");
+		return -1;
+	}
+	if (_len <= 0) {
+		return 0;
+	}
+	if (m_noBody == true) {
+		// The remote does not wait a body
+		return _len;
+	}
+	if (    m_remaining >= 0
+	     && _len > m_remaining) {
+		ENET_ERROR("Write more data than the 'Content-Length' of the answer: " << _len << " > " << m_remaining);
+		return -1;
+	}
+	if (    m_checkSpace == true
+	     && m_interface->waitWrite(m_spaceTimeOut) == false) {
+		// The socket is full: nothing written
+		return 0;
+	}
+	if (m_deflater == null) {
+		return writeData(_data, _len);
+	}
+	m_buffer.clear();
+	if (m_deflater->compress(_data, _len, m_buffer, false) == false) {
+		ENET_ERROR("Can not compress the answer body");
+		return -1;
+	}
+	if (    m_buffer.size() > 0
+	     && writeData(&m_buffer[0], m_buffer.size()) != int32_t(m_buffer.size())) {
+		return -1;
+	}
+	// All the data are consumed (the compressed data can stay in the deflater up to the next write)
+	return _len;
+}
+
+int32_t enet::HttpResponseWriter::writeData(const void* _data, int32_t _len) {
+	int32_t len = 0;
+	if (m_chunked == true) {
+		len = m_interface->writeChunk(_data, _len);
+	} else {
+		len = m_interface->write(_data, _len);
+	}
+	if (    len > 0
+	     && m_remaining > 0) {
+		m_remaining -= len;
+	}
+	return len;
+}
+
+bool enet::HttpResponseWriter::finish() {
+	if (m_interface == null) {
+		return true;
+	}
+	if (    m_noBody == false
+	     && m_deflater != null) {
+		// Write the end of the compressed stream
+		m_buffer.clear();
+		if (    m_deflater->compress(null, 0, m_buffer, true) == false
+		     || (    m_buffer.size() > 0
+		          && writeData(&m_buffer[0], m_buffer.size()) != int32_t(m_buffer.size()))) {
+			ENET_ERROR("Can not write the end of the compressed answer body ==> close the connection");
+			enet::Http* interface = m_interface;
+			m_interface = null;
+			m_deflater.reset();
+			interface->stop(true);
+			return false;
+		}
+		m_deflater.reset();
+	}
+	enet::Http* interface = m_interface;
+	m_interface = null;
+	if (m_noBody == true) {
+		return true;
+	}
+	if (m_chunked == true) {
+		return interface->writeChunkEnd() == 0;
+	}
+	if (m_remaining > 0) {
+		// The remote wait more data: the only way to end the body is to close the connection
+		ENET_ERROR("Answer body finished before the 'Content-Length': " << m_remaining << " byte(s) missing ==> close the connection");
+		interface->stop(true);
+		return false;
+	}
+	return true;
+}
+
+enet::HttpResponseWriter enet::HttpServer::beginResponse(const enet::HttpAnswer& _header) {
+	enet::HttpAnswer answer = _header;
+	enum enet::HTTPAnswerCode code = answer.getErrorCode();
+	bool noBody =    m_requestHeader.getType() == enet::HTTPReqType::HTTP_HEAD
+	              || int32_t(code) < 200
+	              || code == enet::HTTPAnswerCode::c204_noContent
+	              || code == enet::HTTPAnswerCode::c304_notModified;
+	ememory::SharedPtr<enet::HttpDeflater> deflater;
+	if (    m_compression != null
+	     && answer.existKey(enet::HTTPHeaderId::transferEncoding) == false) {
+		int64_t bodySize = -1;
+		if (answer.existKey(enet::HTTPHeaderId::contentLength) == true) {
+			bodySize = answer.getContentLength();
+		}
+		enum enet::httpCompression::encoding encoding = m_compression->select(m_requestHeader, answer, bodySize);
+		if (encoding != enet::httpCompression::encoding::identity) {
+			// The compressed size is not known: the body is chunked (or ended by the close of the connection)
+			enet::HttpCompression::updateHeader(answer, encoding);
+			if (noBody == false) {
+				deflater = ememory::makeShared<enet::HttpDeflater>();
+				if (    deflater == null
+				     || deflater->init(encoding, m_compression->getLevel()) == false) {
+					ENET_ERROR("Can not initialize the compression of the answer body");
+					return enet::HttpResponseWriter();
+				}
+			}
+		}
+	}
+	bool chunked = false;
+	int64_t size = -1;
+	if (noBody == false) {
+		if (answer.existKey(enet::HTTPHeaderId::transferEncoding) == true) {
+			chunked = answer.isChunked();
+		} else if (answer.existKey(enet::HTTPHeaderId::contentLength) == true) {
+			size = etk::max(answer.getContentLength(), int64_t(0));
+		} else if (m_requestHeader.getProtocol() >= enet::HTTPProtocol::http_1_1) {
+			answer.setKey(enet::HTTPHeaderId::transferEncoding, "chunked");
+			if (answer.getProtocol() < enet::HTTPProtocol::http_1_1) {
+				answer.setProtocol(enet::HTTPProtocol::http_1_1);
+			}
+			chunked = true;
+		}
+		// else: HTTP/1.0 remote ==> the end of the body is the close of the connection
+	}
+	setHeader(answer);
+	return enet::HttpResponseWriter(this, chunked, noBody, size, deflater);
+}
+
+int64_t enet::HttpServer::sendFile(const enet::HttpAnswer& _header, int32_t _fd, int64_t _offset, int64_t _size) {
+	m_answerHeader = _header;
+	m_answerHeader.setContentLength(_size);
+	updateAnswerHeader();
+	if (    m_requestHeader.getType() == enet::HTTPReqType::HTTP_HEAD
+	     || _size == 0) {
+		if (writeHeader(m_answerHeader) < 0) {
+			return -1;
+		}
+		return 0;
+	}
+	// The header is sent in the same packet as the start of the file
+	if (writeHeader(m_answerHeader, null, 0, true) < 0) {
+		return -1;
+	}
+	int64_t len = m_connection.writeFile(_fd, _offset, _size);
+	if (len != _size) {
+		if (len >= 0) {
+			// The remote wait more data: the only way to end the body is to close the connection
+			ENET_ERROR("File shorter than the 'Content-Length' of the answer: " << _size - len << " byte(s) missing ==> close the connection");
+		}
+		stop(true);
+		return -1;
+	}
+	return len;
+}
+
+
+namespace enet {
+	namespace httpHeader {
+		/**
+		 * @brief Append data at the end of a buffer (the memory of the buffer is reused).
+		 */
+		static inline void append(etk::Vector<char>& _out, const char* _data, size_t _size) {
+			if (_size == 0) {
+				return;
+			}
+			size_t pos = _out.size();
+			_out.resize(pos + _size);
+			memcpy(&_out[pos], _data, _size);
+		}
+		static inline void append(etk::Vector<char>& _out, const char* _data) {
+			append(_out, _data, strlen(_data));
+		}
+		static inline void append(etk::Vector<char>& _out, const etk::String& _data) {
+			append(_out, _data.c_str(), _data.size());
+		}
+		/**
+		 * @brief Write a number in decimal.
+		 * @return Number of character written (max 20).
+		 */
+		static size_t toDecimal(char* _buffer, uint64_t _value) {
+			char tmp[20];
+			size_t nbDigit = 0;
+			do {
+				tmp[nbDigit++] = '0' + (_value % 10);
+				_value /= 10;
+			} while (_value != 0);
+			for (size_t iii=0; iii<nbDigit; ++iii) {
+				_buffer[iii] = tmp[nbDigit - 1 - iii];
+			}
+			return nbDigit;
+		}
+		static inline char toLower(char _value) {
+			if (    _value >= 'A'
+			     && _value <= 'Z') {
+				return _value + ('a' - 'A');
+			}
+			return _value;
+		}
+		/**
+		 * @brief Compare 2 names of key (ASCII, not case sensitive: RFC 7230 3.2)
+		 */
+		static bool isEqual(const char* _value1, const char* _value2, size_t _size) {
+			for (size_t iii=0; iii<_size; ++iii) {
+				if (toLower(_value1[iii]) != toLower(_value2[iii])) {
+					return false;
+				}
+			}
+			return true;
+		}
+		static const size_t MIN_COMPACT_SIZE = 1024; //!< The arena is not compacted under this size
+		// Name of the well known keys (same order than enet::HTTPHeaderId)
+		static constexpr const char* g_name[] = {
+			"Host",
+			"Connection",
+			"Content-Length",
+			"Content-Type",
+			"Content-Encoding",
+			"Transfer-Encoding",
+			"TE",
+			"Trailer",
+			"Upgrade",
+			"Keep-Alive",
+			"Accept",
+			"Accept-Encoding",
+			"Accept-Language",
+			"Accept-Ranges",
+			"User-Agent",
+			"Server",
+			"Date",
+			"Location",
+			"Cache-Control",
+			"Pragma",
+			"Cookie",
+			"Set-Cookie",
+			"Expect",
+			"Retry-After",
+			"Authorization",
+			"Origin",
+			"ETag",
+			"If-None-Match",
+			"If-Modified-Since",
+			"Last-Modified",
+			"Vary",
+			"Range",
+			"Content-Range",
+			"Sec-WebSocket-Key",
+			"Sec-WebSocket-Accept",
+			"Sec-WebSocket-Version",
+			"Sec-WebSocket-Protocol",
+			"Sec-WebSocket-Extensions",
+			"Referer",
+			"Allow",
+			"If-Range"
+		};
+		static const size_t NUMBER_ID = size_t(enet::HTTPHeaderId::unknow);
+		static_assert(sizeof(g_name) / sizeof(g_name[0]) == NUMBER_ID, "The name list must match enet::HTTPHeaderId");
+		/**
+		 * @brief Hash of the names: FNV-1a of the lower case name, folded on HASH_SIZE slots.
+		 * The seed is selected to have no collision between the well known names (checked when compiling).
+		 */
+		static const uint32_t HASH_SEED = 7325;
+		static const size_t HASH_SIZE = 128;
+		constexpr char toLowerConst(char _value) {
+			return (_value >= 'A' && _value <= 'Z') ? char(_value + ('a' - 'A')) : _value;
+		}
+		constexpr uint32_t fnv(const char* _name, size_t _size, uint32_t _value) {
+			for (size_t iii=0; iii<_size; ++iii) {
+				_value = (_value ^ uint8_t(toLowerConst(_name[iii]))) * 16777619u;
+			}
+			return _value;
+		}
+		constexpr uint32_t fold(uint32_t _value) {
+			return (_value ^ (_value >> 16)) % HASH_SIZE;
+		}
+		constexpr uint32_t hash(const char* _name, size_t _size) {
+			return fold(fnv(_name, _size, 2166136261u ^ HASH_SEED));
+		}
+		constexpr size_t length(const char* _name) {
+			size_t out = 0;
+			while (_name[out] != '\0') {
+				++out;
+			}
+			return out;
+		}
+		constexpr uint32_t hashName(size_t _id) {
+			return hash(g_name[_id], length(g_name[_id]));
+		}
+		constexpr bool isPerfectHash() {
+			for (size_t iii=1; iii<NUMBER_ID; ++iii) {
+				for (size_t jjj=0; jjj<iii; ++jjj) {
+					if (hashName(iii) == hashName(jjj)) {
+						return false;
+					}
+				}
+			}
+			return true;
+		}
+		static_assert(isPerfectHash() == true, "Collision in the hash of the well known header names: change HASH_SEED");
+		/**
+		 * @brief Id of the well known key of each slot of the hash.
+		 */
+		class SlotTable {
+			public:
+				int8_t m_slot[HASH_SIZE];
+				uint8_t m_size[NUMBER_ID];
+				SlotTable() {
+					for (size_t iii=0; iii<HASH_SIZE; ++iii) {
+						m_slot[iii] = -1;
+					}
+					for (size_t iii=0; iii<NUMBER_ID; ++iii) {
+						m_slot[hashName(iii)] = iii;
+						m_size[iii] = length(g_name[iii]);
+					}
+				}
+		};
+		static const SlotTable& getSlotTable() {
+			static SlotTable table;
+			return table;
+		}
+	}
+}
+
+enum enet::HTTPHeaderId enet::getHTTPHeaderId(const char* _name, size_t _size) {
+	const enet::httpHeader::SlotTable& table = enet::httpHeader::getSlotTable();
+	int32_t id = table.m_slot[enet::httpHeader::hash(_name, _size)];
+	if (    id < 0
+	     || table.m_size[id] != _size
+	     || enet::httpHeader::isEqual(enet::httpHeader::g_name[id], _name, _size) == false) {
+		return enet::HTTPHeaderId::unknow;
+	}
+	return enet::HTTPHeaderId(id);
+}
+
+const char* enet::getHTTPHeaderName(enum enet::HTTPHeaderId _id) {
+	if (_id >= enet::HTTPHeaderId::unknow) {
+		return "";
+	}
+	return enet::httpHeader::g_name[size_t(_id)];
+}
+
+const size_t enet::HttpHeader::INLINE_KEY;
+
+int32_t enet::HttpHeader::findEntry(const char* _key, size_t _keySize) const {
+	enum enet::HTTPHeaderId id = enet::getHTTPHeaderId(_key, _keySize);
+	if (id != enet::HTTPHeaderId::unknow) {
+		return m_knownEntry[size_t(id)];
+	}
+	for (size_t iii=0; iii<m_nbEntry; ++iii) {
+		const Entry& entry = getEntry(iii);
+		if (    entry.m_id == enet::HTTPHeaderId::unknow
+		     && entry.m_keySize == _keySize
+		     && enet::httpHeader::isEqual(&m_arena[entry.m_keyOffset], _key, _keySize) == true) {
+			return iii;
+		}
+	}
+	return -1;
+}
+
+uint32_t enet::HttpHeader::addArena(const char* _data, size_t _size) {
+	uint32_t offset = m_arena.size();
+	if (_size == 0) {
+		return offset;
+	}
+	m_arena.resize(offset + _size);
+	memcpy(&m_arena[offset], _data, _size);
+	m_arenaUsed += _size;
+	return offset;
+}
+
+void enet::HttpHeader::compactArena() {
+	if (    m_arena.size() < enet::httpHeader::MIN_COMPACT_SIZE
+	     || m_arenaUsed * 2 > m_arena.size()) {
+		return;
+	}
+	etk::Vector<char> arena;
+	arena.reserve(m_arenaUsed);
+	for (size_t iii=0; iii<m_nbEntry; ++iii) {
+		Entry& entry = getEntry(iii);
+		uint32_t offset = arena.size();
+		arena.resize(offset + entry.m_keySize + entry.m_valueSize);
+		memcpy(&arena[offset], &m_arena[entry.m_keyOffset], entry.m_keySize);
+		if (entry.m_valueSize != 0) {
+			memcpy(&arena[offset + entry.m_keySize], &m_arena[entry.m_valueOffset], entry.m_valueSize);
+		}
+		entry.m_keyOffset = offset;
+		entry.m_valueOffset = offset + entry.m_keySize;
+	}
+	m_arena = etk::move(arena);
+}
 
 void enet::HttpHeader::setKey(const etk::String& _key, const etk::String& _value) {
-	auto it = m_map.find(_key);
-	if (it == m_map.end()) {
-		m_map.add(_key, _value);
+	setKey(_key.c_str(), _key.size(), _value.c_str(), _value.size());
+}
+
+void enet::HttpHeader::setKey(const char* _key, size_t _keySize, const char* _value, size_t _valueSize) {
+	setKey(enet::getHTTPHeaderId(_key, _keySize), _key, _keySize, _value, _valueSize);
+}
+
+void enet::HttpHeader::setKey(enum enet::HTTPHeaderId _id, const etk::String& _value) {
+	setKey(_id, _value.c_str(), _value.size());
+}
+
+void enet::HttpHeader::setKey(enum enet::HTTPHeaderId _id, const char* _value) {
+	setKey(_id, _value, strlen(_value));
+}
+
+void enet::HttpHeader::setKey(enum enet::HTTPHeaderId _id, const char* _value, size_t _valueSize) {
+	if (_id >= enet::HTTPHeaderId::unknow) {
+		ENET_ERROR("Can not set an unknow header key id");
+		return;
+	}
+	const char* name = enet::getHTTPHeaderName(_id);
+	setKey(_id, name, strlen(name), _value, _valueSize);
+}
+
+void enet::HttpHeader::setKey(enum enet::HTTPHeaderId _id, const char* _key, size_t _keySize, const char* _value, size_t _valueSize) {
+	int32_t entryId = -1;
+	if (_id != enet::HTTPHeaderId::unknow) {
+		entryId = m_knownEntry[size_t(_id)];
 	} else {
-		it->second = _value;
+		entryId = findEntry(_key, _keySize);
+	}
+	if (entryId >= 0) {
+		Entry& entry = getEntry(entryId);
+		if (_valueSize <= entry.m_valueSize) {
+			// The new value is not bigger: replace it in place.
+			if (_valueSize != 0) {
+				memcpy(&m_arena[entry.m_valueOffset], _value, _valueSize);
+			}
+			m_arenaUsed -= entry.m_valueSize - _valueSize;
+			entry.m_valueSize = _valueSize;
+			updateKnownValue(entryId);
+			return;
+		}
+		m_arenaUsed -= entry.m_valueSize;
+		entry.m_valueOffset = addArena(_value, _valueSize);
+		entry.m_valueSize = _valueSize;
+		compactArena();
+		updateKnownValue(entryId);
+		return;
+	}
+	Entry entry;
+	entry.m_id = _id;
+	entry.m_keyOffset = addArena(_key, _keySize);
+	entry.m_keySize = _keySize;
+	entry.m_valueOffset = addArena(_value, _valueSize);
+	entry.m_valueSize = _valueSize;
+	if (m_nbEntry < INLINE_KEY) {
+		m_entryInline[m_nbEntry] = entry;
+	} else {
+		m_entryOther.pushBack(entry);
+	}
+	if (_id != enet::HTTPHeaderId::unknow) {
+		m_knownEntry[size_t(_id)] = m_nbEntry;
+	}
+	m_nbEntry++;
+	updateKnownValue(m_nbEntry - 1);
+}
+
+void enet::HttpHeader::updateKnownValue(size_t _entryId) {
+	const Entry& entry = getEntry(_entryId);
+	if (entry.m_id != enet::HTTPHeaderId::contentLength) {
+		return;
+	}
+	// Convert the size of the body one time (1*DIGIT, RFC 7230 3.3.2)
+	m_contentLength = -1;
+	if (    entry.m_valueSize == 0
+	     || entry.m_valueSize > 18) {
+		return;
+	}
+	int64_t value = 0;
+	for (size_t iii=0; iii<entry.m_valueSize; ++iii) {
+		char elem = m_arena[entry.m_valueOffset + iii];
+		if (    elem < '0'
+		     || elem > '9') {
+			ENET_WARNING("Wrong 'Content-Length' value: '" << getKeyValue(_entryId) << "'");
+			return;
+		}
+		value = value * 10 + (elem - '0');
 	}
+	m_contentLength = value;
 }
 
 void enet::HttpHeader::rmKey(const etk::String& _key) {
-	auto it = m_map.find(_key);
-	if (it != m_map.end()) {
-		m_map.erase(it);
+	int32_t id = findEntry(_key.c_str(), _key.size());
+	if (id < 0) {
+		return;
+	}
+	rmEntry(id);
+}
+
+void enet::HttpHeader::rmKey(enum enet::HTTPHeaderId _id) {
+	if (existKey(_id) == false) {
+		return;
+	}
+	rmEntry(m_knownEntry[size_t(_id)]);
+}
+
+void enet::HttpHeader::rmEntry(size_t _entryId) {
+	Entry& removed = getEntry(_entryId);
+	m_arenaUsed -= removed.m_keySize + removed.m_valueSize;
+	if (removed.m_id != enet::HTTPHeaderId::unknow) {
+		m_knownEntry[size_t(removed.m_id)] = -1;
+		if (removed.m_id == enet::HTTPHeaderId::contentLength) {
+			m_contentLength = -1;
+		}
+	}
+	// Keep the order of insertion
+	for (size_t iii=_entryId+1; iii<m_nbEntry; ++iii) {
+		Entry& entry = getEntry(iii-1);
+		entry = getEntry(iii);
+		if (entry.m_id != enet::HTTPHeaderId::unknow) {
+			m_knownEntry[size_t(entry.m_id)] = iii-1;
+		}
+	}
+	m_nbEntry--;
+	if (m_nbEntry >= INLINE_KEY) {
+		m_entryOther.popBack();
+	}
+	if (m_nbEntry == 0) {
+		m_arena.clear();
+		m_arenaUsed = 0;
+		return;
 	}
+	compactArena();
 }
 
 etk::String enet::HttpHeader::getKey(const etk::String& _key) const {
-	auto it = m_map.find(_key);
-	if (it != m_map.end()) {
-		return it->second;
+	int32_t id = findEntry(_key.c_str(), _key.size());
+	if (id < 0) {
+		return "";
 	}
-	return "";
+	return getKeyValue(id);
 }
 
 bool enet::HttpHeader::existKey(const etk::String& _key) const {
-	auto it = m_map.find(_key);
-	if (it != m_map.end()) {
+	return findEntry(_key.c_str(), _key.size()) >= 0;
+}
+
+etk::String enet::HttpHeader::getKey(enum enet::HTTPHeaderId _id) const {
+	if (existKey(_id) == false) {
+		return "";
+	}
+	return getKeyValue(m_knownEntry[size_t(_id)]);
+}
+
+bool enet::HttpHeader::isKeyEqual(enum enet::HTTPHeaderId _id, const char* _value) const {
+	if (existKey(_id) == false) {
+		return false;
+	}
+	const Entry& entry = getEntry(m_knownEntry[size_t(_id)]);
+	if (strlen(_value) != entry.m_valueSize) {
+		return false;
+	}
+	if (entry.m_valueSize == 0) {
 		return true;
 	}
-	return false;
+	return enet::httpHeader::isEqual(&m_arena[entry.m_valueOffset], _value, entry.m_valueSize);
+}
+
+bool enet::HttpHeader::isChunked() const {
+	etk::String value = getKey(enet::HTTPHeaderId::transferEncoding);
+	size_t end = value.size();
+	while (    end > 0
+	        && (    value[end-1] == ' '
+	             || value[end-1] == '\t')) {
+		end--;
+	}
+	if (end < 7) {
+		return false;
+	}
+	if (    end > 7
+	     && value[end-8] != ','
+	     && value[end-8] != ' '
+	     && value[end-8] != '\t') {
+		return false;
+	}
+	static const char* chunked = "chunked";
+	for (size_t iii=0; iii<7; ++iii) {
+		char elem = value[end-7+iii];
+		if (    elem >= 'A'
+		     && elem <= 'Z') {
+			elem += 'a' - 'A';
+		}
+		if (elem != chunked[iii]) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void enet::HttpHeader::setContentLength(int64_t _value) {
+	char buffer[21];
+	size_t size = 0;
+	if (_value < 0) {
+		buffer[size++] = '-';
+		_value = -_value;
+	}
+	size += enet::httpHeader::toDecimal(&buffer[size], _value);
+	setKey(enet::HTTPHeaderId::contentLength, buffer, size);
+}
+
+void enet::HttpHeader::clearKeys() {
+	m_arena.clear();
+	m_arenaUsed = 0;
+	m_entryOther.clear();
+	m_nbEntry = 0;
+	for (size_t iii=0; iii<enet::httpHeader::NUMBER_ID; ++iii) {
+		m_knownEntry[iii] = -1;
+	}
+	m_contentLength = -1;
+}
+
+void enet::HttpHeader::reserveKeys(size_t _size) {
+	m_arena.reserve(m_arena.size() + _size);
+}
+
+bool enet::HttpHeader::setKeys(const char* _data, const enet::HttpParser& _parser) {
+	bool ret = true;
+	// All the fields are copied in one buffer: one allocation for all the header.
+	reserveKeys(_parser.getHeaderSize());
+	for (size_t iii=0; iii<_parser.getNumberField(); ++iii) {
+		const enet::HttpParser::Field& field = _parser.getField(iii);
+		ENET_VERBOSE("header : key='" << enet::HttpParser::extract(_data, field.m_key) << "' value='" << enet::HttpParser::extract(_data, field.m_value) << "'");
+		enum enet::HTTPHeaderId id = enet::getHTTPHeaderId(_data + field.m_key.m_offset, field.m_key.m_size);
+		if (    id == enet::HTTPHeaderId::contentLength
+		     && existKey(id) == true) {
+			// RFC 7230 3.3.2: the same size can be repeated, different sizes are a request smuggling
+			const Entry& entry = getEntry(m_knownEntry[size_t(id)]);
+			if (    entry.m_valueSize != field.m_value.m_size
+			     || memcmp(&m_arena[entry.m_valueOffset], _data + field.m_value.m_offset, entry.m_valueSize) != 0) {
+				ENET_ERROR("Many 'Content-Length' with different values");
+				ret = false;
+			}
+		}
+		setKey(id, _data + field.m_key.m_offset, field.m_key.m_size,
+		       _data + field.m_value.m_offset, field.m_value.m_size);
+	}
+	return ret;
+}
+
+bool enet::HttpHeader::isBodyFramingValid(bool _isRequest) const {
+	if (existKey(enet::HTTPHeaderId::transferEncoding) == true) {
+		// The transfer encoding is used before the content length: a request must be chunked, an answer can end with the connection
+		return    _isRequest == false
+		       || isChunked() == true;
+	}
+	if (existKey(enet::HTTPHeaderId::contentLength) == true) {
+		return m_contentLength >= 0;
+	}
+	return true;
+}
+
+etk::String enet::HttpHeader::getKeyName(size_t _id) const {
+	if (_id >= m_nbEntry) {
+		return "";
+	}
+	const Entry& entry = getEntry(_id);
+	return etk::String(&m_arena[entry.m_keyOffset], entry.m_keySize);
+}
+
+etk::String enet::HttpHeader::getKeyValue(size_t _id) const {
+	if (    _id >= m_nbEntry
+	     || getEntry(_id).m_valueSize == 0) {
+		return "";
+	}
+	const Entry& entry = getEntry(_id);
+	return etk::String(&m_arena[entry.m_valueOffset], entry.m_valueSize);
 }
 
 etk::String enet::HttpHeader::generateKeys() const {
-	etk::String out;
-	for (auto &it : m_map) {
-		if (    it.first != ""
-		     && it.second != "") {
-			out += escapeChar(it.first) + ": " + escapeChar(it.second) + "\r\n";
+	etk::Vector<char> out;
+	generateKeys(out);
+	return etk::String(&out[0], out.size());
+}
+
+void enet::HttpHeader::generateKeys(etk::Vector<char>& _out) const {
+	for (size_t iii=0; iii<m_nbEntry; ++iii) {
+		const Entry& entry = getEntry(iii);
+		if (    entry.m_keySize != 0
+		     && entry.m_valueSize != 0) {
+			enet::httpHeader::append(_out, &m_arena[entry.m_keyOffset], entry.m_keySize);
+			enet::httpHeader::append(_out, ": ", 2);
+			enet::httpHeader::append(_out, &m_arena[entry.m_valueOffset], entry.m_valueSize);
+			enet::httpHeader::append(_out, "\r\n", 2);
 		}
 	}
-	return out;
+}
+
+enet::HttpHeader& enet::HttpHeader::operator= (const enet::HttpHeader& _obj) {
+	if (this == &_obj) {
+		return *this;
+	}
+	// Copy only the used data in the memory already allocated
+	m_arena.resize(_obj.m_arena.size());
+	if (_obj.m_arena.size() != 0) {
+		memcpy(&m_arena[0], &_obj.m_arena[0], _obj.m_arena.size());
+	}
+	m_arenaUsed = _obj.m_arenaUsed;
+	for (size_t iii=0; iii<etk::min(_obj.m_nbEntry, INLINE_KEY); ++iii) {
+		m_entryInline[iii] = _obj.m_entryInline[iii];
+	}
+	m_entryOther.resize(_obj.m_entryOther.size());
+	for (size_t iii=0; iii<_obj.m_entryOther.size(); ++iii) {
+		m_entryOther[iii] = _obj.m_entryOther[iii];
+	}
+	m_nbEntry = _obj.m_nbEntry;
+	for (size_t iii=0; iii<enet::httpHeader::NUMBER_ID; ++iii) {
+		m_knownEntry[iii] = _obj.m_knownEntry[iii];
+	}
+	m_contentLength = _obj.m_contentLength;
+	if (    m_query.size() != 0
+	     || _obj.m_query.size() != 0) {
+		m_query = _obj.m_query;
+	}
+	m_protocol = _obj.m_protocol;
+	return *this;
 }
 
 void enet::HttpHeader::setQuery(const etk::Map<etk::String, etk::String>& _value) {
@@ -716,8 +1917,13 @@ etk::String enet::HttpHeader::generateQueryKeys() const {
 }
 
 enet::HttpHeader::HttpHeader():
+  m_arenaUsed(0),
+  m_nbEntry(0),
+  m_contentLength(-1),
   m_protocol(enet::HTTPProtocol::http_1_0) {
-	
+	for (size_t iii=0; iii<enet::httpHeader::NUMBER_ID; ++iii) {
+		m_knownEntry[iii] = -1;
+	}
 }
 
 
@@ -736,10 +1942,10 @@ void enet::HttpAnswer::display() const {
 	ENET_PRINT("    Code=" << int32_t(m_what));
 	ENET_PRINT("    message=" << m_helpMessage);
 	ENET_PRINT("    Options:");
-	for (auto &it : m_map) {
-		if (    it.first != ""
-		     && it.second != "") {
-			ENET_PRINT("        '" + it.first + "' = '" + it.second + "'");
+	for (size_t iii=0; iii<m_nbEntry; ++iii) {
+		etk::String value = getKeyValue(iii);
+		if (value != "") {
+			ENET_PRINT("        '" + getKeyName(iii) + "' = '" + value + "'");
 		}
 	}
 	ENET_PRINT("    query:");
@@ -752,25 +1958,43 @@ void enet::HttpAnswer::display() const {
 }
 
 etk::String enet::HttpAnswer::generate() const {
-	etk::String out;
-	out += etk::toString(m_protocol);
-	out += " ";
-	out += etk::toString(int32_t(m_what));
-	out += " ";
+	etk::Vector<char> out;
+	generate(out);
+	return etk::String(&out[0], out.size());
+}
+
+void enet::HttpAnswer::generate(etk::Vector<char>& _out) const {
+	enet::httpHeader::append(_out, enet::httpTable::getProtocolName(m_protocol));
+	char code[24];
+	code[0] = ' ';
+	size_t size = enet::httpHeader::toDecimal(&code[1], uint32_t(m_what)) + 1;
+	code[size++] = ' ';
+	enet::httpHeader::append(_out, code, size);
 	if (m_helpMessage != "") {
-		out += escapeChar(m_helpMessage);
+		enet::httpHeader::append(_out, m_helpMessage);
 	} else {
-		auto it = getProtocolName().find(m_what);
-		if (it != getProtocolName().end()) {
-			out += escapeChar(it->second);
+		const char* reason = enet::getHTTPAnswerReason(m_what);
+		if (reason != null) {
+			enet::httpHeader::append(_out, reason);
 		} else {
-			out += "???";
+			enet::httpHeader::append(_out, "???", 3);
 		}
 	}
-	out += "\r\n";
-	out += generateKeys();
-	out += "\r\n";
-	return out;
+	enet::httpHeader::append(_out, "\r\n", 2);
+	generateKeys(_out);
+	enet::httpHeader::append(_out, "\r\n", 2);
+}
+
+void enet::HttpAnswer::setFirstLine(const char* _data, const enet::HttpParser& _parser) {
+	enum enet::HTTPProtocol valueProtocol;
+	const enet::HttpParser::Span& protocol = _parser.getProtocol();
+	enet::httpTable::parseProtocol(_data + protocol.m_offset, protocol.m_size, valueProtocol);
+	setProtocol(valueProtocol);
+	enum HTTPAnswerCode valueErrorCode;
+	const enet::HttpParser::Span& code = _parser.getCode();
+	enet::httpTable::parseAnswerCode(_data + code.m_offset, code.m_size, valueErrorCode);
+	m_what = valueErrorCode;
+	m_helpMessage = enet::HttpParser::extract(_data, _parser.getReason());
 }
 enet::HttpServer::HttpServer(enet::Tcp _connection) :
   enet::Http(etk::move(_connection), true) {
@@ -781,6 +2005,11 @@ enet::HttpClient::HttpClient(enet::Tcp _connection) :
   enet::Http(etk::move(_connection), false) {
 	
 }
+
+enet::HttpClient::HttpClient(ememory::SharedPtr<enet::ConnectionPool> _pool, const etk::String& _hostname, uint16_t _port) :
+  enet::Http(_pool->get(_hostname, _port), false) {
+	m_pool = _pool;
+}
 // -----------------------------------------------------------------------------------------
 
 enet::HttpRequest::HttpRequest(enum enet::HTTPReqType _type):
@@ -789,16 +2018,45 @@ enet::HttpRequest::HttpRequest(enum enet::HTTPReqType _type):
 	
 }
 
+bool enet::HttpRequest::setFirstLine(const char* _data, const enet::HttpParser& _parser) {
+	// get type call:
+	enum enet::HTTPReqType valueType;
+	const enet::HttpParser::Span& method = _parser.getMethod();
+	if (enet::httpTable::parseReqType(_data + method.m_offset, method.m_size, valueType) == false) {
+		return false;
+	}
+	m_req = valueType;
+	// get URI:
+	const enet::HttpParser::Span& uri = _parser.getUri();
+	uint32_t pos = 0;
+	while (    pos < uri.m_size
+	        && _data[uri.m_offset + pos] != '?') {
+		++pos;
+	}
+	if (pos == uri.m_size) {
+		m_uri = enet::HttpParser::extract(_data, uri);
+	} else {
+		m_uri = etk::String(_data + uri.m_offset, pos);
+		setQuery(pourcentUriDecode(etk::String(_data + uri.m_offset + pos + 1, uri.m_size - pos - 1)));
+	}
+	// Get http version:
+	enum enet::HTTPProtocol valueProtocol;
+	const enet::HttpParser::Span& protocol = _parser.getProtocol();
+	enet::httpTable::parseProtocol(_data + protocol.m_offset, protocol.m_size, valueProtocol);
+	setProtocol(valueProtocol);
+	return true;
+}
+
 void enet::HttpRequest::display() const {
 	ENET_PRINT("display header 'Request' ");
 	ENET_PRINT("    type=" << m_req);
 	ENET_PRINT("    protocol=" << m_protocol);
 	ENET_PRINT("    uri=" << m_uri);
 	ENET_PRINT("    Options:");
-	for (auto &it : m_map) {
-		if (    it.first != ""
-		     && it.second != "") {
-			ENET_PRINT("        '" + it.first + "' = '" + it.second + "'");
+	for (size_t iii=0; iii<m_nbEntry; ++iii) {
+		etk::String value = getKeyValue(iii);
+		if (value != "") {
+			ENET_PRINT("        '" + getKeyName(iii) + "' = '" + value + "'");
 		}
 	}
 	ENET_PRINT("    query:");
@@ -811,20 +2069,28 @@ void enet::HttpRequest::display() const {
 }
 
 etk::String enet::HttpRequest::generate() const {
-	etk::String out;
-	out += etk::toString(m_req);
-	out += " ";
-	out += m_uri;
-	etk::String querryData = generateQueryKeys();
-	if (querryData.empty() != 0) {
-		out += "?" + querryData;
+	etk::Vector<char> out;
+	generate(out);
+	return etk::String(&out[0], out.size());
+}
+
+void enet::HttpRequest::generate(etk::Vector<char>& _out) const {
+	if (size_t(m_req) > size_t(enet::HTTPReqType::HTTP_OPTIONS)) {
+		enet::httpHeader::append(_out, "UNKNOW", 6);
+	} else {
+		enet::httpHeader::append(_out, enet::httpTable::g_reqTypeName[size_t(m_req)]);
+	}
+	enet::httpHeader::append(_out, " ", 1);
+	enet::httpHeader::append(_out, m_uri);
+	if (m_query.size() != 0) {
+		enet::httpHeader::append(_out, "?", 1);
+		enet::httpHeader::append(_out, generateQueryKeys());
 	}
-	out += " ";
-	out += etk::toString(m_protocol);
-	out += "\r\n";
-	out += generateKeys();
-	out += "\r\n";
-	return out;
+	enet::httpHeader::append(_out, " ", 1);
+	enet::httpHeader::append(_out, enet::httpTable::getProtocolName(m_protocol));
+	enet::httpHeader::append(_out, "\r\n", 2);
+	generateKeys(_out);
+	enet::httpHeader::append(_out, "\r\n", 2);
 }
 
 
@@ -838,6 +2104,11 @@ etk::Stream& enet::operator <<(etk::Stream& _os, enum enet::HTTPAnswerCode _obj)
 	return _os;
 }
 
+etk::Stream& enet::operator <<(etk::Stream& _os, enum enet::HTTPHeaderId _obj) {
+	_os << "enet::HTTPHeaderId::" << enet::getHTTPHeaderName(_obj);
+	return _os;
+}
+
 etk::Stream& enet::operator <<(etk::Stream& _os, enum enet::HTTPReqType _obj) {
 	_os << "enet::HTTPReqType::" << etk::toString(_obj);
 	return _os;
@@ -6,13 +6,27 @@
 #pragma once
 
 #include <enet/Tcp.hpp>
+#include <enet/HttpParser.hpp>
+#include <enet/HttpChunk.hpp>
 #include <etk/Vector.hpp>
 #include <etk/Map.hpp>
 #include <ethread/Thread.hpp>
 #include <ethread/tools.hpp>
 #include <etk/Function.hpp>
+#include <ememory/memory.hpp>
+#include <echrono/Duration.hpp>
 
 namespace enet {
+	class AdmissionControl;
+	class ConnectionPool;
+	class HttpCannedAnswer;
+	class HttpFuture;
+	class HttpCompression;
+	class HttpDeflater;
+	class HttpInflater;
+	class HttpCache;
+	class RateLimiter;
+	class RetryPolicy;
 	enum class HTTPAnswerCode {
 		c000_unknow = 0,
 		//1xx: Information
@@ -55,6 +69,7 @@ namespace enet {
 		c415_unsupportedMediaType, //!< The server will not accept the request, because the media type is not supported
 		c416_requestedRangeNotSatisfiable, //!< The client has asked for a portion of the file, but the server cannot supply that portion
 		c417_expectationFailed, //!< The server cannot meet the requirements of the Expect request-header field
+		c429_tooManyRequests = 429, //!< The user has sent too many requests in a given amount of time
 		//5xx: Server Error
 		c500_internalServerError = 500, //!< A generic error message, given when no more specific message is suitable
 		c501_notImplemented, //!< The server either does not recognize the request method, or it lacks the ability to fulfill the request
@@ -65,6 +80,12 @@ namespace enet {
 		c511_networkAuthenticationRequired, //!< The client needs to authenticate to gain network access
 	};
 	etk::Stream& operator <<(etk::Stream& _os, enum enet::HTTPAnswerCode _obj);
+	/**
+	 * @brief Get the reason phrase of an answer code (static string, no allocation).
+	 * @param[in] _value Answer code.
+	 * @return The reason ("Not Found" ...) or null if the code is unknow.
+	 */
+	const char* getHTTPAnswerReason(enum HTTPAnswerCode _value);
 	
 	enum class HTTPProtocol {
 		http_0_1,
@@ -112,21 +133,270 @@ namespace enet {
 		http_3_10,
 	};
 	etk::Stream& operator <<(etk::Stream& _os, enum enet::HTTPProtocol _obj);
+	/**
+	 * @brief Well known header keys: they are recognized when the key is set and stored in a fixed slot.
+	 */
+	enum class HTTPHeaderId {
+		host,
+		connection,
+		contentLength,
+		contentType,
+		contentEncoding,
+		transferEncoding,
+		te,
+		trailer,
+		upgrade,
+		keepAlive,
+		accept,
+		acceptEncoding,
+		acceptLanguage,
+		acceptRanges,
+		userAgent,
+		server,
+		date,
+		location,
+		cacheControl,
+		pragma,
+		cookie,
+		setCookie,
+		expect,
+		retryAfter,
+		authorization,
+		origin,
+		eTag,
+		ifNoneMatch,
+		ifModifiedSince,
+		lastModified,
+		vary,
+		range,
+		contentRange,
+		secWebSocketKey,
+		secWebSocketAccept,
+		secWebSocketVersion,
+		secWebSocketProtocol,
+		secWebSocketExtensions,
+		referer,
+		allow,
+		ifRange,
+		unknow //!< Not a well known key (must be the last)
+	};
+	etk::Stream& operator <<(etk::Stream& _os, enum enet::HTTPHeaderId _obj);
+	/**
+	 * @brief Get the id of a header key (not case sensitive).
+	 * @param[in] _name Name of the key.
+	 * @param[in] _size Number of byte of the name.
+	 * @return Id of the key or HTTPHeaderId::unknow.
+	 */
+	enum HTTPHeaderId getHTTPHeaderId(const char* _name, size_t _size);
+	/**
+	 * @brief Get the name of a well known header key.
+	 * @param[in] _id Id of the key.
+	 * @return Name of the key ("" for HTTPHeaderId::unknow).
+	 */
+	const char* getHTTPHeaderName(enum HTTPHeaderId _id);
 	class HttpHeader {
+		public:
+			static const size_t INLINE_KEY = 24; //!< Number of key stored in the object itself (more keys need an allocation)
 		protected:
-			// key, val
-			etk::Map<etk::String, etk::String> m_map;
+			/**
+			 * @brief Position of a key and of its value in the arena.
+			 */
+			class Entry {
+				public:
+					enum HTTPHeaderId m_id; //!< Id of the key if it is a well known one
+					uint32_t m_keyOffset; //!< Position of the key in the arena
+					uint32_t m_keySize; //!< Number of byte of the key
+					uint32_t m_valueOffset; //!< Position of the value in the arena
+					uint32_t m_valueSize; //!< Number of byte of the value
+			};
+			etk::Vector<char> m_arena; //!< Keys and values stored one after the other (in the order of insertion)
+			size_t m_arenaUsed; //!< Number of byte of the arena still referenced (the rest is removed keys or replaced values)
+			Entry m_entryInline[INLINE_KEY]; //!< First keys (no allocation for a typical header)
+			etk::Vector<Entry> m_entryOther; //!< Keys after the INLINE_KEY first ones
+			size_t m_nbEntry; //!< Number of key
+			int32_t m_knownEntry[size_t(HTTPHeaderId::unknow)]; //!< Id of the entry of each well known key (-1 if not set)
+			int64_t m_contentLength; //!< Value of the "Content-Length" key (-1 if not set or invalid)
 			etk::Map<etk::String, etk::String> m_query;
 			enum HTTPProtocol m_protocol;
 		public:
+			/**
+			 * @brief Set the value of a key (the name of the key is not case sensitive).
+			 * @param[in] _key Name of the key.
+			 * @param[in] _value Value of the key.
+			 */
 			void setKey(const etk::String& _key, const etk::String& _value);
+			/**
+			 * @brief Set the value of a key without creating intermediate strings.
+			 * @param[in] _key Name of the key.
+			 * @param[in] _keySize Number of byte of the name.
+			 * @param[in] _value Value of the key.
+			 * @param[in] _valueSize Number of byte of the value.
+			 */
+			void setKey(const char* _key, size_t _keySize, const char* _value, size_t _valueSize);
 			void rmKey(const etk::String& _key);
 			etk::String getKey(const etk::String& _key) const;
 			bool existKey(const etk::String& _key) const;
+			/**
+			 * @brief Set the value of a well known key.
+			 * @param[in] _id Id of the key.
+			 * @param[in] _value Value of the key.
+			 */
+			void setKey(enum HTTPHeaderId _id, const etk::String& _value);
+			/**
+			 * @brief Set the value of a well known key without creating a string.
+			 * @param[in] _id Id of the key.
+			 * @param[in] _value Value of the key ('\0' terminated).
+			 */
+			void setKey(enum HTTPHeaderId _id, const char* _value);
+			/**
+			 * @brief Set the value of a well known key without creating a string.
+			 * @param[in] _id Id of the key.
+			 * @param[in] _value Value of the key.
+			 * @param[in] _valueSize Number of byte of the value.
+			 */
+			void setKey(enum HTTPHeaderId _id, const char* _value, size_t _valueSize);
+			/**
+			 * @brief Remove a well known key.
+			 * @param[in] _id Id of the key.
+			 */
+			void rmKey(enum HTTPHeaderId _id);
+			/**
+			 * @brief Get the value of a well known key (direct access, no search).
+			 * @param[in] _id Id of the key.
+			 * @return Value of the key or "" if not set.
+			 */
+			etk::String getKey(enum HTTPHeaderId _id) const;
+			/**
+			 * @brief Check if a well known key is set.
+			 * @param[in] _id Id of the key.
+			 * @return true if the key is set.
+			 */
+			bool existKey(enum HTTPHeaderId _id) const {
+				return    _id < HTTPHeaderId::unknow
+				       && m_knownEntry[size_t(_id)] >= 0;
+			}
+			/**
+			 * @brief Compare the value of a well known key without creating a string (not case sensitive).
+			 * @param[in] _id Id of the key.
+			 * @param[in] _value Value to compare with.
+			 * @return true if the key is set with this value.
+			 */
+			bool isKeyEqual(enum HTTPHeaderId _id, const char* _value) const;
+			/**
+			 * @brief Get the value of the "Content-Length" key (converted when the key is set).
+			 * @return Size of the body or -1 if not set or invalid.
+			 */
+			int64_t getContentLength() const {
+				return m_contentLength;
+			}
+			/**
+			 * @brief Check if the last transfer coding is "chunked" (RFC 7230 3.3.1).
+			 * @return true if the body is sent in chunks.
+			 */
+			bool isChunked() const;
+			/**
+			 * @brief Set the "Content-Length" key.
+			 * @param[in] _value Size of the body.
+			 */
+			void setContentLength(int64_t _value);
+			/**
+			 * @brief Remove all the keys (the memory is kept for the next header).
+			 */
+			void clearKeys();
+			/**
+			 * @brief Reserve the memory for the next keys and values (one allocation for all the header).
+			 * @param[in] _size Number of byte of the keys and values that will be added.
+			 */
+			void reserveKeys(size_t _size);
+			/**
+			 * @brief Set all the fields of a parsed header (one allocation for all the keys).
+			 * @param[in] _data Parsed buffer.
+			 * @param[in] _parser Parser that contain the position of the fields.
+			 * @return false if the header has many "Content-Length" with different values (RFC 7230 3.3.2).
+			 */
+			bool setKeys(const char* _data, const enet::HttpParser& _parser);
+			/**
+			 * @brief Check if the end of the body can be found (RFC 7230 3.3.3).
+			 * An invalid "Content-Length" is an error, and for a request a transfer coding that does not end with "chunked" too.
+			 * @param[in] _isRequest The header is a request (else an answer).
+			 * @return false if the message must be rejected (400 for a request) and the connection closed.
+			 */
+			bool isBodyFramingValid(bool _isRequest) const;
+			/**
+			 * @brief Get the number of key.
+			 * @return Number of key.
+			 */
+			size_t getNumberKey() const {
+				return m_nbEntry;
+			}
+			/**
+			 * @brief Get the name of a key (in the order of insertion).
+			 * @param[in] _id Id of the key.
+			 * @return Name of the key.
+			 */
+			etk::String getKeyName(size_t _id) const;
+			/**
+			 * @brief Get the value of a key (in the order of insertion).
+			 * @param[in] _id Id of the key.
+			 * @return Value of the key.
+			 */
+			etk::String getKeyValue(size_t _id) const;
 		protected:
+			Entry& getEntry(size_t _id) {
+				if (_id < INLINE_KEY) {
+					return m_entryInline[_id];
+				}
+				return m_entryOther[_id - INLINE_KEY];
+			}
+			const Entry& getEntry(size_t _id) const {
+				if (_id < INLINE_KEY) {
+					return m_entryInline[_id];
+				}
+				return m_entryOther[_id - INLINE_KEY];
+			}
+			/**
+			 * @brief Search a key (not case sensitive).
+			 * @param[in] _key Name of the key.
+			 * @param[in] _keySize Number of byte of the name.
+			 * @return Id of the key or -1 if not found.
+			 */
+			int32_t findEntry(const char* _key, size_t _keySize) const;
+			/**
+			 * @brief Set the value of a key when its id is known.
+			 */
+			void setKey(enum HTTPHeaderId _id, const char* _key, size_t _keySize, const char* _value, size_t _valueSize);
+			/**
+			 * @brief Remove an entry.
+			 * @param[in] _entryId Id of the entry.
+			 */
+			void rmEntry(size_t _entryId);
+			/**
+			 * @brief Update the converted value of a well known key.
+			 * @param[in] _entryId Id of the entry.
+			 */
+			void updateKnownValue(size_t _entryId);
+			/**
+			 * @brief Copy data at the end of the arena.
+			 * @param[in] _data Data to copy.
+			 * @param[in] _size Number of byte.
+			 * @return Position of the data in the arena.
+			 */
+			uint32_t addArena(const char* _data, size_t _size);
+			/**
+			 * @brief Remove the unused data of the arena.
+			 */
+			void compactArena();
 			etk::String generateKeys() const;
+			/**
+			 * @brief Append the keys "name: value\r\n" at the end of a buffer.
+			 * @param[in,out] _out Output buffer.
+			 */
+			void generateKeys(etk::Vector<char>& _out) const;
 		public:
 			void setQuery(const etk::Map<etk::String, etk::String>& _value);
+			const etk::Map<etk::String, etk::String>& getQuery() const {
+				return m_query;
+			}
 			void setQueryKey(const etk::String& _key, const etk::String& _value);
 			void rmQueryKey(const etk::String& _key);
 			etk::String getQueryKey(const etk::String& _key) const;
@@ -141,8 +411,18 @@ namespace enet {
 				m_protocol = _protocol;
 			}
 			HttpHeader();
+			HttpHeader(const HttpHeader& _obj) = default;
+			/**
+			 * @brief Copy a header, the memory already allocated is reused.
+			 */
+			HttpHeader& operator= (const HttpHeader& _obj);
 			virtual ~HttpHeader() = default;
 			virtual etk::String generate() const = 0;
+			/**
+			 * @brief Append the header at the end of a buffer (no intermediate string: no allocation when the buffer is big enough).
+			 * @param[in,out] _out Output buffer.
+			 */
+			virtual void generate(etk::Vector<char>& _out) const = 0;
 	};
 	
 	class HttpAnswer : public HttpHeader {
@@ -153,6 +433,13 @@ namespace enet {
 			HttpAnswer(enum HTTPAnswerCode _code = enet::HTTPAnswerCode::c400_badRequest, const etk::String& _help="");
 			void display() const;
 			etk::String generate() const;
+			void generate(etk::Vector<char>& _out) const;
+			/**
+			 * @brief Set the protocol, code and reason of a parsed answer "HTTP/x.y code reason".
+			 * @param[in] _data Parsed buffer.
+			 * @param[in] _parser Parser that contain the position of the elements.
+			 */
+			void setFirstLine(const char* _data, const enet::HttpParser& _parser);
 			void setErrorCode(enum HTTPAnswerCode _value) {
 				m_what = _value;
 			}
@@ -184,12 +471,20 @@ namespace enet {
 			HttpRequest(enum enet::HTTPReqType _type=enet::HTTPReqType::HTTP_GET);
 			void display() const;
 			etk::String generate() const;
+			void generate(etk::Vector<char>& _out) const;
 			void setType(enum enet::HTTPReqType _value) {
 				m_req = _value;
 			}
 			enum enet::HTTPReqType getType() const{
 				return m_req;
 			}
+			/**
+			 * @brief Set the method, URI, query and protocol of a parsed request "method uri HTTP/x.y".
+			 * @param[in] _data Parsed buffer.
+			 * @param[in] _parser Parser that contain the position of the elements.
+			 * @return false if the method is unknown.
+			 */
+			bool setFirstLine(const char* _data, const enet::HttpParser& _parser);
 			void setUri(const etk::String& _value) {
 				m_uri = _value;
 			}
@@ -213,6 +508,18 @@ namespace enet {
 		protected:
 			enet::HttpRequest m_requestHeader;
 			void setRequestHeader(const enet::HttpRequest& _req);
+			/**
+			 * @brief Send the request header and a body in one system call.
+			 * @param[in] _req Request header ("Content-Length" is set with the size of the body if not present).
+			 * @param[in] _data Pointer on the body.
+			 * @param[in] _len Number of byte of the body.
+			 * @return Number of byte written or -1 on error.
+			 */
+			int32_t setRequest(const enet::HttpRequest& _req, const void* _data, int32_t _len);
+			/**
+			 * @brief Add the default keys in the request before sending it.
+			 */
+			void updateRequestHeader();
 		public:
 			const enet::HttpRequest& getRequestHeader() {
 				return m_requestHeader;
@@ -220,6 +527,24 @@ namespace enet {
 		protected:
 			enet::HttpAnswer m_answerHeader;
 			void setAnswerHeader(const enet::HttpAnswer& _req);
+			/**
+			 * @brief Send the answer header and a body in one system call.
+			 * @param[in] _req Answer header ("Content-Length" is set with the size of the body if not present).
+			 * @param[in] _data Pointer on the body.
+			 * @param[in] _len Number of byte of the body.
+			 * @return Number of byte written or -1 on error.
+			 */
+			int32_t setAnswer(const enet::HttpAnswer& _req, const void* _data, int32_t _len);
+			/**
+			 * @brief Add the default and connection keys in the answer before sending it.
+			 */
+			void updateAnswerHeader();
+			/**
+			 * @brief Send a pre-encoded answer (only the "Date", "Server" and "Connection" keys are added).
+			 * @param[in] _answer Encoded answer.
+			 * @return Number of byte written or -1 on error.
+			 */
+			int32_t setAnswer(const enet::HttpCannedAnswer& _answer);
 		public:
 			const enet::HttpAnswer& getAnswerHeader() {
 				return m_answerHeader;
@@ -230,6 +555,16 @@ namespace enet {
 			ethread::Thread* m_thread;
 			bool m_threadRunning;
 			etk::Vector<uint8_t> m_temporaryBuffer;
+			etk::Vector<char> m_sendBuffer; //!< Serialization buffer of the sent header (kept between the messages)
+			/**
+			 * @brief Serialize a header in the send buffer and write it with the body.
+			 * @param[in] _header Header to send.
+			 * @param[in] _data Pointer on the body (can be null).
+			 * @param[in] _len Number of byte of the body.
+			 * @param[in] _more The body is sent after (the header is kept to be sent with the first data).
+			 * @return Number of byte written or -1 on error.
+			 */
+			int32_t writeHeader(const enet::HttpHeader& _header, const void* _data=null, int32_t _len=0, bool _more=false);
 		public:
 			/**
 			 * @brief Get the adress of the connection source IP:port
@@ -238,9 +573,67 @@ namespace enet {
 			const etk::String& getRemoteAddress() const {
 				return m_connection.getRemoteName();
 			}
+		protected:
+			ememory::SharedPtr<enet::AdmissionControl> m_admissionControl; //!< Overload controller (server only)
+			bool m_connectionAdmitted; //!< The connection has been counted in the admission controller (atomic access: released from the processing thread or from stop())
+			echrono::Duration m_queueDelay; //!< Time between the accept and the start of the processing thread
+			/**
+			 * @brief Send the pre-build reject answer of the admission controller and close the connection.
+			 */
+			void rejectWork();
+			/**
+			 * @brief Release the connection slot of the admission controller (only the first call release it).
+			 */
+			void releaseAdmission();
+			ememory::SharedPtr<enet::RateLimiter> m_rateLimiter; //!< Limit the number of request per remote address (server only)
+			ememory::SharedPtr<enet::HttpCompression> m_compression; //!< Compression of the answers and decompression of the requests (server only)
+			ememory::SharedPtr<enet::HttpInflater> m_inflater; //!< Decompression of the current request body (null if it is not compressed)
+			etk::Vector<uint8_t> m_compressBuffer; //!< Compressed answer body (kept between the messages)
+			etk::Vector<uint8_t> m_inflateBuffer; //!< Decompressed request body (kept between the messages)
+			ememory::SharedPtr<enet::HttpCache> m_cache; //!< Cache of the answers (server only)
+			etk::String m_cacheKey; //!< Key of the current request in the cache (empty: the answer is not stored)
+			echrono::Duration m_idleTimeOut; //!< Maximum time to wait the next request on a persistent connection (server only)
+			int32_t m_maxRequest; //!< Maximum number of request on a connection (0 for no limit) (server only)
+			int32_t m_nbRequest; //!< Number of request processed on the connection (server only)
+			bool m_keepAlive; //!< The connection is kept open after the current message
+			int64_t m_bodySize; //!< Number of byte of the current body still to read (-1: until the connection is closed or chunked)
+			bool m_bodyChunked; //!< The current body is received with "Transfer-Encoding: chunked"
+			enet::HttpChunkDecoder m_chunkDecoder; //!< Decoder of the chunked body
+			/**
+			 * @brief Select how the end of the body is found (RFC 7230 3.3.3).
+			 * @param[in] _header Received header.
+			 * @param[in] _hasBody false if the message has no body whatever the header.
+			 */
+			void updateBodyFraming(const enet::HttpHeader& _header, bool _hasBody);
+			/**
+			 * @brief Check the answer header to know the size of the body and if the connection stay open (client only).
+			 */
+			void updateAnswerFraming();
+			/**
+			 * @brief Read the next part of the body and give it to the observers.
+			 */
+			void readBody();
+			/**
+			 * @brief End of the body: notify the observer and wait the next message (or close the connection).
+			 */
+			void endBody();
+			/**
+			 * @brief Check the request header to know if the connection can stay open after it (RFC 7230 6.3).
+			 */
+			void updateKeepAlive();
+			/**
+			 * @brief Add the persistent connection keys in the answer and update the keep-alive state.
+			 */
+			void updateAnswerConnection();
+			/**
+			 * @brief End of the processing of a request: wait the next one or close the connection.
+			 */
+			void endRequest();
 		private:
 			void threadCallback();
 		private:
+			enet::HttpParser m_parser; //!< Parser of the received header
+			etk::Vector<char> m_headerBuffer; //!< Reception buffer of the header
 			void getHeader();
 		public:
 			void start();
@@ -255,6 +648,25 @@ namespace enet {
 			 * @param[in] _inThreadStop the http thread request an auto-stop.
 			 */
 			void redirectTo(const etk::String& _addressRedirect, bool _inThreadStop=false);
+		protected:
+			ememory::SharedPtr<enet::RetryPolicy> m_retryPolicy; //!< Retry policy of the connection on redirection (client only)
+			ememory::SharedPtr<enet::ConnectionPool> m_pool; //!< Pool that give the connection: it is given back by stop() when it can be reused (client only)
+			bool m_answerWait; //!< A request has been sent and its answer is not finished (client only)
+		public:
+			/**
+			 * @brief Set the retry policy used to connect on a redirection (can be shared between all the connections)
+			 * @param[in] _value Retry policy (null to use the default one)
+			 */
+			void setRetryPolicy(ememory::SharedPtr<enet::RetryPolicy> _value) {
+				m_retryPolicy = _value;
+			}
+			/**
+			 * @brief Get the retry policy used to connect on a redirection.
+			 * @return The retry policy (can be null)
+			 */
+			ememory::SharedPtr<enet::RetryPolicy> getRetryPolicy() const {
+				return m_retryPolicy;
+			}
 		public:
 			using Observer = etk::Function<void(etk::Vector<uint8_t>&)>; //!< Define an Observer: function pointer
 			Observer m_observer;
@@ -273,6 +685,26 @@ namespace enet {
 			void connect(Observer _func) {
 				m_observer = _func;
 			}
+		public:
+			using ObserverBody = etk::Function<void(const uint8_t*, size_t, bool)>; //!< Define an Observer on the body: data, size, end of the body
+		protected:
+			ObserverBody m_observerBody;
+		public:
+			/**
+			 * @brief Connect an function member on the body data (Content-Length and chunked body are decoded).
+			 * The function is called for each part of the body received, and one time with _end == true at the end of the body.
+			 * @param[in] _class Object on whe we need to call.
+			 * @param[in] _func Function to call.
+			 */
+			template<class CLASS_TYPE>
+			void connectBody(CLASS_TYPE* _class, void (CLASS_TYPE::*_func)(const uint8_t*, size_t, bool)) {
+				m_observerBody = [=](const uint8_t* _data, size_t _size, bool _end){
+					(*_class.*_func)(_data, _size, _end);
+				};
+			}
+			void connectBody(ObserverBody _func) {
+				m_observerBody = _func;
+			}
 		public:
 			using ObserverRaw = etk::Function<void(enet::Tcp&)>; //!< Define an Observer: function pointer
 			ObserverRaw m_observerRaw;
@@ -342,20 +774,156 @@ namespace enet {
 				}
 				return ret/sizeof(T);
 			}
+			/**
+			 * @brief Write a chunk of the body (the header must contain "Transfer-Encoding: chunked")
+			 * @param[in] _data pointer on the data might be write
+			 * @param[in] _len Size of the chunk (nothing is written for an empty chunk)
+			 * @return >0 byte size of the data written
+			 * @return -1 an error occured.
+			 */
+			int32_t writeChunk(const void* _data, int32_t _len);
+			/**
+			 * @brief Write the last chunk: end of a chunked body.
+			 * @return 0 on success
+			 * @return -1 an error occured.
+			 */
+			int32_t writeChunkEnd();
+			/**
+			 * @brief Wait some space in the send buffer of the connection.
+			 * @param[in] _timeOut Maximum time to wait (0 to check without waiting).
+			 * @return true if a write will not wait the remote.
+			 */
+			bool waitWrite(echrono::Duration _timeOut) {
+				return m_connection.waitWrite(_timeOut);
+			}
+	};
+	
+	/**
+	 * @brief Writer of an answer body generated step by step (the full body is never in memory).
+	 * The body is sent in chunks ("Transfer-Encoding: chunked"), or raw when the header contain a "Content-Length".
+	 * It is created by HttpServer::beginResponse() and must be finished before the next request is processed.
+	 */
+	class HttpResponseWriter {
+		private:
+			enet::Http* m_interface; //!< Connection to write the body (null when the body is finished)
+			bool m_chunked; //!< The body is sent in chunks
+			bool m_noBody; //!< The answer has no body (HEAD request, 1xx, 204, 304): the data are dropped
+			int64_t m_remaining; //!< Number of byte still to write for a "Content-Length" body (-1: no size)
+			bool m_checkSpace; //!< Check the space in the socket before each write
+			echrono::Duration m_spaceTimeOut; //!< Maximum time to wait some space in the socket when it is checked
+			ememory::SharedPtr<enet::HttpDeflater> m_deflater; //!< Compression of the body (null if it is not compressed)
+			etk::Vector<uint8_t> m_buffer; //!< Compressed data
+		public:
+			HttpResponseWriter();
+			HttpResponseWriter(enet::Http* _interface,
+			                   bool _chunked,
+			                   bool _noBody,
+			                   int64_t _size,
+			                   ememory::SharedPtr<enet::HttpDeflater> _deflater=null);
+			HttpResponseWriter(HttpResponseWriter&& _obj);
+			HttpResponseWriter& operator= (HttpResponseWriter&& _obj);
+			HttpResponseWriter(const HttpResponseWriter& _obj) = delete;
+			HttpResponseWriter& operator= (const HttpResponseWriter& _obj) = delete;
+			/**
+			 * @brief Destructor: finish the body if it is not done.
+			 */
+			~HttpResponseWriter();
+			/**
+			 * @brief Check the space in the send buffer of the socket before each write: writeChunk() return 0 (nothing
+			 * written) when the socket stay full during the time out.
+			 * @note This is not a non-blocking write: when some space is available the data are fully written, the call can
+			 * wait the remote if they are bigger than the free space. Write small parts to limit this wait.
+			 * @param[in] _timeOut Maximum time to wait some space in the socket (0 to never wait).
+			 */
+			void setSpaceTimeOut(echrono::Duration _timeOut) {
+				m_checkSpace = true;
+				m_spaceTimeOut = _timeOut;
+			}
+			/**
+			 * @brief Write without checking the space in the socket: wait until the remote receive the data (default).
+			 */
+			void clearSpaceTimeOut() {
+				m_checkSpace = false;
+			}
+			/**
+			 * @brief Check if some data can be written without waiting the remote.
+			 * @param[in] _timeOut Maximum time to wait.
+			 * @return true if writeChunk() will not block.
+			 */
+			bool canWrite(echrono::Duration _timeOut = echrono::Duration()) const;
+			/**
+			 * @brief Write a part of the body.
+			 * @param[in] _data pointer on the data might be write
+			 * @param[in] _len Number of byte
+			 * @return >0 byte size written (all the data when the body is compressed)
+			 * @return 0 nothing written: the socket is full (only with setSpaceTimeOut()), retry later
+			 * @return -1 an error occured (or the body is finished).
+			 */
+			int32_t writeChunk(const void* _data, int32_t _len);
+			/**
+			 * @brief Write a part of the body.
+			 * @param[in] _data String to write (without the '\0')
+			 * @return Same as writeChunk(const void*, int32_t)
+			 */
+			int32_t writeChunk(const etk::String& _data) {
+				return writeChunk(_data.c_str(), _data.size());
+			}
+			/**
+			 * @brief End the body (send the last chunk). The writer can not be used after.
+			 * @return true if the body is correctly ended, false if the connection has been closed (Content-Length not reached).
+			 */
+			bool finish();
+			/**
+			 * @brief Check if the body is finished.
+			 * @return true if finish() has been called.
+			 */
+			bool isFinished() const {
+				return m_interface == null;
+			}
+		private:
+			/**
+			 * @brief Write data on the connection (in a chunk or raw).
+			 */
+			int32_t writeData(const void* _data, int32_t _len);
 	};
 	
 	class HttpClient : public Http {
 		public:
 			HttpClient(enet::Tcp _connection);
+			/**
+			 * @brief Contructor with a connection of a pool: stop() give back the connection to the pool when no answer is in progress
+			 * and the remote keep the connection open.
+			 * @param[in] _pool Pool of connection.
+			 * @param[in] _hostname Name or IP of the host.
+			 * @param[in] _port Port of the host.
+			 */
+			HttpClient(ememory::SharedPtr<enet::ConnectionPool> _pool, const etk::String& _hostname, uint16_t _port);
 		public:
 			void setHeader(const enet::HttpRequest& _header) {
 				_header.display();
 				setRequestHeader(_header);
 			}
+			/**
+			 * @brief Send a request with its body (header and body are sent in one system call).
+			 * @param[in] _header Request header.
+			 * @param[in] _data Body of the request.
+			 * @return Number of byte written or -1 on error.
+			 */
+			int32_t setHeader(const enet::HttpRequest& _header, const etk::String& _data) {
+				return setRequest(_header, _data.c_str(), _data.size());
+			}
 		public:
-			//bool get(const etk::String& _address);
-			//bool post(const etk::String& _address, const etk::Map<etk::String, etk::String>& _values);
-			//bool post(const etk::String& _address, const etk::String& _contentType, const etk::String& _data);
+			/**
+			 * @brief Send a request without creating a connection: the request is processed by a shared I/O thread
+			 * that reuse the connections on the host (see enet::httpAsync).
+			 * @param[in] _header Request header (the host and the port are read in the "Host" key).
+			 * @param[in] _body Body of the request (the "Content-Length" is set).
+			 * @param[in] _timeOut Maximum time to get the answer (0 to use the default time out).
+			 * @return The future answer (include <enet/HttpAsync.hpp> to use it).
+			 */
+			static enet::HttpFuture request(const enet::HttpRequest& _header,
+			                                const etk::String& _body="",
+			                                echrono::Duration _timeOut=echrono::Duration());
 		public:
 			/**
 			 * @brief Connect an function member on the signal with the shared_ptr object.
@@ -382,6 +950,42 @@ namespace enet {
 				_header.display();
 				setAnswerHeader(_header);
 			}
+			/**
+			 * @brief Send an answer with its body (header and body are sent in one system call).
+			 * @param[in] _header Answer header.
+			 * @param[in] _data Body of the answer.
+			 * @return Number of byte written or -1 on error.
+			 */
+			int32_t setHeader(const enet::HttpAnswer& _header, const etk::String& _data) {
+				return setAnswer(_header, _data.c_str(), _data.size());
+			}
+			/**
+			 * @brief Send a pre-encoded answer (see enet::httpCanned).
+			 * @param[in] _answer Encoded answer.
+			 * @return Number of byte written or -1 on error.
+			 */
+			int32_t setHeader(const enet::HttpCannedAnswer& _answer) {
+				return setAnswer(_answer);
+			}
+			/**
+			 * @brief Send an answer with a part of a file as body (the file is not copied in the user space when possible: sendfile).
+			 * The "Content-Length" is set with the size of the part. The connection is closed if the file is shorter than expected.
+			 * @param[in] _header Answer header.
+			 * @param[in] _fd File descriptor (opened in read mode).
+			 * @param[in] _offset Position of the first byte in the file.
+			 * @param[in] _size Number of byte to send.
+			 * @return Number of byte of the body written or -1 on error.
+			 */
+			int64_t sendFile(const enet::HttpAnswer& _header, int32_t _fd, int64_t _offset, int64_t _size);
+			/**
+			 * @brief Send the answer header and get a writer to stream the body.
+			 * Without "Content-Length" in the answer, the body is sent with "Transfer-Encoding: chunked" (HTTP/1.1 remote)
+			 * or up to the close of the connection (HTTP/1.0 remote).
+			 * When a compression is set (see setCompression()), the body is compressed on the fly if the remote accept it.
+			 * @param[in] _header Answer header.
+			 * @return The writer of the body.
+			 */
+			enet::HttpResponseWriter beginResponse(const enet::HttpAnswer& _header);
 		public:
 			/**
 			 * @brief Connect an function member on the signal with the shared_ptr object.
@@ -398,6 +1002,60 @@ namespace enet {
 			void connectHeader(Http::ObserverRequest _func) {
 				m_observerRequest = _func;
 			}
+		public:
+			/**
+			 * @brief Set the overload controller of the server (can be shared between all the connections)
+			 * @param[in] _value Admission controller (null to disable)
+			 * @note Must be set before calling start()
+			 */
+			void setAdmissionControl(ememory::SharedPtr<enet::AdmissionControl> _value) {
+				m_admissionControl = _value;
+			}
+			/**
+			 * @brief Set the rate limiter checked when a request header is received (can be shared between all the connections)
+			 * @param[in] _value Rate limiter (null to disable)
+			 */
+			void setRateLimiter(ememory::SharedPtr<enet::RateLimiter> _value) {
+				m_rateLimiter = _value;
+			}
+			/**
+			 * @brief Set the compression of the answers (negotiated with "Accept-Encoding") and enable the decompression
+			 * of the request bodies with a "Content-Encoding" (can be shared between all the connections).
+			 * @param[in] _value Compression configuration (null to disable)
+			 */
+			void setCompression(ememory::SharedPtr<enet::HttpCompression> _value) {
+				m_compression = _value;
+			}
+			/**
+			 * @brief Set the cache of the answers (can be shared between all the connections): the requests found in the
+			 * cache are answered without calling the header observer. Only the answers sent with setHeader(answer, data)
+			 * (or setAnswer(answer, data, len)) are stored: the answers sent with beginResponse() or sendFile() are never cached.
+			 * @param[in] _value Cache (null to disable)
+			 */
+			void setCache(ememory::SharedPtr<enet::HttpCache> _value) {
+				m_cache = _value;
+			}
+			/**
+			 * @brief Set the maximum time to wait the next request on a persistent connection.
+			 * @param[in] _value Idle time out (the connection is closed after).
+			 */
+			void setIdleTimeOut(echrono::Duration _value) {
+				m_idleTimeOut = _value;
+			}
+			/**
+			 * @brief Set the maximum number of request on one connection (the last answer is sent with "Connection: close").
+			 * @param[in] _value Number of request (0 for no limit).
+			 */
+			void setMaxRequest(int32_t _value) {
+				m_maxRequest = _value;
+			}
+			/**
+			 * @brief Get the number of request processed on this connection.
+			 * @return Number of request.
+			 */
+			int32_t getNumberRequest() const {
+				return m_nbRequest;
+			}
 	};
 }
 
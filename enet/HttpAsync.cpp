@@ -0,0 +1,1093 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/HttpAsync.hpp>
+#include <enet/HttpParser.hpp>
+#include <enet/HttpChunk.hpp>
+#include <enet/Resolver.hpp>
+#include <enet/enet.hpp>
+#include <etk/Map.hpp>
+#include <etk/stdTools.hpp>
+#include <ethread/Thread.hpp>
+#include <ethread/tools.hpp>
+#include <echrono/Steady.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <errno.h>
+	#include <unistd.h>
+	#include <string.h>
+}
+
+#ifdef __TARGET_OS__Windows
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+#else
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <netinet/tcp.h>
+	#include <fcntl.h>
+	#include <poll.h>
+#endif
+
+enet::HttpResponse::HttpResponse(enum status _status, const etk::String& _error) :
+  m_status(_status),
+  m_error(_error),
+  m_header(enet::HTTPAnswerCode::c000_unknow) {
+	
+}
+
+etk::String enet::HttpResponse::getBodyString() const {
+	if (m_body.size() == 0) {
+		return "";
+	}
+	return etk::String((const char*)&m_body[0], m_body.size());
+}
+
+enet::HttpFuture::State::State() :
+  m_ready(false) {
+	
+}
+
+void enet::HttpFuture::State::set(enet::HttpResponse _response) {
+	Observer observer;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		if (m_ready == true) {
+			return;
+		}
+		m_response = etk::move(_response);
+		m_ready = true;
+		observer = m_observer;
+		m_observer = null;
+	}
+	// The observer is called before waking up the waiters: get() return after it
+	if (observer != null) {
+		observer(m_response);
+	}
+	m_semaphore.post();
+}
+
+enet::HttpFuture::HttpFuture() {
+	
+}
+
+enet::HttpFuture::HttpFuture(ememory::SharedPtr<enet::HttpFuture::State> _state) :
+  m_state(_state) {
+	
+}
+
+bool enet::HttpFuture::isReady() const {
+	if (m_state == null) {
+		return false;
+	}
+	ethread::UniqueLock lock(m_state->m_mutex);
+	return m_state->m_ready;
+}
+
+bool enet::HttpFuture::wait(echrono::Duration _timeOut) const {
+	if (m_state == null) {
+		return false;
+	}
+	if (isReady() == true) {
+		return true;
+	}
+	if (m_state->m_semaphore.wait(_timeOut.get() / 1000) == false) {
+		return false;
+	}
+	// Wake up the other waiters
+	m_state->m_semaphore.post();
+	return true;
+}
+
+const enet::HttpResponse& enet::HttpFuture::get() const {
+	static const enet::HttpResponse noRequest(enet::HttpResponse::status::closed, "no request");
+	if (m_state == null) {
+		return noRequest;
+	}
+	if (isReady() == false) {
+		m_state->m_semaphore.wait();
+		// Wake up the other waiters
+		m_state->m_semaphore.post();
+	}
+	return m_state->m_response;
+}
+
+void enet::HttpFuture::andThen(Observer _func) {
+	if (m_state == null) {
+		return;
+	}
+	{
+		ethread::UniqueLock lock(m_state->m_mutex);
+		if (m_state->m_ready == false) {
+			m_state->m_observer = _func;
+			return;
+		}
+	}
+	if (_func != null) {
+		_func(m_state->m_response);
+	}
+}
+
+namespace enet {
+	namespace httpAsync {
+		#ifdef __TARGET_OS__Windows
+			using Socket = SOCKET;
+			using PollFd = WSAPOLLFD;
+			static const SOCKET INVALID = INVALID_SOCKET;
+			static const int32_t MAX_POLL_MS = 10; //!< No wake up pipe: the new requests are taken at least every 10ms
+		#else
+			using Socket = int32_t;
+			using PollFd = struct pollfd;
+			static const int32_t INVALID = -1;
+			static const int32_t MAX_POLL_MS = 1000;
+		#endif
+		static const size_t RECEIVE_SIZE = 16384; //!< Size of the reception of a connection (bigger only for the big headers)
+		static void closeSocket(Socket _socket) {
+			#ifdef __TARGET_OS__Windows
+				closesocket(_socket);
+			#else
+				close(_socket);
+			#endif
+		}
+		static bool setBlocking(Socket _socket, bool _blocking) {
+			#ifdef __TARGET_OS__Windows
+				u_long mode = _blocking == true ? 0 : 1;
+				return ioctlsocket(_socket, FIONBIO, &mode) == 0;
+			#else
+				int flags = fcntl(_socket, F_GETFL, 0);
+				if (flags < 0) {
+					return false;
+				}
+				if (_blocking == true) {
+					flags &= ~O_NONBLOCK;
+				} else {
+					flags |= O_NONBLOCK;
+				}
+				return fcntl(_socket, F_SETFL, flags) == 0;
+			#endif
+		}
+		static bool isWouldBlock() {
+			#ifdef __TARGET_OS__Windows
+				return WSAGetLastError() == WSAEWOULDBLOCK;
+			#else
+				return    errno == EAGAIN
+				       || errno == EWOULDBLOCK
+				       || errno == EINTR;
+			#endif
+		}
+		static int32_t getPollTimeOut(const echrono::Steady& _event, const echrono::Steady& _now) {
+			if (_event <= _now) {
+				return 0;
+			}
+			// round up to not wake up before the event
+			int64_t delay = ((_event - _now).get() + 999999) / 1000000;
+			if (delay > MAX_POLL_MS) {
+				return MAX_POLL_MS;
+			}
+			return int32_t(delay);
+		}
+		/**
+		 * @brief A request waiting a connection or in progress on a connection.
+		 */
+		class Job {
+			public:
+				ememory::SharedPtr<enet::HttpFuture::State> m_state; //!< Result shared with the futures
+				etk::String m_key; //!< "host:port" of the request
+				etk::Vector<enet::Address> m_address; //!< Address of the host
+				etk::Vector<char> m_data; //!< Serialized request (header and body)
+				bool m_isHead; //!< HEAD request: the answer has no body
+				bool m_retry; //!< The request can be sent again when a reused connection is closed by the remote
+				echrono::Steady m_deadline; //!< Time out of the request
+				uint32_t m_maxHeaderSize; //!< Maximum size of the answer header
+				uint64_t m_maxBodySize; //!< Maximum size of the answer body
+		};
+		/**
+		 * @brief Non-blocking connection on a host, processing one request at a time.
+		 */
+		class Connection {
+			public:
+				enum class state {
+					connecting, //!< Wait the end of the connection
+					sending, //!< Send the request
+					receiving, //!< Receive the answer
+					idle, //!< Wait the next request (keep-alive)
+					closed //!< To remove
+				};
+				Socket m_socket; //!< Socket of the connection
+				etk::String m_key; //!< "host:port" of the connection
+				enum state m_state; //!< Current state
+				etk::Vector<enet::Address> m_address; //!< Address to try for the connection
+				size_t m_addressId; //!< Address currently connecting
+				ememory::SharedPtr<Job> m_job; //!< Request in progress
+				size_t m_sendPosition; //!< Number of byte of the request sent
+				etk::Vector<char> m_buffer; //!< Received data not processed
+				size_t m_used; //!< Number of byte in the buffer
+				enet::HttpParser m_parser; //!< Parser of the answer header
+				bool m_headerDone; //!< The answer header is received
+				enet::HttpResponse m_response; //!< Answer in progress
+				int64_t m_bodySize; //!< Remaining size of the body (-1: until the close of the connection)
+				bool m_chunked; //!< The body is chunked
+				enet::HttpChunkDecoder m_decoder; //!< Decoder of the chunked body
+				bool m_keepAlive; //!< The connection can be reused after the answer
+				bool m_reused; //!< The connection has already processed a request
+				echrono::Steady m_deadline; //!< End of the connection or of the idle time
+				etk::String m_error; //!< Last connection error
+			public:
+				Connection() :
+				  m_socket(INVALID),
+				  m_state(state::connecting),
+				  m_addressId(0),
+				  m_sendPosition(0),
+				  m_used(0),
+				  m_headerDone(false),
+				  m_bodySize(-1),
+				  m_chunked(false),
+				  m_keepAlive(false),
+				  m_reused(false) {
+					
+				}
+				~Connection() {
+					close();
+				}
+				void close() {
+					if (m_socket != INVALID) {
+						closeSocket(m_socket);
+						m_socket = INVALID;
+					}
+					m_state = state::closed;
+				}
+				/**
+				 * @brief Remove the first data of the reception buffer.
+				 */
+				void consume(size_t _size) {
+					if (_size < m_used) {
+						memmove(&m_buffer[0], &m_buffer[_size], m_used - _size);
+					}
+					m_used -= _size;
+				}
+		};
+		/**
+		 * @brief Requests waiting a connection on a host.
+		 */
+		class Host {
+			public:
+				etk::Vector<ememory::SharedPtr<Job>> m_queue; //!< Requests waiting a connection
+				uint32_t m_nbConnection; //!< Number of connection opened on the host
+			public:
+				Host() :
+				  m_nbConnection(0) {
+					
+				}
+		};
+		/**
+		 * @brief Shared I/O thread of all the requests.
+		 */
+		class Engine {
+			public:
+				ethread::Mutex m_mutex; //!< Protect the new requests and the configuration
+				etk::Vector<ememory::SharedPtr<Job>> m_newJob; //!< Requests not yet taken by the I/O thread
+				echrono::Duration m_connectTimeOut;
+				echrono::Duration m_requestTimeOut;
+				echrono::Duration m_idleTimeOut;
+				uint32_t m_maxConnectionPerHost;
+				uint32_t m_maxHeaderSize;
+				uint64_t m_maxBodySize;
+				size_t m_nbInProgress; //!< Number of request not finished
+				ethread::Thread* m_thread;
+				bool m_threadRunning;
+				Socket m_wakeUp[2]; //!< Pipe to wake up the poll when a request is added
+				// Only used by the I/O thread:
+				etk::Map<etk::String, Host> m_host; //!< Requests waiting a connection per host
+				etk::Vector<ememory::SharedPtr<Connection>> m_connection; //!< All the connections
+			public:
+				Engine() :
+				  m_connectTimeOut(echrono::seconds(10)),
+				  m_requestTimeOut(echrono::seconds(30)),
+				  m_idleTimeOut(echrono::seconds(60)),
+				  m_maxConnectionPerHost(64),
+				  m_maxHeaderSize(65536),
+				  m_maxBodySize(64*1024*1024),
+				  m_nbInProgress(0),
+				  m_thread(null),
+				  m_threadRunning(false) {
+					m_wakeUp[0] = INVALID;
+					m_wakeUp[1] = INVALID;
+				}
+				~Engine() {
+					stopThread();
+				}
+				void stopThread() {
+					{
+						ethread::UniqueLock lock(m_mutex);
+						m_threadRunning = false;
+					}
+					wakeUp();
+					if (m_thread != null) {
+						m_thread->join();
+						ETK_DELETE(ethread::Thread, m_thread);
+						m_thread = null;
+					}
+					#ifndef __TARGET_OS__Windows
+						for (size_t iii=0; iii<2; ++iii) {
+							if (m_wakeUp[iii] != INVALID) {
+								closeSocket(m_wakeUp[iii]);
+								m_wakeUp[iii] = INVALID;
+							}
+						}
+					#endif
+				}
+				/**
+				 * @brief Start the I/O thread if needed (the mutex must be locked).
+				 */
+				bool startThread() {
+					if (m_thread != null) {
+						// false when the thread is stopping
+						return m_threadRunning;
+					}
+					#ifndef __TARGET_OS__Windows
+						if (pipe(m_wakeUp) != 0) {
+							ENET_ERROR("can not create the wake up pipe: " << strerror(errno));
+							m_wakeUp[0] = INVALID;
+							m_wakeUp[1] = INVALID;
+							return false;
+						}
+						setBlocking(m_wakeUp[0], false);
+						setBlocking(m_wakeUp[1], false);
+					#endif
+					m_threadRunning = true;
+					m_thread = ETK_NEW(ethread::Thread, [&](){ threadCallback();});
+					if (m_thread == null) {
+						m_threadRunning = false;
+						ENET_ERROR("creating http async thread!");
+						return false;
+					}
+					return true;
+				}
+				void wakeUp() {
+					#ifndef __TARGET_OS__Windows
+						if (m_wakeUp[1] != INVALID) {
+							char value = 0;
+							if (::write(m_wakeUp[1], &value, 1) < 0) {
+								// The pipe is full: the thread is already waked up
+							}
+						}
+					#endif
+				}
+				void add(const ememory::SharedPtr<Job>& _job) {
+					{
+						ethread::UniqueLock lock(m_mutex);
+						if (startThread() == false) {
+							lock.unlock();
+							_job->m_state->set(enet::HttpResponse(enet::HttpResponse::status::closed, "can not start the I/O thread"));
+							return;
+						}
+						m_newJob.pushBack(_job);
+						m_nbInProgress++;
+					}
+					wakeUp();
+				}
+				void threadCallback();
+			private:
+				void complete(const ememory::SharedPtr<Job>& _job, enet::HttpResponse _response);
+				void takeNewJob();
+				echrono::Steady dispatch(const echrono::Steady& _now);
+				void startConnection(const ememory::SharedPtr<Job>& _job, Host& _host, const echrono::Steady& _now);
+				bool connectNext(Connection& _connection, const echrono::Steady& _now);
+				void startSend(Connection& _connection, const ememory::SharedPtr<Job>& _job);
+				void process(Connection& _connection, const echrono::Steady& _now);
+				void processReceive(Connection& _connection, const echrono::Steady& _now);
+				bool processHeader(Connection& _connection);
+				void processBody(Connection& _connection, const echrono::Steady& _now);
+				void endAnswer(Connection& _connection, const echrono::Steady& _now);
+				void fail(Connection& _connection, enum enet::HttpResponse::status _status, const etk::String& _error);
+				void closeConnection(Connection& _connection);
+		};
+		static Engine& getEngine() {
+			static Engine engine;
+			return engine;
+		}
+	}
+}
+
+void enet::httpAsync::Engine::complete(const ememory::SharedPtr<Job>& _job, enet::HttpResponse _response) {
+	{
+		ethread::UniqueLock lock(m_mutex);
+		m_nbInProgress--;
+	}
+	_job->m_state->set(etk::move(_response));
+}
+
+void enet::httpAsync::Engine::takeNewJob() {
+	etk::Vector<ememory::SharedPtr<Job>> list;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		list = etk::move(m_newJob);
+		m_newJob.clear();
+	}
+	for (auto &it : list) {
+		auto itHost = m_host.find(it->m_key);
+		if (itHost == m_host.end()) {
+			m_host.add(it->m_key, Host());
+			itHost = m_host.find(it->m_key);
+		}
+		itHost->second.m_queue.pushBack(it);
+	}
+}
+
+void enet::httpAsync::Engine::closeConnection(Connection& _connection) {
+	if (_connection.m_state == Connection::state::closed) {
+		return;
+	}
+	_connection.close();
+	auto itHost = m_host.find(_connection.m_key);
+	if (    itHost != m_host.end()
+	     && itHost->second.m_nbConnection > 0) {
+		itHost->second.m_nbConnection--;
+	}
+}
+
+void enet::httpAsync::Engine::fail(Connection& _connection, enum enet::HttpResponse::status _status, const etk::String& _error) {
+	ememory::SharedPtr<Job> job = _connection.m_job;
+	_connection.m_job = null;
+	bool nothingReceived =    _connection.m_headerDone == false
+	                       && _connection.m_used == 0;
+	bool reused = _connection.m_reused;
+	closeConnection(_connection);
+	if (job == null) {
+		return;
+	}
+	if (    _status == enet::HttpResponse::status::closed
+	     && reused == true
+	     && nothingReceived == true
+	     && job->m_retry == true) {
+		// The remote closed the idle connection when the request was sent: retry one time on a new connection
+		ENET_DEBUG("Connection closed by " << _connection.m_key << " before the answer ==> retry");
+		job->m_retry = false;
+		auto itHost = m_host.find(job->m_key);
+		if (itHost != m_host.end()) {
+			itHost->second.m_queue.insert(0, job);
+			return;
+		}
+	}
+	ENET_DEBUG("Request on " << _connection.m_key << " failed: " << _error);
+	complete(job, enet::HttpResponse(_status, _error));
+}
+
+bool enet::httpAsync::Engine::connectNext(Connection& _connection, const echrono::Steady& _now) {
+	etk::String error = _connection.m_error;
+	if (error == "") {
+		error = "no address";
+	}
+	while (_connection.m_addressId < _connection.m_address.size()) {
+		const enet::Address& address = _connection.m_address[_connection.m_addressId];
+		_connection.m_addressId++;
+		Socket socketId = socket(address.getFamily(), SOCK_STREAM, IPPROTO_TCP);
+		if (socketId == INVALID) {
+			error = "can not open socket: " + etk::String(strerror(errno));
+			continue;
+		}
+		if (setBlocking(socketId, false) == false) {
+			error = "can not set socket non-blocking: " + etk::String(strerror(errno));
+			closeSocket(socketId);
+			continue;
+		}
+		int flag = 1;
+		setsockopt(socketId, IPPROTO_TCP, TCP_NODELAY, (char*)&flag, sizeof(flag));
+		#ifdef SO_NOSIGPIPE
+			setsockopt(socketId, SOL_SOCKET, SO_NOSIGPIPE, (char*)&flag, sizeof(flag));
+		#endif
+		_connection.m_socket = socketId;
+		_connection.m_state = Connection::state::connecting;
+		_connection.m_deadline = _now + m_connectTimeOut;
+		if (connect(socketId, (const struct sockaddr *)address.getData(), address.getSize()) == 0) {
+			// the end of the connection is detected with the poll
+			return true;
+		}
+		#ifdef __TARGET_OS__Windows
+			bool inProgress = WSAGetLastError() == WSAEWOULDBLOCK;
+		#else
+			bool inProgress = errno == EINPROGRESS;
+		#endif
+		if (inProgress == true) {
+			return true;
+		}
+		error = address.getName() + ": " + strerror(errno);
+		closeSocket(socketId);
+		_connection.m_socket = INVALID;
+	}
+	fail(_connection, enet::HttpResponse::status::connectionError, error);
+	return false;
+}
+
+void enet::httpAsync::Engine::startConnection(const ememory::SharedPtr<Job>& _job, Host& _host, const echrono::Steady& _now) {
+	ememory::SharedPtr<Connection> connection = ememory::makeShared<Connection>();
+	connection->m_key = _job->m_key;
+	connection->m_address = _job->m_address;
+	connection->m_job = _job;
+	_host.m_nbConnection++;
+	m_connection.pushBack(connection);
+	ENET_DEBUG("Start connection on " << _job->m_key);
+	connectNext(*connection, _now);
+}
+
+void enet::httpAsync::Engine::startSend(Connection& _connection, const ememory::SharedPtr<Job>& _job) {
+	_connection.m_job = _job;
+	_connection.m_state = Connection::state::sending;
+	_connection.m_sendPosition = 0;
+	_connection.m_used = 0;
+	_connection.m_headerDone = false;
+	_connection.m_parser.reset();
+	_connection.m_parser.setMaxSize(_job->m_maxHeaderSize);
+	_connection.m_response = enet::HttpResponse(enet::HttpResponse::status::done);
+	if (_connection.m_buffer.size() < RECEIVE_SIZE) {
+		_connection.m_buffer.resize(RECEIVE_SIZE);
+	}
+}
+
+echrono::Steady enet::httpAsync::Engine::dispatch(const echrono::Steady& _now) {
+	echrono::Steady nextEvent = _now + echrono::milliseconds(MAX_POLL_MS);
+	// Time out of the connections
+	for (auto &it : m_connection) {
+		Connection& connection = *it;
+		if (connection.m_state == Connection::state::closed) {
+			continue;
+		}
+		if (connection.m_job != null) {
+			if (_now >= connection.m_job->m_deadline) {
+				fail(connection, enet::HttpResponse::status::timeOut, "request timeout");
+				continue;
+			}
+			if (connection.m_job->m_deadline < nextEvent) {
+				nextEvent = connection.m_job->m_deadline;
+			}
+		}
+		if (    connection.m_state == Connection::state::connecting
+		     || connection.m_state == Connection::state::idle) {
+			if (_now >= connection.m_deadline) {
+				if (connection.m_state == Connection::state::idle) {
+					ENET_DEBUG("Close idle connection on " << connection.m_key);
+					closeConnection(connection);
+					continue;
+				}
+				// try the next address
+				connection.m_error = "connection timeout";
+				closeSocket(connection.m_socket);
+				connection.m_socket = INVALID;
+				if (connectNext(connection, _now) == false) {
+					continue;
+				}
+			}
+			if (connection.m_deadline < nextEvent) {
+				nextEvent = connection.m_deadline;
+			}
+		}
+	}
+	// Give the waiting requests to the idle connections, or to new connections
+	for (auto &itHost : m_host) {
+		Host& host = itHost.second;
+		if (host.m_queue.size() == 0) {
+			continue;
+		}
+		etk::Vector<ememory::SharedPtr<Job>> queue = etk::move(host.m_queue);
+		host.m_queue.clear();
+		size_t iii = 0;
+		// Use the idle connections first (the last used is the most likely to be alive)
+		for (size_t jjj=m_connection.size(); jjj>0 && iii<queue.size(); --jjj) {
+			Connection& connection = *m_connection[jjj-1];
+			if (    connection.m_state != Connection::state::idle
+			     || connection.m_key != itHost.first) {
+				continue;
+			}
+			while (    iii < queue.size()
+			        && _now >= queue[iii]->m_deadline) {
+				complete(queue[iii], enet::HttpResponse(enet::HttpResponse::status::timeOut, "request timeout"));
+				++iii;
+			}
+			if (iii < queue.size()) {
+				ENET_VERBOSE("Reuse connection on " << itHost.first);
+				startSend(connection, queue[iii]);
+				++iii;
+			}
+		}
+		for (; iii<queue.size(); ++iii) {
+			if (_now >= queue[iii]->m_deadline) {
+				complete(queue[iii], enet::HttpResponse(enet::HttpResponse::status::timeOut, "request timeout"));
+				continue;
+			}
+			if (host.m_nbConnection < m_maxConnectionPerHost) {
+				startConnection(queue[iii], host, _now);
+				continue;
+			}
+			if (queue[iii]->m_deadline < nextEvent) {
+				nextEvent = queue[iii]->m_deadline;
+			}
+			host.m_queue.pushBack(queue[iii]);
+		}
+	}
+	// Remove the closed connections
+	size_t pos = 0;
+	for (size_t iii=0; iii<m_connection.size(); ++iii) {
+		if (m_connection[iii]->m_state == Connection::state::closed) {
+			continue;
+		}
+		if (pos != iii) {
+			m_connection[pos] = m_connection[iii];
+		}
+		++pos;
+	}
+	m_connection.resize(pos);
+	return nextEvent;
+}
+
+bool enet::httpAsync::Engine::processHeader(Connection& _connection) {
+	while (true) {
+		enum enet::HttpParser::status status = _connection.m_parser.parse(&_connection.m_buffer[0], _connection.m_used);
+		if (status == enet::HttpParser::status::incomplete) {
+			if (_connection.m_used == _connection.m_buffer.size()) {
+				// Big header: the buffer grow up to the maximum size (the parser fail when it is reached)
+				_connection.m_buffer.resize(etk::min(_connection.m_buffer.size() * 2, etk::max(size_t(_connection.m_job->m_maxHeaderSize), RECEIVE_SIZE)));
+			}
+			return false;
+		}
+		if (    status == enet::HttpParser::status::error
+		     && _connection.m_used >= _connection.m_job->m_maxHeaderSize) {
+			fail(_connection, enet::HttpResponse::status::protocolError, "answer header too big");
+			return false;
+		}
+		if (    status == enet::HttpParser::status::error
+		     || _connection.m_parser.isAnswer() == false) {
+			fail(_connection, enet::HttpResponse::status::protocolError, "malformed answer header");
+			return false;
+		}
+		const char* data = &_connection.m_buffer[0];
+		enet::HttpAnswer& header = _connection.m_response.getHeader();
+		header.setFirstLine(data, _connection.m_parser);
+		enum enet::HTTPAnswerCode code = header.getErrorCode();
+		size_t headerSize = _connection.m_parser.getHeaderSize();
+		if (    int32_t(code) >= 100
+		     && int32_t(code) < 200
+		     && code != enet::HTTPAnswerCode::c101_switchingProtocols) {
+			// Informational answer: the final answer follow
+			_connection.consume(headerSize);
+			_connection.m_parser.reset();
+			if (_connection.m_used == 0) {
+				return false;
+			}
+			continue;
+		}
+		if (header.setKeys(data, _connection.m_parser) == false) {
+			fail(_connection, enet::HttpResponse::status::protocolError, "many different Content-Length");
+			return false;
+		}
+		_connection.consume(headerSize);
+		_connection.m_headerDone = true;
+		break;
+	}
+	enet::HttpAnswer& header = _connection.m_response.getHeader();
+	enum enet::HTTPAnswerCode code = header.getErrorCode();
+	// RFC 7230 3.3.3: no body for the answer of HEAD, 1xx, 204 and 304
+	bool hasBody =    _connection.m_job->m_isHead == false
+	               && int32_t(code) >= 200
+	               && code != enet::HTTPAnswerCode::c204_noContent
+	               && code != enet::HTTPAnswerCode::c304_notModified;
+	_connection.m_chunked = false;
+	_connection.m_decoder.reset();
+	if (hasBody == false) {
+		_connection.m_bodySize = 0;
+	} else if (header.existKey(enet::HTTPHeaderId::transferEncoding) == true) {
+		_connection.m_chunked = header.isChunked();
+		_connection.m_bodySize = -1;
+	} else if (header.existKey(enet::HTTPHeaderId::contentLength) == true) {
+		_connection.m_bodySize = header.getContentLength();
+		if (_connection.m_bodySize < 0) {
+			fail(_connection, enet::HttpResponse::status::protocolError, "invalid Content-Length");
+			return false;
+		}
+		if (uint64_t(_connection.m_bodySize) > _connection.m_job->m_maxBodySize) {
+			fail(_connection, enet::HttpResponse::status::protocolError, "answer body too big");
+			return false;
+		}
+	} else {
+		_connection.m_bodySize = -1;
+	}
+	_connection.m_keepAlive = false;
+	if (    code != enet::HTTPAnswerCode::c101_switchingProtocols
+	     && (    _connection.m_chunked == true
+	          || _connection.m_bodySize >= 0)) {
+		if (header.getProtocol() >= enet::HTTPProtocol::http_1_1) {
+			_connection.m_keepAlive = header.isKeyEqual(enet::HTTPHeaderId::connection, "close") == false;
+		} else {
+			_connection.m_keepAlive = header.isKeyEqual(enet::HTTPHeaderId::connection, "keep-alive");
+		}
+	}
+	return true;
+}
+
+void enet::httpAsync::Engine::processBody(Connection& _connection, const echrono::Steady& _now) {
+	etk::Vector<uint8_t>& body = _connection.m_response.getBody();
+	if (_connection.m_chunked == true) {
+		if (_connection.m_used == 0) {
+			return;
+		}
+		size_t consumed = 0;
+		size_t bodySize = 0;
+		enum enet::HttpChunkDecoder::status status = _connection.m_decoder.decode((uint8_t*)&_connection.m_buffer[0], _connection.m_used, consumed, bodySize);
+		if (body.size() + bodySize > _connection.m_job->m_maxBodySize) {
+			fail(_connection, enet::HttpResponse::status::protocolError, "answer body too big");
+			return;
+		}
+		if (bodySize > 0) {
+			size_t pos = body.size();
+			body.resize(pos + bodySize);
+			memcpy(&body[pos], &_connection.m_buffer[0], bodySize);
+		}
+		_connection.consume(consumed);
+		if (status == enet::HttpChunkDecoder::status::error) {
+			fail(_connection, enet::HttpResponse::status::protocolError, "malformed chunked body");
+			return;
+		}
+		if (status == enet::HttpChunkDecoder::status::done) {
+			endAnswer(_connection, _now);
+		}
+		return;
+	}
+	size_t size = _connection.m_used;
+	if (    _connection.m_bodySize >= 0
+	     && int64_t(size) > _connection.m_bodySize) {
+		size = _connection.m_bodySize;
+	}
+	if (body.size() + size > _connection.m_job->m_maxBodySize) {
+		// Only the body without size can reach this point (the "Content-Length" is checked with the header)
+		fail(_connection, enet::HttpResponse::status::protocolError, "answer body too big");
+		return;
+	}
+	if (size > 0) {
+		size_t pos = body.size();
+		body.resize(pos + size);
+		memcpy(&body[pos], &_connection.m_buffer[0], size);
+		_connection.consume(size);
+	}
+	if (_connection.m_bodySize >= 0) {
+		_connection.m_bodySize -= size;
+		if (_connection.m_bodySize == 0) {
+			endAnswer(_connection, _now);
+		}
+	}
+}
+
+void enet::httpAsync::Engine::endAnswer(Connection& _connection, const echrono::Steady& _now) {
+	ememory::SharedPtr<Job> job = _connection.m_job;
+	_connection.m_job = null;
+	enet::HttpResponse response = etk::move(_connection.m_response);
+	_connection.m_response = enet::HttpResponse();
+	response.setStatus(enet::HttpResponse::status::done);
+	if (    _connection.m_keepAlive == true
+	     && _connection.m_used == 0) {
+		_connection.m_state = Connection::state::idle;
+		_connection.m_reused = true;
+		_connection.m_deadline = _now + m_idleTimeOut;
+	} else {
+		// Data after the answer (not requested) or end of the connection
+		closeConnection(_connection);
+	}
+	complete(job, etk::move(response));
+}
+
+void enet::httpAsync::Engine::processReceive(Connection& _connection, const echrono::Steady& _now) {
+	while (_connection.m_state == Connection::state::receiving) {
+		if (_connection.m_used == _connection.m_buffer.size()) {
+			// Only for the header: the body data are consumed at each reception
+			_connection.m_buffer.resize(_connection.m_buffer.size() * 2);
+		}
+		int32_t len = recv(_connection.m_socket,
+		                   &_connection.m_buffer[_connection.m_used],
+		                   _connection.m_buffer.size() - _connection.m_used,
+		                   0);
+		if (len < 0) {
+			if (isWouldBlock() == true) {
+				return;
+			}
+			fail(_connection, enet::HttpResponse::status::closed, etk::String("recv() failed: ") + strerror(errno));
+			return;
+		}
+		if (len == 0) {
+			if (    _connection.m_headerDone == true
+			     && _connection.m_chunked == false
+			     && _connection.m_bodySize < 0) {
+				// The end of the body is the close of the connection
+				_connection.m_keepAlive = false;
+				endAnswer(_connection, _now);
+				return;
+			}
+			fail(_connection, enet::HttpResponse::status::closed, "connection closed by the remote");
+			return;
+		}
+		_connection.m_used += len;
+		if (    _connection.m_headerDone == false
+		     && processHeader(_connection) == false) {
+			continue;
+		}
+		processBody(_connection, _now);
+	}
+}
+
+void enet::httpAsync::Engine::process(Connection& _connection, const echrono::Steady& _now) {
+	switch (_connection.m_state) {
+		case Connection::state::connecting: {
+			int error = 0;
+			socklen_t errorSize = sizeof(error);
+			if (getsockopt(_connection.m_socket, SOL_SOCKET, SO_ERROR, (char*)&error, &errorSize) != 0) {
+				error = errno;
+			}
+			if (error != 0) {
+				_connection.m_error = _connection.m_address[_connection.m_addressId-1].getName() + ": " + strerror(error);
+				ENET_DEBUG("Connection failed on " << _connection.m_error);
+				closeSocket(_connection.m_socket);
+				_connection.m_socket = INVALID;
+				connectNext(_connection, _now);
+				return;
+			}
+			ENET_DEBUG("Connection done on " << _connection.m_key);
+			startSend(_connection, _connection.m_job);
+			// The socket is writable: send directly
+			process(_connection, _now);
+			return;
+		}
+		case Connection::state::sending: {
+			const etk::Vector<char>& data = _connection.m_job->m_data;
+			while (_connection.m_sendPosition < data.size()) {
+				int flags = 0;
+				#ifdef MSG_NOSIGNAL
+					flags = MSG_NOSIGNAL;
+				#endif
+				int32_t len = ::send(_connection.m_socket,
+				                     &data[_connection.m_sendPosition],
+				                     data.size() - _connection.m_sendPosition,
+				                     flags);
+				if (len < 0) {
+					if (isWouldBlock() == true) {
+						return;
+					}
+					fail(_connection, enet::HttpResponse::status::closed, etk::String("send() failed: ") + strerror(errno));
+					return;
+				}
+				_connection.m_sendPosition += len;
+			}
+			_connection.m_state = Connection::state::receiving;
+			return;
+		}
+		case Connection::state::receiving:
+			processReceive(_connection, _now);
+			return;
+		case Connection::state::idle:
+			// Data or close on an idle connection: it can not be reused
+			ENET_DEBUG("Idle connection closed by " << _connection.m_key);
+			closeConnection(_connection);
+			return;
+		case Connection::state::closed:
+			return;
+	}
+}
+
+void enet::httpAsync::Engine::threadCallback() {
+	ethread::setName("enet-http-async");
+	etk::Vector<PollFd> fds;
+	etk::Vector<ememory::SharedPtr<Connection>> polled;
+	while (true) {
+		{
+			ethread::UniqueLock lock(m_mutex);
+			if (m_threadRunning == false) {
+				break;
+			}
+		}
+		takeNewJob();
+		echrono::Steady now = echrono::Steady::now();
+		echrono::Steady nextEvent = dispatch(now);
+		fds.clear();
+		polled.clear();
+		#ifndef __TARGET_OS__Windows
+			PollFd wakeUpElement;
+			wakeUpElement.fd = m_wakeUp[0];
+			wakeUpElement.events = POLLIN;
+			wakeUpElement.revents = 0;
+			fds.pushBack(wakeUpElement);
+		#endif
+		for (auto &it : m_connection) {
+			PollFd element;
+			element.fd = it->m_socket;
+			element.events = POLLIN;
+			if (    it->m_state == Connection::state::connecting
+			     || it->m_state == Connection::state::sending) {
+				element.events = POLLOUT;
+			}
+			element.revents = 0;
+			fds.pushBack(element);
+			polled.pushBack(it);
+		}
+		int32_t timeOut = getPollTimeOut(nextEvent, now);
+		int32_t ret = 0;
+		if (fds.size() == 0) {
+			ethread::sleepMilliSeconds(timeOut);
+		} else {
+			#ifdef __TARGET_OS__Windows
+				ret = WSAPoll(&fds[0], fds.size(), timeOut);
+			#else
+				ret = ::poll(&fds[0], fds.size(), timeOut);
+			#endif
+		}
+		if (    ret < 0
+		     && isWouldBlock() == false) {
+			ENET_ERROR("poll() failed : errno=" << errno << "," << strerror(errno));
+			ethread::sleepMilliSeconds(1);
+			continue;
+		}
+		if (ret <= 0) {
+			continue;
+		}
+		size_t offset = 0;
+		#ifndef __TARGET_OS__Windows
+			offset = 1;
+			if (fds[0].revents != 0) {
+				char buffer[256];
+				while (::read(m_wakeUp[0], buffer, sizeof(buffer)) > 0) {
+					// empty the pipe
+				}
+			}
+		#endif
+		now = echrono::Steady::now();
+		for (size_t iii=0; iii<polled.size(); ++iii) {
+			if (fds[iii+offset].revents != 0) {
+				process(*polled[iii], now);
+			}
+		}
+	}
+	// End all the requests
+	takeNewJob();
+	for (auto &it : m_connection) {
+		fail(*it, enet::HttpResponse::status::closed, "engine stopped");
+	}
+	m_connection.clear();
+	for (auto &itHost : m_host) {
+		for (auto &it : itHost.second.m_queue) {
+			complete(it, enet::HttpResponse(enet::HttpResponse::status::closed, "engine stopped"));
+		}
+	}
+	m_host.clear();
+}
+
+void enet::httpAsync::setConnectTimeOut(echrono::Duration _value) {
+	ethread::UniqueLock lock(getEngine().m_mutex);
+	getEngine().m_connectTimeOut = _value;
+}
+
+void enet::httpAsync::setRequestTimeOut(echrono::Duration _value) {
+	ethread::UniqueLock lock(getEngine().m_mutex);
+	getEngine().m_requestTimeOut = _value;
+}
+
+void enet::httpAsync::setIdleTimeOut(echrono::Duration _value) {
+	ethread::UniqueLock lock(getEngine().m_mutex);
+	getEngine().m_idleTimeOut = _value;
+}
+
+void enet::httpAsync::setMaxConnectionPerHost(uint32_t _value) {
+	if (_value == 0) {
+		_value = 1;
+	}
+	ethread::UniqueLock lock(getEngine().m_mutex);
+	getEngine().m_maxConnectionPerHost = _value;
+}
+
+void enet::httpAsync::setMaxHeaderSize(uint32_t _value) {
+	ethread::UniqueLock lock(getEngine().m_mutex);
+	getEngine().m_maxHeaderSize = _value;
+}
+
+void enet::httpAsync::setMaxBodySize(uint64_t _value) {
+	ethread::UniqueLock lock(getEngine().m_mutex);
+	getEngine().m_maxBodySize = _value;
+}
+
+size_t enet::httpAsync::getNumberInProgress() {
+	ethread::UniqueLock lock(getEngine().m_mutex);
+	return getEngine().m_nbInProgress;
+}
+
+void enet::httpAsync::stop() {
+	getEngine().stopThread();
+}
+
+enet::HttpFuture enet::HttpClient::request(const enet::HttpRequest& _header, const etk::String& _body, echrono::Duration _timeOut) {
+	ememory::SharedPtr<enet::HttpFuture::State> state = ememory::makeShared<enet::HttpFuture::State>();
+	enet::HttpFuture out(state);
+	if (enet::isInit() == false) {
+		ENET_ERROR("Need call enet::init(...) before accessing to the socket");
+		state->set(enet::HttpResponse(enet::HttpResponse::status::connectionError, "enet not initialized"));
+		return out;
+	}
+	// "Host: name[:port]" (IPv6: "[::1]:port")
+	etk::String host = _header.getKey(enet::HTTPHeaderId::host);
+	etk::String hostname = host;
+	uint16_t port = 80;
+	size_t pos = host.rfind(':');
+	if (    pos != etk::String::npos
+	     && (    host.size() == 0
+	          || host[0] != '['
+	          || host.rfind(']') < pos)) {
+		hostname = host.extract(0, pos);
+		port = etk::string_to_uint16_t(host.extract(pos+1));
+	}
+	if (    hostname.size() >= 2
+	     && hostname[0] == '['
+	     && hostname[hostname.size()-1] == ']') {
+		hostname = hostname.extract(1, hostname.size()-1);
+	}
+	if (hostname == "") {
+		ENET_ERROR("Request without \"Host\" key");
+		state->set(enet::HttpResponse(enet::HttpResponse::status::connectionError, "no host"));
+		return out;
+	}
+	ememory::SharedPtr<enet::httpAsync::Job> job = ememory::makeShared<enet::httpAsync::Job>();
+	job->m_state = state;
+	job->m_key = hostname + ":" + etk::toString(port);
+	// The result is cached ==> no DNS round trip for the next requests
+	if (enet::resolver::resolve(hostname, port, job->m_address) == false) {
+		ENET_ERROR("ERROR, no such host : " << hostname);
+		state->set(enet::HttpResponse(enet::HttpResponse::status::connectionError, "no such host: " + hostname));
+		return out;
+	}
+	enet::HttpRequest header = _header;
+	if (header.getProtocol() < enet::HTTPProtocol::http_1_1) {
+		// persistent connection by default
+		header.setProtocol(enet::HTTPProtocol::http_1_1);
+	}
+	if (    _body.size() != 0
+	     || header.getType() == enet::HTTPReqType::HTTP_POST
+	     || header.getType() == enet::HTTPReqType::HTTP_PUT) {
+		header.setContentLength(_body.size());
+	}
+	header.generate(job->m_data);
+	if (_body.size() != 0) {
+		size_t size = job->m_data.size();
+		job->m_data.resize(size + _body.size());
+		memcpy(&job->m_data[size], _body.c_str(), _body.size());
+	}
+	job->m_isHead = header.getType() == enet::HTTPReqType::HTTP_HEAD;
+	// Only the idempotent requests are sent again (RFC 7230 6.3.1)
+	job->m_retry = header.getType() != enet::HTTPReqType::HTTP_POST;
+	{
+		ethread::UniqueLock lock(enet::httpAsync::getEngine().m_mutex);
+		if (_timeOut == echrono::Duration()) {
+			_timeOut = enet::httpAsync::getEngine().m_requestTimeOut;
+		}
+		job->m_maxHeaderSize = enet::httpAsync::getEngine().m_maxHeaderSize;
+		job->m_maxBodySize = enet::httpAsync::getEngine().m_maxBodySize;
+	}
+	job->m_deadline = echrono::Steady::now() + _timeOut;
+	enet::httpAsync::getEngine().add(job);
+	return out;
+}
@@ -0,0 +1,176 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <enet/Http.hpp>
+#include <etk/Vector.hpp>
+#include <etk/Function.hpp>
+#include <ememory/memory.hpp>
+#include <ethread/Mutex.hpp>
+#include <ethread/Semaphore.hpp>
+#include <echrono/Duration.hpp>
+
+namespace enet {
+	/**
+	 * @brief Result of a request sent with HttpClient::request(): answer header and full body.
+	 */
+	class HttpResponse {
+		public:
+			enum class status {
+				done, //!< The answer is received
+				connectionError, //!< The host can not be resolved or connected
+				timeOut, //!< The answer is not received before the time out
+				protocolError, //!< The answer is malformed
+				closed //!< The connection has been closed before the end of the answer (or the engine is stopped)
+			};
+		private:
+			enum status m_status; //!< Status of the request
+			etk::String m_error; //!< Description of the error
+			enet::HttpAnswer m_header; //!< Header of the answer
+			etk::Vector<uint8_t> m_body; //!< Body of the answer (decoded when it is chunked)
+		public:
+			HttpResponse(enum status _status=status::closed, const etk::String& _error="");
+			enum status getStatus() const {
+				return m_status;
+			}
+			/**
+			 * @brief Check if the answer has been received (whatever the code of the answer).
+			 * @return true if the status is done.
+			 */
+			bool isValid() const {
+				return m_status == status::done;
+			}
+			const etk::String& getError() const {
+				return m_error;
+			}
+			const enet::HttpAnswer& getHeader() const {
+				return m_header;
+			}
+			enet::HttpAnswer& getHeader() {
+				return m_header;
+			}
+			const etk::Vector<uint8_t>& getBody() const {
+				return m_body;
+			}
+			etk::Vector<uint8_t>& getBody() {
+				return m_body;
+			}
+			/**
+			 * @brief Get the body in a string.
+			 * @return New string with the body.
+			 */
+			etk::String getBodyString() const;
+			void setStatus(enum status _status, const etk::String& _error="") {
+				m_status = _status;
+				m_error = _error;
+			}
+	};
+	/**
+	 * @brief Future result of a request (it can be copied, all the copies share the same result).
+	 */
+	class HttpFuture {
+		public:
+			using Observer = etk::Function<void(const enet::HttpResponse&)>; //!< Function called when the answer is received
+			/**
+			 * @brief Shared state between the future and the I/O thread.
+			 */
+			class State {
+				public:
+					mutable ethread::Mutex m_mutex; //!< Protect the state
+					ethread::Semaphore m_semaphore; //!< Posted when the answer is ready
+					bool m_ready; //!< The answer is ready
+					enet::HttpResponse m_response; //!< Result of the request
+					Observer m_observer; //!< Function to call when the result is ready
+				public:
+					State();
+					/**
+					 * @brief Set the result and wake up the waiters (the observer is called in the caller thread).
+					 * @param[in] _response Result of the request.
+					 */
+					void set(enet::HttpResponse _response);
+			};
+		private:
+			ememory::SharedPtr<State> m_state; //!< Shared result
+		public:
+			HttpFuture();
+			HttpFuture(ememory::SharedPtr<State> _state);
+			/**
+			 * @brief Check if the future is attached to a request.
+			 * @return true if a request is attached.
+			 */
+			bool isValid() const {
+				return m_state != null;
+			}
+			/**
+			 * @brief Check if the result is available (never block).
+			 * @return true if get() will not block.
+			 */
+			bool isReady() const;
+			/**
+			 * @brief Wait the result.
+			 * @param[in] _timeOut Maximum time to wait.
+			 * @return true if the result is available.
+			 */
+			bool wait(echrono::Duration _timeOut) const;
+			/**
+			 * @brief Get the result (wait until it is available).
+			 * @return The result of the request.
+			 */
+			const enet::HttpResponse& get() const;
+			/**
+			 * @brief Set the function to call when the result is available (called immediately if it is already available).
+			 * @param[in] _func Function to call.
+			 * @note The function is called in the I/O thread shared by all the requests: it must not block.
+			 */
+			void andThen(Observer _func);
+	};
+	/**
+	 * @brief Configuration of the engine of HttpClient::request().
+	 * All the requests are processed by one I/O thread (started with the first request): the sockets are
+	 * non-blocking, the connections are kept open (keep-alive) and reused for the next requests on the same host.
+	 */
+	namespace httpAsync {
+		/**
+		 * @brief Set the maximum time to connect a host.
+		 * @param[in] _value Time out (default 10s).
+		 */
+		void setConnectTimeOut(echrono::Duration _value);
+		/**
+		 * @brief Set the default maximum time to get an answer (from the call of request(), connection include).
+		 * @param[in] _value Time out (default 30s).
+		 */
+		void setRequestTimeOut(echrono::Duration _value);
+		/**
+		 * @brief Set the time before closing an unused connection.
+		 * @param[in] _value Time out (default 60s).
+		 */
+		void setIdleTimeOut(echrono::Duration _value);
+		/**
+		 * @brief Set the maximum number of connection opened on one host (the other requests wait a free connection).
+		 * @param[in] _value Number of connection (default 64).
+		 */
+		void setMaxConnectionPerHost(uint32_t _value);
+		/**
+		 * @brief Set the maximum size of an answer header (a bigger header end the request with the status protocolError).
+		 * @param[in] _value Size in byte (default 64KB).
+		 */
+		void setMaxHeaderSize(uint32_t _value);
+		/**
+		 * @brief Set the maximum size of an answer body (a bigger body end the request with the status protocolError).
+		 * @param[in] _value Size in byte, after the decoding of a chunked body (default 64MB).
+		 */
+		void setMaxBodySize(uint64_t _value);
+		/**
+		 * @brief Get the number of request not finished.
+		 * @return Number of request.
+		 */
+		size_t getNumberInProgress();
+		/**
+		 * @brief Stop the I/O thread: the requests in progress end with the status closed and the connections are closed.
+		 */
+		void stop();
+	}
+}
@@ -0,0 +1,360 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/HttpCache.hpp>
+#include <enet/pourcentEncoding.hpp>
+#include <etk/stdTools.hpp>
+extern "C" {
+	#include <string.h>
+}
+
+namespace enet {
+	namespace httpCache {
+		static const size_t MAX_ELEMENT_RATIO = 8; //!< An answer can not use more than 1/8 of the cache
+		static char toLower(char _value) {
+			if (    _value >= 'A'
+			     && _value <= 'Z') {
+				return _value + ('a' - 'A');
+			}
+			return _value;
+		}
+		static etk::String toLower(const etk::String& _value) {
+			etk::String out = _value;
+			for (auto &it : out) {
+				it = toLower(it);
+			}
+			return out;
+		}
+		/**
+		 * @brief Get the elements of a list separated by ',' (trimmed and in lower case).
+		 */
+		static etk::Vector<etk::String> split(const etk::String& _value) {
+			etk::Vector<etk::String> out;
+			size_t pos = 0;
+			while (pos < _value.size()) {
+				size_t start = pos;
+				while (    pos < _value.size()
+				        && _value[pos] != ',') {
+					pos++;
+				}
+				size_t stop = pos;
+				while (    start < stop
+				        && (_value[start] == ' ' || _value[start] == '\t')) {
+					start++;
+				}
+				while (    stop > start
+				        && (_value[stop-1] == ' ' || _value[stop-1] == '\t')) {
+					stop--;
+				}
+				if (stop > start) {
+					out.pushBack(toLower(_value.extract(start, stop)));
+				}
+				pos++;
+			}
+			return out;
+		}
+		/**
+		 * @brief Find a directive of a "Cache-Control" key.
+		 * @param[in] _list Directives (see split()).
+		 * @param[in] _name Name of the directive (lower case).
+		 * @param[out] _value Value of the directive ("max-age=60") or -1 if it has no valid value.
+		 * @return true if the directive is present.
+		 */
+		static bool findDirective(const etk::Vector<etk::String>& _list, const char* _name, int64_t& _value) {
+			size_t size = strlen(_name);
+			for (auto &it : _list) {
+				if (    it.size() < size
+				     || strncmp(it.c_str(), _name, size) != 0) {
+					continue;
+				}
+				if (it.size() == size) {
+					_value = -1;
+					return true;
+				}
+				if (it[size] != '=') {
+					continue;
+				}
+				etk::String value = it.extract(size + 1);
+				if (    value.size() >= 2
+				     && value[0] == '"'
+				     && value[value.size()-1] == '"') {
+					value = value.extract(1, value.size() - 1);
+				}
+				_value = -1;
+				if (    value.size() == 0
+				     || value.size() > 12) {
+					return true;
+				}
+				int64_t number = 0;
+				for (auto &itChar : value) {
+					if (    itChar < '0'
+					     || itChar > '9') {
+						return true;
+					}
+					number = number * 10 + (itChar - '0');
+				}
+				_value = number;
+				return true;
+			}
+			return false;
+		}
+		static bool findDirective(const etk::Vector<etk::String>& _list, const char* _name) {
+			int64_t value;
+			return findDirective(_list, _name, value);
+		}
+	}
+}
+
+enet::HttpCache::HttpCache(size_t _maxSize, echrono::Duration _defaultTimeToLive) :
+  m_maxSize(_maxSize),
+  m_size(0),
+  m_defaultTimeToLive(_defaultTimeToLive),
+  m_counter(0),
+  m_nbHit(0),
+  m_nbMiss(0) {
+	
+}
+
+void enet::HttpCache::addVary(const etk::String& _name) {
+	etk::String name = enet::httpCache::toLower(_name);
+	ethread::UniqueLock lock(m_mutex);
+	for (auto &it : m_vary) {
+		if (it == name) {
+			return;
+		}
+	}
+	m_vary.pushBack(name);
+	// The keys change
+	m_list.clear();
+	m_size = 0;
+}
+
+void enet::HttpCache::setMaxSize(size_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_maxSize = _value;
+	if (m_size > m_maxSize) {
+		m_list.clear();
+		m_size = 0;
+	}
+}
+
+void enet::HttpCache::setDefaultTimeToLive(echrono::Duration _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_defaultTimeToLive = _value;
+}
+
+void enet::HttpCache::remove(const etk::String& _uri) {
+	ethread::UniqueLock lock(m_mutex);
+	etk::Vector<etk::String> listRemove;
+	for (auto &it : m_list) {
+		const etk::String& key = it.first;
+		if (    etk::start_with(key, _uri) == true
+		     && (    key.size() == _uri.size()
+		          || key[_uri.size()] == '?'
+		          || key[_uri.size()] == '\n')) {
+			listRemove.pushBack(key);
+		}
+	}
+	for (auto &it : listRemove) {
+		auto itList = m_list.find(it);
+		m_size -= itList->second.m_size;
+		m_list.erase(itList);
+	}
+}
+
+void enet::HttpCache::clear() {
+	ethread::UniqueLock lock(m_mutex);
+	m_list.clear();
+	m_size = 0;
+}
+
+size_t enet::HttpCache::getSize() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_size;
+}
+
+uint64_t enet::HttpCache::getNumberHit() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_nbHit;
+}
+
+uint64_t enet::HttpCache::getNumberMiss() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_nbMiss;
+}
+
+etk::String enet::HttpCache::getKey(const enet::HttpRequest& _request) const {
+	if (    _request.getType() != enet::HTTPReqType::HTTP_GET
+	     && _request.getType() != enet::HTTPReqType::HTTP_HEAD) {
+		return "";
+	}
+	// RFC 7234 3.2: the answers of an authenticated request are private
+	if (_request.existKey(enet::HTTPHeaderId::authorization) == true) {
+		return "";
+	}
+	if (    _request.existKey(enet::HTTPHeaderId::cacheControl) == true
+	     && enet::httpCache::findDirective(enet::httpCache::split(_request.getKey(enet::HTTPHeaderId::cacheControl)), "no-store") == true) {
+		return "";
+	}
+	// The answer of a HEAD request is the header of the GET one: same key
+	etk::String key = _request.getUri();
+	if (_request.getQuery().size() != 0) {
+		key += "?";
+		key += enet::pourcentUriEncode(_request.getQuery());
+	}
+	ethread::UniqueLock lock(m_mutex);
+	for (auto &it : m_vary) {
+		key += "\n";
+		key += _request.getKey(it);
+	}
+	return key;
+}
+
+ememory::SharedPtr<enet::HttpCannedAnswer> enet::HttpCache::get(const etk::String& _key, const enet::HttpRequest& _request) {
+	bool reload = false;
+	if (_request.existKey(enet::HTTPHeaderId::cacheControl) == true) {
+		// RFC 7234 5.2.1: the client want a new answer
+		etk::Vector<etk::String> list = enet::httpCache::split(_request.getKey(enet::HTTPHeaderId::cacheControl));
+		int64_t maxAge = -1;
+		reload =    enet::httpCache::findDirective(list, "no-cache") == true
+		         || (    enet::httpCache::findDirective(list, "max-age", maxAge) == true
+		              && maxAge == 0);
+	} else if (_request.isKeyEqual(enet::HTTPHeaderId::pragma, "no-cache") == true) {
+		reload = true;
+	}
+	echrono::Steady now = echrono::Steady::now();
+	ethread::UniqueLock lock(m_mutex);
+	auto it = m_list.find(_key);
+	if (    reload == true
+	     || it == m_list.end()) {
+		m_nbMiss++;
+		return null;
+	}
+	if (now >= it->second.m_expire) {
+		m_size -= it->second.m_size;
+		m_list.erase(it);
+		m_nbMiss++;
+		return null;
+	}
+	it->second.m_lastUse = ++m_counter;
+	m_nbHit++;
+	return it->second.m_answer;
+}
+
+bool enet::HttpCache::getTimeToLive(const enet::HttpAnswer& _answer, echrono::Duration _defaultTimeToLive, echrono::Duration& _timeToLive) {
+	// RFC 7231 6.1: codes that can be stored by default
+	switch (_answer.getErrorCode()) {
+		case enet::HTTPAnswerCode::c200_ok:
+		case enet::HTTPAnswerCode::c203_nonAuthoritativeInformation:
+		case enet::HTTPAnswerCode::c204_noContent:
+		case enet::HTTPAnswerCode::c300_multipleChoices:
+		case enet::HTTPAnswerCode::c301_movedPermanently:
+		case enet::HTTPAnswerCode::c404_notFound:
+		case enet::HTTPAnswerCode::c405_methodNotAllowed:
+		case enet::HTTPAnswerCode::c410_gone:
+		case enet::HTTPAnswerCode::c414_requestURITooLong:
+		case enet::HTTPAnswerCode::c501_notImplemented:
+			break;
+		default:
+			return false;
+	}
+	if (_answer.existKey(enet::HTTPHeaderId::setCookie) == true) {
+		return false;
+	}
+	etk::Vector<etk::String> list = enet::httpCache::split(_answer.getKey(enet::HTTPHeaderId::cacheControl));
+	if (    enet::httpCache::findDirective(list, "no-store") == true
+	     || enet::httpCache::findDirective(list, "private") == true
+	     || enet::httpCache::findDirective(list, "no-cache") == true) {
+		return false;
+	}
+	int64_t maxAge = -1;
+	// RFC 7234 5.2.2.9: "s-maxage" is for the shared caches (as this one)
+	if (    enet::httpCache::findDirective(list, "s-maxage", maxAge) == true
+	     || enet::httpCache::findDirective(list, "max-age", maxAge) == true) {
+		if (maxAge <= 0) {
+			return false;
+		}
+		_timeToLive = echrono::seconds(maxAge);
+		return true;
+	}
+	if (_defaultTimeToLive.get() <= 0) {
+		return false;
+	}
+	_timeToLive = _defaultTimeToLive;
+	return true;
+}
+
+bool enet::HttpCache::store(const etk::String& _key, const enet::HttpAnswer& _answer, const void* _data, int32_t _len) {
+	if (_key.size() == 0) {
+		return false;
+	}
+	echrono::Duration timeToLive;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		if (getTimeToLive(_answer, m_defaultTimeToLive, timeToLive) == false) {
+			return false;
+		}
+		// The answer must be the same for all the requests with the same key
+		etk::Vector<etk::String> vary = enet::httpCache::split(_answer.getKey(enet::HTTPHeaderId::vary));
+		for (auto &it : vary) {
+			bool find = false;
+			for (auto &itVary : m_vary) {
+				if (it == itVary) {
+					find = true;
+					break;
+				}
+			}
+			if (find == false) {
+				ENET_VERBOSE("Answer not stored: 'Vary: " << it << "' is not in the key of the cache");
+				return false;
+			}
+		}
+		if (_len > int32_t(m_maxSize / enet::httpCache::MAX_ELEMENT_RATIO)) {
+			return false;
+		}
+	}
+	enet::HttpAnswer answer = _answer;
+	// The "Connection" of the answer is set for each request
+	answer.rmKey(enet::HTTPHeaderId::connection);
+	etk::String body;
+	if (    _data != null
+	     && _len > 0) {
+		body = etk::String((const char*)_data, _len);
+	}
+	Element element;
+	element.m_answer = ememory::makeShared<enet::HttpCannedAnswer>(answer, body);
+	if (element.m_answer == null) {
+		return false;
+	}
+	element.m_size = _key.size() + element.m_answer->getHead().size() + element.m_answer->getBody().size() + sizeof(Element);
+	element.m_expire = echrono::Steady::now() + timeToLive;
+	ethread::UniqueLock lock(m_mutex);
+	auto it = m_list.find(_key);
+	if (it != m_list.end()) {
+		m_size -= it->second.m_size;
+		m_list.erase(it);
+	}
+	if (element.m_size > m_maxSize / enet::httpCache::MAX_ELEMENT_RATIO) {
+		return false;
+	}
+	// Remove the least recently used answers
+	while (    m_list.size() > 0
+	        && m_size + element.m_size > m_maxSize) {
+		auto oldest = m_list.begin();
+		for (auto itList = m_list.begin(); itList != m_list.end(); ++itList) {
+			if (itList->second.m_lastUse < oldest->second.m_lastUse) {
+				oldest = itList;
+			}
+		}
+		m_size -= oldest->second.m_size;
+		m_list.erase(oldest);
+	}
+	element.m_lastUse = ++m_counter;
+	m_size += element.m_size;
+	m_list.add(_key, element);
+	return true;
+}
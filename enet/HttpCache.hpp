@@ -0,0 +1,125 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <enet/Http.hpp>
+#include <enet/HttpCanned.hpp>
+#include <etk/Map.hpp>
+#include <etk/Vector.hpp>
+#include <etk/String.hpp>
+#include <ememory/memory.hpp>
+#include <ethread/Mutex.hpp>
+#include <echrono/Steady.hpp>
+#include <echrono/Duration.hpp>
+
+namespace enet {
+	/**
+	 * @brief Cache of the answers of a HttpServer (can be shared between all the connections, see HttpServer::setCache()).
+	 * The answers of the GET requests sent with a full body are stored encoded (HttpCannedAnswer): the next same
+	 * requests are answered from the memory without calling the request observer.
+	 * The key is the URI, the query and the value of the request keys set with addVary().
+	 * An answer is stored only if it allows it ("Cache-Control": no "no-store", "private" or "no-cache", no
+	 * "Set-Cookie", a "Vary" with only the keys of addVary()) during "s-maxage", "max-age" or the default time to live.
+	 */
+	class HttpCache {
+		private:
+			class Element {
+				public:
+					ememory::SharedPtr<enet::HttpCannedAnswer> m_answer; //!< Encoded answer
+					echrono::Steady m_expire; //!< Time when the answer is not valid anymore
+					size_t m_size; //!< Memory used by the element
+					uint64_t m_lastUse; //!< Counter of the last use (LRU)
+			};
+			mutable ethread::Mutex m_mutex; //!< Protect the cache
+			etk::Map<etk::String, Element> m_list; //!< Stored answers
+			etk::Vector<etk::String> m_vary; //!< Name of the request keys in the key of the cache (lower case)
+			size_t m_maxSize; //!< Maximum memory used by the answers
+			size_t m_size; //!< Memory used by the answers
+			echrono::Duration m_defaultTimeToLive; //!< Time to live of an answer without "max-age"
+			uint64_t m_counter; //!< Use counter
+			uint64_t m_nbHit; //!< Number of request answered by the cache
+			uint64_t m_nbMiss; //!< Number of request not found in the cache
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _maxSize Maximum memory used by the answers (byte).
+			 * @param[in] _defaultTimeToLive Time to live of the answers without "max-age" (0: only the answers with a "max-age" are stored).
+			 */
+			HttpCache(size_t _maxSize=16*1024*1024, echrono::Duration _defaultTimeToLive=echrono::Duration());
+			virtual ~HttpCache() = default;
+		public:
+			/**
+			 * @brief Add a request key in the key of the cache (an answer is stored for each value, ex: "Accept-Encoding").
+			 * @param[in] _name Name of the key (not case sensitive).
+			 */
+			void addVary(const etk::String& _name);
+			/**
+			 * @brief Set the maximum memory used by the answers (the least recently used answers are removed).
+			 * @param[in] _value Size in byte.
+			 */
+			void setMaxSize(size_t _value);
+			/**
+			 * @brief Set the time to live of the answers without "max-age".
+			 * @param[in] _value Time (0: only the answers with a "max-age" are stored).
+			 */
+			void setDefaultTimeToLive(echrono::Duration _value);
+			/**
+			 * @brief Remove all the answers of an URI (whatever the query and the vary keys).
+			 * @param[in] _uri URI of the answers.
+			 */
+			void remove(const etk::String& _uri);
+			/**
+			 * @brief Remove all the answers.
+			 */
+			void clear();
+			/**
+			 * @brief Get the memory used by the answers.
+			 * @return Size in byte.
+			 */
+			size_t getSize() const;
+			/**
+			 * @brief Get the number of request answered by the cache.
+			 * @return Number of hit.
+			 */
+			uint64_t getNumberHit() const;
+			/**
+			 * @brief Get the number of request not found in the cache.
+			 * @return Number of miss.
+			 */
+			uint64_t getNumberMiss() const;
+		public:
+			/**
+			 * @brief Get the key of a request.
+			 * @param[in] _request Request header.
+			 * @return The key or "" if the request can not use the cache (not a GET/HEAD, "no-store", "Authorization").
+			 */
+			etk::String getKey(const enet::HttpRequest& _request) const;
+			/**
+			 * @brief Get a stored answer.
+			 * @param[in] _key Key of the request (see getKey()).
+			 * @param[in] _request Request header ("Cache-Control: no-cache" or "max-age=0" need a new answer).
+			 * @return The answer or null if it is not stored (or expired).
+			 */
+			ememory::SharedPtr<enet::HttpCannedAnswer> get(const etk::String& _key, const enet::HttpRequest& _request);
+			/**
+			 * @brief Store an answer (if it allows it).
+			 * @param[in] _key Key of the request (see getKey()).
+			 * @param[in] _answer Answer header.
+			 * @param[in] _data Body of the answer.
+			 * @param[in] _len Number of byte of the body.
+			 * @return true if the answer is stored.
+			 */
+			bool store(const etk::String& _key, const enet::HttpAnswer& _answer, const void* _data, int32_t _len);
+			/**
+			 * @brief Get the time to live of an answer (RFC 7234 3 and 4.2.1).
+			 * @param[in] _answer Answer header.
+			 * @param[in] _defaultTimeToLive Time to live of the answers without "max-age".
+			 * @param[out] _timeToLive Time to live of the answer.
+			 * @return true if the answer can be stored.
+			 */
+			static bool getTimeToLive(const enet::HttpAnswer& _answer, echrono::Duration _defaultTimeToLive, echrono::Duration& _timeToLive);
+	};
+}
@@ -0,0 +1,310 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/HttpCanned.hpp>
+#include <etk/Map.hpp>
+#include <ethread/Mutex.hpp>
+#include <ethread/Thread.hpp>
+#include <ethread/tools.hpp>
+extern "C" {
+	#include <stdio.h>
+	#include <string.h>
+	#include <time.h>
+}
+
+namespace enet {
+	namespace httpDate {
+		static const char* dayName[] = {"Sun", "Mon", "Tue", "Wed", "Thu", "Fri", "Sat"};
+		static const char* monthName[] = {"Jan", "Feb", "Mar", "Apr", "May", "Jun", "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"};
+		/**
+		 * @brief Format a date in a buffer (not localized: strftime can not be used).
+		 * @return Number of byte written.
+		 */
+		static size_t formatDate(time_t _time, char* _buffer, size_t _size) {
+			struct tm date;
+			#ifdef __TARGET_OS__Windows
+				gmtime_s(&date, &_time);
+			#else
+				gmtime_r(&_time, &date);
+			#endif
+			// IMF-fixdate (RFC 7231 7.1.1.1): "Sun, 06 Nov 1994 08:49:37 GMT"
+			return snprintf(_buffer, _size, "%s, %02d %s %04d %02d:%02d:%02d GMT",
+			                dayName[date.tm_wday % 7], date.tm_mday, monthName[date.tm_mon % 12],
+			                date.tm_year + 1900, date.tm_hour, date.tm_min, date.tm_sec);
+		}
+		class Cache {
+			public:
+				ethread::Mutex m_mutex;
+				time_t m_second; //!< Second of the formatted date
+				char m_date[32]; //!< Value of the "Date" key
+				size_t m_dateSize;
+				etk::String m_serverName; //!< Value of the "Server" key
+				char m_lines[MAX_SIZE]; //!< "Date" and "Server" lines
+				size_t m_linesSize;
+				ethread::Thread* m_thread; //!< Refresh thread (protected by m_mutex)
+				bool m_threadRunning; //!< Refresh thread is running (protected by m_mutex)
+			public:
+				Cache() :
+				  m_second(0),
+				  m_dateSize(0),
+				  m_serverName("e-net (ewol network interface)"),
+				  m_linesSize(0),
+				  m_thread(null),
+				  m_threadRunning(false) {
+					
+				}
+				~Cache() {
+					stopThread();
+				}
+				void stopThread() {
+					ethread::Thread* thread = null;
+					{
+						ethread::UniqueLock lock(m_mutex);
+						m_threadRunning = false;
+						thread = m_thread;
+					}
+					if (thread == null) {
+						return;
+					}
+					thread->join();
+					ETK_DELETE(ethread::Thread, thread);
+					ethread::UniqueLock lock(m_mutex);
+					m_thread = null;
+				}
+				/**
+				 * @brief Format the date if the second changed (the mutex must be locked).
+				 * @param[in] _force Format even if the second is the same.
+				 */
+				void update(bool _force) {
+					time_t now = time(null);
+					if (    _force == false
+					     && now == m_second) {
+						return;
+					}
+					m_second = now;
+					m_dateSize = formatDate(now, m_date, sizeof(m_date));
+					m_linesSize = 0;
+					append("Date: ", 6);
+					append(m_date, m_dateSize);
+					append("\r\n", 2);
+					if (m_serverName.size() != 0) {
+						append("Server: ", 8);
+						append(m_serverName.c_str(), m_serverName.size());
+						append("\r\n", 2);
+					}
+				}
+				void threadCallback();
+			private:
+				void append(const char* _data, size_t _size) {
+					_size = etk::min(_size, MAX_SIZE - m_linesSize);
+					memcpy(&m_lines[m_linesSize], _data, _size);
+					m_linesSize += _size;
+				}
+		};
+		static Cache& getCache() {
+			static Cache cache;
+			return cache;
+		}
+	}
+}
+
+void enet::httpDate::Cache::threadCallback() {
+	ethread::setName("enet-http-date");
+	while (true) {
+		{
+			ethread::UniqueLock lock(m_mutex);
+			if (m_threadRunning == false) {
+				return;
+			}
+			update(false);
+		}
+		ethread::sleepMilliSeconds(100);
+	}
+}
+
+size_t enet::httpDate::getLines(char* _buffer) {
+	Cache& cache = getCache();
+	ethread::UniqueLock lock(cache.m_mutex);
+	if (cache.m_threadRunning == false) {
+		cache.update(false);
+	}
+	memcpy(_buffer, cache.m_lines, cache.m_linesSize);
+	return cache.m_linesSize;
+}
+
+void enet::httpDate::setKeys(enet::HttpHeader& _header) {
+	Cache& cache = getCache();
+	ethread::UniqueLock lock(cache.m_mutex);
+	if (cache.m_threadRunning == false) {
+		cache.update(false);
+	}
+	if (_header.existKey(enet::HTTPHeaderId::date) == false) {
+		_header.setKey(enet::HTTPHeaderId::date, cache.m_date, cache.m_dateSize);
+	}
+	if (    cache.m_serverName.size() != 0
+	     && _header.existKey(enet::HTTPHeaderId::server) == false) {
+		_header.setKey(enet::HTTPHeaderId::server, cache.m_serverName.c_str(), cache.m_serverName.size());
+	}
+}
+
+void enet::httpDate::setServerName(const etk::String& _name) {
+	Cache& cache = getCache();
+	ethread::UniqueLock lock(cache.m_mutex);
+	cache.m_serverName = _name;
+	cache.update(true);
+}
+
+void enet::httpDate::setBackgroundRefresh(bool _enable) {
+	Cache& cache = getCache();
+	if (_enable == false) {
+		cache.stopThread();
+		return;
+	}
+	ethread::UniqueLock lock(cache.m_mutex);
+	if (cache.m_thread != null) {
+		return;
+	}
+	cache.update(true);
+	cache.m_threadRunning = true;
+	cache.m_thread = ETK_NEW(ethread::Thread, [&](){ cache.threadCallback();});
+	if (cache.m_thread == null) {
+		cache.m_threadRunning = false;
+		ENET_ERROR("creating HTTP date refresh thread!");
+	}
+}
+
+etk::String enet::httpDate::format(int64_t _time) {
+	char date[32];
+	size_t size = formatDate(time_t(_time), date, sizeof(date));
+	return etk::String(date, size);
+}
+
+bool enet::httpDate::parse(const etk::String& _value, int64_t& _time) {
+	int32_t day = 0;
+	char month[4] = {0};
+	int32_t year = 0;
+	int32_t hour = 0;
+	int32_t minute = 0;
+	int32_t second = 0;
+	const char* value = _value.c_str();
+	const char* separator = strchr(value, ',');
+	if (separator != null) {
+		if (sscanf(separator, ", %2d %3s %4d %2d:%2d:%2d GMT", &day, month, &year, &hour, &minute, &second) != 6) {
+			// RFC 850: "Sunday, 06-Nov-94 08:49:37 GMT"
+			if (sscanf(separator, ", %2d-%3s-%2d %2d:%2d:%2d GMT", &day, month, &year, &hour, &minute, &second) != 6) {
+				return false;
+			}
+			// RFC 7231 7.1.1.1: a 2 digit year more than 50 years in the future is in the past
+			year += year < 70 ? 2000 : 1900;
+		}
+	} else {
+		// asctime: "Sun Nov  6 08:49:37 1994"
+		char dayOfWeek[4];
+		if (sscanf(value, "%3s %3s %2d %2d:%2d:%2d %4d", dayOfWeek, month, &day, &hour, &minute, &second, &year) != 7) {
+			return false;
+		}
+	}
+	int32_t monthId = -1;
+	for (int32_t iii=0; iii<12; ++iii) {
+		if (strcmp(month, enet::httpDate::monthName[iii]) == 0) {
+			monthId = iii;
+			break;
+		}
+	}
+	if (    monthId < 0
+	     || day < 1
+	     || day > 31
+	     || hour > 23
+	     || minute > 59
+	     || second > 60
+	     || year < 1970) {
+		return false;
+	}
+	// Number of days since the 1st January 1970 (civil calendar, no time zone: timegm is not portable)
+	int64_t yearShift = monthId < 2 ? year - 1 : year;
+	int64_t era = yearShift / 400;
+	int64_t yearOfEra = yearShift - era * 400;
+	int64_t dayOfYear = (153 * (monthId < 2 ? monthId + 10 : monthId - 2) + 2) / 5 + day - 1;
+	int64_t dayOfEra = yearOfEra * 365 + yearOfEra / 4 - yearOfEra / 100 + dayOfYear;
+	int64_t days = era * 146097 + dayOfEra - 719468;
+	_time = days * 86400 + hour * 3600 + minute * 60 + second;
+	return true;
+}
+
+enet::HttpCannedAnswer::HttpCannedAnswer(const enet::HttpAnswer& _answer, const etk::String& _body) :
+  m_code(_answer.getErrorCode()),
+  m_protocol(_answer.getProtocol()),
+  m_close(_answer.isKeyEqual(enet::HTTPHeaderId::connection, "close")),
+  m_hasBody(    int32_t(_answer.getErrorCode()) >= 200
+             && _answer.getErrorCode() != enet::HTTPAnswerCode::c204_noContent
+             && _answer.getErrorCode() != enet::HTTPAnswerCode::c304_notModified) {
+	enet::HttpAnswer answer = _answer;
+	// Added for each connection when the answer is sent
+	answer.rmKey(enet::HTTPHeaderId::connection);
+	answer.rmKey(enet::HTTPHeaderId::date);
+	answer.rmKey(enet::HTTPHeaderId::server);
+	if (m_hasBody == true) {
+		answer.setContentLength(_body.size());
+	}
+	answer.generate(m_head);
+	// remove the end of the header: the connection keys are added after
+	m_head.resize(m_head.size() - 2);
+	m_body.pushBack('\r');
+	m_body.pushBack('\n');
+	if (    m_hasBody == true
+	     && _body.size() != 0) {
+		m_body.resize(2 + _body.size());
+		memcpy(&m_body[2], _body.c_str(), _body.size());
+	}
+}
+
+namespace enet {
+	namespace httpCanned {
+		class Registry {
+			public:
+				ethread::Mutex m_mutex;
+				etk::Map<etk::String, ememory::SharedPtr<enet::HttpCannedAnswer>> m_listName; //!< Named answers
+				etk::Map<int32_t, ememory::SharedPtr<enet::HttpCannedAnswer>> m_listCode; //!< Default answer of the codes
+		};
+		static Registry& getRegistry() {
+			static Registry registry;
+			return registry;
+		}
+	}
+}
+
+ememory::SharedPtr<enet::HttpCannedAnswer> enet::httpCanned::add(const etk::String& _name, const enet::HttpAnswer& _answer, const etk::String& _body) {
+	ememory::SharedPtr<enet::HttpCannedAnswer> answer = ememory::makeShared<enet::HttpCannedAnswer>(_answer, _body);
+	Registry& registry = getRegistry();
+	ethread::UniqueLock lock(registry.m_mutex);
+	registry.m_listName.add(_name, answer);
+	return answer;
+}
+
+ememory::SharedPtr<enet::HttpCannedAnswer> enet::httpCanned::get(const etk::String& _name) {
+	Registry& registry = getRegistry();
+	ethread::UniqueLock lock(registry.m_mutex);
+	auto it = registry.m_listName.find(_name);
+	if (it == registry.m_listName.end()) {
+		return null;
+	}
+	return it->second;
+}
+
+ememory::SharedPtr<enet::HttpCannedAnswer> enet::httpCanned::get(enum enet::HTTPAnswerCode _code) {
+	Registry& registry = getRegistry();
+	ethread::UniqueLock lock(registry.m_mutex);
+	auto it = registry.m_listCode.find(int32_t(_code));
+	if (it != registry.m_listCode.end()) {
+		return it->second;
+	}
+	enet::HttpAnswer answer(_code);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	ememory::SharedPtr<enet::HttpCannedAnswer> out = ememory::makeShared<enet::HttpCannedAnswer>(answer);
+	registry.m_listCode.add(int32_t(_code), out);
+	return out;
+}
@@ -0,0 +1,117 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <enet/Http.hpp>
+#include <ememory/memory.hpp>
+
+namespace enet {
+	/**
+	 * @brief Cache of the "Date" and "Server" keys added in the answers of the servers.
+	 * The keys are formatted one time per second: by a background thread when it is enabled, otherwise by the
+	 * first answer of each second.
+	 */
+	namespace httpDate {
+		static const size_t MAX_SIZE = 256; //!< Maximum size of the cached lines
+		/**
+		 * @brief Copy the "Date: ...\r\n" and "Server: ...\r\n" lines of the current second.
+		 * @param[out] _buffer Output buffer (at least MAX_SIZE bytes).
+		 * @return Number of byte written.
+		 */
+		size_t getLines(char* _buffer);
+		/**
+		 * @brief Set the "Date" and "Server" keys in a header (if they are not already set).
+		 * @param[in,out] _header Header to update.
+		 */
+		void setKeys(enet::HttpHeader& _header);
+		/**
+		 * @brief Set the value of the "Server" key.
+		 * @param[in] _name Name of the server ("" to not send the key).
+		 */
+		void setServerName(const etk::String& _name);
+		/**
+		 * @brief Enable or disable the refresh of the date by a background thread (one time per second).
+		 * @param[in] _enable true to start the thread.
+		 */
+		void setBackgroundRefresh(bool _enable);
+		/**
+		 * @brief Format a date (IMF-fixdate, RFC 7231 7.1.1.1).
+		 * @param[in] _time Number of second since the 1st January 1970 (UTC).
+		 * @return The date: "Sun, 06 Nov 1994 08:49:37 GMT".
+		 */
+		etk::String format(int64_t _time);
+		/**
+		 * @brief Parse a date (IMF-fixdate and the obsolete RFC 850 and asctime formats).
+		 * @param[in] _value Date.
+		 * @param[out] _time Number of second since the 1st January 1970 (UTC).
+		 * @return true if the date is valid.
+		 */
+		bool parse(const etk::String& _value, int64_t& _time);
+	}
+	/**
+	 * @brief Answer encoded one time (first line, keys and body), sent from its static buffers without any formatting.
+	 * The "Date", "Server" and "Connection" keys are not in the encoded answer: they are added when it is sent.
+	 */
+	class HttpCannedAnswer {
+		private:
+			enum enet::HTTPAnswerCode m_code; //!< Code of the answer
+			enum enet::HTTPProtocol m_protocol; //!< Protocol of the answer
+			etk::Vector<char> m_head; //!< First line and keys
+			etk::Vector<char> m_body; //!< End of the header (empty line) and body
+			bool m_close; //!< The answer close the connection
+			bool m_hasBody; //!< The answer can have a body (not for 1xx, 204 and 304)
+		public:
+			/**
+			 * @brief Encode an answer.
+			 * @param[in] _answer Header of the answer (the "Content-Length" is set with the size of the body).
+			 * @param[in] _body Body of the answer.
+			 */
+			HttpCannedAnswer(const enet::HttpAnswer& _answer, const etk::String& _body="");
+			enum enet::HTTPAnswerCode getCode() const {
+				return m_code;
+			}
+			enum enet::HTTPProtocol getProtocol() const {
+				return m_protocol;
+			}
+			const etk::Vector<char>& getHead() const {
+				return m_head;
+			}
+			const etk::Vector<char>& getBody() const {
+				return m_body;
+			}
+			bool isClose() const {
+				return m_close;
+			}
+			bool hasBody() const {
+				return m_hasBody;
+			}
+	};
+	/**
+	 * @brief Registry of the canned answers (thread-safe), shared by all the servers.
+	 */
+	namespace httpCanned {
+		/**
+		 * @brief Add (or replace) a named answer.
+		 * @param[in] _name Name of the answer.
+		 * @param[in] _answer Header of the answer.
+		 * @param[in] _body Body of the answer.
+		 * @return The encoded answer.
+		 */
+		ememory::SharedPtr<enet::HttpCannedAnswer> add(const etk::String& _name, const enet::HttpAnswer& _answer, const etk::String& _body="");
+		/**
+		 * @brief Get a named answer (get it one time and keep it: the search is not free).
+		 * @param[in] _name Name of the answer.
+		 * @return The encoded answer or null if not registered.
+		 */
+		ememory::SharedPtr<enet::HttpCannedAnswer> get(const etk::String& _name);
+		/**
+		 * @brief Get the default answer of a code (HTTP/1.1, no body), encoded on the first call.
+		 * @param[in] _code Code of the answer.
+		 * @return The encoded answer.
+		 */
+		ememory::SharedPtr<enet::HttpCannedAnswer> get(enum enet::HTTPAnswerCode _code);
+	}
+}
@@ -0,0 +1,199 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/HttpChunk.hpp>
+extern "C" {
+	#include <string.h>
+}
+
+namespace enet {
+	namespace httpChunk {
+		static const uint32_t MAX_DIGIT = 15; //!< Maximum number of hexadecimal digit of a chunk size (no overflow on 64 bits)
+		static int32_t hexaValue(uint8_t _value) {
+			if (    _value >= '0'
+			     && _value <= '9') {
+				return _value - '0';
+			}
+			if (    _value >= 'a'
+			     && _value <= 'f') {
+				return _value - 'a' + 10;
+			}
+			if (    _value >= 'A'
+			     && _value <= 'F') {
+				return _value - 'A' + 10;
+			}
+			return -1;
+		}
+	}
+}
+
+enet::HttpChunkDecoder::HttpChunkDecoder() {
+	reset();
+}
+
+void enet::HttpChunkDecoder::reset() {
+	m_state = state::size;
+	m_chunkSize = 0;
+	m_nbDigit = 0;
+}
+
+enum enet::HttpChunkDecoder::status enet::HttpChunkDecoder::decode(uint8_t* _data, size_t _size, size_t& _consumed, size_t& _bodySize) {
+	size_t pos = 0;
+	_bodySize = 0;
+	while (    pos < _size
+	        && m_state != state::done
+	        && m_state != state::error) {
+		uint8_t value = _data[pos];
+		switch (m_state) {
+			case state::size: {
+				int32_t digit = enet::httpChunk::hexaValue(value);
+				if (digit >= 0) {
+					if (m_nbDigit >= enet::httpChunk::MAX_DIGIT) {
+						ENET_ERROR("Chunk size too big");
+						m_state = state::error;
+						break;
+					}
+					m_chunkSize = (m_chunkSize << 4) + digit;
+					m_nbDigit++;
+					pos++;
+					break;
+				}
+				if (m_nbDigit == 0) {
+					ENET_ERROR("Chunk without size");
+					m_state = state::error;
+					break;
+				}
+				if (    value == ';'
+				     || value == ' '
+				     || value == '\t') {
+					// chunk extension: ignored
+					m_state = state::extension;
+					pos++;
+					break;
+				}
+				if (value == '\r') {
+					m_state = state::sizeEnd;
+					pos++;
+					break;
+				}
+				if (value == '\n') {
+					pos++;
+					m_state = m_chunkSize == 0 ? state::trailer : state::data;
+					break;
+				}
+				ENET_ERROR("Wrong character in the chunk size: " << int32_t(value));
+				m_state = state::error;
+				break;
+			}
+			case state::extension:
+				if (value == '\r') {
+					m_state = state::sizeEnd;
+				} else if (value == '\n') {
+					m_state = m_chunkSize == 0 ? state::trailer : state::data;
+				}
+				pos++;
+				break;
+			case state::sizeEnd:
+				if (value != '\n') {
+					m_state = state::error;
+					break;
+				}
+				pos++;
+				m_state = m_chunkSize == 0 ? state::trailer : state::data;
+				break;
+			case state::data: {
+				size_t size = _size - pos;
+				if (size > m_chunkSize) {
+					size = m_chunkSize;
+				}
+				// The output is always before the input: move the data in the same buffer
+				if (_bodySize != pos) {
+					memmove(&_data[_bodySize], &_data[pos], size);
+				}
+				_bodySize += size;
+				pos += size;
+				m_chunkSize -= size;
+				if (m_chunkSize == 0) {
+					m_state = state::dataEnd;
+				}
+				break;
+			}
+			case state::dataEnd:
+				if (value == '\r') {
+					m_state = state::dataEndLF;
+					pos++;
+					break;
+				}
+				// accept a bare LF
+				m_state = state::dataEndLF;
+				break;
+			case state::dataEndLF:
+				if (value != '\n') {
+					ENET_ERROR("Missing end of line after a chunk");
+					m_state = state::error;
+					break;
+				}
+				pos++;
+				m_nbDigit = 0;
+				m_state = state::size;
+				break;
+			case state::trailer:
+				// Start of a line of the trailer: an empty line is the end of the body
+				if (value == '\r') {
+					m_state = state::trailerEnd;
+				} else if (value == '\n') {
+					m_state = state::done;
+				} else {
+					m_state = state::trailerLine;
+				}
+				pos++;
+				break;
+			case state::trailerLine:
+				// The trailer fields are ignored
+				if (value == '\n') {
+					m_state = state::trailer;
+				}
+				pos++;
+				break;
+			case state::trailerEnd:
+				if (value != '\n') {
+					m_state = state::error;
+					break;
+				}
+				pos++;
+				m_state = state::done;
+				break;
+			case state::done:
+			case state::error:
+				break;
+		}
+	}
+	_consumed = pos;
+	if (m_state == state::done) {
+		return status::done;
+	}
+	if (m_state == state::error) {
+		return status::error;
+	}
+	return status::incomplete;
+}
+
+size_t enet::generateChunkHeader(char* _buffer, uint64_t _size) {
+	static const char* hexData = "0123456789abcdef";
+	char tmp[16];
+	size_t nbDigit = 0;
+	do {
+		tmp[nbDigit++] = hexData[_size & 0x0F];
+		_size >>= 4;
+	} while (_size != 0);
+	for (size_t iii=0; iii<nbDigit; ++iii) {
+		_buffer[iii] = tmp[nbDigit - 1 - iii];
+	}
+	_buffer[nbDigit] = '\r';
+	_buffer[nbDigit + 1] = '\n';
+	return nbDigit + 2;
+}
@@ -0,0 +1,63 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/types.hpp>
+
+namespace enet {
+	/**
+	 * @brief Incremental decoder of a body with "Transfer-Encoding: chunked" (RFC 7230 4.1).
+	 * The data are decoded in place: the body data are moved at the start of the buffer given, so a body of
+	 * any size is decoded with the reception buffer only.
+	 */
+	class HttpChunkDecoder {
+		public:
+			enum class status {
+				incomplete, //!< Need more data
+				done, //!< The last chunk and the trailer are received
+				error //!< Malformed chunk
+			};
+		private:
+			enum class state {
+				size,
+				extension,
+				sizeEnd,
+				data,
+				dataEnd,
+				dataEndLF,
+				trailer,
+				trailerLine,
+				trailerEnd,
+				done,
+				error
+			};
+			enum state m_state; //!< Current state of the decoder
+			uint64_t m_chunkSize; //!< Number of byte of the current chunk still to read
+			uint32_t m_nbDigit; //!< Number of digit of the size of the chunk
+		public:
+			HttpChunkDecoder();
+			/**
+			 * @brief Reset the decoder for a new body.
+			 */
+			void reset();
+			/**
+			 * @brief Decode data (the data of the body are written at the start of the buffer).
+			 * @param[in,out] _data Received data, body data in output.
+			 * @param[in] _size Number of byte received.
+			 * @param[out] _consumed Number of byte used (the data after are not part of the body when the status is done).
+			 * @param[out] _bodySize Number of byte of body data written at the start of _data.
+			 * @return Status of the decoding.
+			 */
+			enum status decode(uint8_t* _data, size_t _size, size_t& _consumed, size_t& _bodySize);
+	};
+	/**
+	 * @brief Create the start of a chunk: "<size in hexadecimal>\r\n".
+	 * @param[out] _buffer Output buffer (at least 19 bytes).
+	 * @param[in] _size Number of byte of the chunk.
+	 * @return Number of byte written in the buffer.
+	 */
+	size_t generateChunkHeader(char* _buffer, uint64_t _size);
+}
@@ -0,0 +1,593 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/HttpCompression.hpp>
+#include <zlib.h>
+extern "C" {
+	#include <string.h>
+}
+
+namespace enet {
+	namespace httpCompression {
+		static const size_t OUTPUT_STEP = 16384; //!< Size added to the output buffer when zlib need more space
+		static const size_t MAX_SEEN = 1024; //!< Maximum number of body sent one time remembered for the cache
+		static const size_t MAX_CACHE_ELEMENT_RATIO = 8; //!< A body bigger than 1/8 of the cache is not cached
+		static inline char toLower(char _value) {
+			if (    _value >= 'A'
+			     && _value <= 'Z') {
+				return _value + ('a' - 'A');
+			}
+			return _value;
+		}
+		static inline bool isSpace(char _value) {
+			return    _value == ' '
+			       || _value == '\t';
+		}
+		/**
+		 * @brief Compare a part of a string with a name (not case sensitive).
+		 */
+		static bool isEqual(const etk::String& _data, size_t _start, size_t _stop, const char* _name) {
+			size_t size = strlen(_name);
+			if (_stop - _start != size) {
+				return false;
+			}
+			for (size_t iii=0; iii<size; ++iii) {
+				if (toLower(_data[_start+iii]) != _name[iii]) {
+					return false;
+				}
+			}
+			return true;
+		}
+		/**
+		 * @brief Parse a quality value "q=0.xxx" (RFC 7231 5.3.1)
+		 * @return Quality in thousandth (1000 if there is no quality)
+		 */
+		static int32_t parseQuality(const etk::String& _data, size_t _start, size_t _stop) {
+			// search ";q="
+			size_t pos = _start;
+			while (    pos < _stop
+			        && _data[pos] != ';') {
+				++pos;
+			}
+			while (pos < _stop) {
+				++pos;
+				while (    pos < _stop
+				        && isSpace(_data[pos]) == true) {
+					++pos;
+				}
+				if (    pos + 1 < _stop
+				     && toLower(_data[pos]) == 'q'
+				     && _data[pos+1] == '=') {
+					pos += 2;
+					int32_t out = 0;
+					if (    pos < _stop
+					     && _data[pos] == '1') {
+						return 1000;
+					}
+					if (    pos < _stop
+					     && _data[pos] != '0') {
+						return 0;
+					}
+					pos++;
+					if (    pos < _stop
+					     && _data[pos] == '.') {
+						pos++;
+						int32_t factor = 100;
+						while (    pos < _stop
+						        && factor > 0
+						        && _data[pos] >= '0'
+						        && _data[pos] <= '9') {
+							out += (_data[pos] - '0') * factor;
+							factor /= 10;
+							pos++;
+						}
+					}
+					return out;
+				}
+				while (    pos < _stop
+				        && _data[pos] != ';') {
+					++pos;
+				}
+			}
+			return 1000;
+		}
+		/**
+		 * @brief Hash of a body (FNV-1a 64 bits).
+		 */
+		static uint64_t hash(const uint8_t* _data, size_t _size) {
+			uint64_t out = 0xcbf29ce484222325ULL;
+			for (size_t iii=0; iii<_size; ++iii) {
+				out ^= _data[iii];
+				out *= 0x100000001b3ULL;
+			}
+			return out;
+		}
+	}
+}
+
+enum enet::httpCompression::encoding enet::httpCompression::negotiate(const etk::String& _acceptEncoding) {
+	int32_t qualityGzip = -1;
+	int32_t qualityDeflate = -1;
+	int32_t qualityAll = -1;
+	size_t pos = 0;
+	while (pos < _acceptEncoding.size()) {
+		size_t stop = pos;
+		while (    stop < _acceptEncoding.size()
+		        && _acceptEncoding[stop] != ',') {
+			++stop;
+		}
+		size_t start = pos;
+		while (    start < stop
+		        && isSpace(_acceptEncoding[start]) == true) {
+			++start;
+		}
+		size_t nameStop = start;
+		while (    nameStop < stop
+		        && _acceptEncoding[nameStop] != ';'
+		        && isSpace(_acceptEncoding[nameStop]) == false) {
+			++nameStop;
+		}
+		int32_t quality = parseQuality(_acceptEncoding, nameStop, stop);
+		if (    isEqual(_acceptEncoding, start, nameStop, "gzip") == true
+		     || isEqual(_acceptEncoding, start, nameStop, "x-gzip") == true) {
+			qualityGzip = quality;
+		} else if (isEqual(_acceptEncoding, start, nameStop, "deflate") == true) {
+			qualityDeflate = quality;
+		} else if (isEqual(_acceptEncoding, start, nameStop, "*") == true) {
+			qualityAll = quality;
+		}
+		pos = stop + 1;
+	}
+	// "*" match the encodings not listed
+	if (qualityGzip < 0) {
+		qualityGzip = qualityAll;
+	}
+	if (qualityDeflate < 0) {
+		qualityDeflate = qualityAll;
+	}
+	if (    qualityGzip > 0
+	     && qualityGzip >= qualityDeflate) {
+		return encoding::gzip;
+	}
+	if (qualityDeflate > 0) {
+		return encoding::deflate;
+	}
+	return encoding::identity;
+}
+
+const char* enet::httpCompression::getName(enum encoding _value) {
+	switch (_value) {
+		case encoding::gzip:
+			return "gzip";
+		case encoding::deflate:
+			return "deflate";
+		case encoding::identity:
+			break;
+	}
+	return "identity";
+}
+
+bool enet::httpCompression::parseName(const etk::String& _name, enum encoding& _value) {
+	size_t start = 0;
+	size_t stop = _name.size();
+	while (    start < stop
+	        && isSpace(_name[start]) == true) {
+		++start;
+	}
+	while (    stop > start
+	        && isSpace(_name[stop-1]) == true) {
+		--stop;
+	}
+	if (    isEqual(_name, start, stop, "gzip") == true
+	     || isEqual(_name, start, stop, "x-gzip") == true) {
+		_value = encoding::gzip;
+		return true;
+	}
+	if (isEqual(_name, start, stop, "deflate") == true) {
+		_value = encoding::deflate;
+		return true;
+	}
+	if (    start == stop
+	     || isEqual(_name, start, stop, "identity") == true) {
+		_value = encoding::identity;
+		return true;
+	}
+	return false;
+}
+
+enet::HttpDeflater::HttpDeflater() :
+  m_stream(null) {
+
+}
+
+enet::HttpDeflater::~HttpDeflater() {
+	if (m_stream != null) {
+		deflateEnd(m_stream);
+		ETK_DELETE(z_stream, m_stream);
+		m_stream = null;
+	}
+}
+
+bool enet::HttpDeflater::init(enum enet::httpCompression::encoding _encoding, int32_t _level) {
+	if (m_stream != null) {
+		deflateEnd(m_stream);
+	} else {
+		m_stream = ETK_NEW(z_stream);
+		if (m_stream == null) {
+			return false;
+		}
+	}
+	memset(m_stream, 0, sizeof(z_stream));
+	// 15: 32K window, +16: gzip header and trailer instead of zlib ones
+	int32_t windowBits = 15;
+	if (_encoding == enet::httpCompression::encoding::gzip) {
+		windowBits += 16;
+	}
+	if (deflateInit2(m_stream, etk::avg(1, _level, 9), Z_DEFLATED, windowBits, 8, Z_DEFAULT_STRATEGY) != Z_OK) {
+		ENET_ERROR("Can not initialize the compression: " << (m_stream->msg != null ? m_stream->msg : "?"));
+		ETK_DELETE(z_stream, m_stream);
+		m_stream = null;
+		return false;
+	}
+	return true;
+}
+
+bool enet::HttpDeflater::compress(const void* _data, size_t _size, etk::Vector<uint8_t>& _out, bool _finish) {
+	if (m_stream == null) {
+		return false;
+	}
+	m_stream->next_in = (Bytef*)_data;
+	m_stream->avail_in = _size;
+	int32_t flush = _finish == true ? Z_FINISH : Z_NO_FLUSH;
+	size_t used = _out.size();
+	while (true) {
+		if (_out.size() - used < enet::httpCompression::OUTPUT_STEP / 2) {
+			_out.resize(used + enet::httpCompression::OUTPUT_STEP);
+		}
+		m_stream->next_out = &_out[used];
+		m_stream->avail_out = _out.size() - used;
+		int32_t ret = deflate(m_stream, flush);
+		used = _out.size() - m_stream->avail_out;
+		if (ret == Z_STREAM_END) {
+			break;
+		}
+		if (    ret != Z_OK
+		     && ret != Z_BUF_ERROR) {
+			ENET_ERROR("Compression error: " << ret);
+			_out.resize(used);
+			return false;
+		}
+		if (    m_stream->avail_in == 0
+		     && m_stream->avail_out != 0) {
+			// All the data are processed (and all the output is written for the end of the stream)
+			break;
+		}
+	}
+	_out.resize(used);
+	return true;
+}
+
+enet::HttpInflater::HttpInflater() :
+  m_stream(null),
+  m_maxSize(0),
+  m_size(0) {
+
+}
+
+enet::HttpInflater::~HttpInflater() {
+	reset();
+}
+
+void enet::HttpInflater::reset() {
+	if (m_stream != null) {
+		inflateEnd(m_stream);
+		ETK_DELETE(z_stream, m_stream);
+		m_stream = null;
+	}
+}
+
+bool enet::HttpInflater::init(uint64_t _maxSize) {
+	reset();
+	m_stream = ETK_NEW(z_stream);
+	if (m_stream == null) {
+		return false;
+	}
+	memset(m_stream, 0, sizeof(z_stream));
+	// 15: 32K window, +32: detect the gzip or zlib header
+	if (inflateInit2(m_stream, 15 + 32) != Z_OK) {
+		ENET_ERROR("Can not initialize the decompression");
+		ETK_DELETE(z_stream, m_stream);
+		m_stream = null;
+		return false;
+	}
+	m_maxSize = _maxSize;
+	m_size = 0;
+	return true;
+}
+
+enum enet::HttpInflater::status enet::HttpInflater::decompress(const void* _data, size_t _size, etk::Vector<uint8_t>& _out) {
+	_out.clear();
+	if (m_stream == null) {
+		return status::error;
+	}
+	m_stream->next_in = (Bytef*)_data;
+	m_stream->avail_in = _size;
+	size_t used = 0;
+	while (true) {
+		if (_out.size() - used < enet::httpCompression::OUTPUT_STEP / 2) {
+			_out.resize(used + enet::httpCompression::OUTPUT_STEP);
+		}
+		m_stream->next_out = &_out[used];
+		m_stream->avail_out = _out.size() - used;
+		int32_t ret = inflate(m_stream, Z_NO_FLUSH);
+		size_t newUsed = _out.size() - m_stream->avail_out;
+		m_size += newUsed - used;
+		used = newUsed;
+		if (m_size > m_maxSize) {
+			_out.resize(used);
+			return status::tooBig;
+		}
+		if (ret == Z_STREAM_END) {
+			_out.resize(used);
+			return status::done;
+		}
+		if (    ret != Z_OK
+		     && ret != Z_BUF_ERROR) {
+			_out.resize(used);
+			return status::error;
+		}
+		if (    m_stream->avail_in == 0
+		     && m_stream->avail_out != 0) {
+			break;
+		}
+	}
+	_out.resize(used);
+	return status::incomplete;
+}
+
+enet::HttpCompression::HttpCompression(int32_t _level, size_t _minSize) :
+  m_level(_level),
+  m_minSize(_minSize),
+  m_maxInflateSize(16*1024*1024),
+  m_cacheMaxSize(0),
+  m_cacheSize(0),
+  m_cacheCounter(0),
+  m_nbCacheHit(0) {
+	m_types.pushBack("text/");
+	m_types.pushBack("application/json");
+	m_types.pushBack("application/javascript");
+	m_types.pushBack("application/xml");
+	m_types.pushBack("image/svg+xml");
+	m_types.pushBack("+json");
+	m_types.pushBack("+xml");
+}
+
+void enet::HttpCompression::setLevel(int32_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_level = etk::avg(0, _value, 9);
+	m_cache.clear();
+	m_cacheSize = 0;
+}
+
+int32_t enet::HttpCompression::getLevel() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_level;
+}
+
+void enet::HttpCompression::setMinSize(size_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_minSize = _value;
+}
+
+void enet::HttpCompression::setMaxInflateSize(uint64_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_maxInflateSize = _value;
+}
+
+uint64_t enet::HttpCompression::getMaxInflateSize() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_maxInflateSize;
+}
+
+void enet::HttpCompression::addType(const etk::String& _type) {
+	ethread::UniqueLock lock(m_mutex);
+	m_types.pushBack(_type);
+}
+
+bool enet::HttpCompression::isCompressible(const etk::String& _contentType) const {
+	size_t stop = 0;
+	while (    stop < _contentType.size()
+	        && _contentType[stop] != ';'
+	        && enet::httpCompression::isSpace(_contentType[stop]) == false) {
+		++stop;
+	}
+	if (stop == 0) {
+		return false;
+	}
+	ethread::UniqueLock lock(m_mutex);
+	for (auto &it : m_types) {
+		if (it.size() == 0) {
+			continue;
+		}
+		if (it[it.size()-1] == '/') {
+			// prefix "text/"
+			if (    stop > it.size()
+			     && enet::httpCompression::isEqual(_contentType, 0, it.size(), it.c_str()) == true) {
+				return true;
+			}
+		} else if (it[0] == '+') {
+			// suffix "+json"
+			if (    stop > it.size()
+			     && enet::httpCompression::isEqual(_contentType, stop - it.size(), stop, it.c_str()) == true) {
+				return true;
+			}
+		} else if (enet::httpCompression::isEqual(_contentType, 0, stop, it.c_str()) == true) {
+			return true;
+		}
+	}
+	return false;
+}
+
+void enet::HttpCompression::setCacheSize(size_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_cacheMaxSize = _value;
+	if (_value == 0) {
+		m_cache.clear();
+		m_seen.clear();
+		m_cacheSize = 0;
+	}
+}
+
+uint64_t enet::HttpCompression::getNumberCacheHit() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_nbCacheHit;
+}
+
+enum enet::httpCompression::encoding enet::HttpCompression::select(const enet::HttpRequest& _request, const enet::HttpAnswer& _answer, int64_t _size) const {
+	{
+		ethread::UniqueLock lock(m_mutex);
+		if (    m_level <= 0
+		     || (    _size >= 0
+		          && _size < int64_t(m_minSize))) {
+			return enet::httpCompression::encoding::identity;
+		}
+	}
+	enum enet::HTTPAnswerCode code = _answer.getErrorCode();
+	if (    int32_t(code) < 200
+	     || code == enet::HTTPAnswerCode::c204_noContent
+	     || code == enet::HTTPAnswerCode::c304_notModified
+	     || _answer.existKey(enet::HTTPHeaderId::contentEncoding) == true
+	     || _answer.existKey(enet::HTTPHeaderId::contentRange) == true
+	     || _request.existKey(enet::HTTPHeaderId::acceptEncoding) == false) {
+		return enet::httpCompression::encoding::identity;
+	}
+	// RFC 7234 5.2.2.4: the intermediaries (and the server) must not change the body
+	etk::String cacheControl = _answer.getKey(enet::HTTPHeaderId::cacheControl);
+	if (cacheControl.find("no-transform") != etk::String::npos) {
+		return enet::httpCompression::encoding::identity;
+	}
+	if (isCompressible(_answer.getKey(enet::HTTPHeaderId::contentType)) == false) {
+		return enet::httpCompression::encoding::identity;
+	}
+	return enet::httpCompression::negotiate(_request.getKey(enet::HTTPHeaderId::acceptEncoding));
+}
+
+void enet::HttpCompression::updateHeader(enet::HttpAnswer& _answer, enum enet::httpCompression::encoding _encoding) {
+	if (_encoding == enet::httpCompression::encoding::identity) {
+		return;
+	}
+	_answer.setKey(enet::HTTPHeaderId::contentEncoding, enet::httpCompression::getName(_encoding));
+	_answer.rmKey(enet::HTTPHeaderId::contentLength);
+	// The cache must store a version per encoding
+	if (_answer.existKey(enet::HTTPHeaderId::vary) == false) {
+		_answer.setKey(enet::HTTPHeaderId::vary, "Accept-Encoding");
+	} else {
+		etk::String vary = _answer.getKey(enet::HTTPHeaderId::vary);
+		etk::String lower = vary;
+		for (auto &it : lower) {
+			it = enet::httpCompression::toLower(it);
+		}
+		if (    lower.find("accept-encoding") == etk::String::npos
+		     && lower.find("*") == etk::String::npos) {
+			_answer.setKey(enet::HTTPHeaderId::vary, vary + ", Accept-Encoding");
+		}
+	}
+	// The compressed body is not byte-to-byte identical: a strong validator become weak (RFC 7232 2.1)
+	etk::String eTag = _answer.getKey(enet::HTTPHeaderId::eTag);
+	if (    eTag.size() != 0
+	     && eTag[0] == '"') {
+		_answer.setKey(enet::HTTPHeaderId::eTag, "W/" + eTag);
+	}
+}
+
+bool enet::HttpCompression::compress(const void* _data, size_t _size, enum enet::httpCompression::encoding _encoding, etk::Vector<uint8_t>& _out) {
+	_out.clear();
+	if (_encoding == enet::httpCompression::encoding::identity) {
+		return false;
+	}
+	const uint8_t* data = (const uint8_t*)_data;
+	int32_t level = 0;
+	uint64_t hash = 0;
+	bool addInCache = false;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		level = m_level;
+		if (    m_cacheMaxSize > 0
+		     && _size <= m_cacheMaxSize / enet::httpCompression::MAX_CACHE_ELEMENT_RATIO) {
+			hash = enet::httpCompression::hash(data, _size);
+			for (auto &it : m_cache) {
+				if (    it.m_hash == hash
+				     && it.m_encoding == _encoding
+				     && it.m_original.size() == _size
+				     && (    _size == 0
+				          || memcmp(&it.m_original[0], data, _size) == 0)) {
+					it.m_lastUse = ++m_cacheCounter;
+					m_nbCacheHit++;
+					_out = it.m_compressed;
+					return true;
+				}
+			}
+			// Only the bodies sent several times are cached (the dynamic bodies does not replace the static ones)
+			for (auto &it : m_seen) {
+				if (it == hash) {
+					addInCache = true;
+					break;
+				}
+			}
+			if (addInCache == false) {
+				if (m_seen.size() >= enet::httpCompression::MAX_SEEN) {
+					m_seen.clear();
+				}
+				m_seen.pushBack(hash);
+			}
+		}
+	}
+	enet::HttpDeflater deflater;
+	if (    deflater.init(_encoding, level) == false
+	     || deflater.compress(data, _size, _out, true) == false) {
+		_out.clear();
+		return false;
+	}
+	if (addInCache == false) {
+		return true;
+	}
+	ethread::UniqueLock lock(m_mutex);
+	size_t elementSize = _size + _out.size();
+	// Remove the least recently used elements
+	while (    m_cache.size() > 0
+	        && m_cacheSize + elementSize > m_cacheMaxSize) {
+		size_t oldest = 0;
+		for (size_t iii=1; iii<m_cache.size(); ++iii) {
+			if (m_cache[iii].m_lastUse < m_cache[oldest].m_lastUse) {
+				oldest = iii;
+			}
+		}
+		m_cacheSize -= m_cache[oldest].m_original.size() + m_cache[oldest].m_compressed.size();
+		m_cache.erase(m_cache.begin() + oldest);
+	}
+	if (m_cacheSize + elementSize > m_cacheMaxSize) {
+		return true;
+	}
+	CacheElement element;
+	element.m_hash = hash;
+	element.m_encoding = _encoding;
+	element.m_original.resize(_size);
+	if (_size > 0) {
+		memcpy(&element.m_original[0], data, _size);
+	}
+	element.m_compressed = _out;
+	element.m_lastUse = ++m_cacheCounter;
+	m_cache.pushBack(element);
+	m_cacheSize += elementSize;
+	for (size_t iii=0; iii<m_seen.size(); ++iii) {
+		if (m_seen[iii] == hash) {
+			m_seen.erase(m_seen.begin() + iii);
+			break;
+		}
+	}
+	return true;
+}
@@ -0,0 +1,223 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <enet/Http.hpp>
+#include <etk/Vector.hpp>
+#include <etk/String.hpp>
+#include <ethread/Mutex.hpp>
+
+struct z_stream_s;
+
+namespace enet {
+	namespace httpCompression {
+		enum class encoding {
+			identity, //!< No compression
+			gzip, //!< "gzip" content coding (RFC 1952)
+			deflate //!< "deflate" content coding (zlib format, RFC 1950)
+		};
+		/**
+		 * @brief Select the encoding of an answer with the "Accept-Encoding" of the request (RFC 7231 5.3.4).
+		 * @param[in] _acceptEncoding Value of the "Accept-Encoding" key.
+		 * @return The encoding with the highest quality (gzip is preferred when equal), identity if none is accepted.
+		 */
+		enum encoding negotiate(const etk::String& _acceptEncoding);
+		/**
+		 * @brief Get the name of an encoding.
+		 * @param[in] _value Encoding.
+		 * @return "gzip", "deflate" or "identity".
+		 */
+		const char* getName(enum encoding _value);
+		/**
+		 * @brief Get an encoding with the value of a "Content-Encoding" key.
+		 * @param[in] _name Value of the key ("x-gzip" is accepted).
+		 * @param[out] _value Encoding.
+		 * @return true if the encoding is supported.
+		 */
+		bool parseName(const etk::String& _name, enum encoding& _value);
+	}
+	/**
+	 * @brief Streaming compressor (zlib): the data are compressed step by step, the full body is never in memory.
+	 */
+	class HttpDeflater {
+		private:
+			struct z_stream_s* m_stream; //!< zlib state (null if not initialized)
+		public:
+			HttpDeflater();
+			~HttpDeflater();
+			HttpDeflater(const HttpDeflater& _obj) = delete;
+			HttpDeflater& operator= (const HttpDeflater& _obj) = delete;
+			/**
+			 * @brief Start a new compressed stream.
+			 * @param[in] _encoding gzip or deflate.
+			 * @param[in] _level Compression level (1: fast .. 9: small).
+			 * @return true if the stream is initialized.
+			 */
+			bool init(enum enet::httpCompression::encoding _encoding, int32_t _level);
+			/**
+			 * @brief Compress data.
+			 * @param[in] _data Data to compress.
+			 * @param[in] _size Number of byte.
+			 * @param[in,out] _out The compressed data are added at the end (it can be nothing when the data are buffered by zlib).
+			 * @param[in] _finish Last data of the stream (the end of the stream is written).
+			 * @return true if no error.
+			 */
+			bool compress(const void* _data, size_t _size, etk::Vector<uint8_t>& _out, bool _finish);
+	};
+	/**
+	 * @brief Streaming decompressor (zlib) for the request bodies ("gzip" and "deflate" are detected automatically).
+	 */
+	class HttpInflater {
+		public:
+			enum class status {
+				incomplete, //!< Need more data
+				done, //!< The end of the compressed stream is reached
+				error, //!< The data are not valid
+				tooBig //!< The decompressed size exceed the limit
+			};
+		private:
+			struct z_stream_s* m_stream; //!< zlib state (null if not initialized)
+			uint64_t m_maxSize; //!< Maximum size of the decompressed data
+			uint64_t m_size; //!< Size of the decompressed data
+		public:
+			HttpInflater();
+			~HttpInflater();
+			HttpInflater(const HttpInflater& _obj) = delete;
+			HttpInflater& operator= (const HttpInflater& _obj) = delete;
+			/**
+			 * @brief Start a new decompressed stream.
+			 * @param[in] _maxSize Maximum size of the decompressed data (protection against the compression bombs).
+			 * @return true if the stream is initialized.
+			 */
+			bool init(uint64_t _maxSize);
+			/**
+			 * @brief Check if a stream is in progress.
+			 * @return true if init() has been called.
+			 */
+			bool isInit() const {
+				return m_stream != null;
+			}
+			/**
+			 * @brief Stop the stream (free the zlib memory).
+			 */
+			void reset();
+			/**
+			 * @brief Decompress data.
+			 * @param[in] _data Compressed data.
+			 * @param[in] _size Number of byte.
+			 * @param[out] _out Decompressed data (the vector is cleared before).
+			 * @return Status of the stream.
+			 */
+			enum status decompress(const void* _data, size_t _size, etk::Vector<uint8_t>& _out);
+	};
+	/**
+	 * @brief Compression configuration of the HTTP servers (can be shared between all the connections).
+	 * The answers are compressed when the remote accept it, when the type is compressible and the body is big enough.
+	 * The compressed form of the bodies sent several times are kept in a cache (LRU): a body is added in the
+	 * cache the second time it is sent, the next times it is not compressed again.
+	 */
+	class HttpCompression {
+		private:
+			class CacheElement {
+				public:
+					uint64_t m_hash; //!< Hash of the original body
+					enum enet::httpCompression::encoding m_encoding; //!< Encoding of the compressed body
+					etk::Vector<uint8_t> m_original; //!< Original body (to check the hash collisions)
+					etk::Vector<uint8_t> m_compressed; //!< Compressed body
+					uint64_t m_lastUse; //!< Counter of the last use (LRU)
+			};
+			mutable ethread::Mutex m_mutex; //!< Protect the configuration and the cache
+			int32_t m_level; //!< Compression level (0: disable)
+			size_t m_minSize; //!< Minimum size of the compressed bodies
+			uint64_t m_maxInflateSize; //!< Maximum size of a decompressed request body
+			etk::Vector<etk::String> m_types; //!< Compressible types ("text/" is a prefix, "+json" a suffix)
+			etk::Vector<CacheElement> m_cache; //!< Compressed bodies
+			etk::Vector<uint64_t> m_seen; //!< Hash of the bodies sent one time (candidate for the cache)
+			size_t m_cacheMaxSize; //!< Maximum number of byte of the cache (0: disable)
+			size_t m_cacheSize; //!< Number of byte in the cache
+			uint64_t m_cacheCounter; //!< Use counter
+			uint64_t m_nbCacheHit; //!< Number of body found in the cache (statistic)
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _level Compression level (1: fast .. 9: small, 0 to disable).
+			 * @param[in] _minSize Minimum size of a body to compress it (the small bodies become bigger).
+			 */
+			HttpCompression(int32_t _level=6, size_t _minSize=1024);
+			virtual ~HttpCompression() = default;
+		public:
+			/**
+			 * @brief Set the compression level.
+			 * @param[in] _value Level (1: fast .. 9: small, 0 to disable).
+			 */
+			void setLevel(int32_t _value);
+			/**
+			 * @brief Get the compression level.
+			 * @return Level.
+			 */
+			int32_t getLevel() const;
+			/**
+			 * @brief Set the minimum size of a body to compress it.
+			 * @param[in] _value Size in byte.
+			 */
+			void setMinSize(size_t _value);
+			/**
+			 * @brief Set the maximum size of a decompressed request body.
+			 * @param[in] _value Size in byte.
+			 */
+			void setMaxInflateSize(uint64_t _value);
+			/**
+			 * @brief Get the maximum size of a decompressed request body.
+			 * @return Size in byte.
+			 */
+			uint64_t getMaxInflateSize() const;
+			/**
+			 * @brief Add a compressible type (the text, json, javascript, xml and svg types are set by default).
+			 * @param[in] _type Type "xxx/yyy", prefix "xxx/" or suffix "+yyy".
+			 */
+			void addType(const etk::String& _type);
+			/**
+			 * @brief Check if a type is compressible.
+			 * @param[in] _contentType Value of the "Content-Type" key (the parameters are ignored).
+			 * @return true if the type is compressible.
+			 */
+			bool isCompressible(const etk::String& _contentType) const;
+			/**
+			 * @brief Set the size of the cache of the compressed bodies.
+			 * @param[in] _value Maximum number of byte (0 to disable the cache, default).
+			 */
+			void setCacheSize(size_t _value);
+			/**
+			 * @brief Get the number of body found in the cache.
+			 * @return Number of cache hit.
+			 */
+			uint64_t getNumberCacheHit() const;
+		public:
+			/**
+			 * @brief Select the encoding of an answer.
+			 * @param[in] _request Request header (for "Accept-Encoding").
+			 * @param[in] _answer Answer header.
+			 * @param[in] _size Size of the body (-1 if unknown: streamed body).
+			 * @return The encoding to use (identity: no compression).
+			 */
+			enum enet::httpCompression::encoding select(const enet::HttpRequest& _request, const enet::HttpAnswer& _answer, int64_t _size) const;
+			/**
+			 * @brief Update the keys of a compressed answer: "Content-Encoding", "Vary", weak "ETag" and no "Content-Length".
+			 * @param[in,out] _answer Answer header.
+			 * @param[in] _encoding Encoding of the body.
+			 */
+			static void updateHeader(enet::HttpAnswer& _answer, enum enet::httpCompression::encoding _encoding);
+			/**
+			 * @brief Compress a full body (use the cache).
+			 * @param[in] _data Body.
+			 * @param[in] _size Number of byte.
+			 * @param[in] _encoding Encoding.
+			 * @param[out] _out Compressed body.
+			 * @return true if the body is compressed.
+			 */
+			bool compress(const void* _data, size_t _size, enum enet::httpCompression::encoding _encoding, etk::Vector<uint8_t>& _out);
+	};
+}
@@ -0,0 +1,446 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/HttpCoroutine.hpp>
+
+#ifdef ENET_COROUTINE
+
+#include <enet/debug.hpp>
+#include <enet/HttpCanned.hpp>
+#include <enet/WebSocket.hpp>
+extern "C" {
+	#include <string.h>
+}
+
+namespace enet {
+	namespace coroutine {
+		static const size_t READ_SIZE = 4096; //!< Minimum free space for a read
+	}
+}
+
+enet::AsyncHttpServer::AsyncHttpServer(enet::AsyncTcp _connection) :
+  m_connection(etk::move(_connection)),
+  m_bufferSize(0),
+  m_maxBodySize(8*1024*1024),
+  m_keepAlive(false) {
+
+}
+
+enet::Task<bool> enet::AsyncHttpServer::receive() {
+	if (m_buffer.size() < m_bufferSize + enet::coroutine::READ_SIZE) {
+		m_buffer.resize(etk::max(m_buffer.size() * 2, m_bufferSize + enet::coroutine::READ_SIZE));
+	}
+	int32_t len = co_await m_connection.read(&m_buffer[m_bufferSize], m_buffer.size() - m_bufferSize);
+	if (len <= 0) {
+		co_return false;
+	}
+	m_bufferSize += len;
+	co_return true;
+}
+
+void enet::AsyncHttpServer::consume(size_t _size) {
+	if (_size >= m_bufferSize) {
+		m_bufferSize = 0;
+		return;
+	}
+	memmove(&m_buffer[0], &m_buffer[_size], m_bufferSize - _size);
+	m_bufferSize -= _size;
+}
+
+enet::Task<void> enet::AsyncHttpServer::writeError(enum enet::HTTPAnswerCode _code, const etk::String& _help) {
+	m_keepAlive = false;
+	enet::HttpAnswer answer(_code, _help);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	answer.setKey(enet::HTTPHeaderId::connection, "close");
+	co_await write(answer, null, 0);
+	m_connection.close();
+}
+
+enet::Task<bool> enet::AsyncHttpServer::readRequest() {
+	m_body.clear();
+	m_keepAlive = false;
+	m_parser.reset();
+	enum enet::HttpParser::status status = enet::HttpParser::status::incomplete;
+	while (true) {
+		if (m_bufferSize > 0) {
+			status = m_parser.parse((const char*)&m_buffer[0], m_bufferSize);
+			if (status != enet::HttpParser::status::incomplete) {
+				break;
+			}
+		}
+		if (co_await receive() == false) {
+			co_return false;
+		}
+	}
+	const char* data = (const char*)&m_buffer[0];
+	if (    status == enet::HttpParser::status::error
+	     || m_parser.isAnswer() == true) {
+		ENET_ERROR("Malformed HTTP header FROM " << m_connection.getRemoteAddress());
+		co_await writeError(enet::HTTPAnswerCode::c400_badRequest, "Malformed header ...");
+		co_return false;
+	}
+	m_request.clearKeys();
+	m_request.setQuery(etk::Map<etk::String, etk::String>());
+	if (m_request.setFirstLine(data, m_parser) == false) {
+		ENET_ERROR("Un understand method ..." << enet::HttpParser::extract(data, m_parser.getMethod()));
+		co_await writeError(enet::HTTPAnswerCode::c400_badRequest, "Un understand message ...");
+		co_return false;
+	}
+	if (    m_request.setKeys(data, m_parser) == false
+	     || m_request.isBodyFramingValid(true) == false) {
+		// RFC 7230 3.3.3: the next request can not be found
+		co_await writeError(enet::HTTPAnswerCode::c400_badRequest, "Wrong body size ...");
+		co_return false;
+	}
+	consume(m_parser.getHeaderSize());
+	// RFC 7230 3.3.3: the transfer encoding is used before the content length
+	if (m_request.existKey(enet::HTTPHeaderId::transferEncoding) == true) {
+		m_chunkDecoder.reset();
+		while (true) {
+			if (m_bufferSize > 0) {
+				size_t consumed = 0;
+				size_t bodySize = 0;
+				enum enet::HttpChunkDecoder::status chunkStatus = m_chunkDecoder.decode(&m_buffer[0], m_bufferSize, consumed, bodySize);
+				if (chunkStatus == enet::HttpChunkDecoder::status::error) {
+					ENET_ERROR("Malformed chunked body FROM " << m_connection.getRemoteAddress());
+					co_await writeError(enet::HTTPAnswerCode::c400_badRequest, "Malformed chunked body");
+					co_return false;
+				}
+				if (m_body.size() + bodySize > m_maxBodySize) {
+					co_await writeError(enet::HTTPAnswerCode::c413_requestEntityTooLarge, "");
+					co_return false;
+				}
+				size_t offset = m_body.size();
+				m_body.resize(offset + bodySize);
+				if (bodySize > 0) {
+					memcpy(&m_body[offset], &m_buffer[0], bodySize);
+				}
+				consume(consumed);
+				if (chunkStatus == enet::HttpChunkDecoder::status::done) {
+					break;
+				}
+			}
+			if (co_await receive() == false) {
+				co_return false;
+			}
+		}
+	} else if (m_request.existKey(enet::HTTPHeaderId::contentLength) == true) {
+		int64_t size = m_request.getContentLength();
+		if (uint64_t(size) > m_maxBodySize) {
+			co_await writeError(enet::HTTPAnswerCode::c413_requestEntityTooLarge, "");
+			co_return false;
+		}
+		m_body.resize(size);
+		size_t offset = etk::min(size_t(size), m_bufferSize);
+		if (offset > 0) {
+			memcpy(&m_body[0], &m_buffer[0], offset);
+			consume(offset);
+		}
+		// The rest of the body is read directly in its buffer
+		while (offset < size_t(size)) {
+			int32_t len = co_await m_connection.read(&m_body[offset], etk::min(size_t(size) - offset, size_t(65536)));
+			if (len <= 0) {
+				co_return false;
+			}
+			offset += len;
+		}
+	}
+	// HTTP/1.1 is persistent by default, HTTP/1.0 only on request
+	if (m_request.getProtocol() >= enet::HTTPProtocol::http_1_1) {
+		m_keepAlive = m_request.isKeyEqual(enet::HTTPHeaderId::connection, "close") == false;
+	} else {
+		m_keepAlive = m_request.isKeyEqual(enet::HTTPHeaderId::connection, "keep-alive");
+	}
+	co_return true;
+}
+
+enet::Task<int32_t> enet::AsyncHttpServer::write(const enet::HttpAnswer& _answer, const void* _data, int32_t _len) {
+	enet::HttpAnswer answer = _answer;
+	if (_data == null) {
+		_len = 0;
+	}
+	enum enet::HTTPAnswerCode code = answer.getErrorCode();
+	// RFC 7230 3.3.2: no size added for the 1xx, 204 and 304 answers
+	bool hasBody =    int32_t(code) >= 200
+	               && code != enet::HTTPAnswerCode::c204_noContent
+	               && code != enet::HTTPAnswerCode::c304_notModified;
+	if (    hasBody == true
+	     && answer.existKey(enet::HTTPHeaderId::contentLength) == false
+	     && answer.existKey(enet::HTTPHeaderId::transferEncoding) == false) {
+		answer.setContentLength(_len);
+	}
+	if (code != enet::HTTPAnswerCode::c101_switchingProtocols) {
+		if (    answer.isKeyEqual(enet::HTTPHeaderId::connection, "close") == true
+		     || (    hasBody == true
+		          && answer.existKey(enet::HTTPHeaderId::contentLength) == false)) {
+			// The end of the body is the close of the connection
+			m_keepAlive = false;
+		}
+		if (m_keepAlive == false) {
+			if (answer.existKey(enet::HTTPHeaderId::connection) == false) {
+				answer.setKey(enet::HTTPHeaderId::connection, "close");
+			}
+		} else if (    (    m_request.getProtocol() < enet::HTTPProtocol::http_1_1
+		                 || answer.getProtocol() < enet::HTTPProtocol::http_1_1)
+		            && answer.existKey(enet::HTTPHeaderId::connection) == false) {
+			answer.setKey(enet::HTTPHeaderId::connection, "keep-alive");
+		}
+	}
+	// "Date" and "Server" are formatted one time per second
+	enet::httpDate::setKeys(answer);
+	m_sendBuffer.resize(0);
+	answer.generate(m_sendBuffer);
+	if (    _len > 0
+	     && hasBody == true
+	     && m_request.getType() != enet::HTTPReqType::HTTP_HEAD) {
+		// The header and the body are sent in one system call
+		size_t offset = m_sendBuffer.size();
+		m_sendBuffer.resize(offset + _len);
+		memcpy(&m_sendBuffer[offset], _data, _len);
+	}
+	int32_t ret = co_await m_connection.write(&m_sendBuffer[0], m_sendBuffer.size());
+	if (    ret < 0
+	     || (    m_keepAlive == false
+	          && code != enet::HTTPAnswerCode::c101_switchingProtocols)) {
+		ENET_DEBUG("Close connection FROM " << m_connection.getRemoteAddress());
+		m_connection.close();
+	}
+	co_return ret;
+}
+
+enet::AsyncTcp enet::AsyncHttpServer::release(etk::Vector<uint8_t>& _pending) {
+	_pending.resize(m_bufferSize);
+	if (m_bufferSize > 0) {
+		memcpy(&_pending[0], &m_buffer[0], m_bufferSize);
+	}
+	m_bufferSize = 0;
+	m_keepAlive = false;
+	return etk::move(m_connection);
+}
+
+enet::AsyncWebSocket::AsyncWebSocket() :
+  m_bufferSize(0),
+  m_isString(false),
+  m_inMessage(false),
+  m_closeSent(false),
+  m_maxMessageSize(16*1024*1024) {
+
+}
+
+bool enet::AsyncWebSocket::isUpgrade(const enet::HttpRequest& _request) {
+	return    _request.getType() == enet::HTTPReqType::HTTP_GET
+	       && _request.isKeyEqual(enet::HTTPHeaderId::upgrade, "websocket") == true
+	       && _request.existKey(enet::HTTPHeaderId::secWebSocketKey) == true;
+}
+
+enet::Task<bool> enet::AsyncWebSocket::accept(enet::AsyncHttpServer& _http, etk::String _protocol) {
+	if (isUpgrade(_http.getRequest()) == false) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c400_badRequest, "websocket support only with Upgrade: websocket");
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		answer.setKey(enet::HTTPHeaderId::connection, "close");
+		co_await _http.write(answer, null, 0);
+		co_return false;
+	}
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c101_switchingProtocols);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	answer.setKey(enet::HTTPHeaderId::upgrade, "websocket");
+	answer.setKey(enet::HTTPHeaderId::connection, "Upgrade");
+	answer.setKey(enet::HTTPHeaderId::secWebSocketAccept, enet::websocket::generateCheckKey(_http.getRequest().getKey(enet::HTTPHeaderId::secWebSocketKey)));
+	if (_protocol != "") {
+		answer.setKey(enet::HTTPHeaderId::secWebSocketProtocol, _protocol);
+	}
+	if (co_await _http.write(answer, null, 0) < 0) {
+		co_return false;
+	}
+	m_connection = _http.release(m_buffer);
+	m_bufferSize = m_buffer.size();
+	m_inMessage = false;
+	m_closeSent = false;
+	co_return m_connection.isAlive();
+}
+
+enet::Task<bool> enet::AsyncWebSocket::fill(size_t _size) {
+	while (m_bufferSize < _size) {
+		if (m_buffer.size() < m_bufferSize + enet::coroutine::READ_SIZE) {
+			m_buffer.resize(etk::max(_size, m_bufferSize + enet::coroutine::READ_SIZE));
+		}
+		int32_t len = co_await m_connection.read(&m_buffer[m_bufferSize], m_buffer.size() - m_bufferSize);
+		if (len <= 0) {
+			co_return false;
+		}
+		m_bufferSize += len;
+	}
+	co_return true;
+}
+
+enet::Task<bool> enet::AsyncWebSocket::receive() {
+	m_data.clear();
+	while (m_connection.isAlive() == true) {
+		if (co_await fill(2) == false) {
+			m_connection.close();
+			co_return false;
+		}
+		uint8_t opcode = m_buffer[0] & 0x0F;
+		bool fin = (m_buffer[0] & enet::websocket::FLAG_FIN) != 0;
+		bool mask = (m_buffer[1] & enet::websocket::FLAG_MASK) != 0;
+		uint64_t size = m_buffer[1] & 0x7F;
+		size_t headerSize = 2;
+		if (size == 126) {
+			headerSize += 2;
+		} else if (size == 127) {
+			headerSize += 8;
+		}
+		if (mask == true) {
+			headerSize += 4;
+		}
+		if (co_await fill(headerSize) == false) {
+			m_connection.close();
+			co_return false;
+		}
+		// The sizes are in network order (big endian)
+		if (size == 126) {
+			size = (uint64_t(m_buffer[2]) << 8) | m_buffer[3];
+		} else if (size == 127) {
+			size = 0;
+			for (size_t iii=0; iii<8; ++iii) {
+				size = (size << 8) | m_buffer[2+iii];
+			}
+		}
+		// RFC 6455 5.1: the client frames are masked
+		if (mask == false) {
+			ENET_ERROR("Receive a frame without mask FROM " << m_connection.getRemoteAddress());
+			co_await close(1002);
+			co_return false;
+		}
+		bool isControl = (opcode & 0x08) != 0;
+		if (    (    isControl == true
+		          && (    fin == false
+		               || size > 125))
+		     || (    isControl == false
+		          && size > m_maxMessageSize - m_data.size())) {
+			ENET_ERROR("Frame too big FROM " << m_connection.getRemoteAddress() << " (" << size << " byte(s))");
+			co_await close(isControl == true ? 1002 : 1009);
+			co_return false;
+		}
+		if (co_await fill(headerSize + size) == false) {
+			m_connection.close();
+			co_return false;
+		}
+		uint8_t* payload = &m_buffer[headerSize];
+		const uint8_t* dataMask = &m_buffer[headerSize-4];
+		for (size_t iii=0; iii<size; ++iii) {
+			payload[iii] ^= dataMask[iii%4];
+		}
+		if (opcode == enet::websocket::OPCODE_FRAME_PING) {
+			// The pong has the data of the ping
+			etk::Vector<uint8_t> data;
+			data.resize(size);
+			if (size > 0) {
+				memcpy(&data[0], payload, size);
+			}
+			size_t frameSize = headerSize + size;
+			memmove(&m_buffer[0], &m_buffer[frameSize], m_bufferSize - frameSize);
+			m_bufferSize -= frameSize;
+			co_await sendFrame(enet::websocket::OPCODE_FRAME_PONG, data.size() == 0 ? null : &data[0], data.size());
+			continue;
+		}
+		if (opcode == enet::websocket::OPCODE_FRAME_CLOSE) {
+			ENET_DEBUG("Close connection by remote: " << m_connection.getRemoteAddress());
+			if (m_closeSent == false) {
+				// Answer with the same code
+				uint16_t code = 1000;
+				if (size >= 2) {
+					code = (uint16_t(payload[0]) << 8) | payload[1];
+				}
+				co_await close(code);
+			}
+			m_connection.close();
+			co_return false;
+		}
+		if (opcode == enet::websocket::OPCODE_FRAME_PONG) {
+			// Nothing to do
+		} else if (    opcode == enet::websocket::OPCODE_FRAME_TEXT
+		            || opcode == enet::websocket::OPCODE_FRAME_BINARY
+		            || opcode == 0) {
+			if ((opcode == 0) != m_inMessage) {
+				ENET_ERROR("Wrong fragmentation FROM " << m_connection.getRemoteAddress());
+				co_await close(1002);
+				co_return false;
+			}
+			if (opcode != 0) {
+				m_isString = opcode == enet::websocket::OPCODE_FRAME_TEXT;
+			}
+			size_t offset = m_data.size();
+			m_data.resize(offset + size);
+			if (size > 0) {
+				memcpy(&m_data[offset], payload, size);
+			}
+			m_inMessage = fin == false;
+		} else {
+			ENET_ERROR("Unknown opcode " << int32_t(opcode) << " FROM " << m_connection.getRemoteAddress());
+			co_await close(1002);
+			co_return false;
+		}
+		size_t frameSize = headerSize + size;
+		memmove(&m_buffer[0], &m_buffer[frameSize], m_bufferSize - frameSize);
+		m_bufferSize -= frameSize;
+		if (    isControl == false
+		     && m_inMessage == false) {
+			co_return true;
+		}
+	}
+	co_return false;
+}
+
+enet::Task<int32_t> enet::AsyncWebSocket::sendFrame(uint8_t _opcode, const void* _data, int32_t _len) {
+	if (    m_connection.isAlive() == false
+	     || m_closeSent == true) {
+		co_return -1;
+	}
+	if (_data == null) {
+		_len = 0;
+	}
+	// The frames of the server are not masked
+	m_sendBuffer.resize(0);
+	m_sendBuffer.pushBack(enet::websocket::FLAG_FIN | _opcode);
+	if (_len < 126) {
+		m_sendBuffer.pushBack(uint8_t(_len));
+	} else if (_len < 65536) {
+		m_sendBuffer.pushBack(126);
+		m_sendBuffer.pushBack(uint8_t(_len >> 8));
+		m_sendBuffer.pushBack(uint8_t(_len));
+	} else {
+		m_sendBuffer.pushBack(127);
+		for (int32_t iii=7; iii>=0; --iii) {
+			m_sendBuffer.pushBack(uint8_t(uint64_t(_len) >> (iii*8)));
+		}
+	}
+	size_t offset = m_sendBuffer.size();
+	m_sendBuffer.resize(offset + _len);
+	if (_len > 0) {
+		memcpy(&m_sendBuffer[offset], _data, _len);
+	}
+	int32_t ret = co_await m_connection.write(&m_sendBuffer[0], m_sendBuffer.size());
+	if (ret < 0) {
+		co_return -1;
+	}
+	co_return _len;
+}
+
+enet::Task<int32_t> enet::AsyncWebSocket::send(const void* _data, int32_t _len, bool _isString) {
+	return sendFrame(_isString == true ? enet::websocket::OPCODE_FRAME_TEXT : enet::websocket::OPCODE_FRAME_BINARY, _data, _len);
+}
+
+enet::Task<void> enet::AsyncWebSocket::close(uint16_t _code) {
+	uint8_t data[2];
+	data[0] = uint8_t(_code >> 8);
+	data[1] = uint8_t(_code);
+	co_await sendFrame(enet::websocket::OPCODE_FRAME_CLOSE, data, 2);
+	m_closeSent = true;
+	m_connection.close();
+}
+
+#endif
@@ -0,0 +1,236 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <enet/Coroutine.hpp>
+
+#ifdef ENET_COROUTINE
+
+#include <enet/Http.hpp>
+#include <enet/HttpParser.hpp>
+#include <enet/HttpChunk.hpp>
+#include <etk/Vector.hpp>
+#include <etk/String.hpp>
+
+namespace enet {
+	/**
+	 * @brief Server side of a HTTP connection used in a coroutine (one request then its answer, in sequence).
+	 * @code
+	 *   enet::Task<void> session(enet::AsyncTcp _connection) {
+	 *       enet::AsyncHttpServer http(etk::move(_connection));
+	 *       while (co_await http.readRequest() == true) {
+	 *           enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+	 *           answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	 *           co_await http.write(answer, "hello");
+	 *       }
+	 *   }
+	 * @endcode
+	 */
+	class AsyncHttpServer {
+		private:
+			enet::AsyncTcp m_connection; //!< TCP connection
+			enet::HttpParser m_parser; //!< Parser of the request header
+			etk::Vector<uint8_t> m_buffer; //!< Received data not used (start of the next request)
+			size_t m_bufferSize; //!< Number of byte used in m_buffer
+			enet::HttpRequest m_request; //!< Current request
+			etk::Vector<uint8_t> m_body; //!< Body of the current request
+			enet::HttpChunkDecoder m_chunkDecoder; //!< Decoder of the chunked body
+			etk::Vector<char> m_sendBuffer; //!< Answer in progress (header and body, one system call)
+			uint64_t m_maxBodySize; //!< Maximum size of a request body
+			bool m_keepAlive; //!< The connection is kept after the answer
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _connection Connection accepted by the server.
+			 */
+			AsyncHttpServer(enet::AsyncTcp _connection);
+			AsyncHttpServer(const AsyncHttpServer& _obj) = delete;
+			AsyncHttpServer& operator= (const AsyncHttpServer& _obj) = delete;
+			virtual ~AsyncHttpServer() = default;
+		public:
+			enet::AsyncTcp& getConnection() {
+				return m_connection;
+			}
+			/**
+			 * @brief Set the maximum size of a request body (answered 413 when it is bigger).
+			 * @param[in] _value Size in byte (default 8MB).
+			 */
+			void setMaxBodySize(uint64_t _value) {
+				m_maxBodySize = _value;
+			}
+			/**
+			 * @brief Read the next request and its body (the malformed requests are answered 400 and the connection is closed).
+			 * @return true if a request is received, false if the connection is closed.
+			 */
+			enet::Task<bool> readRequest();
+			/**
+			 * @brief Get the header of the last request.
+			 * @return The request.
+			 */
+			const enet::HttpRequest& getRequest() const {
+				return m_request;
+			}
+			/**
+			 * @brief Get the body of the last request (chunked body decoded).
+			 * @return The body.
+			 */
+			const etk::Vector<uint8_t>& getBody() const {
+				return m_body;
+			}
+			/**
+			 * @brief Check if the connection is kept after the answer of the current request.
+			 * @return true for a persistent connection.
+			 */
+			bool isKeepAlive() const {
+				return m_keepAlive;
+			}
+			/**
+			 * @brief Send the answer of the current request (the connection is closed after it when it is not persistent).
+			 * "Content-Length", "Date", "Server" and "Connection" are set if needed, the body is not sent for a HEAD request.
+			 * @param[in] _answer Answer header (must exist until the end of the write).
+			 * @param[in] _data Body of the answer.
+			 * @param[in] _len Number of byte of the body.
+			 * @return Number of byte written or -1 on error.
+			 */
+			enet::Task<int32_t> write(const enet::HttpAnswer& _answer, const void* _data, int32_t _len);
+			/**
+			 * @brief Send the answer of the current request with a text body.
+			 * @param[in] _answer Answer header (must exist until the end of the write).
+			 * @param[in] _data Body of the answer (must exist until the end of the write).
+			 * @return Number of byte written or -1 on error.
+			 */
+			enet::Task<int32_t> write(const enet::HttpAnswer& _answer, const etk::String& _data) {
+				return write(_answer, _data.c_str(), _data.size());
+			}
+			/**
+			 * @brief Give the connection to an other protocol (after a "101 Switching Protocols" answer).
+			 * @param[out] _pending Data already received after the request.
+			 * @return The connection.
+			 */
+			enet::AsyncTcp release(etk::Vector<uint8_t>& _pending);
+		private:
+			/**
+			 * @brief Read data at the end of m_buffer.
+			 * @return false if the connection is closed.
+			 */
+			enet::Task<bool> receive();
+			/**
+			 * @brief Remove the used data at the start of m_buffer.
+			 * @param[in] _size Number of byte used.
+			 */
+			void consume(size_t _size);
+			/**
+			 * @brief Answer an error and close the connection.
+			 * @param[in] _code Code of the answer.
+			 * @param[in] _help Reason of the error.
+			 */
+			enet::Task<void> writeError(enum enet::HTTPAnswerCode _code, const etk::String& _help);
+	};
+	/**
+	 * @brief Server side of a WebSocket connection used in a coroutine (RFC 6455).
+	 * @code
+	 *   if (enet::AsyncWebSocket::isUpgrade(http.getRequest()) == true) {
+	 *       enet::AsyncWebSocket ws;
+	 *       if (co_await ws.accept(http) == false) {
+	 *           co_return;
+	 *       }
+	 *       while (co_await ws.receive() == true) {
+	 *           co_await ws.send(&ws.getData()[0], ws.getData().size(), ws.isString());
+	 *       }
+	 *   }
+	 * @endcode
+	 */
+	class AsyncWebSocket {
+		private:
+			enet::AsyncTcp m_connection; //!< TCP connection
+			etk::Vector<uint8_t> m_buffer; //!< Received data not used
+			size_t m_bufferSize; //!< Number of byte used in m_buffer
+			etk::Vector<uint8_t> m_data; //!< Last message received
+			bool m_isString; //!< The last message is a text
+			bool m_inMessage; //!< A fragmented message is in progress
+			bool m_closeSent; //!< The close frame is sent
+			etk::Vector<uint8_t> m_sendBuffer; //!< Frame in progress
+			uint64_t m_maxMessageSize; //!< Maximum size of a message
+		public:
+			AsyncWebSocket();
+			AsyncWebSocket(const AsyncWebSocket& _obj) = delete;
+			AsyncWebSocket& operator= (const AsyncWebSocket& _obj) = delete;
+			virtual ~AsyncWebSocket() = default;
+		public:
+			/**
+			 * @brief Check if a request ask a WebSocket connection.
+			 * @param[in] _request Request header.
+			 * @return true if the request has "Upgrade: websocket" and a "Sec-WebSocket-Key".
+			 */
+			static bool isUpgrade(const enet::HttpRequest& _request);
+			/**
+			 * @brief Accept the WebSocket request of a HTTP connection (answer "101 Switching Protocols").
+			 * @param[in,out] _http HTTP connection that received the request (the connection is moved in this object).
+			 * @param[in] _protocol Protocol selected in the "Sec-WebSocket-Protocol" list of the request ("": none).
+			 * @return true if the connection is open.
+			 */
+			enet::Task<bool> accept(enet::AsyncHttpServer& _http, etk::String _protocol="");
+			/**
+			 * @brief Set the maximum size of a message (the connection is closed with the code 1009 when it is bigger).
+			 * @param[in] _value Size in byte (default 16MB).
+			 */
+			void setMaxMessageSize(uint64_t _value) {
+				m_maxMessageSize = _value;
+			}
+			enet::AsyncTcp& getConnection() {
+				return m_connection;
+			}
+			/**
+			 * @brief Wait the next message (the ping are answered during the wait).
+			 * @return true if a message is received, false if the connection is closed.
+			 */
+			enet::Task<bool> receive();
+			/**
+			 * @brief Get the last message.
+			 * @return Data of the message.
+			 */
+			const etk::Vector<uint8_t>& getData() const {
+				return m_data;
+			}
+			/**
+			 * @brief Check if the last message is a text.
+			 * @return true for a text message, false for a binary message.
+			 */
+			bool isString() const {
+				return m_isString;
+			}
+			/**
+			 * @brief Send a message (one frame).
+			 * @param[in] _data Data of the message.
+			 * @param[in] _len Number of byte.
+			 * @param[in] _isString The message is a text (UTF-8).
+			 * @return Number of byte written or -1 on error.
+			 */
+			enet::Task<int32_t> send(const void* _data, int32_t _len, bool _isString=false);
+			/**
+			 * @brief Send the close frame and close the connection.
+			 * @param[in] _code Status code of the close (RFC 6455 7.4.1).
+			 */
+			enet::Task<void> close(uint16_t _code=1000);
+		private:
+			/**
+			 * @brief Read data until m_buffer contain a number of byte.
+			 * @param[in] _size Number of byte needed.
+			 * @return false if the connection is closed.
+			 */
+			enet::Task<bool> fill(size_t _size);
+			/**
+			 * @brief Send a frame.
+			 * @param[in] _opcode Type of the frame.
+			 * @param[in] _data Payload.
+			 * @param[in] _len Number of byte of the payload.
+			 * @return Number of byte written or -1 on error.
+			 */
+			enet::Task<int32_t> sendFrame(uint8_t _opcode, const void* _data, int32_t _len);
+	};
+}
+
+#endif
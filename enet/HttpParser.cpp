@@ -0,0 +1,289 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/HttpParser.hpp>
+#include <enet/scan.hpp>
+
+namespace enet {
+	namespace httpParser {
+		static inline char toLower(char _value) {
+			if (    _value >= 'A'
+			     && _value <= 'Z') {
+				return _value + ('a' - 'A');
+			}
+			return _value;
+		}
+		static inline bool isEndLine(char _value) {
+			return    _value == '\r'
+			       || _value == '\n';
+		}
+		static inline bool isSpace(char _value) {
+			return    _value == ' '
+			       || _value == '\t';
+		}
+	}
+}
+
+const size_t enet::HttpParser::MAX_FIELD;
+
+enet::HttpParser::HttpParser(uint32_t _maxSize) :
+  m_maxSize(_maxSize) {
+	reset();
+}
+
+void enet::HttpParser::reset() {
+	m_state = state::lineOne0;
+	m_position = 0;
+	m_tokenStart = 0;
+	m_nbField = 0;
+	m_isAnswer = false;
+	for (size_t iii=0; iii<3; ++iii) {
+		m_lineOne[iii].m_offset = 0;
+		m_lineOne[iii].m_size = 0;
+	}
+}
+
+enum enet::HttpParser::status enet::HttpParser::setError() {
+	m_state = state::error;
+	return status::error;
+}
+
+enum enet::HttpParser::status enet::HttpParser::parse(const char* _data, size_t _size) {
+	if (m_state == state::done) {
+		return status::done;
+	}
+	if (m_state == state::error) {
+		return status::error;
+	}
+	if (_size > m_maxSize) {
+		// Parse only the authorized size, if the header is not ended, it is too big.
+		_size = m_maxSize;
+	}
+	uint32_t pos = m_position;
+	uint32_t size = _size;
+	while (pos < size) {
+		switch (m_state) {
+			case state::lineOne0:
+				// Ignore the empty lines before the first line (RFC 7230 3.5)
+				if (    pos == m_tokenStart
+				     && enet::httpParser::isEndLine(_data[pos]) == true) {
+					pos++;
+					m_tokenStart = pos;
+					break;
+				}
+				pos += enet::scan::findSpaceOrEndLine(_data + pos, size - pos);
+				if (    pos < size
+				     && _data[pos] != ' ') {
+					m_position = pos;
+					return setError();
+				}
+				if (pos < size) {
+					m_lineOne[0].m_offset = m_tokenStart;
+					m_lineOne[0].m_size = pos - m_tokenStart;
+					if (m_lineOne[0].m_size == 0) {
+						m_position = pos;
+						return setError();
+					}
+					m_isAnswer =    m_lineOne[0].m_size >= 5
+					             && _data[m_tokenStart] == 'H'
+					             && _data[m_tokenStart+1] == 'T'
+					             && _data[m_tokenStart+2] == 'T'
+					             && _data[m_tokenStart+3] == 'P'
+					             && _data[m_tokenStart+4] == '/';
+					pos++;
+					m_tokenStart = pos;
+					m_state = state::lineOne1;
+				}
+				break;
+			case state::lineOne1:
+				pos += enet::scan::findSpaceOrEndLine(_data + pos, size - pos);
+				if (    pos < size
+				     && _data[pos] != ' ') {
+					m_position = pos;
+					return setError();
+				}
+				if (pos < size) {
+					m_lineOne[1].m_offset = m_tokenStart;
+					m_lineOne[1].m_size = pos - m_tokenStart;
+					if (m_lineOne[1].m_size == 0) {
+						m_position = pos;
+						return setError();
+					}
+					if (m_isAnswer == true) {
+						if (m_lineOne[1].m_size != 3) {
+							m_position = pos;
+							return setError();
+						}
+						for (uint32_t iii=m_tokenStart; iii<pos; ++iii) {
+							if (    _data[iii] < '0'
+							     || _data[iii] > '9') {
+								m_position = pos;
+								return setError();
+							}
+						}
+					}
+					pos++;
+					m_tokenStart = pos;
+					m_state = state::lineOne2;
+				}
+				break;
+			case state::lineOne2:
+				// The reason of an answer can contain spaces: take all the end of the line.
+				pos += enet::scan::findEndLine(_data + pos, size - pos);
+				if (pos < size) {
+					m_lineOne[2].m_offset = m_tokenStart;
+					m_lineOne[2].m_size = pos - m_tokenStart;
+					if (    m_isAnswer == false
+					     && m_lineOne[2].m_size == 0) {
+						m_position = pos;
+						return setError();
+					}
+					if (_data[pos] == '\r') {
+						m_state = state::lineOneEnd;
+					} else {
+						m_state = state::fieldStart;
+					}
+					pos++;
+				}
+				break;
+			case state::lineOneEnd:
+				if (_data[pos] != '\n') {
+					m_position = pos;
+					return setError();
+				}
+				pos++;
+				m_state = state::fieldStart;
+				break;
+			case state::fieldStart:
+				if (_data[pos] == '\r') {
+					pos++;
+					m_state = state::headerEnd;
+					break;
+				}
+				if (_data[pos] == '\n') {
+					pos++;
+					m_position = pos;
+					m_state = state::done;
+					return status::done;
+				}
+				if (enet::httpParser::isSpace(_data[pos]) == true) {
+					// obsolete line folding (RFC 7230 3.2.4)
+					m_position = pos;
+					return setError();
+				}
+				if (m_nbField >= MAX_FIELD) {
+					ENET_ERROR("Too many field in the HTTP header (max " << MAX_FIELD << ")");
+					m_position = pos;
+					return setError();
+				}
+				m_tokenStart = pos;
+				m_state = state::fieldKey;
+				break;
+			case state::fieldKey:
+				pos += enet::scan::findInvalidToken(_data + pos, size - pos);
+				if (    pos < size
+				     && _data[pos] != ':') {
+					m_position = pos;
+					return setError();
+				}
+				if (pos < size) {
+					if (pos == m_tokenStart) {
+						m_position = pos;
+						return setError();
+					}
+					m_fields[m_nbField].m_key.m_offset = m_tokenStart;
+					m_fields[m_nbField].m_key.m_size = pos - m_tokenStart;
+					pos++;
+					m_state = state::fieldSpace;
+				}
+				break;
+			case state::fieldSpace:
+				while (    pos < size
+				        && enet::httpParser::isSpace(_data[pos]) == true) {
+					pos++;
+				}
+				if (pos < size) {
+					m_tokenStart = pos;
+					m_state = state::fieldValue;
+				}
+				break;
+			case state::fieldValue:
+				pos += enet::scan::findInvalidValue(_data + pos, size - pos);
+				if (pos < size) {
+					if (enet::httpParser::isEndLine(_data[pos]) == false) {
+						// control character in the value
+						m_position = pos;
+						return setError();
+					}
+					// remove the ending spaces
+					uint32_t valueStop = pos;
+					while (    valueStop > m_tokenStart
+					        && enet::httpParser::isSpace(_data[valueStop-1]) == true) {
+						valueStop--;
+					}
+					m_fields[m_nbField].m_value.m_offset = m_tokenStart;
+					m_fields[m_nbField].m_value.m_size = valueStop - m_tokenStart;
+					m_nbField++;
+					if (_data[pos] == '\r') {
+						m_state = state::fieldEnd;
+					} else {
+						m_state = state::fieldStart;
+					}
+					pos++;
+				}
+				break;
+			case state::fieldEnd:
+				if (_data[pos] != '\n') {
+					m_position = pos;
+					return setError();
+				}
+				pos++;
+				m_state = state::fieldStart;
+				break;
+			case state::headerEnd:
+				if (_data[pos] != '\n') {
+					m_position = pos;
+					return setError();
+				}
+				pos++;
+				m_position = pos;
+				m_state = state::done;
+				return status::done;
+			case state::done:
+			case state::error:
+				break;
+		}
+	}
+	m_position = pos;
+	if (pos >= m_maxSize) {
+		ENET_ERROR("HTTP header too big (max " << m_maxSize << " bytes)");
+		return setError();
+	}
+	return status::incomplete;
+}
+
+bool enet::HttpParser::isEqual(const char* _data, const Span& _span, const char* _value) {
+	const char* data = _data + _span.m_offset;
+	for (uint32_t iii=0; iii<_span.m_size; ++iii) {
+		if (_value[iii] == '\0') {
+			return false;
+		}
+		if (enet::httpParser::toLower(data[iii]) != enet::httpParser::toLower(_value[iii])) {
+			return false;
+		}
+	}
+	return _value[_span.m_size] == '\0';
+}
+
+int32_t enet::HttpParser::findField(const char* _data, const char* _key) const {
+	for (size_t iii=0; iii<m_nbField; ++iii) {
+		if (isEqual(_data, m_fields[iii].m_key, _key) == true) {
+			return iii;
+		}
+	}
+	return -1;
+}
@@ -0,0 +1,184 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+
+namespace enet {
+	/**
+	 * @brief Incremental HTTP/1.x header parser (request or answer).
+	 * The parser work directly on the receive buffer and never allocate: all the elements are returned as
+	 * offsets in the buffer. It can be resumed: when the header is not complete, the caller append the new
+	 * data at the end of the same buffer and call parse() again, the parsing continue where it stopped.
+	 */
+	class HttpParser {
+		public:
+			/**
+			 * @brief Position of an element in the parsed buffer.
+			 */
+			class Span {
+				public:
+					uint32_t m_offset; //!< Position of the first byte in the buffer
+					uint32_t m_size; //!< Number of byte
+			};
+			/**
+			 * @brief Header field "key: value" (the spaces around the value are removed).
+			 */
+			class Field {
+				public:
+					Span m_key; //!< Name of the field
+					Span m_value; //!< Value of the field
+			};
+			enum class status {
+				incomplete, //!< Need more data
+				done, //!< The header is complete
+				error //!< The header is malformed or too big
+			};
+			static const size_t MAX_FIELD = 64; //!< Maximum number of field in a header
+		private:
+			enum class state {
+				lineOne0,
+				lineOne1,
+				lineOne2,
+				lineOneEnd,
+				fieldStart,
+				fieldKey,
+				fieldSpace,
+				fieldValue,
+				fieldEnd,
+				headerEnd,
+				done,
+				error
+			};
+			enum state m_state; //!< Current state of the parser
+			uint32_t m_position; //!< Next byte to parse
+			uint32_t m_tokenStart; //!< Start of the element in progress
+			uint32_t m_maxSize; //!< Maximum size of the header
+			Span m_lineOne[3]; //!< The 3 elements of the first line
+			Field m_fields[MAX_FIELD]; //!< Header fields
+			size_t m_nbField; //!< Number of field parsed
+			bool m_isAnswer; //!< The first line is an answer "HTTP/x.y code reason"
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _maxSize Maximum size of a header (bigger header are an error)
+			 */
+			HttpParser(uint32_t _maxSize=65536);
+			/**
+			 * @brief Set the maximum size of a header (used by the next parsing).
+			 * @param[in] _value Size in byte (bigger header are an error)
+			 */
+			void setMaxSize(uint32_t _value) {
+				m_maxSize = _value;
+			}
+			/**
+			 * @brief Reset the parser to parse a new header.
+			 */
+			void reset();
+			/**
+			 * @brief Parse (or continue to parse) a header.
+			 * @param[in] _data Buffer that contain the header (from the first byte, same content as the previous call)
+			 * @param[in] _size Number of byte available in the buffer.
+			 * @return The status of the parsing.
+			 */
+			enum status parse(const char* _data, size_t _size);
+			/**
+			 * @brief Get the number of byte of the header (empty line include), the body start just after.
+			 * @return Size of the header (valid when the status is done)
+			 */
+			uint32_t getHeaderSize() const {
+				return m_position;
+			}
+			/**
+			 * @brief Check if the message is an answer.
+			 * @return true for an answer "HTTP/x.y code reason", false for a request "method uri HTTP/x.y"
+			 */
+			bool isAnswer() const {
+				return m_isAnswer;
+			}
+			/**
+			 * @brief Get the method of a request.
+			 * @return Position of the method.
+			 */
+			const Span& getMethod() const {
+				return m_lineOne[0];
+			}
+			/**
+			 * @brief Get the URI of a request.
+			 * @return Position of the URI.
+			 */
+			const Span& getUri() const {
+				return m_lineOne[1];
+			}
+			/**
+			 * @brief Get the protocol "HTTP/x.y" (request or answer).
+			 * @return Position of the protocol.
+			 */
+			const Span& getProtocol() const {
+				if (m_isAnswer == true) {
+					return m_lineOne[0];
+				}
+				return m_lineOne[2];
+			}
+			/**
+			 * @brief Get the status code of an answer.
+			 * @return Position of the code.
+			 */
+			const Span& getCode() const {
+				return m_lineOne[1];
+			}
+			/**
+			 * @brief Get the reason of an answer.
+			 * @return Position of the reason.
+			 */
+			const Span& getReason() const {
+				return m_lineOne[2];
+			}
+			/**
+			 * @brief Get the number of field of the header.
+			 * @return Number of field.
+			 */
+			size_t getNumberField() const {
+				return m_nbField;
+			}
+			/**
+			 * @brief Get a field of the header.
+			 * @param[in] _id Id of the field.
+			 * @return The field.
+			 */
+			const Field& getField(size_t _id) const {
+				return m_fields[_id];
+			}
+			/**
+			 * @brief Search a field (the name is not case sensitive).
+			 * @param[in] _data Parsed buffer.
+			 * @param[in] _key Name of the field.
+			 * @return Id of the field or -1 if not found.
+			 */
+			int32_t findField(const char* _data, const char* _key) const;
+		public:
+			/**
+			 * @brief Compare an element with a string (not case sensitive).
+			 * @param[in] _data Parsed buffer.
+			 * @param[in] _span Element to compare.
+			 * @param[in] _value String to compare with.
+			 * @return true if equal
+			 */
+			static bool isEqual(const char* _data, const Span& _span, const char* _value);
+			/**
+			 * @brief Create a string with an element.
+			 * @param[in] _data Parsed buffer.
+			 * @param[in] _span Element to extract.
+			 * @return New string
+			 */
+			static etk::String extract(const char* _data, const Span& _span) {
+				return etk::String(_data + _span.m_offset, _span.m_size);
+			}
+		private:
+			enum status setError();
+	};
+}
@@ -0,0 +1,225 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/LoadBalancer.hpp>
+#include <enet/TcpClient.hpp>
+#include <etk/stdTools.hpp>
+#include <etk/tool.hpp>
+
+enet::LoadBalancer::LoadBalancer(const etk::Vector<etk::String>& _list) :
+  m_smoothing(0.3f),
+  m_maxError(3),
+  m_ejectDuration(echrono::seconds(10)) {
+	for (auto &it : _list) {
+		size_t pos = it.rfind(':');
+		if (pos == etk::String::npos) {
+			ENET_ERROR("Endpoint without port: '" << it << "' ==> not added");
+			continue;
+		}
+		add(it.extract(0, pos), etk::string_to_uint16_t(it.extract(pos+1)));
+	}
+}
+
+void enet::LoadBalancer::add(const etk::String& _hostname, uint16_t _port) {
+	Endpoint element;
+	element.m_name = _hostname + ":" + etk::toString(_port);
+	element.m_hostname = _hostname;
+	element.m_port = _port;
+	element.m_latency = 0;
+	element.m_inFlight = 0;
+	element.m_nbError = 0;
+	ethread::UniqueLock lock(m_mutex);
+	m_list.pushBack(element);
+}
+
+size_t enet::LoadBalancer::size() const {
+	ethread::UniqueLock lock(m_mutex);
+	return m_list.size();
+}
+
+void enet::LoadBalancer::setEjection(uint32_t _maxError, echrono::Duration _duration) {
+	ethread::UniqueLock lock(m_mutex);
+	m_maxError = etk::max(_maxError, uint32_t(1));
+	m_ejectDuration = _duration;
+}
+
+void enet::LoadBalancer::setSmoothing(float _value) {
+	if (    _value <= 0.0f
+	     || _value > 1.0f) {
+		ENET_ERROR("Smoothing must be in ]0, 1] : " << _value);
+		return;
+	}
+	ethread::UniqueLock lock(m_mutex);
+	m_smoothing = _value;
+}
+
+int32_t enet::LoadBalancer::findId(const etk::String& _name) const {
+	for (size_t iii=0; iii<m_list.size(); ++iii) {
+		if (m_list[iii].m_name == _name) {
+			return iii;
+		}
+	}
+	return -1;
+}
+
+int32_t enet::LoadBalancer::selectId(const echrono::Steady& _now, const etk::Vector<int32_t>& _exclude) const {
+	etk::Vector<int32_t> available;
+	etk::Vector<int32_t> ejected;
+	for (size_t iii=0; iii<m_list.size(); ++iii) {
+		bool excluded = false;
+		for (auto &it : _exclude) {
+			if (it == int32_t(iii)) {
+				excluded = true;
+				break;
+			}
+		}
+		if (excluded == true) {
+			continue;
+		}
+		if (m_list[iii].m_ejectEnd <= _now) {
+			available.pushBack(iii);
+		} else {
+			ejected.pushBack(iii);
+		}
+	}
+	if (available.size() == 0) {
+		if (ejected.size() == 0) {
+			return -1;
+		}
+		// All the endpoints are ejected: use the one that come back first instead of failing.
+		int32_t out = ejected[0];
+		for (auto &it : ejected) {
+			if (m_list[it].m_ejectEnd < m_list[out].m_ejectEnd) {
+				out = it;
+			}
+		}
+		return out;
+	}
+	if (available.size() == 1) {
+		return available[0];
+	}
+	uint32_t first = etk::tool::urand(0, available.size()-1);
+	uint32_t second = etk::tool::urand(0, available.size()-2);
+	if (second >= first) {
+		second++;
+	}
+	// An unknown latency is the average of the known ones: a new endpoint is tried without taking all the
+	// connections until its first report (the in-flight count still increase its cost).
+	int64_t average = 0;
+	int64_t nbKnown = 0;
+	for (auto &it : available) {
+		if (m_list[it].m_latency != 0) {
+			average += m_list[it].m_latency;
+			nbKnown++;
+		}
+	}
+	average = nbKnown == 0 ? 1 : average / nbKnown;
+	const Endpoint& elemFirst = m_list[available[first]];
+	const Endpoint& elemSecond = m_list[available[second]];
+	int64_t costFirst = (elemFirst.m_latency == 0 ? average : elemFirst.m_latency) * int64_t(elemFirst.m_inFlight + 1);
+	int64_t costSecond = (elemSecond.m_latency == 0 ? average : elemSecond.m_latency) * int64_t(elemSecond.m_inFlight + 1);
+	if (costSecond < costFirst) {
+		return available[second];
+	}
+	return available[first];
+}
+
+etk::String enet::LoadBalancer::select() const {
+	ethread::UniqueLock lock(m_mutex);
+	int32_t id = selectId(echrono::Steady::now());
+	if (id < 0) {
+		return "";
+	}
+	return m_list[id].m_name;
+}
+
+bool enet::LoadBalancer::isEjected(const etk::String& _name) const {
+	ethread::UniqueLock lock(m_mutex);
+	int32_t id = findId(_name);
+	if (id < 0) {
+		return false;
+	}
+	return m_list[id].m_ejectEnd > echrono::Steady::now();
+}
+
+void enet::LoadBalancer::reportId(int32_t _id, bool _success, echrono::Duration _latency, const echrono::Steady& _now) {
+	Endpoint& element = m_list[_id];
+	if (_success == true) {
+		element.m_nbError = 0;
+		if (element.m_latency == 0) {
+			element.m_latency = etk::max(_latency.get(), int64_t(1));
+		} else {
+			element.m_latency = etk::max(int64_t(m_smoothing * _latency.get() + (1.0f - m_smoothing) * element.m_latency), int64_t(1));
+		}
+		return;
+	}
+	element.m_nbError++;
+	if (element.m_nbError >= m_maxError) {
+		ENET_WARNING("Eject endpoint " << element.m_name << " (" << element.m_nbError << " consecutive errors)");
+		element.m_ejectEnd = _now + m_ejectDuration;
+		// When it come back, a single error eject it again.
+		element.m_nbError = m_maxError - 1;
+	}
+}
+
+void enet::LoadBalancer::report(const etk::String& _name, bool _success, echrono::Duration _latency) {
+	ethread::UniqueLock lock(m_mutex);
+	int32_t id = findId(_name);
+	if (id < 0) {
+		ENET_ERROR("Report on an unknow endpoint: '" << _name << "'");
+		return;
+	}
+	reportId(id, _success, _latency, echrono::Steady::now());
+}
+
+enet::Tcp enet::LoadBalancer::connect(echrono::Duration _timeOut) {
+	// Each endpoint is tried only once per call (a failed endpoint keep its cost until it is ejected)
+	etk::Vector<int32_t> listTried;
+	while (true) {
+		etk::String hostname;
+		uint16_t port;
+		int32_t id;
+		{
+			ethread::UniqueLock lock(m_mutex);
+			id = selectId(echrono::Steady::now(), listTried);
+			if (id < 0) {
+				break;
+			}
+			listTried.pushBack(id);
+			hostname = m_list[id].m_hostname;
+			port = m_list[id].m_port;
+			m_list[id].m_inFlight++;
+		}
+		echrono::Steady start = echrono::Steady::now();
+		enet::Tcp connection = enet::connectTcpClient(hostname, port, 1, _timeOut);
+		echrono::Steady now = echrono::Steady::now();
+		bool success = connection.getConnectionStatus() == enet::Tcp::status::link;
+		{
+			ethread::UniqueLock lock(m_mutex);
+			reportId(id, success, now - start, now);
+			if (success == true) {
+				return connection;
+			}
+			m_list[id].m_inFlight--;
+		}
+		ENET_WARNING("Can not connect on endpoint " << hostname << ":" << port << " ==> try an other");
+	}
+	ENET_ERROR("Can not connect on any endpoint");
+	return etk::move(enet::Tcp());
+}
+
+void enet::LoadBalancer::release(const enet::Tcp& _connection) {
+	ethread::UniqueLock lock(m_mutex);
+	int32_t id = findId(_connection.getName());
+	if (id < 0) {
+		ENET_ERROR("Release a connection on an unknow endpoint: '" << _connection.getName() << "'");
+		return;
+	}
+	if (m_list[id].m_inFlight > 0) {
+		m_list[id].m_inFlight--;
+	}
+}
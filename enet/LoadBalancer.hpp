@@ -0,0 +1,103 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <enet/Tcp.hpp>
+#include <etk/Vector.hpp>
+#include <ethread/Mutex.hpp>
+#include <echrono/Steady.hpp>
+#include <echrono/Duration.hpp>
+
+namespace enet {
+	/**
+	 * @brief Client side load balancer on a list of equivalent endpoints "hostname:port".
+	 * The endpoint is selected with the "power of two choices": two endpoints are taken randomly and the one
+	 * with the lower cost (average latency * number of connection in use) is used.
+	 * An endpoint that fail too many times in a row is ejected for a while.
+	 */
+	class LoadBalancer {
+		private:
+			class Endpoint {
+				public:
+					etk::String m_name; //!< "hostname:port"
+					etk::String m_hostname; //!< Host name to connect with
+					uint16_t m_port; //!< Port to connect with
+					int64_t m_latency; //!< Average latency in nanoseconds (0 if unknown)
+					uint32_t m_inFlight; //!< Number of connection in use
+					uint32_t m_nbError; //!< Number of consecutive error
+					echrono::Steady m_ejectEnd; //!< End of the ejection
+			};
+			mutable ethread::Mutex m_mutex; //!< Protect the endpoints
+			etk::Vector<Endpoint> m_list; //!< All the endpoints
+			float m_smoothing; //!< Weight of a new latency in the average
+			uint32_t m_maxError; //!< Number of consecutive error before ejecting an endpoint
+			echrono::Duration m_ejectDuration; //!< Duration of an ejection
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _list List of endpoint "hostname:port".
+			 */
+			LoadBalancer(const etk::Vector<etk::String>& _list=etk::Vector<etk::String>());
+			virtual ~LoadBalancer() = default;
+		public:
+			/**
+			 * @brief Add an endpoint.
+			 * @param[in] _hostname Name or IP of the host.
+			 * @param[in] _port Port of the host.
+			 */
+			void add(const etk::String& _hostname, uint16_t _port);
+			/**
+			 * @brief Get the number of endpoint.
+			 * @return Number of endpoint
+			 */
+			size_t size() const;
+			/**
+			 * @brief Configure the ejection of the failing endpoints.
+			 * @param[in] _maxError Number of consecutive error before ejecting an endpoint.
+			 * @param[in] _duration Duration of an ejection.
+			 */
+			void setEjection(uint32_t _maxError, echrono::Duration _duration);
+			/**
+			 * @brief Set the weight of a new latency in the average (exponentially weighted moving average).
+			 * @param[in] _value Weight in ]0, 1].
+			 */
+			void setSmoothing(float _value);
+		public:
+			/**
+			 * @brief Select an endpoint and connect on it (on error, try the other endpoints: each endpoint is tried once)
+			 * @param[in] _timeOut Timeout of each connection.
+			 * @return The connection (status error if no endpoint can be connected)
+			 */
+			enet::Tcp connect(echrono::Duration _timeOut=echrono::seconds(1));
+			/**
+			 * @brief Give back a connection created with connect() (when the connection is closed or reused for an other thing)
+			 * @param[in] _connection Connection created by connect().
+			 */
+			void release(const enet::Tcp& _connection);
+			/**
+			 * @brief Report the result of an action on an endpoint (for example the latency of a request)
+			 * @param[in] _name Name of the endpoint "hostname:port" (the name of the connection).
+			 * @param[in] _success true if the action succeed.
+			 * @param[in] _latency Duration of the action.
+			 */
+			void report(const etk::String& _name, bool _success, echrono::Duration _latency);
+			/**
+			 * @brief Select the endpoint to use (without connecting).
+			 * @return Name of the endpoint "hostname:port" (empty if no endpoint)
+			 */
+			etk::String select() const;
+			/**
+			 * @brief Check if an endpoint is ejected.
+			 * @param[in] _name Name of the endpoint "hostname:port".
+			 * @return true if ejected
+			 */
+			bool isEjected(const etk::String& _name) const;
+		private:
+			int32_t selectId(const echrono::Steady& _now, const etk::Vector<int32_t>& _exclude=etk::Vector<int32_t>()) const;
+			int32_t findId(const etk::String& _name) const;
+			void reportId(int32_t _id, bool _success, echrono::Duration _latency, const echrono::Steady& _now);
+	};
+}
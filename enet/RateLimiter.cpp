@@ -0,0 +1,142 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/RateLimiter.hpp>
+#include <echrono/Steady.hpp>
+
+namespace enet {
+	namespace rateLimiter {
+		static const uint32_t NUMBER_SHARD = 16;
+		static const uint32_t MAX_PROBE = 8;
+		static uint32_t upperPowerOfTwo(uint32_t _value) {
+			uint32_t out = 1;
+			while (out < _value) {
+				out <<= 1;
+			}
+			return out;
+		}
+	}
+}
+
+enet::RateLimiter::RateLimiter(float _rate, uint32_t _burst, uint32_t _nbBucket) :
+  m_nbShard(enet::rateLimiter::NUMBER_SHARD),
+  m_shardSize(1),
+  m_emissionInterval(0),
+  m_burstTolerance(0),
+  m_nbReject(0),
+  m_nbOverflow(0) {
+	m_shardSize = enet::rateLimiter::upperPowerOfTwo(etk::max(_nbBucket / m_nbShard, enet::rateLimiter::MAX_PROBE));
+	m_buckets.resize(m_nbShard * m_shardSize);
+	for (auto &it : m_buckets) {
+		it.m_key = 0;
+		it.m_arrivalTime = 0;
+	}
+	setRate(_rate, _burst);
+}
+
+void enet::RateLimiter::setRate(float _rate, uint32_t _burst) {
+	if (_rate <= 0.0f) {
+		ENET_ERROR("Can not set a rate <= 0 ==> force 1 per second");
+		_rate = 1.0f;
+	}
+	if (_burst == 0) {
+		_burst = 1;
+	}
+	int64_t interval = int64_t(1000000000.0f / _rate);
+	__atomic_store_n(&m_emissionInterval, interval, __ATOMIC_RELAXED);
+	__atomic_store_n(&m_burstTolerance, interval * int64_t(_burst), __ATOMIC_RELAXED);
+}
+
+uint64_t enet::RateLimiter::getKey(const etk::String& _remoteAddress) {
+	// Remove the port: the limit is for the remote host.
+	size_t end = _remoteAddress.rfind(':');
+	if (end == etk::String::npos) {
+		end = _remoteAddress.size();
+	}
+	// FNV-1a
+	uint64_t out = 14695981039346656037ULL;
+	const char* data = _remoteAddress.c_str();
+	for (size_t iii=0; iii<end; ++iii) {
+		out ^= uint8_t(data[iii]);
+		out *= 1099511628211ULL;
+	}
+	if (out == 0) {
+		// 0 is reserved for the empty slots
+		out = 1;
+	}
+	return out;
+}
+
+bool enet::RateLimiter::check(const etk::String& _remoteAddress) {
+	return check(getKey(_remoteAddress));
+}
+
+bool enet::RateLimiter::consume(Bucket& _bucket, int64_t _now) {
+	int64_t interval = __atomic_load_n(&m_emissionInterval, __ATOMIC_RELAXED);
+	int64_t tolerance = __atomic_load_n(&m_burstTolerance, __ATOMIC_RELAXED);
+	int64_t arrivalTime = __atomic_load_n(&_bucket.m_arrivalTime, __ATOMIC_ACQUIRE);
+	while (true) {
+		int64_t newArrivalTime = etk::max(arrivalTime, _now) + interval;
+		if (newArrivalTime - _now > tolerance) {
+			__atomic_add_fetch(&m_nbReject, 1, __ATOMIC_RELAXED);
+			return false;
+		}
+		if (__atomic_compare_exchange_n(&_bucket.m_arrivalTime, &arrivalTime, newArrivalTime, true, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == true) {
+			return true;
+		}
+		// arrivalTime has been updated with the current value ==> retry
+	}
+}
+
+bool enet::RateLimiter::check(uint64_t _key) {
+	if (_key == 0) {
+		_key = 1;
+	}
+	int64_t now = echrono::Steady::now().get();
+	int64_t tolerance = __atomic_load_n(&m_burstTolerance, __ATOMIC_RELAXED);
+	Bucket* shard = &m_buckets[(_key & (m_nbShard-1)) * m_shardSize];
+	uint32_t mask = m_shardSize - 1;
+	uint32_t base = uint32_t(_key >> 32);
+	Bucket* reusable = null;
+	for (uint32_t iii=0; iii<enet::rateLimiter::MAX_PROBE; ++iii) {
+		Bucket& bucket = shard[(base + iii) & mask];
+		uint64_t key = __atomic_load_n(&bucket.m_key, __ATOMIC_ACQUIRE);
+		if (key == _key) {
+			return consume(bucket, now);
+		}
+		if (key == 0) {
+			if (    __atomic_compare_exchange_n(&bucket.m_key, &key, _key, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == true
+			     || key == _key) {
+				return consume(bucket, now);
+			}
+			continue;
+		}
+		// A bucket that is full of token has no more information ==> can be reused.
+		if (    reusable == null
+		     && __atomic_load_n(&bucket.m_arrivalTime, __ATOMIC_RELAXED) + tolerance <= now) {
+			reusable = &bucket;
+		}
+	}
+	if (reusable != null) {
+		uint64_t key = __atomic_load_n(&reusable->m_key, __ATOMIC_ACQUIRE);
+		if (__atomic_compare_exchange_n(&reusable->m_key, &key, _key, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE) == true) {
+			__atomic_store_n(&reusable->m_arrivalTime, 0, __ATOMIC_RELEASE);
+			return consume(*reusable, now);
+		}
+	}
+	// All the buckets are in use: do not block the legitimate remote.
+	__atomic_add_fetch(&m_nbOverflow, 1, __ATOMIC_RELAXED);
+	return true;
+}
+
+uint64_t enet::RateLimiter::getNumberReject() const {
+	return __atomic_load_n(&m_nbReject, __ATOMIC_RELAXED);
+}
+
+uint64_t enet::RateLimiter::getNumberOverflow() const {
+	return __atomic_load_n(&m_nbOverflow, __ATOMIC_RELAXED);
+}
@@ -0,0 +1,85 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+#include <etk/Vector.hpp>
+#include <echrono/Duration.hpp>
+
+namespace enet {
+	/**
+	 * @brief Token bucket rate limiter keyed by the remote address.
+	 * Each bucket is stored as a single "theoretical arrival time" (GCRA), this permit to update it with
+	 * a simple compare and swap: the check is lock-free and does not allocate.
+	 * The table is split in shards of fixed size (open addressing), when a shard is full the oldest idle
+	 * bucket (full of token) is reused.
+	 */
+	class RateLimiter {
+		private:
+			class Bucket {
+				public:
+					uint64_t m_key; //!< hash of the remote address (0 for an empty slot)
+					int64_t m_arrivalTime; //!< theoretical arrival time of the next token in nanoseconds
+			};
+			etk::Vector<Bucket> m_buckets; //!< All the buckets (m_nbShard * m_shardSize)
+			uint32_t m_nbShard; //!< Number of shards (power of 2)
+			uint32_t m_shardSize; //!< Number of bucket in a shard (power of 2)
+			int64_t m_emissionInterval; //!< Time to generate a token in nanoseconds
+			int64_t m_burstTolerance; //!< Maximum advance of the arrival time on the current time in nanoseconds
+			uint64_t m_nbReject; //!< Number of check rejected (statistic)
+			uint64_t m_nbOverflow; //!< Number of check accepted because the table is full (statistic)
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _rate Number of token generated per second for each remote address.
+			 * @param[in] _burst Size of the bucket (maximum number of check accepted at the same time).
+			 * @param[in] _nbBucket Number of remote address that can be tracked at the same time.
+			 */
+			RateLimiter(float _rate=20.0f, uint32_t _burst=40, uint32_t _nbBucket=16384);
+			virtual ~RateLimiter() = default;
+		public:
+			/**
+			 * @brief Configure the bucket properties.
+			 * @param[in] _rate Number of token generated per second for each remote address.
+			 * @param[in] _burst Size of the bucket (maximum number of check accepted at the same time).
+			 */
+			void setRate(float _rate, uint32_t _burst);
+			/**
+			 * @brief Consume a token for the remote address.
+			 * @param[in] _remoteAddress Remote address "IP:port" (the port is not used in the key).
+			 * @return true The action is accepted.
+			 * @return false The remote exceed its rate, the action must be rejected.
+			 */
+			bool check(const etk::String& _remoteAddress);
+			/**
+			 * @brief Consume a token for a key.
+			 * @param[in] _key Hash of the element to limit (0 is not a valid key).
+			 * @return true The action is accepted.
+			 * @return false The key exceed its rate, the action must be rejected.
+			 */
+			bool check(uint64_t _key);
+			/**
+			 * @brief Get the key of a remote address.
+			 * @param[in] _remoteAddress Remote address "IP:port" (the port is not used in the key).
+			 * @return The key to use with check(uint64_t).
+			 */
+			static uint64_t getKey(const etk::String& _remoteAddress);
+		public:
+			/**
+			 * @brief Get the number of check rejected since the start
+			 * @return Number of reject
+			 */
+			uint64_t getNumberReject() const;
+			/**
+			 * @brief Get the number of check accepted without tracking (all the buckets are in use)
+			 * @return Number of overflow
+			 */
+			uint64_t getNumberOverflow() const;
+		private:
+			bool consume(Bucket& _bucket, int64_t _now);
+	};
+}
@@ -0,0 +1,362 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/Resolver.hpp>
+#include <etk/Map.hpp>
+#include <etk/stdTools.hpp>
+#include <ethread/Mutex.hpp>
+#include <ethread/Thread.hpp>
+#include <ethread/tools.hpp>
+#include <echrono/Steady.hpp>
+extern "C" {
+	#include <string.h>
+}
+
+#ifdef __TARGET_OS__Windows
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
+#else
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <netdb.h>
+	#include <arpa/inet.h>
+#endif
+
+static_assert(sizeof(struct sockaddr_storage) <= 128, "Address storage is too small");
+
+enet::Address::Address() :
+  m_size(0) {
+	memset(m_data, 0, sizeof(m_data));
+}
+
+enet::Address::Address(const void* _data, int32_t _size) :
+  m_size(0) {
+	memset(m_data, 0, sizeof(m_data));
+	if (    _data == null
+	     || _size <= 0
+	     || _size > int32_t(sizeof(m_data))) {
+		ENET_ERROR("Can not create an address with size=" << _size);
+		return;
+	}
+	memcpy(m_data, _data, _size);
+	m_size = _size;
+}
+
+void enet::Address::setIpV4(uint8_t _first, uint8_t _second, uint8_t _third, uint8_t _quatro, uint16_t _port) {
+	memset(m_data, 0, sizeof(m_data));
+	struct sockaddr_in* addr = (struct sockaddr_in*)m_data;
+	addr->sin_family = AF_INET;
+	uint8_t* ip = (uint8_t*)&addr->sin_addr.s_addr;
+	ip[0] = _first;
+	ip[1] = _second;
+	ip[2] = _third;
+	ip[3] = _quatro;
+	addr->sin_port = htons(_port);
+	m_size = sizeof(struct sockaddr_in);
+}
+
+int32_t enet::Address::getFamily() const {
+	if (m_size == 0) {
+		return AF_UNSPEC;
+	}
+	return ((const struct sockaddr*)m_data)->sa_family;
+}
+
+void enet::Address::setPort(uint16_t _port) {
+	if (getFamily() == AF_INET) {
+		((struct sockaddr_in*)m_data)->sin_port = htons(_port);
+	} else if (getFamily() == AF_INET6) {
+		((struct sockaddr_in6*)m_data)->sin6_port = htons(_port);
+	}
+}
+
+uint16_t enet::Address::getPort() const {
+	if (getFamily() == AF_INET) {
+		return ntohs(((const struct sockaddr_in*)m_data)->sin_port);
+	} else if (getFamily() == AF_INET6) {
+		return ntohs(((const struct sockaddr_in6*)m_data)->sin6_port);
+	}
+	return 0;
+}
+
+etk::String enet::Address::getName() const {
+	char ipstr[INET6_ADDRSTRLEN];
+	ipstr[0] = '\0';
+	if (getFamily() == AF_INET) {
+		inet_ntop(AF_INET, (void*)&((const struct sockaddr_in*)m_data)->sin_addr, ipstr, sizeof(ipstr));
+		return etk::String(ipstr) + ":" + etk::toString(getPort());
+	} else if (getFamily() == AF_INET6) {
+		inet_ntop(AF_INET6, (void*)&((const struct sockaddr_in6*)m_data)->sin6_addr, ipstr, sizeof(ipstr));
+		return "[" + etk::String(ipstr) + "]:" + etk::toString(getPort());
+	}
+	return "";
+}
+
+bool enet::Address::operator== (const enet::Address& _obj) const {
+	return    m_size == _obj.m_size
+	       && memcmp(m_data, _obj.m_data, m_size) == 0;
+}
+
+namespace enet {
+	namespace resolver {
+		class CacheElement {
+			public:
+				etk::Vector<enet::Address> m_list; //!< Resolved addresses (port 0)
+				echrono::Steady m_expire; //!< Time when the element must be resolved again
+				echrono::Steady m_lastUse; //!< Last time the element has been requested
+				bool m_valid; //!< false for a negative cache element
+				CacheElement() :
+				  m_valid(false) {
+
+				}
+		};
+		class Cache {
+			public:
+				ethread::Mutex m_mutex;
+				etk::Map<etk::String, enet::resolver::CacheElement> m_list;
+				echrono::Duration m_timeToLivePositive;
+				echrono::Duration m_timeToLiveNegative;
+				enet::resolver::ResolveFunction m_function;
+				size_t m_maxSize; //!< Maximum number of entries (the expired then the least recently used are removed)
+				ethread::Thread* m_thread; //!< Refresh thread (protected by m_mutex)
+				bool m_threadRunning; //!< Refresh thread is running (protected by m_mutex)
+				Cache() :
+				  m_timeToLivePositive(echrono::seconds(60)),
+				  m_timeToLiveNegative(echrono::seconds(5)),
+				  m_function(null),
+				  m_maxSize(1024),
+				  m_thread(null),
+				  m_threadRunning(false) {
+
+				}
+				~Cache() {
+					stopThread();
+				}
+				void stopThread() {
+					ethread::Thread* thread = null;
+					{
+						ethread::UniqueLock lock(m_mutex);
+						m_threadRunning = false;
+						thread = m_thread;
+					}
+					if (thread == null) {
+						return;
+					}
+					thread->join();
+					ETK_DELETE(ethread::Thread, thread);
+					ethread::UniqueLock lock(m_mutex);
+					m_thread = null;
+				}
+				void threadCallback();
+		};
+		static Cache& getCache() {
+			static Cache cache;
+			return cache;
+		}
+		static bool systemResolve(const etk::String& _hostname, etk::Vector<enet::Address>& _result) {
+			struct addrinfo hints;
+			memset(&hints, 0, sizeof(hints));
+			hints.ai_family = AF_UNSPEC;
+			hints.ai_socktype = SOCK_STREAM;
+			hints.ai_protocol = IPPROTO_TCP;
+			struct addrinfo* result = null;
+			int iResult = getaddrinfo(_hostname.c_str(), null, &hints, &result);
+			if (iResult != 0) {
+				ENET_ERROR("getaddrinfo '" << _hostname << "' failed with error: " << iResult << "," << gai_strerror(iResult));
+				return false;
+			}
+			for (struct addrinfo* ptr=result;
+			     ptr != null;
+			     ptr=ptr->ai_next) {
+				if (    ptr->ai_family != AF_INET
+				     && ptr->ai_family != AF_INET6) {
+					continue;
+				}
+				enet::Address address(ptr->ai_addr, ptr->ai_addrlen);
+				bool find = false;
+				for (auto &it : _result) {
+					if (it == address) {
+						find = true;
+						break;
+					}
+				}
+				if (find == false) {
+					_result.pushBack(address);
+				}
+			}
+			freeaddrinfo(result);
+			return _result.size() != 0;
+		}
+		static bool resolveNoCache(const etk::String& _hostname, etk::Vector<enet::Address>& _result) {
+			enet::resolver::ResolveFunction function;
+			{
+				ethread::UniqueLock lock(getCache().m_mutex);
+				function = getCache().m_function;
+			}
+			if (function != null) {
+				return function(_hostname, _result);
+			}
+			return systemResolve(_hostname, _result);
+		}
+		/**
+		 * @brief Remove the expired entries, then the least recently used ones while the cache has more than _maxSize entries (the mutex must be locked).
+		 */
+		static void purge(Cache& _cache, const echrono::Steady& _now, size_t _maxSize) {
+			etk::Vector<etk::String> listRemove;
+			for (auto &it : _cache.m_list) {
+				if (it.second.m_expire <= _now) {
+					listRemove.pushBack(it.first);
+				}
+			}
+			for (auto &it : listRemove) {
+				_cache.m_list.remove(it);
+			}
+			while (_cache.m_list.size() > _maxSize) {
+				auto older = _cache.m_list.begin();
+				for (auto it = _cache.m_list.begin(); it != _cache.m_list.end(); ++it) {
+					if (it->second.m_lastUse < older->second.m_lastUse) {
+						older = it;
+					}
+				}
+				_cache.m_list.erase(older);
+			}
+		}
+		static void update(const etk::String& _hostname, bool _valid, const etk::Vector<enet::Address>& _list, const echrono::Steady& _now, bool _used) {
+			Cache& cache = getCache();
+			ethread::UniqueLock lock(cache.m_mutex);
+			auto it = cache.m_list.find(_hostname);
+			if (it == cache.m_list.end()) {
+				if (cache.m_list.size() >= cache.m_maxSize) {
+					// Keep a place for the new entry (the host names come from the remote data: no unlimited growth)
+					purge(cache, _now, cache.m_maxSize == 0 ? 0 : cache.m_maxSize - 1);
+				}
+				cache.m_list.add(_hostname, enet::resolver::CacheElement());
+				it = cache.m_list.find(_hostname);
+			}
+			enet::resolver::CacheElement& element = it->second;
+			if (_used == true) {
+				element.m_lastUse = _now;
+			}
+			element.m_valid = _valid;
+			element.m_list = _list;
+			if (_valid == true) {
+				element.m_expire = _now + cache.m_timeToLivePositive;
+			} else {
+				element.m_expire = _now + cache.m_timeToLiveNegative;
+			}
+		}
+	}
+}
+
+void enet::resolver::Cache::threadCallback() {
+	ethread::setName("enet-resolver");
+	while (true) {
+		ethread::sleepMilliSeconds(200);
+		echrono::Steady now = echrono::Steady::now();
+		etk::Vector<etk::String> listRefresh;
+		{
+			ethread::UniqueLock lock(m_mutex);
+			if (m_threadRunning == false) {
+				return;
+			}
+			enet::resolver::purge(*this, now, m_maxSize);
+			// refresh the entries used recently that will expire in less than 1/5 of their life.
+			echrono::Duration margin = echrono::nanoseconds(m_timeToLivePositive.get() / 5);
+			for (auto &it : m_list) {
+				if (    it.second.m_valid == true
+				     && now - it.second.m_lastUse < m_timeToLivePositive
+				     && it.second.m_expire - now < margin) {
+					listRefresh.pushBack(it.first);
+				}
+			}
+		}
+		for (auto &it : listRefresh) {
+			etk::Vector<enet::Address> list;
+			if (enet::resolver::resolveNoCache(it, list) == true) {
+				enet::resolver::update(it, true, list, now, false);
+			}
+			// On error, the previous value is kept until it expire.
+		}
+	}
+}
+
+bool enet::resolver::resolve(const etk::String& _hostname, uint16_t _port, etk::Vector<enet::Address>& _result) {
+	_result.clear();
+	if (_hostname == "") {
+		ENET_ERROR("Can not resolve an empty hostname");
+		return false;
+	}
+	echrono::Steady now = echrono::Steady::now();
+	bool find = false;
+	bool valid = false;
+	{
+		Cache& cache = getCache();
+		ethread::UniqueLock lock(cache.m_mutex);
+		auto it = cache.m_list.find(_hostname);
+		if (    it != cache.m_list.end()
+		     && now < it->second.m_expire) {
+			find = true;
+			valid = it->second.m_valid;
+			it->second.m_lastUse = now;
+			_result = it->second.m_list;
+		}
+	}
+	if (find == false) {
+		ENET_DEBUG("Resolve '" << _hostname << "' (not in cache)");
+		valid = enet::resolver::resolveNoCache(_hostname, _result);
+		enet::resolver::update(_hostname, valid, _result, now, true);
+	}
+	if (valid == false) {
+		_result.clear();
+		return false;
+	}
+	for (auto &it : _result) {
+		it.setPort(_port);
+	}
+	return true;
+}
+
+void enet::resolver::setTimeToLive(echrono::Duration _positive, echrono::Duration _negative) {
+	ethread::UniqueLock lock(getCache().m_mutex);
+	getCache().m_timeToLivePositive = _positive;
+	getCache().m_timeToLiveNegative = _negative;
+}
+
+void enet::resolver::setBackgroundRefresh(bool _enable) {
+	Cache& cache = getCache();
+	if (_enable == false) {
+		cache.stopThread();
+		return;
+	}
+	ethread::UniqueLock lock(cache.m_mutex);
+	if (cache.m_thread != null) {
+		return;
+	}
+	cache.m_threadRunning = true;
+	cache.m_thread = ETK_NEW(ethread::Thread, [&](){ cache.threadCallback();});
+	if (cache.m_thread == null) {
+		cache.m_threadRunning = false;
+		ENET_ERROR("creating resolver refresh thread!");
+	}
+}
+
+void enet::resolver::setResolveFunction(enet::resolver::ResolveFunction _function) {
+	ethread::UniqueLock lock(getCache().m_mutex);
+	getCache().m_function = _function;
+}
+
+void enet::resolver::setMaxSize(size_t _value) {
+	ethread::UniqueLock lock(getCache().m_mutex);
+	getCache().m_maxSize = _value;
+	enet::resolver::purge(getCache(), echrono::Steady::now(), _value);
+}
+
+void enet::resolver::clear() {
+	ethread::UniqueLock lock(getCache().m_mutex);
+	getCache().m_list.clear();
+}
@@ -0,0 +1,132 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/types.hpp>
+#include <etk/String.hpp>
+#include <etk/Vector.hpp>
+#include <etk/Function.hpp>
+#include <echrono/Duration.hpp>
+
+namespace enet {
+	/**
+	 * @brief Socket address (IPv4 or IPv6) with its port, ready to be used with connect().
+	 */
+	class Address {
+		private:
+			uint8_t m_data[128]; //!< Raw "struct sockaddr_storage"
+			int32_t m_size; //!< Size of the used data (0 if not set)
+		public:
+			Address();
+			/**
+			 * @brief Create an address from a system sockaddr.
+			 * @param[in] _data Pointer on the "struct sockaddr"
+			 * @param[in] _size Size of the structure
+			 */
+			Address(const void* _data, int32_t _size);
+			/**
+			 * @brief Set an IPv4 address
+			 * @param[in] _first Firt number of the IP v4.
+			 * @param[in] _second Second number of the IP v4.
+			 * @param[in] _third Third number of the IP v4.
+			 * @param[in] _quatro Quatro number of the IP v4.
+			 * @param[in] _port Port of the address.
+			 */
+			void setIpV4(uint8_t _first, uint8_t _second, uint8_t _third, uint8_t _quatro, uint16_t _port=0);
+			/**
+			 * @brief Check if the address is set.
+			 * @return true if an address is stored
+			 */
+			bool isValid() const {
+				return m_size != 0;
+			}
+			/**
+			 * @brief Get the address family (AF_INET or AF_INET6)
+			 * @return The system family value
+			 */
+			int32_t getFamily() const;
+			/**
+			 * @brief Set the port of the address.
+			 * @param[in] _port New port.
+			 */
+			void setPort(uint16_t _port);
+			/**
+			 * @brief Get the port of the address.
+			 * @return The port.
+			 */
+			uint16_t getPort() const;
+			/**
+			 * @brief Get the "struct sockaddr" pointer
+			 * @return Pointer on the data
+			 */
+			const void* getData() const {
+				return &m_data[0];
+			}
+			/**
+			 * @brief Get the size of the "struct sockaddr"
+			 * @return Size in byte
+			 */
+			int32_t getSize() const {
+				return m_size;
+			}
+			/**
+			 * @brief Get the descriptive name of the address "IP:port"
+			 * @return String with the address
+			 */
+			etk::String getName() const;
+			bool operator== (const enet::Address& _obj) const;
+			bool operator!= (const enet::Address& _obj) const {
+				return !(*this == _obj);
+			}
+	};
+	/**
+	 * @brief Host name resolution with an in-process cache (thread-safe).
+	 * The positive and negative results are kept for a limited time, and the used entries can be
+	 * refreshed in background before they expire.
+	 */
+	namespace resolver {
+		/**
+		 * @brief Function that resolve a host name (the port of the output addresses is not used).
+		 * @param[in] _hostname Name of the host to resolve.
+		 * @param[out] _result List of addresses of the host.
+		 * @return true if the host has been resolved
+		 */
+		using ResolveFunction = etk::Function<bool(const etk::String& _hostname, etk::Vector<enet::Address>& _result)>;
+		/**
+		 * @brief Resolve a host name (use the cache when possible)
+		 * @param[in] _hostname Name or IP of the host.
+		 * @param[in] _port Port to set in the addresses.
+		 * @param[out] _result List of addresses (IPv6 and IPv4)
+		 * @return true if the host has been resolved
+		 */
+		bool resolve(const etk::String& _hostname, uint16_t _port, etk::Vector<enet::Address>& _result);
+		/**
+		 * @brief Set the duration the results are kept in the cache.
+		 * @param[in] _positive Duration of a valid resolution.
+		 * @param[in] _negative Duration of a failed resolution.
+		 */
+		void setTimeToLive(echrono::Duration _positive, echrono::Duration _negative);
+		/**
+		 * @brief Set the maximum number of entries of the cache (the expired entries then the least recently used are removed).
+		 * @param[in] _value Number of entries (default 1024).
+		 */
+		void setMaxSize(size_t _value);
+		/**
+		 * @brief Enable or disable the background refresh of the used entries before they expire.
+		 * @param[in] _enable New state.
+		 */
+		void setBackgroundRefresh(bool _enable);
+		/**
+		 * @brief Replace the system resolver (getaddrinfo) by a specific function (for test)
+		 * @param[in] _function New resolver function (null to restore the system resolver)
+		 */
+		void setResolveFunction(ResolveFunction _function);
+		/**
+		 * @brief Remove all the entries of the cache.
+		 */
+		void clear();
+	}
+}
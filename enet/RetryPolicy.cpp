@@ -0,0 +1,105 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/RetryPolicy.hpp>
+#include <etk/tool.hpp>
+#include <ethread/tools.hpp>
+
+enet::RetryPolicy::RetryPolicy(uint32_t _maxAttempt, echrono::Duration _baseDelay, echrono::Duration _maxDelay, echrono::Duration _maxElapsed) :
+  m_maxAttempt(_maxAttempt),
+  m_baseDelay(_baseDelay),
+  m_maxDelay(_maxDelay),
+  m_maxElapsed(_maxElapsed),
+  m_budgetRatio(0.0f),
+  m_budgetMax(10.0f),
+  m_budgetToken(10.0f) {
+	setDelay(_baseDelay, _maxDelay);
+}
+
+void enet::RetryPolicy::setMaxAttempt(uint32_t _value) {
+	m_maxAttempt = _value;
+}
+
+void enet::RetryPolicy::setDelay(echrono::Duration _baseDelay, echrono::Duration _maxDelay) {
+	if (_baseDelay.get() <= 0) {
+		ENET_WARNING("Retry base delay must be > 0 ==> force 1ms");
+		_baseDelay = echrono::milliseconds(1);
+	}
+	if (_maxDelay < _baseDelay) {
+		_maxDelay = _baseDelay;
+	}
+	m_baseDelay = _baseDelay;
+	m_maxDelay = _maxDelay;
+}
+
+void enet::RetryPolicy::setMaxElapsed(echrono::Duration _value) {
+	m_maxElapsed = _value;
+}
+
+void enet::RetryPolicy::setBudget(float _ratio, float _max) {
+	ethread::UniqueLock lock(m_mutex);
+	m_budgetRatio = _ratio;
+	m_budgetMax = _max;
+	m_budgetToken = _max;
+}
+
+echrono::Duration enet::RetryPolicy::getNextDelay(echrono::Duration _previous) const {
+	int64_t base = m_baseDelay.get();
+	int64_t upper = etk::max(base, _previous.get() * 3);
+	int64_t delay = int64_t(etk::tool::frand(double(base), double(upper)));
+	delay = etk::min(etk::max(delay, base), m_maxDelay.get());
+	return echrono::nanoseconds(delay);
+}
+
+bool enet::RetryPolicy::acquireRetry() {
+	ethread::UniqueLock lock(m_mutex);
+	if (m_budgetRatio <= 0.0f) {
+		return true;
+	}
+	if (m_budgetToken < 1.0f) {
+		return false;
+	}
+	m_budgetToken -= 1.0f;
+	return true;
+}
+
+void enet::RetryPolicy::reportSuccess() {
+	ethread::UniqueLock lock(m_mutex);
+	m_budgetToken = etk::min(m_budgetToken + m_budgetRatio, m_budgetMax);
+}
+
+enet::RetryPolicy::Sequence::Sequence(enet::RetryPolicy& _policy) :
+  m_policy(_policy),
+  m_attempt(1),
+  m_startTime(echrono::Steady::now()),
+  m_delay(0) {
+
+}
+
+bool enet::RetryPolicy::Sequence::retry() {
+	if (m_attempt >= m_policy.getMaxAttempt()) {
+		ENET_DEBUG("Retry: no more attempt (" << m_attempt << ")");
+		return false;
+	}
+	m_delay = m_policy.getNextDelay(m_delay);
+	if ((echrono::Steady::now() + m_delay) - m_startTime > m_policy.m_maxElapsed) {
+		ENET_DEBUG("Retry: maximum elapsed time reached");
+		return false;
+	}
+	if (m_policy.acquireRetry() == false) {
+		ENET_WARNING("Retry: budget exhausted ==> no retry");
+		return false;
+	}
+	ENET_DEBUG("Retry: wait " << m_delay << " before attempt " << m_attempt+1);
+	ethread::sleepMilliSeconds(uint32_t(m_delay.get() / 1000000));
+	m_attempt++;
+	return true;
+}
+
+void enet::RetryPolicy::Sequence::success() {
+	m_policy.reportSuccess();
+}
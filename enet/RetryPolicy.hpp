@@ -0,0 +1,126 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/types.hpp>
+#include <ethread/Mutex.hpp>
+#include <echrono/Steady.hpp>
+#include <echrono/Duration.hpp>
+
+namespace enet {
+	/**
+	 * @brief Policy of the retry of a connection: exponential backoff with decorrelated jitter.
+	 * The delay between two attempt is random in [base, previous delay * 3] (limited to the maximum delay):
+	 * the clients that fail at the same time do not come back at the same time.
+	 * A retry budget can be shared between all the users of the policy: each success give a part of a
+	 * token and each retry consume a token, this avoid a retry storm when the remote is down.
+	 */
+	class RetryPolicy {
+		private:
+			uint32_t m_maxAttempt; //!< Maximum number of attempt (first one include)
+			echrono::Duration m_baseDelay; //!< Minimum delay between two attempts
+			echrono::Duration m_maxDelay; //!< Maximum delay between two attempts
+			echrono::Duration m_maxElapsed; //!< Maximum time since the first attempt to start a new one
+			mutable ethread::Mutex m_mutex; //!< Protect the budget
+			float m_budgetRatio; //!< Part of token given by a success (0 to disable the budget)
+			float m_budgetMax; //!< Maximum number of token in the budget
+			float m_budgetToken; //!< Current number of token in the budget
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _maxAttempt Maximum number of attempt (first one include).
+			 * @param[in] _baseDelay Minimum delay between two attempts.
+			 * @param[in] _maxDelay Maximum delay between two attempts.
+			 * @param[in] _maxElapsed Maximum time since the first attempt to start a new one.
+			 */
+			RetryPolicy(uint32_t _maxAttempt=5,
+			            echrono::Duration _baseDelay=echrono::milliseconds(100),
+			            echrono::Duration _maxDelay=echrono::seconds(10),
+			            echrono::Duration _maxElapsed=echrono::seconds(30));
+			virtual ~RetryPolicy() = default;
+		public:
+			/**
+			 * @brief Set the maximum number of attempt.
+			 * @param[in] _value New value (first attempt include).
+			 */
+			void setMaxAttempt(uint32_t _value);
+			/**
+			 * @brief Get the maximum number of attempt.
+			 * @return Number of attempt (first attempt include).
+			 */
+			uint32_t getMaxAttempt() const {
+				return m_maxAttempt;
+			}
+			/**
+			 * @brief Set the range of the delay between two attempts.
+			 * @param[in] _baseDelay Minimum delay.
+			 * @param[in] _maxDelay Maximum delay.
+			 */
+			void setDelay(echrono::Duration _baseDelay, echrono::Duration _maxDelay);
+			/**
+			 * @brief Set the maximum time since the first attempt to start a new one.
+			 * @param[in] _value New value.
+			 */
+			void setMaxElapsed(echrono::Duration _value);
+			/**
+			 * @brief Configure the retry budget.
+			 * @param[in] _ratio Part of token given by each success (0 to disable the budget).
+			 * @param[in] _max Maximum number of token (the budget start full).
+			 */
+			void setBudget(float _ratio, float _max);
+		public:
+			/**
+			 * @brief Get the delay before the next attempt (decorrelated jitter).
+			 * @param[in] _previous Previous delay (0 for the first retry).
+			 * @return Random delay in [base, min(max, previous*3)]
+			 */
+			echrono::Duration getNextDelay(echrono::Duration _previous) const;
+			/**
+			 * @brief Consume a token of the retry budget.
+			 * @return true The retry can be done.
+			 * @return false The budget is empty, the retry must not be done.
+			 */
+			bool acquireRetry();
+			/**
+			 * @brief Report a success to refill the retry budget.
+			 */
+			void reportSuccess();
+		public:
+			/**
+			 * @brief Retry state of one action (not thread-safe, one per action).
+			 */
+			class Sequence {
+				private:
+					enet::RetryPolicy& m_policy; //!< Reference on the policy
+					uint32_t m_attempt; //!< Number of attempt done
+					echrono::Steady m_startTime; //!< Time of the first attempt
+					echrono::Duration m_delay; //!< Last delay used
+				public:
+					/**
+					 * @brief Contructor (start the time of the sequence)
+					 * @param[in] _policy Policy to use.
+					 */
+					Sequence(enet::RetryPolicy& _policy);
+					/**
+					 * @brief Wait the delay before the next attempt (to call after a failed attempt)
+					 * @return true A new attempt can be done.
+					 * @return false No more retry (attempt, elapsed time or budget exhausted)
+					 */
+					bool retry();
+					/**
+					 * @brief Report the success of the action.
+					 */
+					void success();
+					/**
+					 * @brief Get the number of the current attempt.
+					 * @return Current attempt (start at 1)
+					 */
+					uint32_t getAttempt() const {
+						return m_attempt;
+					}
+			};
+	};
+}
@@ -0,0 +1,324 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/Router.hpp>
+#include <enet/HttpCanned.hpp>
+extern "C" {
+	#include <string.h>
+}
+
+namespace enet {
+	namespace router {
+		/**
+		 * @brief Get the position after the leading '/' of a path.
+		 */
+		static size_t skipSlash(const etk::String& _path) {
+			size_t pos = 0;
+			while (    pos < _path.size()
+			        && _path[pos] == '/') {
+				pos++;
+			}
+			return pos;
+		}
+		/**
+		 * @brief Check if a position is the start of a segment of the path.
+		 */
+		static bool isSegmentStart(const char* _path, size_t _pos) {
+			return    _pos == 0
+			       || _path[_pos-1] == '/';
+		}
+	}
+}
+
+enet::Router::Match::Match() :
+  m_uri(null),
+  m_size(0) {
+
+}
+
+bool enet::Router::Match::exist(const etk::String& _name) const {
+	for (size_t iii=0; iii<m_size; ++iii) {
+		if (*m_list[iii].m_name == _name) {
+			return true;
+		}
+	}
+	return false;
+}
+
+etk::String enet::Router::Match::get(const etk::String& _name) const {
+	for (size_t iii=0; iii<m_size; ++iii) {
+		if (*m_list[iii].m_name == _name) {
+			return enet::HttpParser::extract(m_uri, m_list[iii].m_value);
+		}
+	}
+	return "";
+}
+
+enet::Router::Node::Node(const etk::String& _prefix) :
+  m_prefix(_prefix),
+  m_parameter(null) {
+
+}
+
+enet::Router::Router() :
+  m_root(ememory::makeShared<Node>()),
+  m_default(null) {
+
+}
+
+bool enet::Router::add(enum enet::HTTPReqType _type, const etk::String& _path, Observer _observer) {
+	if (size_t(_type) >= NB_METHOD) {
+		ENET_ERROR("Can not add a route: wrong method");
+		return false;
+	}
+	if (_observer == null) {
+		ENET_ERROR("Can not add the route '" << _path << "': no function");
+		return false;
+	}
+	const char* path = _path.c_str();
+	size_t pos = enet::router::skipSlash(_path);
+	Node* node = m_root.get();
+	while (pos < _path.size()) {
+		if (    path[pos] == ':'
+		     && enet::router::isSegmentStart(path, pos) == true) {
+			size_t end = pos + 1;
+			while (    end < _path.size()
+			        && path[end] != '/') {
+				end++;
+			}
+			etk::String name = _path.extract(pos + 1, end);
+			if (name.size() == 0) {
+				ENET_ERROR("Can not add the route '" << _path << "': parameter without name");
+				return false;
+			}
+			if (node->m_parameter == null) {
+				node->m_parameter = ememory::makeShared<Node>();
+				if (node->m_parameter == null) {
+					ENET_ERROR("Can not allocate a node of the router");
+					return false;
+				}
+				node->m_parameterName = name;
+			} else if (node->m_parameterName != name) {
+				ENET_ERROR("Can not add the route '" << _path << "': the parameter ':" << name << "' conflict with ':" << node->m_parameterName << "'");
+				return false;
+			}
+			node = node->m_parameter.get();
+			pos = end;
+			continue;
+		}
+		if (    path[pos] == '*'
+		     && enet::router::isSegmentStart(path, pos) == true) {
+			etk::String name = _path.extract(pos + 1);
+			if (    name.size() == 0
+			     || strchr(name.c_str(), '/') != null) {
+				ENET_ERROR("Can not add the route '" << _path << "': the wildcard must have a name and be at the end of the path");
+				return false;
+			}
+			if (    node->m_wildcardName.size() != 0
+			     && node->m_wildcardName != name) {
+				ENET_ERROR("Can not add the route '" << _path << "': the wildcard '*" << name << "' conflict with '*" << node->m_wildcardName << "'");
+				return false;
+			}
+			node->m_wildcardName = name;
+			if (node->m_wildcard[size_t(_type)] != null) {
+				ENET_WARNING("Replace the route " << _type << " '" << _path << "'");
+			}
+			node->m_wildcard[size_t(_type)] = _observer;
+			return true;
+		}
+		// Static part: until the next parameter or wildcard
+		size_t end = pos + 1;
+		while (    end < _path.size()
+		        && (    (path[end] != ':' && path[end] != '*')
+		             || enet::router::isSegmentStart(path, end) == false)) {
+			end++;
+		}
+		Node* next = null;
+		for (auto &it : node->m_children) {
+			if (it->m_prefix[0] != path[pos]) {
+				continue;
+			}
+			size_t common = 1;
+			while (    common < it->m_prefix.size()
+			        && pos + common < end
+			        && it->m_prefix[common] == path[pos + common]) {
+				common++;
+			}
+			if (common < it->m_prefix.size()) {
+				// Split the node: the common part become the parent of the end
+				ememory::SharedPtr<Node> parent = ememory::makeShared<Node>(it->m_prefix.extract(0, common));
+				if (parent == null) {
+					ENET_ERROR("Can not allocate a node of the router");
+					return false;
+				}
+				it->m_prefix = it->m_prefix.extract(common);
+				parent->m_children.pushBack(it);
+				it = parent;
+			}
+			next = it.get();
+			pos += common;
+			break;
+		}
+		if (next == null) {
+			ememory::SharedPtr<Node> child = ememory::makeShared<Node>(_path.extract(pos, end));
+			if (child == null) {
+				ENET_ERROR("Can not allocate a node of the router");
+				return false;
+			}
+			node->m_children.pushBack(child);
+			next = child.get();
+			pos = end;
+		}
+		node = next;
+	}
+	if (node->m_observer[size_t(_type)] != null) {
+		ENET_WARNING("Replace the route " << _type << " '" << _path << "'");
+	}
+	node->m_observer[size_t(_type)] = _observer;
+	return true;
+}
+
+const enet::Router::Node* enet::Router::find(const Node* _node, const char* _uri, size_t _size, size_t _pos, Match& _match, bool& _wildcard) {
+	const etk::String& prefix = _node->m_prefix;
+	if (    _size - _pos < prefix.size()
+	     || memcmp(_uri + _pos, prefix.c_str(), prefix.size()) != 0) {
+		return null;
+	}
+	size_t pos = _pos + prefix.size();
+	if (pos == _size) {
+		for (size_t iii=0; iii<NB_METHOD; ++iii) {
+			if (_node->m_observer[iii] != null) {
+				_wildcard = false;
+				return _node;
+			}
+		}
+	} else {
+		// 1: static path
+		for (auto &it : _node->m_children) {
+			if (it->m_prefix[0] == _uri[pos]) {
+				const Node* out = find(it.get(), _uri, _size, pos, _match, _wildcard);
+				if (out != null) {
+					return out;
+				}
+				break;
+			}
+		}
+		// 2: parameter (not empty)
+		if (    _node->m_parameter != null
+		     && _match.m_size < MAX_PARAMETER
+		     && enet::router::isSegmentStart(_uri, pos) == true
+		     && _uri[pos] != '/') {
+			size_t end = pos + 1;
+			while (    end < _size
+			        && _uri[end] != '/') {
+				end++;
+			}
+			Match::Parameter& parameter = _match.m_list[_match.m_size];
+			parameter.m_name = &_node->m_parameterName;
+			parameter.m_value.m_offset = pos;
+			parameter.m_value.m_size = end - pos;
+			_match.m_size++;
+			const Node* out = find(_node->m_parameter.get(), _uri, _size, end, _match, _wildcard);
+			if (out != null) {
+				return out;
+			}
+			_match.m_size--;
+		}
+	}
+	// 3: wildcard (can be empty)
+	if (    _node->m_wildcardName.size() != 0
+	     && _match.m_size < MAX_PARAMETER
+	     && enet::router::isSegmentStart(_uri, pos) == true) {
+		Match::Parameter& parameter = _match.m_list[_match.m_size];
+		parameter.m_name = &_node->m_wildcardName;
+		parameter.m_value.m_offset = pos;
+		parameter.m_value.m_size = _size - pos;
+		_match.m_size++;
+		_wildcard = true;
+		return _node;
+	}
+	return null;
+}
+
+const enet::Router::Observer* enet::Router::find(enum enet::HTTPReqType _type, const etk::String& _uri, Match& _match, etk::String* _allow) const {
+	_match.m_uri = _uri.c_str();
+	_match.m_size = 0;
+	if (_allow != null) {
+		_allow->clear();
+	}
+	if (size_t(_type) >= NB_METHOD) {
+		return null;
+	}
+	bool wildcard = false;
+	const Node* node = find(m_root.get(), _uri.c_str(), _uri.size(), enet::router::skipSlash(_uri), _match, wildcard);
+	if (node == null) {
+		return null;
+	}
+	const Observer* list = wildcard == true ? node->m_wildcard : node->m_observer;
+	if (list[size_t(_type)] != null) {
+		return &list[size_t(_type)];
+	}
+	// RFC 7231 4.3.2: HEAD is a GET without body
+	if (    _type == enet::HTTPReqType::HTTP_HEAD
+	     && list[size_t(enet::HTTPReqType::HTTP_GET)] != null) {
+		return &list[size_t(enet::HTTPReqType::HTTP_GET)];
+	}
+	if (_allow != null) {
+		for (size_t iii=0; iii<NB_METHOD; ++iii) {
+			if (    list[iii] == null
+			     && (    iii != size_t(enet::HTTPReqType::HTTP_HEAD)
+			          || list[size_t(enet::HTTPReqType::HTTP_GET)] == null)) {
+				continue;
+			}
+			if (_allow->size() != 0) {
+				*_allow += ", ";
+			}
+			*_allow += etk::toString(enet::HTTPReqType(iii));
+		}
+	}
+	return null;
+}
+
+bool enet::Router::process(enet::HttpServer* _interface, const enet::HttpRequest& _request) const {
+	Match match;
+	etk::String allow;
+	const Observer* observer = find(_request.getType(), _request.getUri(), match, &allow);
+	if (observer != null) {
+		(*observer)(_interface, _request, match);
+		return true;
+	}
+	if (allow.size() == 0) {
+		return false;
+	}
+	// RFC 7231 6.5.5: the path exist with other methods
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c405_methodNotAllowed);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	answer.setKey(enet::HTTPHeaderId::allow, allow);
+	_interface->setHeader(answer, "");
+	return true;
+}
+
+void enet::Router::connect(enet::HttpServer* _interface) const {
+	_interface->connectHeader([this, _interface](const enet::HttpRequest& _value){
+		if (process(_interface, _value) == true) {
+			return;
+		}
+		if (m_default != null) {
+			m_default(_interface, _value);
+			return;
+		}
+		_interface->setHeader(*enet::httpCanned::get(enet::HTTPAnswerCode::c404_notFound));
+	});
+}
+
+etk::String enet::Router::checkUri(const etk::String& _uri, const etk::Vector<etk::String>&) const {
+	Match match;
+	if (find(enet::HTTPReqType::HTTP_GET, _uri, match) == null) {
+		return "CLOSE";
+	}
+	return "OK";
+}
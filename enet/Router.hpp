@@ -0,0 +1,173 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <enet/Http.hpp>
+#include <enet/HttpParser.hpp>
+#include <etk/Vector.hpp>
+#include <etk/String.hpp>
+#include <etk/Function.hpp>
+#include <ememory/memory.hpp>
+
+namespace enet {
+	//! @brief Dispatch the requests of a HttpServer on the functions registered for a method and a path.
+	//! The paths are stored in a compressed radix tree: the search time depends on the size of the URI, not on
+	//! the number of route. A path is composed of static parts, parameters (":name", one segment) and can end
+	//! with a wildcard ("*name", all the end of the URI). The static parts are checked first, then the parameter,
+	//! then the wildcard. The leading '/' of the paths and of the URIs are ignored.
+	//! @code
+	//!   ememory::SharedPtr<enet::Router> router = ememory::makeShared<enet::Router>();
+	//!   router->add(enet::HTTPReqType::HTTP_GET, "/user/:id/files/*path",
+	//!               [](enet::HttpServer* _interface, const enet::HttpRequest& _request, const enet::Router::Match& _match) {
+	//!                   etk::String id = _match.get("id");
+	//!                   ...
+	//!               });
+	//!   router->connect(&connection);
+	//! @endcode
+	class Router {
+		public:
+			static const size_t MAX_PARAMETER = 16; //!< Maximum number of parameter in a path
+			static const size_t NB_METHOD = size_t(enet::HTTPReqType::HTTP_OPTIONS) + 1; //!< Number of method of a route
+			/**
+			 * @brief Parameters of the path that match an URI (position in the URI, no copy).
+			 */
+			class Match {
+				friend class enet::Router;
+				private:
+					/**
+					 * @brief A parameter of the path.
+					 */
+					class Parameter {
+						public:
+							const etk::String* m_name; //!< Name of the parameter (in the route)
+							enet::HttpParser::Span m_value; //!< Position of the value in the URI
+					};
+					const char* m_uri; //!< Matched URI
+					Parameter m_list[MAX_PARAMETER]; //!< Parameters
+					size_t m_size; //!< Number of parameter
+				public:
+					Match();
+					/**
+					 * @brief Get the number of parameter.
+					 * @return Number of parameter (the wildcard is the last one).
+					 */
+					size_t size() const {
+						return m_size;
+					}
+					/**
+					 * @brief Get the name of a parameter.
+					 * @param[in] _id Index of the parameter.
+					 * @return Name of the parameter.
+					 */
+					const etk::String& getName(size_t _id) const {
+						return *m_list[_id].m_name;
+					}
+					/**
+					 * @brief Get the position of a parameter in the URI.
+					 * @param[in] _id Index of the parameter.
+					 * @return Position of the value in the URI.
+					 */
+					const enet::HttpParser::Span& getSpan(size_t _id) const {
+						return m_list[_id].m_value;
+					}
+					/**
+					 * @brief Check if a parameter exist.
+					 * @param[in] _name Name of the parameter.
+					 * @return true if the path has this parameter.
+					 */
+					bool exist(const etk::String& _name) const;
+					/**
+					 * @brief Get the value of a parameter.
+					 * @param[in] _name Name of the parameter.
+					 * @return Value of the parameter ("" if it does not exist).
+					 */
+					etk::String get(const etk::String& _name) const;
+			};
+			using Observer = etk::Function<void(enet::HttpServer* _interface, const enet::HttpRequest& _request, const enet::Router::Match& _match)>; //!< Function that answer a request
+			using ObserverDefault = etk::Function<void(enet::HttpServer* _interface, const enet::HttpRequest& _request)>; //!< Function that answer the requests without route
+		private:
+			/**
+			 * @brief Node of the radix tree.
+			 */
+			class Node {
+				public:
+					etk::String m_prefix; //!< Static part of the path
+					etk::Vector<ememory::SharedPtr<Node>> m_children; //!< Static children (all with a different first character)
+					ememory::SharedPtr<Node> m_parameter; //!< Child of the parameter segment
+					etk::String m_parameterName; //!< Name of the parameter segment
+					etk::String m_wildcardName; //!< Name of the wildcard (empty: no wildcard)
+					Observer m_observer[NB_METHOD]; //!< Functions of the path ended on this node
+					Observer m_wildcard[NB_METHOD]; //!< Functions of the wildcard
+				public:
+					Node(const etk::String& _prefix="");
+			};
+			ememory::SharedPtr<Node> m_root; //!< Root of the radix tree
+			ObserverDefault m_default; //!< Function called when no route match
+		public:
+			Router();
+			virtual ~Router() = default;
+		public:
+			//! @brief Add a route.
+			//! @param[in] _type Method of the request (a HEAD request use the GET route when it has no HEAD route).
+			//! @param[in] _path Path ("files/index.html", "user/:id", "static/*path").
+			//! @param[in] _observer Function called for the requests.
+			//! @return false if the path is invalid or conflict with an other route (name of a parameter).
+			bool add(enum enet::HTTPReqType _type, const etk::String& _path, Observer _observer);
+			/**
+			 * @brief Set the function called when no route match the URI (default: 404 answer).
+			 * @param[in] _observer Function to call (null for the 404 answer).
+			 */
+			void setDefault(ObserverDefault _observer) {
+				m_default = _observer;
+			}
+			/**
+			 * @brief Search the function of a request.
+			 * @param[in] _type Method of the request.
+			 * @param[in] _uri URI of the request (must exist while _match is used).
+			 * @param[out] _match Parameters of the path.
+			 * @param[out] _allow Methods of the path when the method has no route (for the "Allow" key), can be null.
+			 * @return The function or null if the path or the method has no route.
+			 */
+			const Observer* find(enum enet::HTTPReqType _type, const etk::String& _uri, Match& _match, etk::String* _allow=null) const;
+			/**
+			 * @brief Answer a request with the function of its route.
+			 * A path without the method is answered 405 (with the "Allow" key).
+			 * @param[in] _interface Connection that received the request.
+			 * @param[in] _request Request header.
+			 * @return true if the request is answered, false if no route match its URI (nothing is sent).
+			 */
+			bool process(enet::HttpServer* _interface, const enet::HttpRequest& _request) const;
+			/**
+			 * @brief Set the router as the header observer of a connection (process() then the default function).
+			 * @param[in] _interface Connection to dispatch (the router must exist while the connection is alive).
+			 */
+			void connect(enet::HttpServer* _interface) const;
+			/**
+			 * @brief Check the URI of a WebSocket connection (see WebSocket::connectUri()): accepted if it has a GET route.
+			 * @code
+			 *   connection.connectUri([=](const etk::String& _uri, const etk::Vector<etk::String>& _protocols) {
+			 *       return router->checkUri(_uri, _protocols);
+			 *   });
+			 * @endcode
+			 * @param[in] _uri URI of the request.
+			 * @param[in] _protocols Protocols asked by the remote (not checked: only the URI select the route).
+			 * @return "OK" or "CLOSE".
+			 */
+			etk::String checkUri(const etk::String& _uri, const etk::Vector<etk::String>& _protocols) const;
+		private:
+			/**
+			 * @brief Search the node of an URI (recursive).
+			 * @param[in] _node Node to check.
+			 * @param[in] _uri URI of the request.
+			 * @param[in] _size Size of the URI.
+			 * @param[in] _pos Position of the node in the URI.
+			 * @param[in,out] _match Parameters of the path.
+			 * @param[out] _wildcard The URI match the wildcard of the node.
+			 * @return The node or null.
+			 */
+			static const Node* find(const Node* _node, const char* _uri, size_t _size, size_t _pos, Match& _match, bool& _wildcard);
+	};
+}
@@ -0,0 +1,523 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/StaticFiles.hpp>
+#include <enet/HttpCanned.hpp>
+#include <enet/pourcentEncoding.hpp>
+#include <etk/stdTools.hpp>
+#include <sys/types.h>
+#include <sys/stat.h>
+extern "C" {
+	#include <fcntl.h>
+	#include <stdio.h>
+	#include <string.h>
+	#include <unistd.h>
+}
+#ifdef __TARGET_OS__Windows
+	#include <io.h>
+#endif
+
+namespace enet {
+	namespace staticFiles {
+		static char toLower(char _value) {
+			if (    _value >= 'A'
+			     && _value <= 'Z') {
+				return _value + ('a' - 'A');
+			}
+			return _value;
+		}
+		/**
+		 * @brief Get the path of a file with the URI of the request.
+		 * The segments "." are removed, the hidden files and the segments ".." are refused (no access out of the root).
+		 * @param[in] _uri URI of the request.
+		 * @param[in] _prefix Prefix of the files.
+		 * @param[out] _path Path relative to the root (empty or ended by '/' for a directory).
+		 * @return true if the URI is a valid path of the directory.
+		 */
+		static bool getPath(const etk::String& _uri, const etk::String& _prefix, etk::String& _path) {
+			size_t start = 0;
+			while (    start < _uri.size()
+			        && _uri[start] == '/') {
+				start++;
+			}
+			if (    _uri.size() - start < _prefix.size()
+			     || strncmp(&_uri.c_str()[start], _prefix.c_str(), _prefix.size()) != 0) {
+				return false;
+			}
+			// The prefix is a full segment: "static" does not match "/staticfoo/x"
+			if (    _prefix.size() != 0
+			     && _prefix[_prefix.size()-1] != '/'
+			     && start + _prefix.size() < _uri.size()
+			     && _uri[start + _prefix.size()] != '/') {
+				return false;
+			}
+			etk::String uri = enet::pourcentDecode(_uri.extract(start + _prefix.size()));
+			_path.clear();
+			size_t pos = 0;
+			while (pos < uri.size()) {
+				size_t end = pos;
+				while (    end < uri.size()
+				        && uri[end] != '/') {
+					end++;
+				}
+				if (    end - pos == 1
+				     && uri[pos] == '.') {
+					// current directory
+				} else if (end != pos) {
+					if (uri[pos] == '.') {
+						// ".." and hidden files (".git", ".htpasswd" ...)
+						return false;
+					}
+					for (size_t iii=pos; iii<end; ++iii) {
+						if (    uri[iii] == '\0'
+						     || uri[iii] == '\\') {
+							return false;
+						}
+					}
+					if (_path.size() != 0) {
+						_path += '/';
+					}
+					_path += uri.extract(pos, end);
+				}
+				pos = end + 1;
+			}
+			if (    uri.size() != 0
+			     && uri[uri.size()-1] == '/'
+			     && _path.size() != 0) {
+				_path += '/';
+			}
+			return true;
+		}
+		/**
+		 * @brief Read a decimal number.
+		 * @return Number of digit read (0 if none or if the number is too big).
+		 */
+		static size_t parseNumber(const char* _data, int64_t& _value) {
+			size_t size = 0;
+			_value = 0;
+			while (    _data[size] >= '0'
+			        && _data[size] <= '9') {
+				if (_value > (INT64_MAX - 9) / 10) {
+					return 0;
+				}
+				_value = _value * 10 + (_data[size] - '0');
+				size++;
+			}
+			return size;
+		}
+		/**
+		 * @brief Remove the spaces at the start and at the end of a string.
+		 */
+		static etk::String trim(const etk::String& _value, size_t _start, size_t _stop) {
+			while (    _start < _stop
+			        && (_value[_start] == ' ' || _value[_start] == '\t')) {
+				_start++;
+			}
+			while (    _stop > _start
+			        && (_value[_stop-1] == ' ' || _value[_stop-1] == '\t')) {
+				_stop--;
+			}
+			return _value.extract(_start, _stop);
+		}
+	}
+}
+
+enet::StaticFiles::File::File() :
+  m_fd(-1),
+  m_size(0),
+  m_modified(0),
+  m_id(0),
+  m_lastUse(0) {
+	
+}
+
+enet::StaticFiles::File::~File() {
+	if (m_fd >= 0) {
+		::close(m_fd);
+		m_fd = -1;
+	}
+}
+
+enet::StaticFiles::StaticFiles(const etk::String& _root, const etk::String& _prefix) :
+  m_root(_root),
+  m_prefix(_prefix),
+  m_index("index.html"),
+  m_cacheMaxSize(256),
+  m_checkInterval(echrono::seconds(1)),
+  m_cacheCounter(0) {
+	while (    m_root.size() > 0
+	        && m_root[m_root.size()-1] == '/') {
+		m_root.popBack();
+	}
+	size_t start = 0;
+	while (    start < m_prefix.size()
+	        && m_prefix[start] == '/') {
+		start++;
+	}
+	m_prefix = m_prefix.extract(start);
+	m_types.add("html", "text/html; charset=utf-8");
+	m_types.add("htm", "text/html; charset=utf-8");
+	m_types.add("css", "text/css; charset=utf-8");
+	m_types.add("js", "application/javascript");
+	m_types.add("json", "application/json");
+	m_types.add("txt", "text/plain; charset=utf-8");
+	m_types.add("xml", "application/xml");
+	m_types.add("svg", "image/svg+xml");
+	m_types.add("png", "image/png");
+	m_types.add("jpg", "image/jpeg");
+	m_types.add("jpeg", "image/jpeg");
+	m_types.add("gif", "image/gif");
+	m_types.add("webp", "image/webp");
+	m_types.add("ico", "image/x-icon");
+	m_types.add("woff", "font/woff");
+	m_types.add("woff2", "font/woff2");
+	m_types.add("ttf", "font/ttf");
+	m_types.add("wasm", "application/wasm");
+	m_types.add("pdf", "application/pdf");
+	m_types.add("zip", "application/zip");
+	m_types.add("gz", "application/gzip");
+	m_types.add("mp3", "audio/mpeg");
+	m_types.add("ogg", "audio/ogg");
+	m_types.add("mp4", "video/mp4");
+	m_types.add("webm", "video/webm");
+}
+
+void enet::StaticFiles::setIndex(const etk::String& _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_index = _value;
+	m_cache.clear();
+}
+
+void enet::StaticFiles::setMaxAge(echrono::Duration _value) {
+	int64_t seconds = _value.get() / 1000000000LL;
+	ethread::UniqueLock lock(m_mutex);
+	if (seconds <= 0) {
+		m_cacheControl = "";
+		return;
+	}
+	m_cacheControl = "public, max-age=" + etk::toString(seconds);
+}
+
+void enet::StaticFiles::addType(const etk::String& _extension, const etk::String& _type) {
+	etk::String extension = _extension;
+	for (auto &it : extension) {
+		it = enet::staticFiles::toLower(it);
+	}
+	ethread::UniqueLock lock(m_mutex);
+	m_types.set(extension, _type);
+}
+
+etk::String enet::StaticFiles::getType(const etk::String& _path) const {
+	size_t pos = _path.size();
+	while (    pos > 0
+	        && _path[pos-1] != '.'
+	        && _path[pos-1] != '/') {
+		pos--;
+	}
+	if (    pos > 0
+	     && _path[pos-1] == '.') {
+		etk::String extension = _path.extract(pos);
+		for (auto &it : extension) {
+			it = enet::staticFiles::toLower(it);
+		}
+		ethread::UniqueLock lock(m_mutex);
+		auto it = m_types.find(extension);
+		if (it != m_types.end()) {
+			return it->second;
+		}
+	}
+	return "application/octet-stream";
+}
+
+void enet::StaticFiles::setCacheSize(size_t _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_cacheMaxSize = _value;
+	if (m_cache.size() > m_cacheMaxSize) {
+		m_cache.clear();
+	}
+}
+
+void enet::StaticFiles::setCheckInterval(echrono::Duration _value) {
+	ethread::UniqueLock lock(m_mutex);
+	m_checkInterval = _value;
+}
+
+void enet::StaticFiles::clear() {
+	ethread::UniqueLock lock(m_mutex);
+	// The files in use by a connection are closed at the end of their answer
+	m_cache.clear();
+}
+
+ememory::SharedPtr<enet::StaticFiles::File> enet::StaticFiles::openFile(const etk::String& _path) const {
+	etk::String path = _path;
+	struct stat info;
+	if (::stat(path.c_str(), &info) != 0) {
+		return null;
+	}
+	if (S_ISDIR(info.st_mode) != 0) {
+		etk::String index;
+		{
+			ethread::UniqueLock lock(m_mutex);
+			index = m_index;
+		}
+		if (index.size() == 0) {
+			return null;
+		}
+		if (path[path.size()-1] != '/') {
+			path += '/';
+		}
+		path += index;
+	}
+	int flags = O_RDONLY;
+	#ifdef O_BINARY
+		flags |= O_BINARY;
+	#endif
+	#ifdef O_CLOEXEC
+		flags |= O_CLOEXEC;
+	#endif
+	int fd = ::open(path.c_str(), flags);
+	if (fd < 0) {
+		return null;
+	}
+	// Check the opened file (it can be changed between the 2 calls)
+	if (    ::fstat(fd, &info) != 0
+	     || S_ISREG(info.st_mode) == 0) {
+		::close(fd);
+		return null;
+	}
+	ememory::SharedPtr<File> file = ememory::makeShared<File>();
+	if (file == null) {
+		::close(fd);
+		return null;
+	}
+	file->m_path = path;
+	file->m_fd = fd;
+	file->m_size = info.st_size;
+	file->m_modified = info.st_mtime;
+	file->m_id = info.st_ino;
+	// Same format than the common servers: "<modification time>-<size>" in hexadecimal
+	char eTag[48];
+	snprintf(eTag, sizeof(eTag), "\"%llx-%llx\"", (unsigned long long)file->m_modified, (unsigned long long)file->m_size);
+	file->m_eTag = eTag;
+	file->m_lastModified = enet::httpDate::format(file->m_modified);
+	file->m_contentType = getType(path);
+	return file;
+}
+
+ememory::SharedPtr<enet::StaticFiles::File> enet::StaticFiles::getFile(const etk::String& _path) {
+	echrono::Steady now = echrono::Steady::now();
+	ememory::SharedPtr<File> file;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		auto it = m_cache.find(_path);
+		if (it != m_cache.end()) {
+			file = it->second;
+			file->m_lastUse = ++m_cacheCounter;
+			if (now - file->m_lastCheck < m_checkInterval) {
+				return file;
+			}
+		}
+	}
+	if (file != null) {
+		// Check if the file has been modified (the system call is done without lock)
+		struct stat info;
+		if (    ::stat(file->m_path.c_str(), &info) == 0
+		     && S_ISREG(info.st_mode) != 0
+		     && info.st_size == file->m_size
+		     && info.st_mtime == file->m_modified
+		     && uint64_t(info.st_ino) == file->m_id) {
+			ethread::UniqueLock lock(m_mutex);
+			file->m_lastCheck = now;
+			return file;
+		}
+	}
+	file = openFile(m_root + "/" + _path);
+	ethread::UniqueLock lock(m_mutex);
+	auto it = m_cache.find(_path);
+	if (it != m_cache.end()) {
+		m_cache.erase(it);
+	}
+	if (    file == null
+	     || m_cacheMaxSize == 0) {
+		return file;
+	}
+	file->m_lastCheck = now;
+	file->m_lastUse = ++m_cacheCounter;
+	// Close the least recently used files (the files in use are closed at the end of their answer)
+	while (m_cache.size() >= m_cacheMaxSize) {
+		auto oldest = m_cache.begin();
+		for (auto itCache = m_cache.begin(); itCache != m_cache.end(); ++itCache) {
+			if (itCache->second->m_lastUse < oldest->second->m_lastUse) {
+				oldest = itCache;
+			}
+		}
+		m_cache.erase(oldest);
+	}
+	m_cache.add(_path, file);
+	return file;
+}
+
+enum enet::StaticFiles::range enet::StaticFiles::parseRange(const etk::String& _value, int64_t _size, int64_t& _start, int64_t& _stop) {
+	etk::String value = enet::staticFiles::trim(_value, 0, _value.size());
+	if (    value.size() < 6
+	     || strncmp(value.c_str(), "bytes=", 6) != 0
+	     || value.find(',') != etk::String::npos) {
+		// Other unit or multiple ranges: the full file is sent (RFC 7233 3.1: the range can be ignored)
+		return range::full;
+	}
+	const char* data = value.c_str() + 6;
+	int64_t first = -1;
+	int64_t last = -1;
+	size_t size = enet::staticFiles::parseNumber(data, first);
+	if (size == 0) {
+		first = -1;
+	}
+	data += size;
+	if (*data != '-') {
+		return range::full;
+	}
+	data++;
+	size = enet::staticFiles::parseNumber(data, last);
+	if (size == 0) {
+		last = -1;
+	}
+	data += size;
+	if (*data != '\0') {
+		return range::full;
+	}
+	if (first < 0) {
+		// Suffix: "bytes=-500" is the last 500 bytes
+		if (last < 0) {
+			return range::full;
+		}
+		if (last == 0) {
+			return range::unsatisfiable;
+		}
+		_start = etk::max(_size - last, int64_t(0));
+		_stop = _size - 1;
+		if (_size == 0) {
+			return range::unsatisfiable;
+		}
+		return range::partial;
+	}
+	if (    last >= 0
+	     && last < first) {
+		return range::full;
+	}
+	if (first >= _size) {
+		return range::unsatisfiable;
+	}
+	_start = first;
+	_stop = _size - 1;
+	if (last >= 0) {
+		_stop = etk::min(last, _size - 1);
+	}
+	return range::partial;
+}
+
+bool enet::StaticFiles::matchETag(const etk::String& _list, const etk::String& _eTag) {
+	etk::String eTag = _eTag;
+	if (etk::start_with(eTag, "W/") == true) {
+		eTag = eTag.extract(2);
+	}
+	size_t pos = 0;
+	while (pos <= _list.size()) {
+		size_t end = _list.find(',', pos);
+		if (end == etk::String::npos) {
+			end = _list.size();
+		}
+		etk::String value = enet::staticFiles::trim(_list, pos, end);
+		if (value == "*") {
+			return true;
+		}
+		if (etk::start_with(value, "W/") == true) {
+			value = value.extract(2);
+		}
+		if (    value.size() != 0
+		     && value == eTag) {
+			return true;
+		}
+		pos = end + 1;
+	}
+	return false;
+}
+
+bool enet::StaticFiles::process(enet::HttpServer* _interface, const enet::HttpRequest& _request) {
+	if (    _request.getType() != enet::HTTPReqType::HTTP_GET
+	     && _request.getType() != enet::HTTPReqType::HTTP_HEAD) {
+		return false;
+	}
+	etk::String path;
+	if (enet::staticFiles::getPath(_request.getUri(), m_prefix, path) == false) {
+		return false;
+	}
+	ememory::SharedPtr<File> file = getFile(path);
+	if (file == null) {
+		return false;
+	}
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	answer.setKey(enet::HTTPHeaderId::eTag, file->m_eTag);
+	answer.setKey(enet::HTTPHeaderId::lastModified, file->m_lastModified);
+	etk::String cacheControl;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		cacheControl = m_cacheControl;
+	}
+	if (cacheControl.size() != 0) {
+		answer.setKey(enet::HTTPHeaderId::cacheControl, cacheControl);
+	}
+	// RFC 7232 6: "If-Modified-Since" is ignored when "If-None-Match" is set
+	bool notModified = false;
+	if (_request.existKey(enet::HTTPHeaderId::ifNoneMatch) == true) {
+		notModified = matchETag(_request.getKey(enet::HTTPHeaderId::ifNoneMatch), file->m_eTag);
+	} else if (_request.existKey(enet::HTTPHeaderId::ifModifiedSince) == true) {
+		int64_t date = 0;
+		notModified =    enet::httpDate::parse(_request.getKey(enet::HTTPHeaderId::ifModifiedSince), date) == true
+		              && file->m_modified <= date;
+	}
+	if (notModified == true) {
+		// No body and no size
+		answer.setErrorCode(enet::HTTPAnswerCode::c304_notModified);
+		_interface->setHeader(answer);
+		return true;
+	}
+	answer.setKey(enet::HTTPHeaderId::contentType, file->m_contentType);
+	answer.setKey(enet::HTTPHeaderId::acceptRanges, "bytes");
+	int64_t start = 0;
+	int64_t size = file->m_size;
+	if (_request.existKey(enet::HTTPHeaderId::range) == true) {
+		// RFC 7233 3.2: the range is used only if the file is the one of "If-Range" (entity tag or date)
+		bool useRange = true;
+		if (_request.existKey(enet::HTTPHeaderId::ifRange) == true) {
+			etk::String ifRange = _request.getKey(enet::HTTPHeaderId::ifRange);
+			useRange =    ifRange == file->m_eTag
+			           || ifRange == file->m_lastModified;
+		}
+		int64_t stop = 0;
+		enum range type = range::full;
+		if (useRange == true) {
+			type = parseRange(_request.getKey(enet::HTTPHeaderId::range), file->m_size, start, stop);
+		}
+		if (type == range::unsatisfiable) {
+			answer.setErrorCode(enet::HTTPAnswerCode::c416_requestedRangeNotSatisfiable);
+			answer.rmKey(enet::HTTPHeaderId::contentType);
+			answer.setKey(enet::HTTPHeaderId::contentRange, "bytes */" + etk::toString(file->m_size));
+			_interface->setHeader(answer, "");
+			return true;
+		}
+		if (type == range::partial) {
+			answer.setErrorCode(enet::HTTPAnswerCode::c206_partialContent);
+			answer.setKey(enet::HTTPHeaderId::contentRange, "bytes " + etk::toString(start) + "-" + etk::toString(stop) + "/" + etk::toString(file->m_size));
+			size = stop - start + 1;
+		} else {
+			start = 0;
+		}
+	}
+	_interface->sendFile(answer, file->m_fd, start, size);
+	return true;
+}
@@ -0,0 +1,153 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <enet/Http.hpp>
+#include <etk/Map.hpp>
+#include <etk/String.hpp>
+#include <ememory/memory.hpp>
+#include <ethread/Mutex.hpp>
+#include <echrono/Steady.hpp>
+#include <echrono/Duration.hpp>
+
+namespace enet {
+	/**
+	 * @brief Serve the files of a directory on a HttpServer (GET and HEAD requests).
+	 * The files are sent with sendfile (no copy in the user space), the opened files and their metadata are kept
+	 * in a cache shared by all the connections. The answers support the conditional requests ("If-None-Match",
+	 * "If-Modified-Since": 304) and one byte range ("Range": 206).
+	 * @code
+	 *   ememory::SharedPtr<enet::StaticFiles> files = ememory::makeShared<enet::StaticFiles>("/var/www", "static/");
+	 *   connection.connectHeader([=](const enet::HttpRequest& _value){
+	 *       if (files->process(tmp, _value) == false) {
+	 *           tmp->setHeader(*enet::httpCanned::get(enet::HTTPAnswerCode::c404_notFound));
+	 *       }
+	 *   });
+	 * @endcode
+	 */
+	class StaticFiles {
+		public:
+			enum class range {
+				full, //!< No range (or a range that is ignored): send all the file
+				partial, //!< One valid range
+				unsatisfiable //!< The range is out of the file
+			};
+		private:
+			/**
+			 * @brief Opened file and its metadata (the file is closed when the last user release it).
+			 */
+			class File {
+				public:
+					etk::String m_path; //!< Full path of the file
+					int32_t m_fd; //!< File descriptor
+					int64_t m_size; //!< Size of the file
+					int64_t m_modified; //!< Time of the last modification (second since 1970)
+					uint64_t m_id; //!< Identifier of the file in the file system (inode)
+					etk::String m_eTag; //!< Value of the "ETag" key
+					etk::String m_lastModified; //!< Value of the "Last-Modified" key
+					etk::String m_contentType; //!< Value of the "Content-Type" key
+					echrono::Steady m_lastCheck; //!< Last time the metadata have been checked
+					uint64_t m_lastUse; //!< Counter of the last use (LRU)
+				public:
+					File();
+					~File();
+					File(const File& _obj) = delete;
+					File& operator= (const File& _obj) = delete;
+			};
+			etk::String m_root; //!< Served directory
+			etk::String m_prefix; //!< Prefix of the URI of the files
+			etk::String m_index; //!< File sent for a directory
+			etk::String m_cacheControl; //!< Value of the "Cache-Control" key (empty: not sent)
+			etk::Map<etk::String, etk::String> m_types; //!< Content type of the extensions
+			mutable ethread::Mutex m_mutex; //!< Protect the cache and the configuration
+			etk::Map<etk::String, ememory::SharedPtr<File>> m_cache; //!< Opened files
+			size_t m_cacheMaxSize; //!< Maximum number of opened files
+			echrono::Duration m_checkInterval; //!< Time between 2 checks of the metadata of a file
+			uint64_t m_cacheCounter; //!< Use counter
+		public:
+			/**
+			 * @brief Contructor
+			 * @param[in] _root Directory to serve.
+			 * @param[in] _prefix Prefix of the URI of the files (removed to get the path of the file).
+			 */
+			StaticFiles(const etk::String& _root, const etk::String& _prefix="");
+			virtual ~StaticFiles() = default;
+		public:
+			/**
+			 * @brief Set the file sent when the URI is a directory.
+			 * @param[in] _value Name of the file (default "index.html", empty to disable).
+			 */
+			void setIndex(const etk::String& _value);
+			/**
+			 * @brief Set the time the remote can keep the files without asking them again.
+			 * @param[in] _value Time ("Cache-Control: max-age"), 0 to not send the key (default).
+			 */
+			void setMaxAge(echrono::Duration _value);
+			/**
+			 * @brief Set the content type of an extension (the common types are set by default).
+			 * @param[in] _extension Extension of the file without the dot (not case sensitive).
+			 * @param[in] _type Content type.
+			 */
+			void addType(const etk::String& _extension, const etk::String& _type);
+			/**
+			 * @brief Get the content type of a file.
+			 * @param[in] _path Path or name of the file.
+			 * @return Content type ("application/octet-stream" for an unknown extension).
+			 */
+			etk::String getType(const etk::String& _path) const;
+			/**
+			 * @brief Set the maximum number of file kept opened.
+			 * @param[in] _value Number of file (default 256, 0 to open the file for each request).
+			 */
+			void setCacheSize(size_t _value);
+			/**
+			 * @brief Set the time between 2 checks of the metadata of a file (the modified files are opened again).
+			 * @param[in] _value Time (default 1s).
+			 */
+			void setCheckInterval(echrono::Duration _value);
+			/**
+			 * @brief Remove all the files of the cache.
+			 */
+			void clear();
+		public:
+			/**
+			 * @brief Answer a request if it is a GET or a HEAD on an existing file.
+			 * @param[in] _interface Connection that received the request.
+			 * @param[in] _request Request header.
+			 * @return true if the request is answered, false if it is not a file of this directory (nothing is sent).
+			 */
+			bool process(enet::HttpServer* _interface, const enet::HttpRequest& _request);
+			/**
+			 * @brief Parse the value of a "Range" key (RFC 7233 2.1): only one byte range is supported.
+			 * @param[in] _value Value of the key ("bytes=0-99", "bytes=100-", "bytes=-100").
+			 * @param[in] _size Size of the file.
+			 * @param[out] _start First byte of the range.
+			 * @param[out] _stop Last byte of the range (included).
+			 * @return Type of the range (full for an invalid or a multiple range).
+			 */
+			static enum range parseRange(const etk::String& _value, int64_t _size, int64_t& _start, int64_t& _stop);
+			/**
+			 * @brief Check if an entity tag is in the value of a "If-None-Match" key (weak comparison, RFC 7232 2.3.2).
+			 * @param[in] _list Value of the key ("*" or a list of entity tag).
+			 * @param[in] _eTag Entity tag of the file.
+			 * @return true if the entity tag match.
+			 */
+			static bool matchETag(const etk::String& _list, const etk::String& _eTag);
+		private:
+			/**
+			 * @brief Get a file (from the cache or opened).
+			 * @param[in] _path Path of the file (relative to the root).
+			 * @return The file or null if it does not exist.
+			 */
+			ememory::SharedPtr<File> getFile(const etk::String& _path);
+			/**
+			 * @brief Open a file and read its metadata.
+			 * @param[in] _path Full path of the file.
+			 * @return The file or null if it does not exist (or is not a regular file).
+			 */
+			ememory::SharedPtr<File> openFile(const etk::String& _path) const;
+	};
+}
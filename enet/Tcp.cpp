@@ -18,17 +18,54 @@ extern "C" {
 #ifdef __TARGET_OS__Windows
 	#include <winsock2.h>
 	#include <ws2tcpip.h>
+	#include <io.h>
 #else
 	#include <sys/socket.h>
+	#include <sys/uio.h>
 	#include <netinet/in.h>
 	#include <netinet/tcp.h>
 	#include <netdb.h>
+	#include <poll.h>
+	#if    defined(__TARGET_OS__Linux) \
+	    || defined(__TARGET_OS__Android)
+		#include <sys/sendfile.h>
+	#endif
 #endif
 
 #ifdef ENET_STORE_INPUT
 	static uint32_t baseID = 0;
 #endif
 
+namespace enet {
+	namespace tcp {
+		#ifdef __TARGET_OS__Windows
+			using Socket = SOCKET;
+			using PollFd = WSAPOLLFD;
+		#else
+			using Socket = int32_t;
+			using PollFd = struct pollfd;
+		#endif
+		/**
+		 * @brief Wait an event on a socket with poll() (select() can not be used with a socket over FD_SETSIZE).
+		 * @param[in] _socket Socket to check.
+		 * @param[in] _events Events to wait (POLLIN or POLLOUT).
+		 * @param[in] _timeOutMs Maximum time to wait (0 to check without waiting).
+		 * @return >0 an event is present, 0 on time out, <0 on error.
+		 */
+		static int32_t waitEvent(Socket _socket, short _events, int32_t _timeOutMs) {
+			PollFd element;
+			element.fd = _socket;
+			element.events = _events;
+			element.revents = 0;
+			#ifdef __TARGET_OS__Windows
+				return WSAPoll(&element, 1, _timeOutMs);
+			#else
+				return ::poll(&element, 1, _timeOutMs);
+			#endif
+		}
+	}
+}
+
 bool enet::Tcp::setTCPNoDelay(bool _enabled) {
 	if (m_socketId >= 0) {
 		int flag = _enabled==true?1:0;
@@ -60,6 +97,7 @@ enet::Tcp::Tcp() :
   m_socketId(_idSocket),
   m_name(_name),
   m_remoteName(_remoteName),
+  m_linkTime(echrono::Steady::now()),
   m_status(status::link) {
 	#ifdef ENET_STORE_INPUT
 		m_nodeStoreInput = etk::FSNode("CACHE:StoreTCPdata_" + etk::toString(baseID++) + ".tcp");
@@ -71,7 +109,9 @@ enet::Tcp::Tcp(Tcp&& _obj) :
   m_socketId(_obj.m_socketId),
   m_name(_obj.m_name),
   m_remoteName(_obj.m_remoteName),
-  m_status(_obj.m_status) {
+  m_linkTime(_obj.m_linkTime),
+  m_status(_obj.m_status),
+  m_readBack(etk::move(_obj.m_readBack)) {
 	#ifdef ENET_STORE_INPUT
 		m_nodeStoreInput = etk::FSNode("CACHE:StoreTCPdata_" + etk::toString(baseID++) + ".tcp");
 		m_nodeStoreInput.fileOpenWrite();
@@ -103,8 +143,13 @@ enet::Tcp& enet::Tcp::operator = (enet::Tcp&& _obj) {
 	#endif
 	m_name = _obj.m_name;
 	_obj.m_name = "";
+	m_remoteName = _obj.m_remoteName;
+	_obj.m_remoteName = "";
+	m_linkTime = _obj.m_linkTime;
 	m_status = _obj.m_status;
 	_obj.m_status = status::error;
+	m_readBack = etk::move(_obj.m_readBack);
+	_obj.m_readBack.clear();
 	return *this;
 }
 
@@ -131,12 +176,89 @@ bool enet::Tcp::unlink() {
 	return true;
 }
 
+bool enet::Tcp::checkLink() {
+	if (m_status != status::link) {
+		return false;
+	}
+	if (m_readBack.size() != 0) {
+		// Data not consumed
+		return false;
+	}
+	int rc = enet::tcp::waitEvent(m_socketId, POLLIN, 0);
+	if (rc < 0) {
+		m_status = status::error;
+		return false;
+	}
+	if (rc == 0) {
+		// nothing to read ==> connection idle
+		return true;
+	}
+	// The socket is readable: the remote close the connection or send data nobody wait...
+	char tmp;
+	{
+		ethread::UniqueLock lock(m_mutex);
+		rc = recv(m_socketId, &tmp, 1, MSG_PEEK);
+	}
+	if (rc == 0) {
+		ENET_DEBUG("Connection closed by remote");
+		m_status = status::linkRemoteClose;
+	} else if (rc < 0) {
+		m_status = status::error;
+	}
+	return false;
+}
+
+bool enet::Tcp::waitData(echrono::Duration _timeOut) {
+	if (m_status != status::link) {
+		return false;
+	}
+	if (m_readBack.size() != 0) {
+		return true;
+	}
+	// round up to the next milli-second (do not spin on a small time out)
+	int64_t timeOut = (etk::max(_timeOut.get(), int64_t(0)) + 999999) / 1000000;
+	int rc = enet::tcp::waitEvent(m_socketId, POLLIN, int32_t(etk::min(timeOut, int64_t(0x7FFFFFFF))));
+	if (rc < 0) {
+		ENET_ERROR("	poll() failed");
+		return false;
+	}
+	return rc != 0;
+}
+
+bool enet::Tcp::waitWrite(echrono::Duration _timeOut) {
+	if (m_status != status::link) {
+		return false;
+	}
+	// round up to the next milli-second (do not spin on a small time out)
+	int64_t timeOut = (etk::max(_timeOut.get(), int64_t(0)) + 999999) / 1000000;
+	int rc = enet::tcp::waitEvent(m_socketId, POLLOUT, int32_t(etk::min(timeOut, int64_t(0x7FFFFFFF))));
+	if (rc < 0) {
+		ENET_ERROR("	poll() failed");
+		return false;
+	}
+	return rc != 0;
+}
+
+void enet::Tcp::putBack(const void* _data, int32_t _size) {
+	if (    _data == null
+	     || _size <= 0) {
+		return;
+	}
+	// Insert before the data not consumed
+	m_readBack.insert(m_readBack.begin(), (const uint8_t*)_data, (const uint8_t*)_data + _size);
+}
 
 int32_t enet::Tcp::read(void* _data, int32_t _maxLen) {
 	if (m_status != status::link) {
 		ENET_ERROR("Can not read on unlink connection");
 		return -1;
 	}
+	if (m_readBack.size() != 0) {
+		int32_t size = etk::min(_maxLen, int32_t(m_readBack.size()));
+		memcpy(_data, &m_readBack[0], size);
+		m_readBack.erase(m_readBack.begin(), m_readBack.begin() + size);
+		return size;
+	}
 	int32_t size = -1;
 	
 	fd_set sock;
@@ -231,3 +353,178 @@ int32_t enet::Tcp::write(const void* _data, int32_t _len) {
 	}
 	return size;
 }
+
+const size_t enet::Tcp::MAX_BUFFER;
+
+int32_t enet::Tcp::writeMultiple(const Buffer* _list, size_t _count, bool _more) {
+	if (m_status != status::link) {
+		ENET_ERROR("Can not write on unlink connection");
+		return -1;
+	}
+	if (    _list == null
+	     || _count > MAX_BUFFER) {
+		ENET_ERROR("try write " << _count << " buffers on TCP socket (max " << MAX_BUFFER << ")");
+		return -1;
+	}
+	int64_t total = 0;
+	#ifdef __TARGET_OS__Windows
+		WSABUF list[MAX_BUFFER];
+	#else
+		struct iovec list[MAX_BUFFER];
+	#endif
+	size_t nbElement = 0;
+	for (size_t iii=0; iii<_count; ++iii) {
+		if (_list[iii].m_size <= 0) {
+			continue;
+		}
+		if (_list[iii].m_data == null) {
+			ENET_ERROR("try write null data on TCP socket");
+			return -1;
+		}
+		#ifdef __TARGET_OS__Windows
+			list[nbElement].buf = (char*)_list[iii].m_data;
+			list[nbElement].len = _list[iii].m_size;
+		#else
+			list[nbElement].iov_base = (void*)_list[iii].m_data;
+			list[nbElement].iov_len = _list[iii].m_size;
+		#endif
+		total += _list[iii].m_size;
+		nbElement++;
+	}
+	if (nbElement == 0) {
+		return 0;
+	}
+	ethread::UniqueLock lock(m_mutex);
+	#ifdef __TARGET_OS__Windows
+		DWORD size = 0;
+		if (WSASend(m_socketId, list, nbElement, &size, 0, NULL, NULL) != 0) {
+			ENET_ERROR("PB when writing data on the FD : request=" << total << " error=" << WSAGetLastError());
+			m_status = status::error;
+			return -1;
+		}
+		return size;
+	#else
+		int flags = 0;
+		#ifdef MSG_MORE
+			if (_more == true) {
+				flags |= MSG_MORE;
+			}
+		#endif
+		int64_t written = 0;
+		size_t first = 0;
+		while (written < total) {
+			struct msghdr message;
+			memset(&message, 0, sizeof(message));
+			message.msg_iov = &list[first];
+			message.msg_iovlen = nbElement - first;
+			ssize_t size = ::sendmsg(m_socketId, &message, flags);
+			if (size < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				ENET_ERROR("PB when writing data on the FD : request=" << total << " have=" << written << ", erno=" << errno << "," << strerror(errno));
+				m_status = status::error;
+				return -1;
+			}
+			written += size;
+			// Partial write: skip the buffers sent
+			while (    first < nbElement
+			        && size_t(size) >= list[first].iov_len) {
+				size -= list[first].iov_len;
+				first++;
+			}
+			if (first < nbElement) {
+				list[first].iov_base = (uint8_t*)list[first].iov_base + size;
+				list[first].iov_len -= size;
+			}
+		}
+		return written;
+	#endif
+}
+
+int64_t enet::Tcp::writeFile(int32_t _fd, int64_t _offset, int64_t _size) {
+	if (m_status != status::link) {
+		ENET_ERROR("Can not write on unlink connection");
+		return -1;
+	}
+	if (    _fd < 0
+	     || _offset < 0
+	     || _size < 0) {
+		ENET_ERROR("try write file fd=" << _fd << " offset=" << _offset << " size=" << _size << " on TCP socket");
+		return -1;
+	}
+	ethread::UniqueLock lock(m_mutex);
+	int64_t written = 0;
+	#if    defined(__TARGET_OS__Linux) \
+	    || defined(__TARGET_OS__Android)
+		// The data never go in the user space
+		off_t offset = _offset;
+		while (written < _size) {
+			ssize_t size = ::sendfile(m_socketId, _fd, &offset, etk::min(_size - written, int64_t(0x7ffff000)));
+			if (size < 0) {
+				if (errno == EINTR) {
+					continue;
+				}
+				ENET_ERROR("PB when sending file on the FD : request=" << _size << " have=" << written << ", erno=" << errno << "," << strerror(errno));
+				m_status = status::error;
+				return -1;
+			}
+			if (size == 0) {
+				// End of the file
+				break;
+			}
+			written += size;
+		}
+	#else
+		uint8_t buffer[65536];
+		while (written < _size) {
+			int64_t size = etk::min(_size - written, int64_t(sizeof(buffer)));
+			#ifdef __TARGET_OS__Windows
+				OVERLAPPED position;
+				memset(&position, 0, sizeof(position));
+				position.Offset = DWORD(uint64_t(_offset + written) & 0xFFFFFFFF);
+				position.OffsetHigh = DWORD(uint64_t(_offset + written) >> 32);
+				DWORD nbRead = 0;
+				if (    ReadFile((HANDLE)_get_osfhandle(_fd), buffer, DWORD(size), &nbRead, &position) == FALSE
+				     && GetLastError() != ERROR_HANDLE_EOF) {
+					ENET_ERROR("PB when reading the file to send: error=" << GetLastError());
+					return -1;
+				}
+				size = nbRead;
+			#else
+				size = ::pread(_fd, buffer, size, _offset + written);
+				if (size < 0) {
+					if (errno == EINTR) {
+						continue;
+					}
+					ENET_ERROR("PB when reading the file to send: erno=" << errno << "," << strerror(errno));
+					return -1;
+				}
+			#endif
+			if (size == 0) {
+				// End of the file
+				break;
+			}
+			int64_t sent = 0;
+			while (sent < size) {
+				#ifdef __TARGET_OS__Windows
+					int len = ::send(m_socketId, (const char *)&buffer[sent], int(size - sent), 0);
+				#else
+					ssize_t len = ::send(m_socketId, &buffer[sent], size - sent, 0);
+					if (    len < 0
+					     && errno == EINTR) {
+						continue;
+					}
+				#endif
+				if (len <= 0) {
+					ENET_ERROR("PB when sending file on the FD : request=" << _size << " have=" << written + sent << ", erno=" << errno << "," << strerror(errno));
+					m_status = status::error;
+					return -1;
+				}
+				sent += len;
+			}
+			written += size;
+		}
+	#endif
+	return written;
+}
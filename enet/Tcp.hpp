@@ -8,6 +8,9 @@
 #include <etk/types.hpp>
 #include <ethread/Mutex.hpp>
 #include <etk/Function.hpp>
+#include <etk/Vector.hpp>
+#include <echrono/Steady.hpp>
+#include <echrono/Duration.hpp>
 #ifdef __TARGET_OS__Windows
 	#include <winsock2.h>
 	#include <ws2tcpip.h>
@@ -65,6 +68,16 @@ namespace enet {
 			const etk::String& getRemoteName() const {
 				return m_remoteName;
 			}
+		private:
+			echrono::Steady m_linkTime; //!< Time when the connection has been established (or accepted).
+		public:
+			/**
+			 * @brief Get the time when the connection has been established (or accepted)
+			 * @return The steady time of the link
+			 */
+			const echrono::Steady& getLinkTime() const {
+				return m_linkTime;
+			}
 		public:
 			enum class status {
 				unlink,
@@ -89,6 +102,32 @@ namespace enet {
 			 * @return false otherwise ...
 			 */
 			bool unlink();
+			/**
+			 * @brief Check (without blocking) if the connection can still be used: not closed by the remote and no pending data.
+			 * @return true if the connection is usable
+			 */
+			bool checkLink();
+			/**
+			 * @brief Wait some data to read (or the close of the connection).
+			 * @param[in] _timeOut Maximum time to wait.
+			 * @return true if read() will not block, false if the time out is reached or on error.
+			 */
+			bool waitData(echrono::Duration _timeOut);
+			/**
+			 * @brief Wait some space in the send buffer of the socket.
+			 * @param[in] _timeOut Maximum time to wait (0 to check without waiting).
+			 * @return true if write() can send data without waiting the remote, false if the time out is reached or on error.
+			 */
+			bool waitWrite(echrono::Duration _timeOut);
+		private:
+			etk::Vector<uint8_t> m_readBack; //!< Data read in advance, given back before the socket data
+		public:
+			/**
+			 * @brief Give back data read in advance: it will be returned by the next read() before the socket data.
+			 * @param[in] _data Pointer on the data.
+			 * @param[in] _size Number of byte.
+			 */
+			void putBack(const void* _data, int32_t _size);
 			/**
 			 * @brief Read a chunk of data on the socket
 			 * @param[in] _data pointer on the data might be write
@@ -105,6 +144,33 @@ namespace enet {
 			 * @return -1 an error occured.
 			 */
 			int32_t write(const void* _data, int32_t _len);
+			/**
+			 * @brief Part of the data written by writeMultiple().
+			 */
+			class Buffer {
+				public:
+					const void* m_data; //!< Pointer on the data
+					int32_t m_size; //!< Number of byte
+			};
+			static const size_t MAX_BUFFER = 16; //!< Maximum number of buffer in one writeMultiple()
+			/**
+			 * @brief Write multiple buffers in one system call (vectored send: no copy of the data).
+			 * @param[in] _list List of buffers (the empty ones are skipped).
+			 * @param[in] _count Number of buffer (max MAX_BUFFER).
+			 * @param[in] _more Other data will follow: the last partial packet is kept for the next write (Linux only).
+			 * @return >0 byte size on the socket write
+			 * @return -1 an error occured.
+			 */
+			int32_t writeMultiple(const Buffer* _list, size_t _count, bool _more=false);
+			/**
+			 * @brief Write a part of a file on the socket (the data are copied by the kernel when possible: sendfile).
+			 * @param[in] _fd File descriptor (it is not moved: the same file can be sent by several connections).
+			 * @param[in] _offset Position of the first byte in the file.
+			 * @param[in] _size Number of byte.
+			 * @return >=0 byte size on the socket write (less than _size if the end of the file is reached)
+			 * @return -1 an error occured.
+			 */
+			int64_t writeFile(int32_t _fd, int64_t _offset, int64_t _size);
 			/**
 			 * @brief Write a chunk of data on the socket
 			 * @param[in] _data String to rite on the soccket
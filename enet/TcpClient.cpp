@@ -8,6 +8,9 @@
 #include <enet/Tcp.hpp>
 #include <enet/TcpClient.hpp>
 #include <enet/enet.hpp>
+#include <enet/Resolver.hpp>
+#include <ethread/tools.hpp>
+#include <ememory/memory.hpp>
 extern "C" {
 	#include <sys/types.h>
 	#include <errno.h>
@@ -17,23 +20,360 @@ extern "C" {
 #include <etk/stdTools.hpp>
 
 #ifdef __TARGET_OS__Windows
-
+	#include <winsock2.h>
+	#include <ws2tcpip.h>
 #else
+	#include <sys/socket.h>
 	#include <netinet/in.h>
 	#include <netdb.h>
-	#include <netinet/in.h>
 	#include <arpa/inet.h>
+	#include <netinet/tcp.h>
+	#include <fcntl.h>
+	#include <poll.h>
 #endif
 
-enet::Tcp enet::connectTcpClient(const etk::String& _config, uint32_t _numberRetry, echrono::Duration _timeOut) {
-	size_t pos = _config.find(':');
-	if (pos == etk::String::npos) {
-		return etk::move(enet::connectTcpClient(_config, 0, _numberRetry, _timeOut));
+namespace enet {
+	namespace tcpClient {
+		#ifdef __TARGET_OS__Windows
+			using Socket = SOCKET;
+			using PollFd = WSAPOLLFD;
+			static const SOCKET INVALID = INVALID_SOCKET;
+		#else
+			using Socket = int32_t;
+			using PollFd = struct pollfd;
+			static const int32_t INVALID = -1;
+		#endif
+		/**
+		 * @brief Delay before starting a connection on the next address when the previous one does not answer (RFC 8305 "Connection Attempt Delay")
+		 */
+		static const int32_t CONNECTION_ATTEMPT_DELAY_MS = 100;
+		static void closeSocket(Socket _socket) {
+			#ifdef __TARGET_OS__Windows
+				closesocket(_socket);
+			#else
+				close(_socket);
+			#endif
+		}
+		static bool setBlocking(Socket _socket, bool _blocking) {
+			#ifdef __TARGET_OS__Windows
+				u_long mode = _blocking == true ? 0 : 1;
+				return ioctlsocket(_socket, FIONBIO, &mode) == 0;
+			#else
+				int flags = fcntl(_socket, F_GETFL, 0);
+				if (flags < 0) {
+					return false;
+				}
+				if (_blocking == true) {
+					flags &= ~O_NONBLOCK;
+				} else {
+					flags |= O_NONBLOCK;
+				}
+				return fcntl(_socket, F_SETFL, flags) == 0;
+			#endif
+		}
+		static int32_t poll(PollFd* _fds, size_t _count, int32_t _timeOutMs) {
+			#ifdef __TARGET_OS__Windows
+				return WSAPoll(_fds, _count, _timeOutMs);
+			#else
+				return ::poll(_fds, _count, _timeOutMs);
+			#endif
+		}
+		/**
+		 * @brief Split a "hostname:port" (IPv6: "[::1]:port") in its host and its port.
+		 * @param[in] _value Host and port.
+		 * @param[out] _hostname Host (without the brackets).
+		 * @param[out] _port Port (0 if not set).
+		 */
+		static void splitHost(const etk::String& _value, etk::String& _hostname, uint16_t& _port) {
+			_hostname = _value;
+			_port = 0;
+			size_t pos = _value.rfind(':');
+			if (    pos != etk::String::npos
+			     && (    _value[0] != '['
+			          || _value.rfind(']') < pos)) {
+				_hostname = _value.extract(0, pos);
+				_port = etk::string_to_uint16_t(_value.extract(pos+1));
+			}
+			if (    _hostname.size() >= 2
+			     && _hostname[0] == '['
+			     && _hostname[_hostname.size()-1] == ']') {
+				_hostname = _hostname.extract(1, _hostname.size()-1);
+			}
+		}
+		/**
+		 * @brief Sort the address to alternate the families, starting with the first family given by the resolver (RFC 8305)
+		 */
+		static etk::Vector<enet::Address> sortAddress(const etk::Vector<enet::Address>& _list) {
+			etk::Vector<enet::Address> out;
+			if (_list.size() == 0) {
+				return out;
+			}
+			etk::Vector<enet::Address> first;
+			etk::Vector<enet::Address> second;
+			for (auto &it : _list) {
+				if (it.getFamily() == _list[0].getFamily()) {
+					first.pushBack(it);
+				} else {
+					second.pushBack(it);
+				}
+			}
+			for (size_t iii=0; iii<etk::max(first.size(), second.size()); ++iii) {
+				if (iii < first.size()) {
+					out.pushBack(first[iii]);
+				}
+				if (iii < second.size()) {
+					out.pushBack(second[iii]);
+				}
+			}
+			return out;
+		}
+		/**
+		 * @brief Connection state machine on a list of address: start a non-blocking connection on an address,
+		 * and start the next one if it has not succeed after the attempt delay (or as soon as it fail).
+		 * The first connection established is kept and the other are closed.
+		 */
+		class HappyEyeballs {
+			private:
+				class Attempt {
+					public:
+						Socket m_socket;
+						size_t m_index;
+				};
+				etk::Vector<enet::Address> m_list; //!< Sorted list of address
+				size_t m_next; //!< Next address to try
+				etk::Vector<Attempt> m_attempts; //!< Connection in progress
+				echrono::Steady m_nextStart; //!< Time to start the next attempt
+				echrono::Steady m_deadline; //!< Time to stop all the connections
+				Socket m_winner; //!< Connected socket
+				etk::String m_error; //!< Last error
+			public:
+				HappyEyeballs() :
+				  m_next(0),
+				  m_winner(INVALID) {
+					
+				}
+				~HappyEyeballs() {
+					abort();
+				}
+				void init(const etk::Vector<enet::Address>& _list, const echrono::Steady& _deadline) {
+					abort();
+					m_list = sortAddress(_list);
+					m_next = 0;
+					m_deadline = _deadline;
+					m_nextStart = echrono::Steady();
+					m_winner = INVALID;
+					m_error = "";
+				}
+				bool isConnected() const {
+					return m_winner != INVALID;
+				}
+				bool isFinished() const {
+					return    m_winner != INVALID
+					       || (    m_attempts.size() == 0
+					            && m_next >= m_list.size());
+				}
+				const etk::String& getError() const {
+					return m_error;
+				}
+				const enet::Address& getAddress(size_t _index) const {
+					return m_list[_index];
+				}
+				/**
+				 * @brief Get the connected socket (the caller become the owner)
+				 */
+				Socket extractSocket() {
+					Socket out = m_winner;
+					m_winner = INVALID;
+					return out;
+				}
+				void abort() {
+					for (auto &it : m_attempts) {
+						closeSocket(it.m_socket);
+					}
+					m_attempts.clear();
+					if (m_winner != INVALID) {
+						closeSocket(m_winner);
+						m_winner = INVALID;
+					}
+				}
+				/**
+				 * @brief Get the next time the state machine need to be updated without socket event.
+				 */
+				echrono::Steady getNextEvent() const {
+					if (    m_next < m_list.size()
+					     && m_nextStart < m_deadline) {
+						return m_nextStart;
+					}
+					return m_deadline;
+				}
+				/**
+				 * @brief Start the attempt that are due and check the deadline.
+				 * @return true when the state machine is finished
+				 */
+				bool update(const echrono::Steady& _now) {
+					while (    isFinished() == false
+					        && m_next < m_list.size()
+					        && (    _now >= m_nextStart
+					             || m_attempts.size() == 0)) {
+						startNext(_now);
+					}
+					if (    isFinished() == false
+					     && _now >= m_deadline) {
+						m_error = "connection timeout";
+						abort();
+						m_next = m_list.size();
+					}
+					return isFinished();
+				}
+				/**
+				 * @brief Add the socket to wait in the poll list.
+				 * @return Number of element added.
+				 */
+				size_t fillPoll(etk::Vector<PollFd>& _fds) const {
+					for (auto &it : m_attempts) {
+						PollFd element;
+						element.fd = it.m_socket;
+						element.events = POLLOUT;
+						element.revents = 0;
+						_fds.pushBack(element);
+					}
+					return m_attempts.size();
+				}
+				/**
+				 * @brief Process the poll result of the element added with fillPoll().
+				 */
+				void process(const PollFd* _fds, size_t _count, const echrono::Steady& _now) {
+					if (_count != m_attempts.size()) {
+						ENET_ERROR("Poll list does not match the attempts ...");
+						return;
+					}
+					etk::Vector<Attempt> attempts = m_attempts;
+					m_attempts.clear();
+					for (size_t iii=0; iii<_count; ++iii) {
+						if (_fds[iii].revents == 0) {
+							m_attempts.pushBack(attempts[iii]);
+							continue;
+						}
+						int error = 0;
+						socklen_t errorSize = sizeof(error);
+						if (getsockopt(attempts[iii].m_socket, SOL_SOCKET, SO_ERROR, (char*)&error, &errorSize) != 0) {
+							error = errno;
+						}
+						if (    error == 0
+						     && m_winner == INVALID) {
+							ENET_INFO("Connection done on " << m_list[attempts[iii].m_index].getName());
+							m_winner = attempts[iii].m_socket;
+							continue;
+						}
+						if (error != 0) {
+							m_error = m_list[attempts[iii].m_index].getName() + ": " + strerror(error);
+							ENET_DEBUG("Connection failed on " << m_error);
+						}
+						closeSocket(attempts[iii].m_socket);
+						// Fail fast: no need to wait the delay to try the next address
+						m_nextStart = _now;
+					}
+					if (m_winner != INVALID) {
+						// The first winner is kept, close all the other.
+						for (auto &it : m_attempts) {
+							closeSocket(it.m_socket);
+						}
+						m_attempts.clear();
+						setBlocking(m_winner, true);
+					}
+				}
+			private:
+				void startNext(const echrono::Steady& _now) {
+					const enet::Address& address = m_list[m_next];
+					Attempt attempt;
+					attempt.m_index = m_next;
+					m_next++;
+					m_nextStart = _now + echrono::milliseconds(CONNECTION_ATTEMPT_DELAY_MS);
+					attempt.m_socket = socket(address.getFamily(), SOCK_STREAM, IPPROTO_TCP);
+					if (attempt.m_socket == INVALID) {
+						m_error = "can not open socket: " + etk::String(strerror(errno));
+						m_nextStart = _now;
+						return;
+					}
+					if (setBlocking(attempt.m_socket, false) == false) {
+						m_error = "can not set socket non-blocking: " + etk::String(strerror(errno));
+						closeSocket(attempt.m_socket);
+						m_nextStart = _now;
+						return;
+					}
+					#ifdef TCP_FASTOPEN_CONNECT
+						// connect() return immediately when a cookie is cached, the SYN is sent with the first write:
+						// the handshake is not checked, so it is not used when an other address can be tried.
+						if (    enet::getTcpFastOpen() == true
+						     && m_list.size() == 1) {
+							int flag = 1;
+							if (setsockopt(attempt.m_socket, IPPROTO_TCP, TCP_FASTOPEN_CONNECT, (char*)&flag, sizeof(flag)) != 0) {
+								ENET_WARNING("Can not enable TCP fast open: " << strerror(errno));
+							}
+						}
+					#endif
+					ENET_INFO("Start connexion on " << address.getName());
+					if (connect(attempt.m_socket, (const struct sockaddr *)address.getData(), address.getSize()) == 0) {
+						for (auto &it : m_attempts) {
+							closeSocket(it.m_socket);
+						}
+						m_attempts.clear();
+						m_winner = attempt.m_socket;
+						setBlocking(m_winner, true);
+						return;
+					}
+					#ifdef __TARGET_OS__Windows
+						bool inProgress = WSAGetLastError() == WSAEWOULDBLOCK;
+					#else
+						bool inProgress = errno == EINPROGRESS;
+					#endif
+					if (inProgress == false) {
+						m_error = address.getName() + ": " + strerror(errno);
+						ENET_DEBUG("Connection failed on " << m_error);
+						closeSocket(attempt.m_socket);
+						m_nextStart = _now;
+						return;
+					}
+					m_attempts.pushBack(attempt);
+				}
+		};
+		/**
+		 * @brief Get the time to wait in a poll call (in ms)
+		 */
+		static int32_t getPollTimeOut(const echrono::Steady& _event, const echrono::Steady& _now) {
+			if (_event <= _now) {
+				return 0;
+			}
+			// round up to not wake up before the event
+			return int32_t(((_event - _now).get() + 999999) / 1000000);
+		}
 	}
-	return etk::move(enet::connectTcpClient(_config.extract(0, pos),
-	                                        etk::string_to_uint16_t(_config.extract(pos+1)),
-	                                        _numberRetry,
-	                                        _timeOut));
+}
+
+static bool& getFastOpenStatus() {
+	static bool isEnable = false;
+	return isEnable;
+}
+
+void enet::setTcpFastOpen(bool _enable) {
+	#ifndef TCP_FASTOPEN_CONNECT
+		if (_enable == true) {
+			ENET_WARNING("TCP fast open is not supported on this platform");
+			return;
+		}
+	#endif
+	getFastOpenStatus() = _enable;
+}
+
+bool enet::getTcpFastOpen() {
+	return getFastOpenStatus();
+}
+
+enet::Tcp enet::connectTcpClient(const etk::String& _config, uint32_t _numberRetry, echrono::Duration _timeOut) {
+	etk::String hostname;
+	uint16_t port = 0;
+	enet::tcpClient::splitHost(_config, hostname, port);
+	return enet::connectTcpClient(hostname, port, _numberRetry, _timeOut);
 }
 
 enet::Tcp enet::connectTcpClient(uint8_t _ip1, uint8_t _ip2, uint8_t _ip3, uint8_t _ip4, uint16_t _port, uint32_t _numberRetry, echrono::Duration _timeOut) {
@@ -48,159 +388,185 @@ enet::Tcp enet::connectTcpClient(uint8_t _ip1, uint8_t _ip2, uint8_t _ip3, uint8
 	return etk::move(enet::connectTcpClient(tmpname, _port, _numberRetry, _timeOut));
 }
 
-#ifdef __TARGET_OS__Windows
-	enet::Tcp enet::connectTcpClient(const etk::String& _hostname, uint16_t _port, uint32_t _numberRetry, echrono::Duration _timeOut) {
-		if (enet::isInit() == false) {
-			ENET_ERROR("Need call enet::init(...) before accessing to the socket");
-			return etk::move(enet::Tcp());
-		}
-		if (_hostname == "") {
-			ENET_ERROR("get connection wihtout hostname");
-			return etk::move(enet::Tcp());
-		}
-		SOCKET socketId = INVALID_SOCKET;
-		ENET_INFO("Start connection on " << _hostname << ":" << _port);
-		for(int32_t iii=0; iii<_numberRetry ;iii++) {
-			if (iii > 0) {
-				ethread::sleepMilliSeconds((200));
-			}
-			// open in Socket normal mode
-			socketId = socket(AF_INET, SOCK_STREAM, 0);
-			if (socketId < 0) {
-				ENET_ERROR("ERROR while opening socket : errno=" << errno << "," << strerror(errno));
-				continue;
-			}
-			ENET_INFO("Try connect on socket ... (" << iii+1 << "/" << _numberRetry << ")");
-			
-			struct addrinfo hints;
-			memset(&hints, 0, sizeof(hints));
-			hints.ai_family = AF_UNSPEC;
-			hints.ai_socktype = SOCK_STREAM;
-			hints.ai_protocol = IPPROTO_TCP;
-			
-			// Resolve the server address and port
-			struct addrinfo* result = null;
-			etk::String portValue = etk::toString(_port);
-			int iResult = getaddrinfo(_hostname.c_str(), portValue.c_str(), &hints, &result);
-			if (iResult != 0) {
-				ENET_ERROR("getaddrinfo failed with error: " << iResult);
-				continue;
-			}
-			
-			// Attempt to connect to an address until one succeeds
-			for(struct addrinfo* ptr=result;
-			    ptr != null;
-			    ptr=ptr->ai_next) {
-				ENET_DEBUG(" find one ...");
-				// Create a SOCKET for connecting to server
-				socketId = socket(ptr->ai_family, ptr->ai_socktype, ptr->ai_protocol);
-				if (socketId == INVALID_SOCKET) {
-					ENET_ERROR("socket failed with error: " << WSAGetLastError());
-					break;
-				}
-				// Connect to server.
-				iResult = connect(socketId, ptr->ai_addr, (int)ptr->ai_addrlen);
-				if (iResult == SOCKET_ERROR) {
-					ENET_ERROR("socket connection failed with error: " << WSAGetLastError());
-					closesocket(socketId);
-					socketId = INVALID_SOCKET;
-					continue;
-				}
-				break;
-			}
-			freeaddrinfo(result);
-			
-			if (socketId == INVALID_SOCKET) {
-				ENET_ERROR("Unable to connect to server!");
-				continue;
-			} else {
+enet::Tcp enet::connectTcpClient(const etk::String& _config, enet::RetryPolicy& _policy, echrono::Duration _timeOut) {
+	etk::String hostname;
+	uint16_t port = 0;
+	enet::tcpClient::splitHost(_config, hostname, port);
+	return enet::connectTcpClient(hostname, port, _policy, _timeOut);
+}
+
+enet::Tcp enet::connectTcpClient(const etk::String& _hostname, uint16_t _port, uint32_t _numberRetry, echrono::Duration _timeOut) {
+	if (_numberRetry == 0) {
+		ENET_ERROR("ERROR connecting ... (no try requested)");
+		return etk::move(enet::Tcp());
+	}
+	enet::RetryPolicy policy(_numberRetry);
+	return etk::move(enet::connectTcpClient(_hostname, _port, policy, _timeOut));
+}
+
+enet::Tcp enet::connectTcpClient(const etk::String& _hostname, uint16_t _port, enet::RetryPolicy& _policy, echrono::Duration _timeOut) {
+	if (enet::isInit() == false) {
+		ENET_ERROR("Need call enet::init(...) before accessing to the socket");
+		return etk::move(enet::Tcp());
+	}
+	if (_hostname == "") {
+		ENET_ERROR("get connection wihtout hostname");
+		return etk::move(enet::Tcp());
+	}
+	enet::tcpClient::Socket socketId = enet::tcpClient::INVALID;
+	etk::Vector<enet::Address> listAddress;
+	enet::tcpClient::HappyEyeballs connector;
+	ENET_INFO("Start connection on " << _hostname << ":" << _port);
+	enet::RetryPolicy::Sequence sequence(_policy);
+	do {
+		// The result is cached ==> no DNS round trip when retry or reconnect
+		if (enet::resolver::resolve(_hostname, _port, listAddress) == false) {
+			ENET_ERROR("ERROR, no such host : " << _hostname);
+			continue;
+		}
+		ENET_INFO("Try connect on socket ... (" << sequence.getAttempt() << "/" << _policy.getMaxAttempt() << ")");
+		// Race the connection on all the addresses until one succeeds or the timeout
+		connector.init(listAddress, echrono::Steady::now() + _timeOut);
+		etk::Vector<enet::tcpClient::PollFd> fds;
+		while (connector.update(echrono::Steady::now()) == false) {
+			fds.clear();
+			size_t nbElement = connector.fillPoll(fds);
+			echrono::Steady now = echrono::Steady::now();
+			int32_t ret = enet::tcpClient::poll(&fds[0], nbElement, enet::tcpClient::getPollTimeOut(connector.getNextEvent(), now));
+			if (ret < 0) {
+				ENET_ERROR("poll() failed : errno=" << errno << "," << strerror(errno));
+				connector.abort();
 				break;
 			}
+			connector.process(&fds[0], nbElement, echrono::Steady::now());
 		}
-		if (socketId == INVALID_SOCKET) {
-			ENET_ERROR("ERROR connecting ... (after all try)");
-			return etk::move(enet::Tcp());
+		if (connector.isConnected() == true) {
+			socketId = connector.extractSocket();
+			sequence.success();
+			break;
 		}
-		ENET_DEBUG("Connection done");
-		return etk::move(enet::Tcp(socketId, _hostname + ":" + etk::toString(_port)));
+		ENET_ERROR("ERROR connecting, maybe retry ... " << connector.getError());
+	} while (sequence.retry() == true);
+	if (socketId == enet::tcpClient::INVALID) {
+		ENET_ERROR("ERROR connecting ... (after all try)");
+		return etk::move(enet::Tcp());
 	}
-#else
-	#include <sys/socket.h>
-	enet::Tcp enet::connectTcpClient(const etk::String& _hostname, uint16_t _port, uint32_t _numberRetry, echrono::Duration _timeOut) {
-		if (enet::isInit() == false) {
-			ENET_ERROR("Need call enet::init(...) before accessing to the socket");
-			return etk::move(enet::Tcp());
-		}
-		if (_hostname == "") {
-			ENET_ERROR("get connection wihtout hostname");
-			return etk::move(enet::Tcp());
-		}
-		int32_t socketId = -1;
-		ENET_INFO("Start connection on " << _hostname << ":" << _port);
-		for(int32_t iii=0; iii<_numberRetry ;iii++) {
-			if (iii > 0) {
-				ethread::sleepMilliSeconds((200));
+	ENET_INFO("Connection done");
+	return etk::move(enet::Tcp(socketId, _hostname + ":" + etk::toString(_port)));
+}
+
+etk::Vector<enet::Tcp> enet::connectMany(const etk::Vector<etk::String>& _list, echrono::Duration _timeOut, uint32_t _concurrency) {
+	etk::Vector<etk::String> errors;
+	return etk::move(enet::connectMany(_list, _timeOut, _concurrency, errors));
+}
+
+etk::Vector<enet::Tcp> enet::connectMany(const etk::Vector<etk::String>& _list, echrono::Duration _timeOut, uint32_t _concurrency, etk::Vector<etk::String>& _errors) {
+	etk::Vector<enet::Tcp> out;
+	_errors.clear();
+	if (enet::isInit() == false) {
+		ENET_ERROR("Need call enet::init(...) before accessing to the socket");
+		for (size_t iii=0; iii<_list.size(); ++iii) {
+			out.pushBack(enet::Tcp());
+			_errors.pushBack("enet not initialized");
+		}
+		return out;
+	}
+	if (_concurrency == 0) {
+		_concurrency = 1;
+	}
+	class Slot {
+		public:
+			size_t m_index; //!< Index of the host in the list
+			ememory::SharedPtr<enet::tcpClient::HappyEyeballs> m_connector; //!< Connection in progress
+	};
+	etk::Vector<enet::tcpClient::Socket> sockets;
+	for (size_t iii=0; iii<_list.size(); ++iii) {
+		sockets.pushBack(enet::tcpClient::INVALID);
+		_errors.pushBack("");
+	}
+	echrono::Steady deadline = echrono::Steady::now() + _timeOut;
+	etk::Vector<Slot> slots;
+	etk::Vector<enet::tcpClient::PollFd> fds;
+	etk::Vector<size_t> fdsCount;
+	size_t next = 0;
+	ENET_INFO("Start " << _list.size() << " connections (concurrency=" << _concurrency << ")");
+	while (true) {
+		echrono::Steady now = echrono::Steady::now();
+		// Start new hosts while there is free slots
+		while (    next < _list.size()
+		        && slots.size() < _concurrency) {
+			size_t index = next++;
+			if (now >= deadline) {
+				_errors[index] = "connection timeout";
+				continue;
 			}
-			// open in Socket normal mode
-			socketId = socket(AF_INET, SOCK_STREAM, 0);
-			if (socketId < 0) {
-				ENET_ERROR("ERROR while opening socket : errno=" << errno << "," << strerror(errno));
+			etk::String hostname;
+			uint16_t port = 0;
+			enet::tcpClient::splitHost(_list[index], hostname, port);
+			etk::Vector<enet::Address> listAddress;
+			if (enet::resolver::resolve(hostname, port, listAddress) == false) {
+				_errors[index] = "no such host: " + hostname;
 				continue;
 			}
-			ENET_INFO("Try connect on socket ... (" << iii+1 << "/" << _numberRetry << ")");
-			struct sockaddr_in servAddr;
-			struct hostent* server = null;
-			if (    _hostname.c_str()[0] >= '0'
-			     && _hostname.c_str()[0] <= '9') {
-				ENET_INFO("Calling gethostbyaddr with " << _hostname);
-				struct in_addr addr;
-				addr.s_addr = inet_addr(_hostname.c_str());
-				if (addr.s_addr == INADDR_NONE) {
-					ENET_ERROR("The IPv4 address entered must be a legal address" << _hostname.c_str());
-					return etk::move(enet::Tcp());
-				} else {
-					// TODO : This is deprecated use getaddrinfo like windows ...
-					server = gethostbyaddr((char *) &addr, 4, AF_INET);
-				}
+			Slot slot;
+			slot.m_index = index;
+			slot.m_connector = ememory::makeShared<enet::tcpClient::HappyEyeballs>();
+			slot.m_connector->init(listAddress, deadline);
+			slots.pushBack(slot);
+		}
+		// Update the state machines and remove the finished ones
+		for (size_t iii=0; iii<slots.size();) {
+			if (slots[iii].m_connector->update(now) == false) {
+				++iii;
+				continue;
+			}
+			if (slots[iii].m_connector->isConnected() == true) {
+				sockets[slots[iii].m_index] = slots[iii].m_connector->extractSocket();
 			} else {
-				ENET_INFO("Calling gethostbyname with " << _hostname);
-				// TODO : This is deprecated use getaddrinfo like windows ...
-				server = gethostbyname(_hostname.c_str());
+				_errors[slots[iii].m_index] = slots[iii].m_connector->getError();
 			}
-			if (server == null) {
-				ENET_ERROR("ERROR, no such host : " << _hostname);
+			slots.erase(slots.begin() + iii);
+		}
+		if (slots.size() == 0) {
+			if (next < _list.size()) {
 				continue;
 			}
-			bzero((char *) &servAddr, sizeof(servAddr));
-			servAddr.sin_family = AF_INET;
-			bcopy((char *)server->h_addr, (char *)&servAddr.sin_addr.s_addr, server->h_length);
-			servAddr.sin_port = htons(_port);
-			ENET_INFO("Start connexion ...");
-			if (connect(socketId, (struct sockaddr *)&servAddr, sizeof(servAddr)) != 0) {
-				if(errno != EINPROGRESS) {
-					if(    errno != ENOENT
-					    && errno != EAGAIN
-					    && errno != ECONNREFUSED) {
-						ENET_ERROR("ERROR connecting on : errno=" << errno << "," << strerror(errno));
-					}
-					#ifdef __TARGET_OS__Windows
-						closesocket(socketId);
-					#else
-						close(socketId);
-					#endif
-					socketId = -1;
-				}
-				ENET_ERROR("ERROR connecting, maybe retry ... errno=" << errno << "," << strerror(errno));
-				continue;
+			break;
+		}
+		// Wait the first event of all the connections
+		fds.clear();
+		fdsCount.clear();
+		echrono::Steady nextEvent = deadline;
+		for (auto &it : slots) {
+			fdsCount.pushBack(it.m_connector->fillPoll(fds));
+			nextEvent = etk::min(nextEvent, it.m_connector->getNextEvent());
+		}
+		int32_t ret = enet::tcpClient::poll(&fds[0], fds.size(), enet::tcpClient::getPollTimeOut(nextEvent, now));
+		if (ret < 0) {
+			ENET_ERROR("poll() failed : errno=" << errno << "," << strerror(errno));
+			for (auto &it : slots) {
+				it.m_connector->abort();
+				_errors[it.m_index] = "poll error";
 			}
 			break;
 		}
-		if (socketId<0) {
-			ENET_ERROR("ERROR connecting ... (after all try)");
-			return etk::move(enet::Tcp());
+		now = echrono::Steady::now();
+		size_t offset = 0;
+		for (size_t iii=0; iii<slots.size(); ++iii) {
+			slots[iii].m_connector->process(&fds[offset], fdsCount[iii], now);
+			offset += fdsCount[iii];
 		}
-		ENET_INFO("Connection done");
-		return etk::move(enet::Tcp(socketId, _hostname + ":" + etk::toString(_port)));
 	}
-#endif
-
+	size_t nbConnected = 0;
+	for (size_t iii=0; iii<_list.size(); ++iii) {
+		if (sockets[iii] == enet::tcpClient::INVALID) {
+			ENET_WARNING("Can not connect on " << _list[iii] << " : " << _errors[iii]);
+			out.pushBack(enet::Tcp());
+			continue;
+		}
+		nbConnected++;
+		out.pushBack(enet::Tcp(sockets[iii], _list[iii]));
+	}
+	ENET_INFO("Connection done on " << nbConnected << "/" << _list.size() << " hosts");
+	return out;
+}
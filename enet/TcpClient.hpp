@@ -6,10 +6,62 @@
 #pragma once
 
 #include <enet/Tcp.hpp>
+#include <enet/RetryPolicy.hpp>
 #include <echrono/Duration.hpp>
+#include <etk/Vector.hpp>
 
 namespace enet {
 	enet::Tcp connectTcpClient(uint8_t _ip1, uint8_t _ip2, uint8_t _ip3, uint8_t _ip4, uint16_t _port, uint32_t _numberRetry=5, echrono::Duration _timeOut = echrono::seconds(1));
 	enet::Tcp connectTcpClient(const etk::String& _hostname, uint16_t _port, uint32_t _numberRetry=5, echrono::Duration _timeOut = echrono::seconds(1));
 	enet::Tcp connectTcpClient(const etk::String& _config, uint32_t _numberRetry, echrono::Duration _timeOut);
+	/**
+	 * @brief Connect on a host, the retry are done with a backoff policy.
+	 * @param[in] _hostname Name or IP of the host.
+	 * @param[in] _port Port of the host.
+	 * @param[in] _policy Retry policy (can be shared between connections to share the retry budget)
+	 * @param[in] _timeOut Timeout of each attempt.
+	 * @return The connection (status error if the connection can not be done)
+	 */
+	enet::Tcp connectTcpClient(const etk::String& _hostname, uint16_t _port, enet::RetryPolicy& _policy, echrono::Duration _timeOut = echrono::seconds(1));
+	/**
+	 * @brief Connect on a host "hostname:port", the retry are done with a backoff policy.
+	 * @param[in] _config Host and port "hostname:port" (IPv6: "[::1]:port").
+	 * @param[in] _policy Retry policy (can be shared between connections to share the retry budget)
+	 * @param[in] _timeOut Timeout of each attempt.
+	 * @return The connection (status error if the connection can not be done)
+	 */
+	enet::Tcp connectTcpClient(const etk::String& _config, enet::RetryPolicy& _policy, echrono::Duration _timeOut = echrono::seconds(1));
+	/**
+	 * @brief Connect on many hosts in parallel in the current thread (non-blocking connections driven by a single poll).
+	 * The duration of the call depend on the slowest host (limited by the timeout), not on the sum of all the hosts.
+	 * @param[in] _list List of host "hostname:port" (IPv6: "[::1]:port").
+	 * @param[in] _timeOut Global timeout of the connections.
+	 * @param[in] _concurrency Maximum number of host in connection at the same time.
+	 * @param[out] _errors Error of each host (empty string when connected), same order as _list.
+	 * @return The connections (status error if the connection can not be done), same order as _list.
+	 */
+	etk::Vector<enet::Tcp> connectMany(const etk::Vector<etk::String>& _list, echrono::Duration _timeOut, uint32_t _concurrency, etk::Vector<etk::String>& _errors);
+	/**
+	 * @brief Connect on many hosts in parallel in the current thread.
+	 * @param[in] _list List of host "hostname:port" (IPv6: "[::1]:port").
+	 * @param[in] _timeOut Global timeout of the connections.
+	 * @param[in] _concurrency Maximum number of host in connection at the same time.
+	 * @return The connections (status error if the connection can not be done), same order as _list.
+	 */
+	etk::Vector<enet::Tcp> connectMany(const etk::Vector<etk::String>& _list, echrono::Duration _timeOut = echrono::seconds(5), uint32_t _concurrency=64);
+	/**
+	 * @brief Enable or disable the TCP Fast Open on the client connections (Linux only, disable by default).
+	 * When the system has a TFO cookie of the server, the connection is done without waiting the handshake
+	 * and the first write on the socket (like the HTTP request header or the WebSocket upgrade) is sent in the SYN.
+	 * It is only used when the host has one address: with many addresses, the connections are raced (Happy Eyeballs)
+	 * and an address is selected only when its handshake is done.
+	 * @note Can be enabled with the "--enet-tcp-fast-open" parameter of enet::init
+	 * @param[in] _enable New state.
+	 */
+	void setTcpFastOpen(bool _enable);
+	/**
+	 * @brief Get the TCP Fast Open status of the client connections.
+	 * @return true if enabled
+	 */
+	bool getTcpFastOpen();
 }
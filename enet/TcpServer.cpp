@@ -30,7 +30,8 @@ extern "C" {
 enet::TcpServer::TcpServer() :
   m_socketId(-1),
   m_host("127.0.0.1"),
-  m_port(23191) {
+  m_port(23191),
+  m_rateLimiter(null) {
 	
 }
 
@@ -152,6 +153,56 @@ void enet::TcpServer::setPort(uint16_t _port) {
 	}
 #endif
 
+static etk::String getRemoteAddress(int32_t _socketId) {
+	etk::String remoteAddress;
+	struct sockaddr_storage addr;
+	socklen_t len = sizeof(addr);
+	getpeername(_socketId, (struct sockaddr*)&addr, &len);
+	// deal with both IPv4 and IPv6:
+	if (addr.ss_family == AF_INET) {
+		struct sockaddr_in *s = (struct sockaddr_in *)&addr;
+		int port = ntohs(s->sin_port);
+		remoteAddress = etk::toString(s->sin_addr.s_addr&0xFF);
+		remoteAddress += ".";
+		remoteAddress += etk::toString((s->sin_addr.s_addr>>8)&0xFF);
+		remoteAddress += ".";
+		remoteAddress += etk::toString((s->sin_addr.s_addr>>16)&0xFF);
+		remoteAddress += ".";
+		remoteAddress += etk::toString((s->sin_addr.s_addr>>24)&0xFF);
+		remoteAddress += ":";
+		remoteAddress += etk::toString(port);
+	} else { // AF_INET6
+		struct sockaddr_in6 *s = (struct sockaddr_in6 *)&addr;
+		int port = ntohs(s->sin6_port);
+		remoteAddress = etk::toHex(s->sin6_addr.s6_addr[0], 2);
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[1], 2);
+		remoteAddress += ".";
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[2], 2);
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[3], 2);
+		remoteAddress += ".";
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[4], 2);
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[5], 2);
+		remoteAddress += ".";
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[6], 2);
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[7], 2);
+		remoteAddress += ".";
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[8], 2);
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[9], 2);
+		remoteAddress += ".";
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[10], 2);
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[11], 2);
+		remoteAddress += ".";
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[12], 2);
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[13], 2);
+		remoteAddress += ".";
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[14], 2);
+		remoteAddress += etk::toHex(s->sin6_addr.s6_addr[15], 2);
+		remoteAddress += ":";
+		remoteAddress += etk::toString(port);
+	}
+	return remoteAddress;
+}
+
 enet::Tcp enet::TcpServer::waitNext() {
 	if (enet::isInit() == false) {
 		ENET_ERROR("Need call enet::init(...) before accessing to the socket");
@@ -167,73 +218,37 @@ enet::Tcp enet::TcpServer::waitNext() {
 	#else
 		listen(m_socketId, 1); // 1 is for the number of connection at the same time ...
 	#endif
-	ENET_INFO("End listen Socket ... (start accept)");
-	struct sockaddr_in clientAddr;
-	socklen_t clilen = sizeof(clientAddr);
-	int32_t socketIdClient = accept(m_socketId, (struct sockaddr *) &clientAddr, &clilen);
-	if (socketIdClient < 0) {
-		ENET_ERROR("ERROR on accept errno=" << errno << "," << strerror(errno));
-		#ifdef __TARGET_OS__Windows
-			closesocket(m_socketId);
-			m_socketId = INVALID_SOCKET;
-		#else
-			close(m_socketId);
-			m_socketId = -1;
-		#endif
-		
-		return enet::Tcp();
-	}
-	etk::String remoteAddress;
-	{
-		struct sockaddr_storage addr;
-		char ipstr[INET6_ADDRSTRLEN];
-		socklen_t len = sizeof(addr);
-		getpeername(socketIdClient, (struct sockaddr*)&addr, &len);
-		// deal with both IPv4 and IPv6:
-		if (addr.ss_family == AF_INET) {
-			struct sockaddr_in *s = (struct sockaddr_in *)&addr;
-			int port = ntohs(s->sin_port);
-			remoteAddress = etk::toString(s->sin_addr.s_addr&0xFF);
-			remoteAddress += ".";
-			remoteAddress += etk::toString((s->sin_addr.s_addr>>8)&0xFF);
-			remoteAddress += ".";
-			remoteAddress += etk::toString((s->sin_addr.s_addr>>16)&0xFF);
-			remoteAddress += ".";
-			remoteAddress += etk::toString((s->sin_addr.s_addr>>24)&0xFF);
-			remoteAddress += ":";
-			remoteAddress += etk::toString(port);
-		} else { // AF_INET6
-			struct sockaddr_in6 *s = (struct sockaddr_in6 *)&addr;
-			int port = ntohs(s->sin6_port);
-			remoteAddress = etk::toHex(s->sin6_addr.s6_addr[0], 2);
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[1], 2);
-			remoteAddress += ".";
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[2], 2);
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[3], 2);
-			remoteAddress += ".";
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[4], 2);
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[5], 2);
-			remoteAddress += ".";
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[6], 2);
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[7], 2);
-			remoteAddress += ".";
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[8], 2);
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[9], 2);
-			remoteAddress += ".";
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[10], 2);
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[11], 2);
-			remoteAddress += ".";
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[12], 2);
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[13], 2);
-			remoteAddress += ".";
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[14], 2);
-			remoteAddress += etk::toHex(s->sin6_addr.s6_addr[15], 2);
-			remoteAddress += ":";
-			remoteAddress += etk::toString(port);
+	while (true) {
+		ENET_INFO("End listen Socket ... (start accept)");
+		struct sockaddr_in clientAddr;
+		socklen_t clilen = sizeof(clientAddr);
+		int32_t socketIdClient = accept(m_socketId, (struct sockaddr *) &clientAddr, &clilen);
+		if (socketIdClient < 0) {
+			ENET_ERROR("ERROR on accept errno=" << errno << "," << strerror(errno));
+			#ifdef __TARGET_OS__Windows
+				closesocket(m_socketId);
+				m_socketId = INVALID_SOCKET;
+			#else
+				close(m_socketId);
+				m_socketId = -1;
+			#endif
+			
+			return enet::Tcp();
+		}
+		etk::String remoteAddress = getRemoteAddress(socketIdClient);
+		if (    m_rateLimiter != null
+		     && m_rateLimiter->check(remoteAddress) == false) {
+			ENET_WARNING("Reject connection FROM " << remoteAddress << " ==> rate limit");
+			#ifdef __TARGET_OS__Windows
+				closesocket(socketIdClient);
+			#else
+				close(socketIdClient);
+			#endif
+			continue;
 		}
+		ENET_ERROR("End configuring Socket ... Find New one FROM " << remoteAddress);
+		return enet::Tcp(socketIdClient, m_host + ":" + etk::toString(m_port), remoteAddress);
 	}
-	ENET_ERROR("End configuring Socket ... Find New one FROM " << remoteAddress);
-	return enet::Tcp(socketIdClient, m_host + ":" + etk::toString(m_port), remoteAddress);
 }
 
 
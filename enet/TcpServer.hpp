@@ -5,6 +5,8 @@
  */
 #pragma once
 #include <enet/Tcp.hpp>
+#include <enet/RateLimiter.hpp>
+#include <ememory/memory.hpp>
 #ifdef __TARGET_OS__Windows
 	
 #else
@@ -63,6 +65,16 @@ namespace enet {
 			uint16_t getPort() {
 				return m_port;
 			}
+		private:
+			ememory::SharedPtr<enet::RateLimiter> m_rateLimiter; //!< Limit the number of connection accepted per remote address
+		public:
+			/**
+			 * @brief Set the rate limiter used when a new connection is accepted.
+			 * @param[in] _value Rate limiter (null to disable)
+			 */
+			void setRateLimiter(ememory::SharedPtr<enet::RateLimiter> _value) {
+				m_rateLimiter = _value;
+			}
 		public:
 			bool link();
 			bool unlink();
@@ -6,6 +6,8 @@
 
 #include <enet/debug.hpp>
 #include <enet/WebSocket.hpp>
+#include <enet/RetryPolicy.hpp>
+#include <enet/ConnectionPool.hpp>
 #include <etk/Map.hpp>
 #include <etk/stdTools.hpp>
 #include <etk/String.hpp>
@@ -13,20 +15,6 @@
 #include <algue/base64.hpp>
 #include <algue/sha1.hpp>
 
-
-
-namespace enet {
-	namespace websocket {
-		static const uint32_t FLAG_FIN = 0x80;
-		static const uint32_t FLAG_MASK = 0x80;
-		static const uint32_t OPCODE_FRAME_TEXT = 0x01;
-		static const uint32_t OPCODE_FRAME_BINARY = 0x02;
-		static const uint32_t OPCODE_FRAME_CLOSE = 0x08;
-		static const uint32_t OPCODE_FRAME_PING = 0x09;
-		static const uint32_t OPCODE_FRAME_PONG = 0x0A;
-	}
-}
-
 enet::WebSocket::WebSocket() :
   m_connectionValidate(false),
   m_interface(null),
@@ -43,6 +31,14 @@ enet::WebSocket::WebSocket(enet::Tcp _connection, bool _isServer) :
 	setInterface(etk::move(_connection), _isServer);
 }
 
+enet::WebSocket::WebSocket(ememory::SharedPtr<enet::ConnectionPool> _pool, const etk::String& _hostname, uint16_t _port) :
+  m_connectionValidate(false),
+  m_interface(null),
+  m_observer(null),
+  m_observerUriCheck(null) {
+	setInterface(_pool->get(_hostname, _port), false);
+}
+
 const etk::String& enet::WebSocket::getRemoteAddress() const {
 	if (m_interface == null) {
 		static const etk::String tmpOut;
@@ -73,6 +69,32 @@ void enet::WebSocket::setInterface(enet::Tcp _connection, bool _isServer) {
 	m_interface->connectRaw(this, &enet::WebSocket::onReceiveData);
 }
 
+void enet::WebSocket::setAdmissionControl(ememory::SharedPtr<enet::AdmissionControl> _value) {
+	ememory::SharedPtr<enet::HttpServer> interface = ememory::dynamicPointerCast<enet::HttpServer>(m_interface);
+	if (interface == null) {
+		ENET_ERROR("Admission control is only available in server mode ...");
+		return;
+	}
+	interface->setAdmissionControl(_value);
+}
+
+void enet::WebSocket::setRateLimiter(ememory::SharedPtr<enet::RateLimiter> _value) {
+	ememory::SharedPtr<enet::HttpServer> interface = ememory::dynamicPointerCast<enet::HttpServer>(m_interface);
+	if (interface == null) {
+		ENET_ERROR("Rate limiter is only available in server mode ...");
+		return;
+	}
+	interface->setRateLimiter(_value);
+}
+
+void enet::WebSocket::setRetryPolicy(ememory::SharedPtr<enet::RetryPolicy> _value) {
+	if (m_interface == null) {
+		ENET_ERROR("Nullptr interface ...");
+		return;
+	}
+	m_interface->setRetryPolicy(_value);
+}
+
 enet::WebSocket::~WebSocket() {
 	if (m_interface == null) {
 		return;
@@ -89,7 +111,7 @@ static etk::String generateKey() {
 	return algue::base64::encode(dataKey, 16);
 }
 
-static etk::String generateCheckKey(const etk::String& _key) {
+etk::String enet::websocket::generateCheckKey(const etk::String& _key) {
 	etk::String out = _key + "258EAFA5-E914-47DA-95CA-C5AB0DC85B11";
 	etk::Vector<uint8_t> keyData = algue::sha1::encode(out);
 	return algue::base64::encode(keyData);
@@ -103,20 +125,25 @@ void enet::WebSocket::start(const etk::String& _uri, const etk::Vector<etk::Stri
 	if (m_interface->isServer() == true) {
 		m_interface->start();
 	} else {
+		ememory::SharedPtr<enet::RetryPolicy> policy = m_interface->getRetryPolicy();
+		if (policy == null) {
+			policy = ememory::makeShared<enet::RetryPolicy>();
+		}
+		enet::RetryPolicy::Sequence sequence(*policy);
 		do {
 			m_redirectInProgress = false;
 			m_interface->start();
 			enet::HttpRequest req(enet::HTTPReqType::HTTP_GET);
 			req.setProtocol(enet::HTTPProtocol::http_1_1);
 			req.setUri(_uri);
-			req.setKey("Upgrade", "websocket");
-			req.setKey("Connection", "Upgrade");
+			req.setKey(enet::HTTPHeaderId::upgrade, "websocket");
+			req.setKey(enet::HTTPHeaderId::connection, "Upgrade");
 			m_checkKey = generateKey();
-			req.setKey("Sec-WebSocket-Key", m_checkKey); // this is an example key ...
-			m_checkKey = generateCheckKey(m_checkKey);
-			req.setKey("Sec-WebSocket-Version", "13");
-			req.setKey("Pragma", "no-cache");
-			req.setKey("Cache-Control", "no-cache");
+			req.setKey(enet::HTTPHeaderId::secWebSocketKey, m_checkKey); // this is an example key ...
+			m_checkKey = enet::websocket::generateCheckKey(m_checkKey);
+			req.setKey(enet::HTTPHeaderId::secWebSocketVersion, "13");
+			req.setKey(enet::HTTPHeaderId::pragma, "no-cache");
+			req.setKey(enet::HTTPHeaderId::cacheControl, "no-cache");
 			etk::String protocolList;
 			for (auto &it : _listProtocols) {
 				if (it == "") {
@@ -128,7 +155,7 @@ void enet::WebSocket::start(const etk::String& _uri, const etk::Vector<etk::Stri
 				protocolList += it;
 			}
 			if (protocolList != "") {
-				req.setKey("Sec-WebSocket-Protocol", protocolList);
+				req.setKey(enet::HTTPHeaderId::secWebSocketProtocol, protocolList);
 			}
 			ememory::SharedPtr<enet::HttpClient> interface = ememory::dynamicPointerCast<enet::HttpClient>(m_interface);
 			if (interface != null) {
@@ -144,8 +171,14 @@ void enet::WebSocket::start(const etk::String& _uri, const etk::Vector<etk::Stri
 					timeout--;
 				}
 				if (m_redirectInProgress == true) {
-					ENET_WARNING("Request a redirection (wait 500ms)");
-					ethread::sleepMilliSeconds(500);
+					// Wait with a random backoff: all the clients redirected at the same time do not come back together.
+					ENET_WARNING("Request a redirection (wait)");
+					if (sequence.retry() == false) {
+						ENET_ERROR("Too many redirection ==> stop");
+						m_redirectInProgress = false;
+						m_interface->stop();
+						break;
+					}
 					ENET_WARNING("Request a redirection (wait-end)");
 				} else {
 					if (    m_connectionValidate == false
@@ -353,39 +386,39 @@ void enet::WebSocket::onReceiveRequest(const enet::HttpRequest& _data) {
 	if (_data.getType() != enet::HTTPReqType::HTTP_GET) {
 		enet::HttpAnswer answer(enet::HTTPAnswerCode::c400_badRequest, "support only GET");
 		answer.setProtocol(enet::HTTPProtocol::http_1_1);
-		answer.setKey("Connection", "close");
+		answer.setKey(enet::HTTPHeaderId::connection, "close");
 		interface->setHeader(answer);
 		interface->stop(true);
 		return;
 	}
-	if (_data.getKey("Connection") == "close") {
+	if (_data.isKeyEqual(enet::HTTPHeaderId::connection, "close") == true) {
 		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
 		answer.setProtocol(enet::HTTPProtocol::http_1_1);
-		answer.setKey("Connection", "close");
+		answer.setKey(enet::HTTPHeaderId::connection, "close");
 		interface->setHeader(answer);
 		interface->stop(true);
 		return;
 	}
-	if (_data.getKey("Upgrade") != "websocket") {
+	if (_data.isKeyEqual(enet::HTTPHeaderId::upgrade, "websocket") == false) {
 		enet::HttpAnswer answer(enet::HTTPAnswerCode::c400_badRequest, "websocket support only with Upgrade: websocket");
 		answer.setProtocol(enet::HTTPProtocol::http_1_1);
-		answer.setKey("Connection", "close");
+		answer.setKey(enet::HTTPHeaderId::connection, "close");
 		interface->setHeader(answer);
 		interface->stop(true);
 		return;
 	}
-	if (_data.getKey("Sec-WebSocket-Key") == "") {
+	if (_data.existKey(enet::HTTPHeaderId::secWebSocketKey) == false) {
 		enet::HttpAnswer answer(enet::HTTPAnswerCode::c400_badRequest, "websocket missing 'Sec-WebSocket-Key'");
 		answer.setProtocol(enet::HTTPProtocol::http_1_1);
-		answer.setKey("Connection", "close");
+		answer.setKey(enet::HTTPHeaderId::connection, "close");
 		interface->setHeader(answer);
 		interface->stop(true);
 		return;
 	}
 	// parse all protocols:
 	etk::Vector<etk::String> listProtocol;
-	if (_data.getKey("Sec-WebSocket-Protocol") != "") {
-		listProtocol = etk::split(_data.getKey("Sec-WebSocket-Protocol"),',');
+	if (_data.getKey(enet::HTTPHeaderId::secWebSocketProtocol) != "") {
+		listProtocol = etk::split(_data.getKey(enet::HTTPHeaderId::secWebSocketProtocol),',');
 		for (size_t iii=0; iii<listProtocol.size(); ++iii) {
 			listProtocol[iii] = removeStartAndStopSpace(listProtocol[iii]);
 		}
@@ -398,7 +431,7 @@ void enet::WebSocket::onReceiveRequest(const enet::HttpRequest& _data) {
 			ENET_INFO("Request redirection of HTTP/WebSocket connection to : '" << ret.extract(9, ret.size()) << "'");
 			enet::HttpAnswer answer(enet::HTTPAnswerCode::c307_temporaryRedirect);
 			answer.setProtocol(enet::HTTPProtocol::http_1_1);
-			answer.setKey("Location", ret.extract(9, ret.size()));
+			answer.setKey(enet::HTTPHeaderId::location, ret.extract(9, ret.size()));
 			interface->setHeader(answer);
 			interface->stop(true);
 			return;
@@ -408,7 +441,7 @@ void enet::WebSocket::onReceiveRequest(const enet::HttpRequest& _data) {
 			}
 			enet::HttpAnswer answer(enet::HTTPAnswerCode::c404_notFound);
 			answer.setProtocol(enet::HTTPProtocol::http_1_1);
-			answer.setKey("Connection", "close");
+			answer.setKey(enet::HTTPHeaderId::connection, "close");
 			interface->setHeader(answer);
 			interface->stop(true);
 			return;
@@ -416,12 +449,12 @@ void enet::WebSocket::onReceiveRequest(const enet::HttpRequest& _data) {
 	}
 	enet::HttpAnswer answer(enet::HTTPAnswerCode::c101_switchingProtocols);
 	answer.setProtocol(enet::HTTPProtocol::http_1_1);
-	answer.setKey("Upgrade", "websocket");
-	answer.setKey("Connection", "Upgrade");
-	etk::String answerKey = generateCheckKey(_data.getKey("Sec-WebSocket-Key"));
-	answer.setKey("Sec-WebSocket-Accept", answerKey);
+	answer.setKey(enet::HTTPHeaderId::upgrade, "websocket");
+	answer.setKey(enet::HTTPHeaderId::connection, "Upgrade");
+	etk::String answerKey = enet::websocket::generateCheckKey(_data.getKey(enet::HTTPHeaderId::secWebSocketKey));
+	answer.setKey(enet::HTTPHeaderId::secWebSocketAccept, answerKey);
 	if (m_protocol != "") {
-		answer.setKey("Sec-WebSocket-Protocol", m_protocol);
+		answer.setKey(enet::HTTPHeaderId::secWebSocketProtocol, m_protocol);
 	}
 	interface->setHeader(answer);
 }
@@ -433,11 +466,11 @@ void enet::WebSocket::onReceiveAnswer(const enet::HttpAnswer& _data) {
 	}
 	_data.display();
 	if (_data.getErrorCode() == enet::HTTPAnswerCode::c307_temporaryRedirect) {
-		ENET_ERROR("Request connection redirection to '" << _data.getKey("Location") << "'");
+		ENET_ERROR("Request connection redirection to '" << _data.getKey(enet::HTTPHeaderId::location) << "'");
 		// We are a client mode, we need to recreate a TCP connection on the new remote interface
 		// This is the generic way to accept a redirection
 		m_redirectInProgress = true;
-		m_interface->redirectTo(_data.getKey("Location"), true);
+		m_interface->redirectTo(_data.getKey(enet::HTTPHeaderId::location), true);
 		return;
 	}
 	if (_data.getErrorCode() != enet::HTTPAnswerCode::c101_switchingProtocols) {
@@ -445,23 +478,23 @@ void enet::WebSocket::onReceiveAnswer(const enet::HttpAnswer& _data) {
 		m_interface->stop(true);
 		return;
 	}
-	if (_data.getKey("Connection") != "Upgrade") {
-		ENET_ERROR("Missing key : 'Connection : Upgrade' get '" << _data.getKey("Connection") << "'");
+	if (_data.isKeyEqual(enet::HTTPHeaderId::connection, "Upgrade") == false) {
+		ENET_ERROR("Missing key : 'Connection : Upgrade' get '" << _data.getKey(enet::HTTPHeaderId::connection) << "'");
 		m_interface->stop(true);
 		return;
 	}
-	if (_data.getKey("Upgrade") != "websocket") {
-		ENET_ERROR("Missing key : 'Upgrade : websocket' get '" << _data.getKey("Upgrade") << "'");
+	if (_data.isKeyEqual(enet::HTTPHeaderId::upgrade, "websocket") == false) {
+		ENET_ERROR("Missing key : 'Upgrade : websocket' get '" << _data.getKey(enet::HTTPHeaderId::upgrade) << "'");
 		m_interface->stop(true);
 		return;
 	}
 	// NOTE : This is a temporary magic check ...
-	if (_data.getKey("Sec-WebSocket-Accept") != m_checkKey) {
-		ENET_ERROR("Wrong key : 'Sec-WebSocket-Accept : xxx' get '" << _data.getKey("Sec-WebSocket-Accept") << "'");
+	if (_data.getKey(enet::HTTPHeaderId::secWebSocketAccept) != m_checkKey) {
+		ENET_ERROR("Wrong key : 'Sec-WebSocket-Accept : xxx' get '" << _data.getKey(enet::HTTPHeaderId::secWebSocketAccept) << "'");
 		m_interface->stop(true);
 		return;
 	}
-	setProtocol(_data.getKey("Sec-WebSocket-Protocol"));
+	setProtocol(_data.getKey(enet::HTTPHeaderId::secWebSocketProtocol));
 	// TODO : Create a methode to check the current protocol ...
 	// now we can release the client call connection ...
 	m_connectionValidate = true;
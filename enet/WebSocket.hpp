@@ -12,6 +12,21 @@
 #include <etk/Map.hpp>
 
 namespace enet {
+	namespace websocket {
+		static const uint32_t FLAG_FIN = 0x80;
+		static const uint32_t FLAG_MASK = 0x80;
+		static const uint32_t OPCODE_FRAME_TEXT = 0x01;
+		static const uint32_t OPCODE_FRAME_BINARY = 0x02;
+		static const uint32_t OPCODE_FRAME_CLOSE = 0x08;
+		static const uint32_t OPCODE_FRAME_PING = 0x09;
+		static const uint32_t OPCODE_FRAME_PONG = 0x0A;
+		/**
+		 * @brief Get the value of the "Sec-WebSocket-Accept" key of a "Sec-WebSocket-Key" (RFC 6455 4.2.2).
+		 * @param[in] _key Value of the "Sec-WebSocket-Key" key.
+		 * @return Value of the "Sec-WebSocket-Accept" key.
+		 */
+		etk::String generateCheckKey(const etk::String& _key);
+	}
 	class WebSocket {
 		protected:
 			etk::Vector<uint8_t> m_sendBuffer;
@@ -33,7 +48,33 @@ namespace enet {
 		public:
 			WebSocket();
 			WebSocket(enet::Tcp _connection, bool _isServer=false);
+			/**
+			 * @brief Contructor of a client with a connection of a pool (a warm connection avoid the handshake delay).
+			 * The connection is never given back to the pool: it is used by the WebSocket protocol after the upgrade.
+			 * @param[in] _pool Pool of connection.
+			 * @param[in] _hostname Name or IP of the host.
+			 * @param[in] _port Port of the host.
+			 */
+			WebSocket(ememory::SharedPtr<enet::ConnectionPool> _pool, const etk::String& _hostname, uint16_t _port);
 			void setInterface(enet::Tcp _connection, bool _isServer=false);
+			/**
+			 * @brief Set the overload controller of the server (can be shared between all the connections)
+			 * @param[in] _value Admission controller (null to disable)
+			 * @note Only used in server mode, must be set before calling start()
+			 */
+			void setAdmissionControl(ememory::SharedPtr<enet::AdmissionControl> _value);
+			/**
+			 * @brief Set the rate limiter checked when the upgrade request is received (can be shared between all the connections)
+			 * @param[in] _value Rate limiter (null to disable)
+			 * @note Only used in server mode
+			 */
+			void setRateLimiter(ememory::SharedPtr<enet::RateLimiter> _value);
+			/**
+			 * @brief Set the retry policy used to wait and connect on a redirection (can be shared between all the connections)
+			 * @param[in] _value Retry policy (null to use the default one)
+			 * @note Only used in client mode
+			 */
+			void setRetryPolicy(ememory::SharedPtr<enet::RetryPolicy> _value);
 			virtual ~WebSocket();
 			void start(const etk::String& _uri="", const etk::Vector<etk::String>& _listProtocols=etk::Vector<etk::String>());
 			void stop(bool _inThread=false);
@@ -5,6 +5,10 @@
  */
 #include <enet/enet.hpp>
 #include <enet/debug.hpp>
+#include <enet/Resolver.hpp>
+#include <enet/HttpCanned.hpp>
+#include <enet/HttpAsync.hpp>
+#include <enet/TcpClient.hpp>
 
 static bool& getInitSatatus() {
 	static bool isInit = false;
@@ -20,7 +24,9 @@ static bool& getInitSatatus() {
 void enet::init(int _argc, const char** _argv) {
 	for (int32_t iii=0; iii<_argc; ++iii) {
 		etk::String value = _argv[iii];
-		if (etk::start_with(value, "--enet") == true) {
+		if (value == "--enet-tcp-fast-open") {
+			enet::setTcpFastOpen(true);
+		} else if (etk::start_with(value, "--enet") == true) {
 			ENET_ERROR("Unknow parameter type: '" << value << "'");
 		}
 	}
@@ -40,6 +46,9 @@ void enet::unInit() {
 	if (getInitSatatus() == false) {
 		ENET_ERROR("Request UnInit of enent already done ...");
 	} else {
+		enet::resolver::setBackgroundRefresh(false);
+		enet::httpDate::setBackgroundRefresh(false);
+		enet::httpAsync::stop();
 		#ifdef __TARGET_OS__Windows
 			WSACleanup();
 		#endif
@@ -5,6 +5,7 @@
  */
 #include <enet/pourcentEncoding.hpp>
 #include <enet/debug.hpp>
+#include <enet/scan.hpp>
 #include <etk/types.hpp>
 #include <etk/String.hpp>
 
@@ -46,20 +47,29 @@ static int32_t convertStringHexToInt(const char _value) {
 
 etk::String enet::pourcentDecode(const etk::String& _data) {
 	etk::String out;
-	for (size_t iii=0; iii<_data.size(); ++iii) {
-		auto it = _data[iii];
-		if (it == '%') {
-			if (iii+2 < _data.size()) {
-				auto val1 = convertStringHexToInt(_data[iii+1])<<4;
-				val1 += convertStringHexToInt(_data[iii+2]);
-				out += char(val1);
-				iii += 2;
-			} else {
-				ENET_ERROR("can not convert pourcent ==> input size error: '" << _data << "'");
-				return out;
-			}
+	out.reserve(_data.size());
+	const char* data = _data.c_str();
+	size_t iii = 0;
+	while (iii < _data.size()) {
+		// copy all the raw data up to the next '%' in one time
+		size_t nbRaw = enet::scan::findChar(data + iii, _data.size() - iii, '%');
+		if (nbRaw != 0) {
+			size_t outSize = out.size();
+			out.resize(outSize + nbRaw);
+			memcpy(&out[outSize], data + iii, nbRaw);
+			iii += nbRaw;
+		}
+		if (iii >= _data.size()) {
+			break;
+		}
+		if (iii+2 < _data.size()) {
+			auto val1 = convertStringHexToInt(_data[iii+1])<<4;
+			val1 += convertStringHexToInt(_data[iii+2]);
+			out += char(val1);
+			iii += 3;
 		} else {
-			out += it;
+			ENET_ERROR("can not convert pourcent ==> input size error: '" << _data << "'");
+			return out;
 		}
 	}
 	return out;
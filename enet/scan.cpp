@@ -0,0 +1,330 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <enet/debug.hpp>
+#include <enet/scan.hpp>
+extern "C" {
+	#include <string.h>
+}
+
+#if    defined(__GNUC__) \
+    && defined(__SSE2__) \
+    && (    defined(__x86_64__) \
+         || defined(__i386__))
+	#define ENET_SCAN_X86
+	#include <immintrin.h>
+	// AVX2 code is compiled for the functions that need it only, it is called only if the CPU support it.
+	#define ENET_SCAN_AVX2 __attribute__((target("avx2")))
+#endif
+
+namespace enet {
+	namespace scan {
+		/**
+		 * @brief List of character authorized in a token: "!#$%&'*+-.^_`|~" DIGIT ALPHA
+		 */
+		class TokenTable {
+			public:
+				bool m_valid[256];
+				TokenTable() {
+					for (size_t iii=0; iii<256; ++iii) {
+						m_valid[iii] =    (iii >= 'a' && iii <= 'z')
+						               || (iii >= 'A' && iii <= 'Z')
+						               || (iii >= '0' && iii <= '9');
+					}
+					const char* special = "!#$%&'*+-.^_`|~";
+					for (const char* it=special; *it != '\0'; ++it) {
+						m_valid[uint8_t(*it)] = true;
+					}
+				}
+		};
+		static const TokenTable& getTokenTable() {
+			static TokenTable table;
+			return table;
+		}
+		/**
+		 * @brief Each predicate define the byte searched in scalar, SSE2 (16 bytes) and AVX2 (32 bytes)
+		 * The vector version return 0xFF in the byte that match.
+		 */
+		class PredicateChar {
+			public:
+				char m_value;
+				PredicateChar(char _value) :
+				  m_value(_value) {
+
+				}
+				bool scalar(uint8_t _value) const {
+					return _value == uint8_t(m_value);
+				}
+				#ifdef ENET_SCAN_X86
+					__m128i sse2(__m128i _value) const {
+						return _mm_cmpeq_epi8(_value, _mm_set1_epi8(m_value));
+					}
+					ENET_SCAN_AVX2 __m256i avx2(__m256i _value) const {
+						return _mm256_cmpeq_epi8(_value, _mm256_set1_epi8(m_value));
+					}
+				#endif
+		};
+		class PredicateEndLine {
+			public:
+				bool scalar(uint8_t _value) const {
+					return    _value == '\r'
+					       || _value == '\n';
+				}
+				#ifdef ENET_SCAN_X86
+					__m128i sse2(__m128i _value) const {
+						return _mm_or_si128(_mm_cmpeq_epi8(_value, _mm_set1_epi8('\r')),
+						                    _mm_cmpeq_epi8(_value, _mm_set1_epi8('\n')));
+					}
+					ENET_SCAN_AVX2 __m256i avx2(__m256i _value) const {
+						return _mm256_or_si256(_mm256_cmpeq_epi8(_value, _mm256_set1_epi8('\r')),
+						                       _mm256_cmpeq_epi8(_value, _mm256_set1_epi8('\n')));
+					}
+				#endif
+		};
+		class PredicateSpaceOrEndLine {
+			public:
+				bool scalar(uint8_t _value) const {
+					return    _value == ' '
+					       || _value == '\r'
+					       || _value == '\n';
+				}
+				#ifdef ENET_SCAN_X86
+					__m128i sse2(__m128i _value) const {
+						return _mm_or_si128(_mm_cmpeq_epi8(_value, _mm_set1_epi8(' ')),
+						                    PredicateEndLine().sse2(_value));
+					}
+					ENET_SCAN_AVX2 __m256i avx2(__m256i _value) const {
+						return _mm256_or_si256(_mm256_cmpeq_epi8(_value, _mm256_set1_epi8(' ')),
+						                       PredicateEndLine().avx2(_value));
+					}
+				#endif
+		};
+		class PredicateInvalidToken {
+			private:
+				const TokenTable& m_table;
+			public:
+				PredicateInvalidToken() :
+				  m_table(getTokenTable()) {
+
+				}
+				bool scalar(uint8_t _value) const {
+					return m_table.m_valid[_value] == false;
+				}
+				#ifdef ENET_SCAN_X86
+					// Invalid: <= ' ' (and >= 0x80 that are negative in signed), DEL, and the separators '"' '(' ')' ',' '/' ':' ';' '<' '=' '>' '?' '@' '[' '\' ']' '{' '}'
+					static __m128i sse2Range(__m128i _value, char _min, char _max) {
+						return _mm_and_si128(_mm_cmpgt_epi8(_value, _mm_set1_epi8(_min-1)),
+						                     _mm_cmplt_epi8(_value, _mm_set1_epi8(_max+1)));
+					}
+					__m128i sse2(__m128i _value) const {
+						__m128i out = _mm_cmplt_epi8(_value, _mm_set1_epi8(0x21));
+						out = _mm_or_si128(out, _mm_cmpeq_epi8(_value, _mm_set1_epi8(0x7F)));
+						out = _mm_or_si128(out, _mm_cmpeq_epi8(_value, _mm_set1_epi8('"')));
+						out = _mm_or_si128(out, _mm_cmpeq_epi8(_value, _mm_set1_epi8(',')));
+						out = _mm_or_si128(out, _mm_cmpeq_epi8(_value, _mm_set1_epi8('/')));
+						out = _mm_or_si128(out, _mm_cmpeq_epi8(_value, _mm_set1_epi8('{')));
+						out = _mm_or_si128(out, _mm_cmpeq_epi8(_value, _mm_set1_epi8('}')));
+						out = _mm_or_si128(out, sse2Range(_value, '(', ')'));
+						out = _mm_or_si128(out, sse2Range(_value, ':', '@'));
+						out = _mm_or_si128(out, sse2Range(_value, '[', ']'));
+						return out;
+					}
+					ENET_SCAN_AVX2 static __m256i avx2Range(__m256i _value, char _min, char _max) {
+						return _mm256_and_si256(_mm256_cmpgt_epi8(_value, _mm256_set1_epi8(_min-1)),
+						                        _mm256_cmpgt_epi8(_mm256_set1_epi8(_max+1), _value));
+					}
+					ENET_SCAN_AVX2 __m256i avx2(__m256i _value) const {
+						__m256i out = _mm256_cmpgt_epi8(_mm256_set1_epi8(0x21), _value);
+						out = _mm256_or_si256(out, _mm256_cmpeq_epi8(_value, _mm256_set1_epi8(0x7F)));
+						out = _mm256_or_si256(out, _mm256_cmpeq_epi8(_value, _mm256_set1_epi8('"')));
+						out = _mm256_or_si256(out, _mm256_cmpeq_epi8(_value, _mm256_set1_epi8(',')));
+						out = _mm256_or_si256(out, _mm256_cmpeq_epi8(_value, _mm256_set1_epi8('/')));
+						out = _mm256_or_si256(out, _mm256_cmpeq_epi8(_value, _mm256_set1_epi8('{')));
+						out = _mm256_or_si256(out, _mm256_cmpeq_epi8(_value, _mm256_set1_epi8('}')));
+						out = _mm256_or_si256(out, avx2Range(_value, '(', ')'));
+						out = _mm256_or_si256(out, avx2Range(_value, ':', '@'));
+						out = _mm256_or_si256(out, avx2Range(_value, '[', ']'));
+						return out;
+					}
+				#endif
+		};
+		class PredicateInvalidValue {
+			public:
+				bool scalar(uint8_t _value) const {
+					return    (    _value < 0x20
+					            && _value != '\t')
+					       || _value == 0x7F;
+				}
+				#ifdef ENET_SCAN_X86
+					// Invalid: [0x00..0x1F] except '\t', and DEL (the bytes >= 0x80 are negative and valid)
+					__m128i sse2(__m128i _value) const {
+						__m128i control = _mm_and_si128(_mm_cmpgt_epi8(_value, _mm_set1_epi8(-1)),
+						                                _mm_cmplt_epi8(_value, _mm_set1_epi8(0x20)));
+						control = _mm_andnot_si128(_mm_cmpeq_epi8(_value, _mm_set1_epi8('\t')), control);
+						return _mm_or_si128(control, _mm_cmpeq_epi8(_value, _mm_set1_epi8(0x7F)));
+					}
+					ENET_SCAN_AVX2 __m256i avx2(__m256i _value) const {
+						__m256i control = _mm256_and_si256(_mm256_cmpgt_epi8(_value, _mm256_set1_epi8(-1)),
+						                                   _mm256_cmpgt_epi8(_mm256_set1_epi8(0x20), _value));
+						control = _mm256_andnot_si256(_mm256_cmpeq_epi8(_value, _mm256_set1_epi8('\t')), control);
+						return _mm256_or_si256(control, _mm256_cmpeq_epi8(_value, _mm256_set1_epi8(0x7F)));
+					}
+				#endif
+		};
+		template<class PREDICATE>
+		static size_t findScalar(const char* _data, size_t _size, const PREDICATE& _predicate) {
+			for (size_t iii=0; iii<_size; ++iii) {
+				if (_predicate.scalar(uint8_t(_data[iii])) == true) {
+					return iii;
+				}
+			}
+			return _size;
+		}
+		#ifdef ENET_SCAN_X86
+			template<class PREDICATE>
+			static size_t findSse2(const char* _data, size_t _size, const PREDICATE& _predicate) {
+				size_t pos = 0;
+				for (; pos + 16 <= _size; pos += 16) {
+					__m128i value = _mm_loadu_si128((const __m128i*)(_data + pos));
+					int32_t mask = _mm_movemask_epi8(_predicate.sse2(value));
+					if (mask != 0) {
+						return pos + __builtin_ctz(mask);
+					}
+				}
+				return pos + findScalar(_data + pos, _size - pos, _predicate);
+			}
+			template<class PREDICATE>
+			ENET_SCAN_AVX2 static size_t findAvx2(const char* _data, size_t _size, const PREDICATE& _predicate) {
+				size_t pos = 0;
+				for (; pos + 32 <= _size; pos += 32) {
+					__m256i value = _mm256_loadu_si256((const __m256i*)(_data + pos));
+					uint32_t mask = uint32_t(_mm256_movemask_epi8(_predicate.avx2(value)));
+					if (mask != 0) {
+						return pos + __builtin_ctz(mask);
+					}
+				}
+				// The end is done with 16 bytes vector here (VEX encoded): calling findSse2() would mix AVX and
+				// legacy SSE instructions, that cost a transition penalty on each call.
+				for (; pos + 16 <= _size; pos += 16) {
+					__m128i value = _mm_loadu_si128((const __m128i*)(_data + pos));
+					int32_t mask = _mm_movemask_epi8(_predicate.sse2(value));
+					if (mask != 0) {
+						return pos + __builtin_ctz(mask);
+					}
+				}
+				return pos + findScalar(_data + pos, _size - pos, _predicate);
+			}
+		#endif
+		/**
+		 * @brief List of the functions of an instruction set.
+		 */
+		class Implementation {
+			public:
+				const char* m_name;
+				size_t (*m_findChar)(const char*, size_t, char);
+				size_t (*m_findEndLine)(const char*, size_t);
+				size_t (*m_findSpaceOrEndLine)(const char*, size_t);
+				size_t (*m_findInvalidToken)(const char*, size_t);
+				size_t (*m_findInvalidValue)(const char*, size_t);
+		};
+		static const Implementation g_scalar = {
+			"scalar",
+			[](const char* _data, size_t _size, char _value) { return findScalar(_data, _size, PredicateChar(_value)); },
+			[](const char* _data, size_t _size) { return findScalar(_data, _size, PredicateEndLine()); },
+			[](const char* _data, size_t _size) { return findScalar(_data, _size, PredicateSpaceOrEndLine()); },
+			[](const char* _data, size_t _size) { return findScalar(_data, _size, PredicateInvalidToken()); },
+			[](const char* _data, size_t _size) { return findScalar(_data, _size, PredicateInvalidValue()); }
+		};
+		#ifdef ENET_SCAN_X86
+			static const Implementation g_sse2 = {
+				"sse2",
+				[](const char* _data, size_t _size, char _value) { return findSse2(_data, _size, PredicateChar(_value)); },
+				[](const char* _data, size_t _size) { return findSse2(_data, _size, PredicateEndLine()); },
+				[](const char* _data, size_t _size) { return findSse2(_data, _size, PredicateSpaceOrEndLine()); },
+				[](const char* _data, size_t _size) { return findSse2(_data, _size, PredicateInvalidToken()); },
+				[](const char* _data, size_t _size) { return findSse2(_data, _size, PredicateInvalidValue()); }
+			};
+			static const Implementation g_avx2 = {
+				"avx2",
+				[](const char* _data, size_t _size, char _value) { return findAvx2(_data, _size, PredicateChar(_value)); },
+				[](const char* _data, size_t _size) { return findAvx2(_data, _size, PredicateEndLine()); },
+				[](const char* _data, size_t _size) { return findAvx2(_data, _size, PredicateSpaceOrEndLine()); },
+				[](const char* _data, size_t _size) { return findAvx2(_data, _size, PredicateInvalidToken()); },
+				[](const char* _data, size_t _size) { return findAvx2(_data, _size, PredicateInvalidValue()); }
+			};
+		#endif
+		static bool isSupported(const Implementation& _implementation) {
+			#ifdef ENET_SCAN_X86
+				if (&_implementation == &g_avx2) {
+					__builtin_cpu_init();
+					return __builtin_cpu_supports("avx2") != 0;
+				}
+			#endif
+			return true;
+		}
+		static const Implementation* detect() {
+			#ifdef ENET_SCAN_X86
+				if (isSupported(g_avx2) == true) {
+					return &g_avx2;
+				}
+				return &g_sse2;
+			#else
+				return &g_scalar;
+			#endif
+		}
+		static const Implementation*& getImplementationPointer() {
+			static const Implementation* implementation = detect();
+			return implementation;
+		}
+	}
+}
+
+size_t enet::scan::findChar(const char* _data, size_t _size, char _value) {
+	return getImplementationPointer()->m_findChar(_data, _size, _value);
+}
+
+size_t enet::scan::findEndLine(const char* _data, size_t _size) {
+	return getImplementationPointer()->m_findEndLine(_data, _size);
+}
+
+size_t enet::scan::findSpaceOrEndLine(const char* _data, size_t _size) {
+	return getImplementationPointer()->m_findSpaceOrEndLine(_data, _size);
+}
+
+size_t enet::scan::findInvalidToken(const char* _data, size_t _size) {
+	return getImplementationPointer()->m_findInvalidToken(_data, _size);
+}
+
+size_t enet::scan::findInvalidValue(const char* _data, size_t _size) {
+	return getImplementationPointer()->m_findInvalidValue(_data, _size);
+}
+
+const char* enet::scan::getImplementation() {
+	return getImplementationPointer()->m_name;
+}
+
+bool enet::scan::setImplementation(const char* _name) {
+	const Implementation* list[] = {
+		#ifdef ENET_SCAN_X86
+			&g_avx2,
+			&g_sse2,
+		#endif
+		&g_scalar
+	};
+	for (auto &it : list) {
+		if (strcmp(it->m_name, _name) != 0) {
+			continue;
+		}
+		if (isSupported(*it) == false) {
+			ENET_ERROR("Scan implementation '" << _name << "' is not supported by the CPU");
+			return false;
+		}
+		getImplementationPointer() = it;
+		return true;
+	}
+	ENET_ERROR("Unknow scan implementation '" << _name << "'");
+	return false;
+}
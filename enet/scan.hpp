@@ -0,0 +1,66 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+#pragma once
+
+#include <etk/types.hpp>
+
+namespace enet {
+	/**
+	 * @brief Delimiter search in the protocol buffers.
+	 * The search is done 16 (SSE2) or 32 (AVX2) bytes at a time, the instruction set is selected when
+	 * the library start (AVX2 if the CPU support it), with a scalar version for the other CPUs.
+	 * All the functions return the position of the first byte found, or _size if there is none.
+	 */
+	namespace scan {
+		/**
+		 * @brief Find a character.
+		 * @param[in] _data Data to parse.
+		 * @param[in] _size Number of byte of the data.
+		 * @param[in] _value Character to find.
+		 * @return Position of the character or _size
+		 */
+		size_t findChar(const char* _data, size_t _size, char _value);
+		/**
+		 * @brief Find the end of a line ('\\r' or '\\n').
+		 * @param[in] _data Data to parse.
+		 * @param[in] _size Number of byte of the data.
+		 * @return Position of the end of line or _size
+		 */
+		size_t findEndLine(const char* _data, size_t _size);
+		/**
+		 * @brief Find the end of a word of the first line (' ', '\\r' or '\\n').
+		 * @param[in] _data Data to parse.
+		 * @param[in] _size Number of byte of the data.
+		 * @return Position of the separator or _size
+		 */
+		size_t findSpaceOrEndLine(const char* _data, size_t _size);
+		/**
+		 * @brief Find the first character that is not valid in a token (header name, method, RFC 7230 3.2.6).
+		 * @param[in] _data Data to parse.
+		 * @param[in] _size Number of byte of the data.
+		 * @return Position of the invalid character or _size
+		 */
+		size_t findInvalidToken(const char* _data, size_t _size);
+		/**
+		 * @brief Find the first control character in a header value (all except the tabulation, the end of line are include).
+		 * @param[in] _data Data to parse.
+		 * @param[in] _size Number of byte of the data.
+		 * @return Position of the control character or _size
+		 */
+		size_t findInvalidValue(const char* _data, size_t _size);
+		/**
+		 * @brief Get the name of the instruction set used.
+		 * @return "avx2", "sse2" or "scalar"
+		 */
+		const char* getImplementation();
+		/**
+		 * @brief Force the instruction set used (for test and benchmark).
+		 * @param[in] _name "avx2", "sse2" or "scalar" (refused if not supported by the CPU)
+		 * @return true if the instruction set is used
+		 */
+		bool setImplementation(const char* _name);
+	}
+}
@@ -33,7 +33,27 @@ def configure(target, my_module):
 	    ])
 	my_module.add_src_file([
 	    'test/main-test.cpp',
-	    'test/main-unit-pourcentEncoding.cpp'
+	    'test/main-unit-pourcentEncoding.cpp',
+	    'test/main-unit-rateLimiter.cpp',
+	    'test/main-unit-admissionControl.cpp',
+	    'test/main-unit-resolver.cpp',
+	    'test/main-unit-retryPolicy.cpp',
+	    'test/main-unit-loadBalancer.cpp',
+	    'test/main-unit-httpParser.cpp',
+	    'test/main-unit-scan.cpp',
+	    'test/main-unit-httpHeader.cpp',
+	    'test/main-unit-httpChunk.cpp',
+	    'test/main-unit-httpResponseWriter.cpp',
+	    'test/main-unit-httpKeepAlive.cpp',
+	    'test/main-unit-httpCanned.cpp',
+	    'test/main-unit-httpCompression.cpp',
+	    'test/main-unit-staticFiles.cpp',
+	    'test/main-unit-httpCache.cpp',
+	    'test/main-unit-router.cpp',
+	    'test/main-unit-httpAsync.cpp',
+	    'test/main-unit-coroutine.cpp',
+	    'test/main-unit-tcpClient.cpp',
+	    'test/main-unit-connectionPool.cpp',
 	    ])
 	return True
 
@@ -29,7 +29,8 @@ def configure(target, my_module):
 	    'etk',
 	    'ememory',
 	    'algue',
-	    'ethread'
+	    'ethread',
+	    'z'
 	    ])
 	my_module.add_path(".")
 	my_module.add_src_file([
@@ -43,6 +44,23 @@ def configure(target, my_module):
 	    'enet/Ftp.cpp',
 	    'enet/WebSocket.cpp',
 	    'enet/pourcentEncoding.cpp',
+	    'enet/AdmissionControl.cpp',
+	    'enet/RateLimiter.cpp',
+	    'enet/Resolver.cpp',
+	    'enet/ConnectionPool.cpp',
+	    'enet/RetryPolicy.cpp',
+	    'enet/LoadBalancer.cpp',
+	    'enet/HttpParser.cpp',
+	    'enet/scan.cpp',
+	    'enet/HttpChunk.cpp',
+	    'enet/HttpCanned.cpp',
+	    'enet/HttpAsync.cpp',
+	    'enet/HttpCompression.cpp',
+	    'enet/StaticFiles.cpp',
+	    'enet/HttpCache.cpp',
+	    'enet/Router.cpp',
+	    'enet/Coroutine.cpp',
+	    'enet/HttpCoroutine.cpp',
 	    ])
 	my_module.add_header_file([
 	    'enet/enet.hpp',
@@ -55,6 +73,23 @@ def configure(target, my_module):
 	    'enet/Ftp.hpp',
 	    'enet/WebSocket.hpp',
 	    'enet/pourcentEncoding.hpp',
+	    'enet/AdmissionControl.hpp',
+	    'enet/RateLimiter.hpp',
+	    'enet/Resolver.hpp',
+	    'enet/ConnectionPool.hpp',
+	    'enet/RetryPolicy.hpp',
+	    'enet/LoadBalancer.hpp',
+	    'enet/HttpParser.hpp',
+	    'enet/scan.hpp',
+	    'enet/HttpChunk.hpp',
+	    'enet/HttpCanned.hpp',
+	    'enet/HttpAsync.hpp',
+	    'enet/HttpCompression.hpp',
+	    'enet/StaticFiles.hpp',
+	    'enet/HttpCache.hpp',
+	    'enet/Router.hpp',
+	    'enet/Coroutine.hpp',
+	    'enet/HttpCoroutine.hpp',
 	    ])
 	if "Windows" in target.get_type():
 		my_module.add_depend("ws2");
@@ -0,0 +1,214 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <test-debug/debug.hpp>
+#include <enet/enet.hpp>
+#include <enet/Http.hpp>
+#include <enet/HttpParser.hpp>
+#include <enet/scan.hpp>
+#include <etk/etk.hpp>
+#include <etk/stdTools.hpp>
+#include <echrono/Steady.hpp>
+#include <new>
+extern "C" {
+	#include <stdlib.h>
+}
+
+// Count all the allocations of the process to check the parsing does not allocate.
+static uint64_t g_nbAllocation = 0;
+
+void* operator new(size_t _size) {
+	g_nbAllocation++;
+	void* out = malloc(_size == 0 ? 1 : _size);
+	if (out == nullptr) {
+		throw std::bad_alloc();
+	}
+	return out;
+}
+
+void operator delete(void* _pointer) noexcept {
+	free(_pointer);
+}
+
+void operator delete(void* _pointer, size_t) noexcept {
+	free(_pointer);
+}
+
+namespace appl {
+	static const char* g_header = "GET /api/v1/element/42?format=json HTTP/1.1\r\n"
+	                              "Host: www.example.com\r\n"
+	                              "User-Agent: Mozilla/5.0 (X11; Linux x86_64; rv:60.0) Gecko/20100101 Firefox/60.0\r\n"
+	                              "Accept: text/html,application/xhtml+xml,application/xml;q=0.9,*/*;q=0.8\r\n"
+	                              "Accept-Language: en-US,en;q=0.5\r\n"
+	                              "Accept-Encoding: gzip, deflate\r\n"
+	                              "Cookie: session=0123456789abcdef0123456789abcdef; theme=dark\r\n"
+	                              "Connection: keep-alive\r\n"
+	                              "Cache-Control: max-age=0\r\n"
+	                              "\r\n";
+	/**
+	 * @brief Parse the header in one buffer or in small chunks (resume of the parser)
+	 */
+	void benchParser(const etk::String& _data, size_t _chunkSize, int32_t _nbLoop) {
+		enet::HttpParser parser;
+		uint64_t nbField = 0;
+		uint64_t nbAllocation = g_nbAllocation;
+		echrono::Steady start = echrono::Steady::now();
+		for (int32_t iii=0; iii<_nbLoop; ++iii) {
+			parser.reset();
+			size_t size = 0;
+			while (size < _data.size()) {
+				size = etk::min(size + _chunkSize, _data.size());
+				if (parser.parse(_data.c_str(), size) != enet::HttpParser::status::incomplete) {
+					break;
+				}
+			}
+			nbField += parser.getNumberField();
+		}
+		echrono::Duration duration = echrono::Steady::now() - start;
+		nbAllocation = g_nbAllocation - nbAllocation;
+		double second = double(duration.get()) / 1000000000.0;
+		TEST_PRINT("HttpParser chunk=" << _chunkSize << " : " << _nbLoop << " headers in " << duration);
+		TEST_PRINT("    " << int64_t(double(_nbLoop) / second) << " headers/s, "
+		                  << int64_t(double(nbField) / second) << " fields/s, "
+		                  << int64_t(double(_data.size()) * _nbLoop / second / 1024.0 / 1024.0) << " MB/s");
+		TEST_PRINT("    allocations: " << nbAllocation);
+		if (nbAllocation != 0) {
+			TEST_ERROR("The parser must not allocate memory");
+		}
+	}
+	/**
+	 * @brief Parse the header and store the fields in a request (as done by enet::Http)
+	 */
+	void benchHeader(const etk::String& _data, int32_t _nbLoop) {
+		enet::HttpParser parser;
+		uint64_t nbAllocation = g_nbAllocation;
+		echrono::Steady start = echrono::Steady::now();
+		for (int32_t iii=0; iii<_nbLoop; ++iii) {
+			enet::HttpRequest request;
+			parser.reset();
+			parser.parse(_data.c_str(), _data.size());
+			request.reserveKeys(parser.getHeaderSize());
+			for (size_t jjj=0; jjj<parser.getNumberField(); ++jjj) {
+				const enet::HttpParser::Field& field = parser.getField(jjj);
+				request.setKey(_data.c_str() + field.m_key.m_offset, field.m_key.m_size,
+				               _data.c_str() + field.m_value.m_offset, field.m_value.m_size);
+			}
+		}
+		echrono::Duration duration = echrono::Steady::now() - start;
+		nbAllocation = g_nbAllocation - nbAllocation;
+		double second = double(duration.get()) / 1000000000.0;
+		TEST_PRINT("HttpRequest fill : " << _nbLoop << " headers in " << duration);
+		TEST_PRINT("    " << int64_t(double(_nbLoop) / second) << " headers/s, "
+		                  << double(nbAllocation) / _nbLoop << " allocation/header");
+	}
+	/**
+	 * @brief Serialize a small JSON answer (as done by enet::Http before sending it)
+	 */
+	void benchGenerate(int32_t _nbLoop) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		answer.setKey(enet::HTTPHeaderId::contentType, "application/json");
+		answer.setKey(enet::HTTPHeaderId::server, "e-net (ewol network interface)");
+		answer.setContentLength(17);
+		// Temporary strings
+		uint64_t nbAllocation = g_nbAllocation;
+		echrono::Steady start = echrono::Steady::now();
+		size_t size = 0;
+		for (int32_t iii=0; iii<_nbLoop; ++iii) {
+			etk::String value = answer.generate();
+			size += value.size();
+		}
+		echrono::Duration duration = echrono::Steady::now() - start;
+		nbAllocation = g_nbAllocation - nbAllocation;
+		double second = double(duration.get()) / 1000000000.0;
+		TEST_PRINT("HttpAnswer generate (string) : " << _nbLoop << " headers in " << duration);
+		TEST_PRINT("    " << int64_t(double(_nbLoop) / second) << " headers/s, "
+		                  << double(nbAllocation) / _nbLoop << " allocation/header");
+		// Reused buffer
+		etk::Vector<char> buffer;
+		enet::HttpAnswer copy;
+		nbAllocation = g_nbAllocation;
+		start = echrono::Steady::now();
+		for (int32_t iii=0; iii<_nbLoop; ++iii) {
+			copy = answer;
+			buffer.resize(0);
+			copy.generate(buffer);
+			size += buffer.size();
+		}
+		duration = echrono::Steady::now() - start;
+		nbAllocation = g_nbAllocation - nbAllocation;
+		second = double(duration.get()) / 1000000000.0;
+		TEST_PRINT("HttpAnswer copy + generate (buffer) : " << _nbLoop << " headers in " << duration << " (" << size << " bytes)");
+		TEST_PRINT("    " << int64_t(double(_nbLoop) / second) << " headers/s, "
+		                  << double(nbAllocation) / _nbLoop << " allocation/header");
+	}
+	/**
+	 * @brief Search all the delimiters of the header with one scan function and one instruction set.
+	 */
+	void benchScan(const etk::String& _data, const char* _name, size_t (*_function)(const char*, size_t), int32_t _nbLoop) {
+		uint64_t nbFound = 0;
+		echrono::Steady start = echrono::Steady::now();
+		for (int32_t iii=0; iii<_nbLoop; ++iii) {
+			size_t pos = 0;
+			while (pos < _data.size()) {
+				pos += _function(_data.c_str() + pos, _data.size() - pos) + 1;
+				nbFound++;
+			}
+		}
+		echrono::Duration duration = echrono::Steady::now() - start;
+		double second = double(duration.get()) / 1000000000.0;
+		TEST_PRINT("scan " << _name << " [" << enet::scan::getImplementation() << "] : "
+		           << int64_t(double(_data.size()) * _nbLoop / second / 1024.0 / 1024.0) << " MB/s ("
+		           << nbFound / _nbLoop << " found/header)");
+	}
+	static size_t findColon(const char* _data, size_t _size) {
+		return enet::scan::findChar(_data, _size, ':');
+	}
+	void benchScanAll(const etk::String& _data, int32_t _nbLoop) {
+		const char* listImplementation[] = {"scalar", "sse2", "avx2"};
+		for (auto &it : listImplementation) {
+			if (enet::scan::setImplementation(it) == false) {
+				TEST_PRINT("scan [" << it << "] : not supported by the CPU");
+				continue;
+			}
+			benchScan(_data, "findChar", &findColon, _nbLoop);
+			benchScan(_data, "findEndLine", &enet::scan::findEndLine, _nbLoop);
+			benchScan(_data, "findSpaceOrEndLine", &enet::scan::findSpaceOrEndLine, _nbLoop);
+			benchScan(_data, "findInvalidToken", &enet::scan::findInvalidToken, _nbLoop);
+			benchScan(_data, "findInvalidValue", &enet::scan::findInvalidValue, _nbLoop);
+			benchParser(_data, _data.size(), _nbLoop);
+		}
+	}
+}
+
+int main(int _argc, const char *_argv[]) {
+	etk::init(_argc, _argv);
+	enet::init(_argc, _argv);
+	int32_t nbLoop = 1000000;
+	for (int32_t iii=0; iii<_argc ; ++iii) {
+		etk::String data = _argv[iii];
+		if (    data == "-h"
+		     || data == "--help") {
+			TEST_PRINT(etk::getApplicationName() << " - help : ");
+			TEST_PRINT("    " << _argv[0] << " [options]");
+			TEST_PRINT("        --loop=XXX Number of header parsed");
+			return -1;
+		} else if (etk::start_with(data, "--loop=") == true) {
+			nbLoop = etk::string_to_int32_t(data.extract(7));
+		}
+	}
+	TEST_INFO("==================================");
+	TEST_INFO("== Bench HTTP                   ==");
+	TEST_INFO("==================================");
+	etk::String header = appl::g_header;
+	appl::benchParser(header, header.size(), nbLoop);
+	appl::benchParser(header, 64, nbLoop);
+	appl::benchHeader(header, nbLoop);
+	appl::benchGenerate(nbLoop);
+	appl::benchScanAll(header, nbLoop);
+	enet::unInit();
+	return 0;
+}
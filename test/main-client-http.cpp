@@ -9,6 +9,7 @@
 #include <enet/Tcp.hpp>
 #include <enet/TcpClient.hpp>
 #include <enet/Http.hpp>
+#include <enet/HttpAsync.hpp>
 #include <etk/etk.hpp>
 
 #include <etk/stdTools.hpp>
@@ -19,21 +20,61 @@ namespace appl {
 		TEST_INFO("Receive Datas : " << _data.size() << " bytes");
 		TEST_INFO("data:" << (char*)&_data[0] << "");
 	}
+	static bool g_bodyEnd = false;
+	void onReceiveBody(const uint8_t* _data, size_t _size, bool _end) {
+		if (_end == true) {
+			TEST_INFO("End of the body");
+			g_bodyEnd = true;
+			return;
+		}
+		TEST_INFO("Receive body : " << _size << " bytes");
+	}
+}
+
+/**
+ * @brief Send the requests without managing the connection: they are processed in parallel by the shared I/O thread.
+ */
+static int32_t testAsync() {
+	// The test server process only one connection: all the requests are sent on it.
+	enet::httpAsync::setMaxConnectionPerHost(1);
+	enet::HttpRequest req(enet::HTTPReqType::HTTP_GET);
+	req.setKey(enet::HTTPHeaderId::host, "127.0.0.1:12345");
+	req.setUri("plop.txt");
+	etk::Vector<enet::HttpFuture> list;
+	for (size_t iii=0; iii<16; ++iii) {
+		list.pushBack(enet::HttpClient::request(req));
+	}
+	for (auto &it : list) {
+		const enet::HttpResponse& response = it.get();
+		if (response.isValid() == false) {
+			TEST_ERROR("Request failed: " << response.getError());
+			continue;
+		}
+		TEST_INFO("Receive answer " << int32_t(response.getHeader().getErrorCode()) << " : " << response.getBody().size() << " bytes");
+	}
+	enet::unInit();
+	return 0;
 }
 
 int main(int _argc, const char *_argv[]) {
 	etk::init(_argc, _argv);
 	enet::init(_argc, _argv);
+	bool async = false;
 	for (int32_t iii=0; iii<_argc ; ++iii) {
 		etk::String data = _argv[iii];
-		if (    data == "-h"
-		     || data == "--help") {
+		if (data == "--async") {
+			async = true;
+		} else if (    data == "-h"
+		            || data == "--help") {
 			TEST_PRINT(etk::getApplicationName() << " - help : ");
 			TEST_PRINT("    " << _argv[0] << " [options]");
-			TEST_PRINT("        No options ...");
+			TEST_PRINT("        --async  Send 16 requests with enet::HttpClient::request()");
 			return -1;
 		}
 	}
+	if (async == true) {
+		return testAsync();
+	}
 	TEST_INFO("==================================");
 	TEST_INFO("== Test HTTP client             ==");
 	TEST_INFO("==================================");
@@ -45,6 +86,7 @@ int main(int _argc, const char *_argv[]) {
 	enet::HttpClient connection(etk::move(tcpConnection));
 	// Set callbacks:
 	connection.connect(appl::onReceiveData);
+	connection.connectBody(appl::onReceiveBody);
 	
 	// start http connection (the actual state is just TCP start ...)
 	connection.start();
@@ -52,8 +94,11 @@ int main(int _argc, const char *_argv[]) {
 	req.setUri("plop.txt");
 	connection.setHeader(req);
 	
-	while (connection.isAlive() == true) {
+	// The connection is persistent: wait the end of the answer body
+	while (    connection.isAlive() == true
+	        && appl::g_bodyEnd == false) {
 		ethread::sleepMilliSeconds((100));
 	}
+	connection.stop();
 	return 0;
 }
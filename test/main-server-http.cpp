@@ -8,33 +8,62 @@
 #include <enet/enet.hpp>
 #include <enet/Tcp.hpp>
 #include <enet/Http.hpp>
+#include <enet/HttpCanned.hpp>
+#include <enet/HttpCompression.hpp>
+#include <enet/HttpCache.hpp>
+#include <enet/StaticFiles.hpp>
+#include <enet/Router.hpp>
 #include <enet/TcpServer.hpp>
 #include <etk/etk.hpp>
 
 
 #include <etk/stdTools.hpp>
 namespace appl {
+	ememory::SharedPtr<enet::StaticFiles> g_files; //!< Files served on "static/..." (option --root)
 	void onReceiveData(enet::HttpServer* _interface, etk::Vector<uint8_t>& _data) {
 		TEST_INFO("Receive Datas : " << _data.size() << " bytes");
 	}
-	void onReceiveHeader(enet::HttpServer* _interface, const enet::HttpRequest& _data) {
-		TEST_INFO("Receive Header data:");
-		_data.display();
-		if (_data.getType() == enet::HTTPReqType::HTTP_GET) {
-			if (_data.getUri() == "plop.txt") {
-				enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
-				etk::String data = "<html><head></head></body>coucou</body></html>";
-				answer.setKey("Content-Length", etk::toString(data.size()));
-				_interface->setHeader(answer);
-				_interface->write(data);
-				_interface->stop(true);
+	void onPlop(enet::HttpServer* _interface, const enet::HttpRequest& _data, const enet::Router::Match& _match) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		// Stored in the cache: the next requests are answered without calling this function during 60s
+		answer.setKey(enet::HTTPHeaderId::cacheControl, "max-age=60");
+		etk::String data = "<html><head></head></body>coucou</body></html>";
+		// Header and body are sent together (the Content-Length is set with the size of the body)
+		_interface->setHeader(answer, data);
+		// The connection stay open for the next request (keep-alive)
+	}
+	void onChunked(enet::HttpServer* _interface, const enet::HttpRequest& _data, const enet::Router::Match& _match) {
+		// Size not known when the header is sent: stream the body (chunked)
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		answer.setKey(enet::HTTPHeaderId::contentType, "text/plain");
+		enet::HttpResponseWriter writer = _interface->beginResponse(answer);
+		for (int32_t iii=0; iii<10000; ++iii) {
+			// block when the remote does not read fast enough: the memory stay bounded
+			if (writer.writeChunk("line " + etk::toString(iii) + "\n") < 0) {
 				return;
 			}
 		}
-		enet::HttpAnswer answer(enet::HTTPAnswerCode::c404_notFound);
-		answer.setKey("Connection", "close");
-		_interface->setHeader(answer);
-		_interface->stop(true);
+		writer.finish();
+	}
+	void onHello(enet::HttpServer* _interface, const enet::HttpRequest& _data, const enet::Router::Match& _match) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		answer.setKey(enet::HTTPHeaderId::contentType, "text/plain");
+		// Parameter of the path "hello/:name"
+		_interface->setHeader(answer, "Hello " + _match.get("name") + "\n");
+	}
+	void onReceiveHeader(enet::HttpServer* _interface, const enet::HttpRequest& _data) {
+		TEST_INFO("Receive Header data (no route):");
+		_data.display();
+		if (    g_files != null
+		     && g_files->process(_interface, _data) == true) {
+			// Sent with sendfile (304/206 for the conditional and range requests)
+			return;
+		}
+		// Pre-encoded answer: no formatting
+		_interface->setHeader(*enet::httpCanned::get(enet::HTTPAnswerCode::c404_notFound));
 	}
 }
 
@@ -47,13 +76,18 @@ int main(int _argc, const char *_argv[]) {
 		     || data == "--help") {
 			TEST_PRINT(etk::getApplicationName() << " - help : ");
 			TEST_PRINT("    " << _argv[0] << " [options]");
-			TEST_PRINT("        No options ...");
+			TEST_PRINT("        --root=XXX  Serve the files of the directory XXX on 'static/...'");
 			return -1;
 		}
+		if (etk::start_with(data, "--root=") == true) {
+			appl::g_files = ememory::makeShared<enet::StaticFiles>(etk::String(&data[7]), "static/");
+		}
 	}
 	TEST_INFO("==================================");
 	TEST_INFO("== Test HTTP server             ==");
 	TEST_INFO("==================================");
+	// Format the "Date" of the answers one time per second
+	enet::httpDate::setBackgroundRefresh(true);
 	//Wait on TCP connection:
 	enet::TcpServer interface;
 	// Configure server interface:
@@ -70,13 +104,26 @@ int main(int _argc, const char *_argv[]) {
 	// Create a HTTP connection in Server mode
 	enet::HttpServer connection(etk::move(tcpConnection));
 	enet::HttpServer* tmp = &connection;
+	// Persistent connection: close after 5 second without request or after 100 requests
+	connection.setIdleTimeOut(echrono::seconds(5));
+	connection.setMaxRequest(100);
+	// Compress the text answers (and decompress the compressed requests) when the remote accept it
+	connection.setCompression(ememory::makeShared<enet::HttpCompression>(6, 1024));
+	// Keep the answers in memory (one answer per "Accept-Encoding": the body can be compressed)
+	ememory::SharedPtr<enet::HttpCache> cache = ememory::makeShared<enet::HttpCache>(4*1024*1024);
+	cache->addVary("Accept-Encoding");
+	connection.setCache(cache);
 	// Set callbacks:
 	connection.connect([=](etk::Vector<uint8_t>& _value){
 					appl::onReceiveData(tmp, _value);
 				});
-	connection.connectHeader([=](const enet::HttpRequest& _value){
-					appl::onReceiveHeader(tmp, _value);
-				});
+	// Dispatch the requests on their path (the other requests are sent to onReceiveHeader)
+	ememory::SharedPtr<enet::Router> router = ememory::makeShared<enet::Router>();
+	router->add(enet::HTTPReqType::HTTP_GET, "plop.txt", &appl::onPlop);
+	router->add(enet::HTTPReqType::HTTP_GET, "chunked.txt", &appl::onChunked);
+	router->add(enet::HTTPReqType::HTTP_GET, "hello/:name", &appl::onHello);
+	router->setDefault(&appl::onReceiveHeader);
+	router->connect(tmp);
 	
 	// start http connection (the actual state is just TCP start ...)
 	connection.start();
@@ -0,0 +1,110 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/AdmissionControl.hpp>
+#include <enet/Http.hpp>
+#include <ethread/tools.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <unistd.h>
+}
+
+TEST(admissionControl, maxConnection) {
+	enet::AdmissionControl control(2);
+	EXPECT_EQ(control.connectionOpen(), true);
+	EXPECT_EQ(control.connectionOpen(), true);
+	EXPECT_EQ(control.connectionOpen(), false);
+	EXPECT_EQ(control.getNumberConnection(), 2);
+	EXPECT_EQ(control.getNumberReject(), 1);
+	control.connectionClose();
+	EXPECT_EQ(control.connectionOpen(), true);
+	control.connectionClose();
+	control.connectionClose();
+	EXPECT_EQ(control.getNumberConnection(), 0);
+	// An unbalanced release does not underflow
+	control.connectionClose();
+	EXPECT_EQ(control.getNumberConnection(), 0);
+}
+
+TEST(admissionControl, rejectAnswer) {
+	enet::AdmissionControl control;
+	control.setRejectAnswer(enet::HttpAnswer(enet::HTTPAnswerCode::c429_tooManyRequests));
+	enet::HttpAnswer answer = control.getRejectAnswer();
+	EXPECT_EQ(answer.getErrorCode() == enet::HTTPAnswerCode::c429_tooManyRequests, true);
+	EXPECT_EQ(answer.getKey(enet::HTTPHeaderId::connection), "close");
+}
+
+TEST(admissionControl, maxRequest) {
+	enet::AdmissionControl control(0, 1);
+	EXPECT_EQ(control.requestStart(echrono::milliseconds(0)), true);
+	EXPECT_EQ(control.requestStart(echrono::milliseconds(0)), false);
+	EXPECT_EQ(control.getNumberRequestInProgress(), 1);
+	control.requestEnd();
+	EXPECT_EQ(control.requestStart(echrono::milliseconds(0)), true);
+	control.requestEnd();
+	EXPECT_EQ(control.getNumberRequestInProgress(), 0);
+}
+
+TEST(admissionControl, standingQueue) {
+	enet::AdmissionControl control(0, 0, echrono::milliseconds(10), echrono::milliseconds(20));
+	// The delay stay over the target during a full window
+	EXPECT_EQ(control.requestStart(echrono::milliseconds(15)), true);
+	control.requestEnd();
+	ethread::sleepMilliSeconds(30);
+	EXPECT_EQ(control.requestStart(echrono::milliseconds(15)), false);
+	EXPECT_EQ(control.isOverloaded(), true);
+	// The work that did not wait is still accepted
+	EXPECT_EQ(control.requestStart(echrono::milliseconds(1)), true);
+	control.requestEnd();
+}
+
+static bool waitConnection(const ememory::SharedPtr<enet::AdmissionControl>& _control, uint32_t _value) {
+	for (size_t iii=0; iii<200; ++iii) {
+		if (_control->getNumberConnection() == _value) {
+			return true;
+		}
+		ethread::sleepMilliSeconds(10);
+	}
+	return false;
+}
+
+TEST(admissionControl, releaseOnRemoteClose) {
+	ememory::SharedPtr<enet::AdmissionControl> control = ememory::makeShared<enet::AdmissionControl>(1);
+	int sockets[2];
+	EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+	enet::HttpServer server(enet::Tcp(sockets[0], "test"));
+	server.setAdmissionControl(control);
+	server.start();
+	EXPECT_EQ(waitConnection(control, 1), true);
+	// The remote close the connection: the slot is released without any call of stop()
+	close(sockets[1]);
+	EXPECT_EQ(waitConnection(control, 0), true);
+	server.stop();
+	EXPECT_EQ(control->getNumberConnection(), 0);
+}
+
+TEST(admissionControl, releaseOnStop) {
+	ememory::SharedPtr<enet::AdmissionControl> control = ememory::makeShared<enet::AdmissionControl>(1);
+	int sockets[2];
+	EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+	{
+		enet::HttpServer server(enet::Tcp(sockets[0], "test"));
+		server.setAdmissionControl(control);
+		server.start();
+		EXPECT_EQ(waitConnection(control, 1), true);
+		server.stop();
+		EXPECT_EQ(control->getNumberConnection(), 0);
+		// The destructor call stop() again: the slot is not released twice
+	}
+	EXPECT_EQ(control->getNumberConnection(), 0);
+	close(sockets[1]);
+	EXPECT_EQ(control->connectionOpen(), true);
+	EXPECT_EQ(control->getNumberConnection(), 1);
+}
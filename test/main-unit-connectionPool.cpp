@@ -0,0 +1,240 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/enet.hpp>
+#include <enet/ConnectionPool.hpp>
+#include <enet/Http.hpp>
+#include <ethread/Thread.hpp>
+#include <ethread/Mutex.hpp>
+#include <ethread/tools.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <string.h>
+}
+
+/**
+ * @brief Loopback HTTP server: accept the connections and answer "ok" to all the requests.
+ */
+class PoolServer {
+	private:
+		int32_t m_socket; //!< Listening socket
+		uint16_t m_port; //!< Port selected by the system
+		ethread::Mutex m_mutex; //!< Protect the flags
+		bool m_running; //!< The thread must continue
+		bool m_closeAll; //!< Close all the connections (remote close)
+		size_t m_nbConnection; //!< Number of connection accepted
+		size_t m_nbRequest; //!< Number of request received
+		ethread::Thread* m_thread; //!< Thread of the server
+	public:
+		PoolServer() :
+		  m_socket(-1),
+		  m_port(0),
+		  m_running(true),
+		  m_closeAll(false),
+		  m_nbConnection(0),
+		  m_nbRequest(0),
+		  m_thread(null) {
+			m_socket = socket(AF_INET, SOCK_STREAM, 0);
+			struct sockaddr_in address;
+			memset(&address, 0, sizeof(address));
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			socklen_t size = sizeof(address);
+			if (    bind(m_socket, (struct sockaddr*)&address, sizeof(address)) != 0
+			     || listen(m_socket, 64) != 0
+			     || getsockname(m_socket, (struct sockaddr*)&address, &size) != 0) {
+				TEST_ERROR("Can not create the test server: " << strerror(errno));
+				return;
+			}
+			m_port = ntohs(address.sin_port);
+			m_thread = ETK_NEW(ethread::Thread, [&](){ threadCallback();});
+		}
+		~PoolServer() {
+			{
+				ethread::UniqueLock lock(m_mutex);
+				m_running = false;
+			}
+			if (m_thread != null) {
+				m_thread->join();
+				ETK_DELETE(ethread::Thread, m_thread);
+			}
+			close(m_socket);
+		}
+		uint16_t getPort() const {
+			return m_port;
+		}
+		size_t getNumberConnection() {
+			ethread::UniqueLock lock(m_mutex);
+			return m_nbConnection;
+		}
+		size_t getNumberRequest() {
+			ethread::UniqueLock lock(m_mutex);
+			return m_nbRequest;
+		}
+		void closeAll() {
+			ethread::UniqueLock lock(m_mutex);
+			m_closeAll = true;
+		}
+	private:
+		void threadCallback() {
+			etk::Vector<int32_t> clients;
+			while (true) {
+				{
+					ethread::UniqueLock lock(m_mutex);
+					if (m_running == false) {
+						break;
+					}
+					if (m_closeAll == true) {
+						m_closeAll = false;
+						for (auto &it : clients) {
+							close(it);
+						}
+						clients.clear();
+					}
+				}
+				etk::Vector<struct pollfd> fds;
+				struct pollfd element;
+				element.fd = m_socket;
+				element.events = POLLIN;
+				element.revents = 0;
+				fds.pushBack(element);
+				for (auto &it : clients) {
+					element.fd = it;
+					fds.pushBack(element);
+				}
+				if (poll(&fds[0], fds.size(), 20) <= 0) {
+					continue;
+				}
+				if (fds[0].revents != 0) {
+					clients.pushBack(accept(m_socket, null, null));
+					ethread::UniqueLock lock(m_mutex);
+					m_nbConnection++;
+				}
+				for (size_t iii=1; iii<fds.size(); ++iii) {
+					if (fds[iii].revents == 0) {
+						continue;
+					}
+					char data[4096];
+					ssize_t len = recv(clients[iii-1], data, sizeof(data), 0);
+					if (len <= 0) {
+						close(clients[iii-1]);
+						clients[iii-1] = -1;
+						continue;
+					}
+					// The requests of the test are small: one request per reception
+					etk::String answer = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+					send(clients[iii-1], answer.c_str(), answer.size(), MSG_NOSIGNAL);
+					ethread::UniqueLock lock(m_mutex);
+					m_nbRequest++;
+				}
+				for (size_t iii=clients.size(); iii>0; --iii) {
+					if (clients[iii-1] < 0) {
+						clients.erase(clients.begin() + iii - 1);
+					}
+				}
+			}
+			for (auto &it : clients) {
+				close(it);
+			}
+		}
+};
+
+TEST(connectionPool, reuse) {
+	enet::init(0, null);
+	PoolServer server;
+	enet::ConnectionPool pool;
+	enet::Tcp connection = pool.get("127.0.0.1", server.getPort());
+	EXPECT_EQ(connection.getConnectionStatus() == enet::Tcp::status::link, true);
+	pool.release(etk::move(connection));
+	EXPECT_EQ(pool.getNumberIdle("127.0.0.1", server.getPort()), 1);
+	connection = pool.get("127.0.0.1", server.getPort());
+	EXPECT_EQ(connection.getConnectionStatus() == enet::Tcp::status::link, true);
+	EXPECT_EQ(pool.getNumberIdle("127.0.0.1", server.getPort()), 0);
+	ethread::sleepMilliSeconds(100);
+	EXPECT_EQ(server.getNumberConnection(), 1);
+}
+
+TEST(connectionPool, dropClosedConnection) {
+	enet::init(0, null);
+	PoolServer server;
+	enet::ConnectionPool pool;
+	pool.warmup("127.0.0.1", server.getPort(), 2);
+	EXPECT_EQ(pool.getNumberIdle("127.0.0.1", server.getPort()), 2);
+	ethread::sleepMilliSeconds(100);
+	// The remote close the idle connections: they are removed by the maintenance
+	server.closeAll();
+	ethread::sleepMilliSeconds(100);
+	pool.update();
+	EXPECT_EQ(pool.getNumberIdle("127.0.0.1", server.getPort()), 0);
+	// get() does not give a closed connection
+	enet::Tcp connection = pool.get("127.0.0.1", server.getPort());
+	EXPECT_EQ(connection.checkLink(), true);
+}
+
+TEST(connectionPool, refillByStep) {
+	enet::init(0, null);
+	PoolServer server;
+	enet::ConnectionPool pool(3);
+	pool.release(pool.get("127.0.0.1", server.getPort()));
+	EXPECT_EQ(pool.getNumberIdle("127.0.0.1", server.getPort()), 1);
+	// Only one connection per host at each call
+	pool.update();
+	EXPECT_EQ(pool.getNumberIdle("127.0.0.1", server.getPort()), 2);
+	pool.update();
+	EXPECT_EQ(pool.getNumberIdle("127.0.0.1", server.getPort()), 3);
+	pool.update();
+	EXPECT_EQ(pool.getNumberIdle("127.0.0.1", server.getPort()), 3);
+}
+
+TEST(connectionPool, stopMaintenance) {
+	enet::ConnectionPool pool;
+	pool.start();
+	ethread::sleepMilliSeconds(50);
+	echrono::Steady start = echrono::Steady::now();
+	pool.stop();
+	EXPECT_EQ(echrono::Steady::now() - start < echrono::seconds(1), true);
+}
+
+static bool sendRequest(enet::HttpClient& _client, bool& _end) {
+	_end = false;
+	enet::HttpRequest request(enet::HTTPReqType::HTTP_GET);
+	request.setUri("/plop");
+	_client.setHeader(request);
+	for (size_t iii=0; iii<200 && _end == false; ++iii) {
+		ethread::sleepMilliSeconds(10);
+	}
+	return _end;
+}
+
+TEST(connectionPool, httpClient) {
+	enet::init(0, null);
+	PoolServer server;
+	ememory::SharedPtr<enet::ConnectionPool> pool = ememory::makeShared<enet::ConnectionPool>();
+	for (size_t iii=0; iii<2; ++iii) {
+		bool end = false;
+		enet::HttpClient client(pool, "127.0.0.1", server.getPort());
+		client.connectBody([&](const uint8_t* _data, size_t _size, bool _end) {
+			if (_end == true) {
+				end = true;
+			}
+		});
+		client.start();
+		EXPECT_EQ(sendRequest(client, end), true);
+		// The answer is finished: the connection is given back to the pool
+		client.stop();
+		EXPECT_EQ(pool->getNumberIdle("127.0.0.1", server.getPort()), 1);
+	}
+	EXPECT_EQ(server.getNumberRequest(), 2);
+	EXPECT_EQ(server.getNumberConnection(), 1);
+}
@@ -0,0 +1,102 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/Coroutine.hpp>
+
+#ifdef ENET_COROUTINE
+
+#include <enet/HttpCoroutine.hpp>
+
+static enet::Task<int32_t> add(enet::EventLoop* _loop, int32_t _value) {
+	co_await _loop->sleep(echrono::milliseconds(1));
+	co_return _value + 1;
+}
+
+static enet::Task<void> count(enet::EventLoop* _loop, int32_t* _result) {
+	int32_t value = 0;
+	for (size_t iii=0; iii<10; ++iii) {
+		value = co_await add(_loop, value);
+	}
+	*_result = value;
+	_loop->stop();
+}
+
+TEST(coroutine, task) {
+	enet::EventLoop loop;
+	int32_t result = 0;
+	loop.spawn(count(&loop, &result));
+	loop.run();
+	EXPECT_EQ(result, 10);
+}
+
+static enet::Task<void> waitStop(enet::EventLoop* _loop, bool* _result) {
+	*_result = co_await _loop->sleep(echrono::seconds(60));
+}
+
+TEST(coroutine, stop) {
+	bool result = true;
+	echrono::Steady start;
+	{
+		enet::EventLoop loop;
+		loop.spawn(waitStop(&loop, &result));
+		EXPECT_EQ(loop.start(), true);
+		ethread::sleepMilliSeconds(20);
+		start = echrono::Steady::now();
+		loop.stop();
+		// The destructor wait the end of the thread
+	}
+	// The wait end with the stop
+	EXPECT_EQ(result, false);
+	EXPECT_EQ(echrono::Steady::now() - start < echrono::seconds(10), true);
+}
+
+static enet::Task<void> serverSession(enet::AsyncTcpServer* _server) {
+	enet::AsyncHttpServer http(co_await _server->accept());
+	while (co_await http.readRequest() == true) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		etk::String body = http.getRequest().getUri() + ":" + etk::toString(http.getBody().size());
+		co_await http.write(answer, body);
+	}
+}
+
+static enet::Task<void> clientSession(enet::EventLoop* _loop, uint16_t _port, etk::String* _result) {
+	enet::AsyncTcp connection = co_await enet::connect("127.0.0.1", _port);
+	if (connection.isAlive() == true) {
+		// Two requests in one write: the second is kept for the next read
+		etk::String request =   "POST /plop HTTP/1.1\r\nContent-Length: 5\r\n\r\nhello"
+		                        "GET /end HTTP/1.1\r\nConnection: close\r\n\r\n";
+		co_await connection.write(request.c_str(), request.size());
+		char data[4096];
+		while (true) {
+			int32_t len = co_await connection.read(data, sizeof(data));
+			if (len <= 0) {
+				break;
+			}
+			*_result += etk::String(data, len);
+		}
+	}
+	_loop->stop();
+}
+
+TEST(coroutine, http) {
+	enet::EventLoop loop;
+	enet::AsyncTcpServer server;
+	EXPECT_EQ(server.link(&loop, "127.0.0.1", 0), true);
+	EXPECT_EQ(server.getPort() != 0, true);
+	etk::String result;
+	loop.spawn(serverSession(&server));
+	loop.spawn(clientSession(&loop, server.getPort(), &result));
+	loop.run();
+	EXPECT_EQ(result.find("plop:5") != etk::String::npos, true);
+	EXPECT_EQ(result.find("end:0") != etk::String::npos, true);
+	EXPECT_EQ(result.find("Connection: close") != etk::String::npos, true);
+}
+
+#endif
@@ -0,0 +1,296 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/enet.hpp>
+#include <enet/HttpAsync.hpp>
+#include <ethread/Thread.hpp>
+#include <ethread/Mutex.hpp>
+#include <ethread/tools.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <string.h>
+}
+
+/**
+ * @brief Loopback HTTP server: the answer of each request is given by a function.
+ */
+class ScriptServer {
+	public:
+		/**
+		 * @brief Get the answer of a request.
+		 * @param[in] _connectionId Number of the connection (in the order of the accept).
+		 * @param[in] _requestId Number of the request on the connection.
+		 * @param[in] _request Header of the request.
+		 * @return Data to send ("": no answer, "close": close the connection without answer).
+		 */
+		using Observer = etk::Function<etk::String(size_t _connectionId, size_t _requestId, const etk::String& _request)>;
+	private:
+		class Client {
+			public:
+				int32_t m_socket;
+				size_t m_id;
+				size_t m_nbRequest;
+				etk::String m_buffer;
+		};
+		int32_t m_socket; //!< Listening socket
+		uint16_t m_port; //!< Port selected by the system
+		Observer m_observer; //!< Answer of the requests
+		ethread::Mutex m_mutex; //!< Protect the flags
+		bool m_running; //!< The thread must continue
+		size_t m_nbConnection; //!< Number of connection accepted
+		ethread::Thread* m_thread; //!< Thread of the server
+	public:
+		ScriptServer(Observer _observer) :
+		  m_socket(-1),
+		  m_port(0),
+		  m_observer(_observer),
+		  m_running(true),
+		  m_nbConnection(0),
+		  m_thread(null) {
+			m_socket = socket(AF_INET, SOCK_STREAM, 0);
+			struct sockaddr_in address;
+			memset(&address, 0, sizeof(address));
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+			socklen_t size = sizeof(address);
+			if (    bind(m_socket, (struct sockaddr*)&address, sizeof(address)) != 0
+			     || listen(m_socket, 64) != 0
+			     || getsockname(m_socket, (struct sockaddr*)&address, &size) != 0) {
+				TEST_ERROR("Can not create the test server: " << strerror(errno));
+				return;
+			}
+			m_port = ntohs(address.sin_port);
+			m_thread = ETK_NEW(ethread::Thread, [&](){ threadCallback();});
+		}
+		~ScriptServer() {
+			{
+				ethread::UniqueLock lock(m_mutex);
+				m_running = false;
+			}
+			if (m_thread != null) {
+				m_thread->join();
+				ETK_DELETE(ethread::Thread, m_thread);
+			}
+			close(m_socket);
+		}
+		uint16_t getPort() const {
+			return m_port;
+		}
+		size_t getNumberConnection() {
+			ethread::UniqueLock lock(m_mutex);
+			return m_nbConnection;
+		}
+		/**
+		 * @brief Create a request for this server.
+		 */
+		enet::HttpRequest createRequest(const etk::String& _uri, enum enet::HTTPReqType _type=enet::HTTPReqType::HTTP_GET) {
+			enet::HttpRequest out(_type);
+			out.setUri(_uri);
+			out.setKey(enet::HTTPHeaderId::host, "127.0.0.1:" + etk::toString(m_port));
+			return out;
+		}
+	private:
+		void threadCallback() {
+			etk::Vector<Client> clients;
+			while (true) {
+				{
+					ethread::UniqueLock lock(m_mutex);
+					if (m_running == false) {
+						break;
+					}
+				}
+				etk::Vector<struct pollfd> fds;
+				struct pollfd element;
+				element.fd = m_socket;
+				element.events = POLLIN;
+				element.revents = 0;
+				fds.pushBack(element);
+				for (auto &it : clients) {
+					element.fd = it.m_socket;
+					fds.pushBack(element);
+				}
+				if (poll(&fds[0], fds.size(), 20) <= 0) {
+					continue;
+				}
+				if (fds[0].revents != 0) {
+					Client client;
+					client.m_socket = accept(m_socket, null, null);
+					client.m_nbRequest = 0;
+					ethread::UniqueLock lock(m_mutex);
+					client.m_id = m_nbConnection++;
+					clients.pushBack(client);
+				}
+				for (size_t iii=1; iii<fds.size(); ++iii) {
+					if (fds[iii].revents == 0) {
+						continue;
+					}
+					Client& client = clients[iii-1];
+					char data[4096];
+					ssize_t len = recv(client.m_socket, data, sizeof(data), 0);
+					if (len <= 0) {
+						close(client.m_socket);
+						client.m_socket = -1;
+						continue;
+					}
+					client.m_buffer += etk::String(data, len);
+					size_t pos = client.m_buffer.find("\r\n\r\n");
+					while (    pos != etk::String::npos
+					        && client.m_socket >= 0) {
+						etk::String request = client.m_buffer.extract(0, pos + 4);
+						client.m_buffer = client.m_buffer.extract(pos + 4);
+						etk::String answer = m_observer(client.m_id, client.m_nbRequest++, request);
+						if (answer == "close") {
+							close(client.m_socket);
+							client.m_socket = -1;
+						} else if (answer != "") {
+							send(client.m_socket, answer.c_str(), answer.size(), MSG_NOSIGNAL);
+						}
+						pos = client.m_buffer.find("\r\n\r\n");
+					}
+				}
+				for (size_t iii=clients.size(); iii>0; --iii) {
+					if (clients[iii-1].m_socket < 0) {
+						clients.erase(clients.begin() + iii - 1);
+					}
+				}
+			}
+			for (auto &it : clients) {
+				close(it.m_socket);
+			}
+		}
+};
+
+static const etk::String g_answerOk = "HTTP/1.1 200 OK\r\nContent-Length: 2\r\n\r\nok";
+
+static etk::String answerOk(size_t _connectionId, size_t _requestId, const etk::String& _request) {
+	return g_answerOk;
+}
+
+TEST(httpAsync, keepAlive) {
+	enet::init(0, null);
+	ScriptServer server(answerOk);
+	for (size_t iii=0; iii<3; ++iii) {
+		enet::HttpFuture future = enet::HttpClient::request(server.createRequest("/plop"));
+		const enet::HttpResponse& response = future.get();
+		EXPECT_EQ(response.getStatus() == enet::HttpResponse::status::done, true);
+		EXPECT_EQ(response.getBodyString(), "ok");
+	}
+	// All the requests use the same connection
+	EXPECT_EQ(server.getNumberConnection(), 1);
+	enet::httpAsync::stop();
+}
+
+TEST(httpAsync, retryStaleConnection) {
+	enet::init(0, null);
+	ScriptServer server([](size_t _connectionId, size_t _requestId, const etk::String& _request) {
+		if (_requestId == 1) {
+			// The remote close the idle connection when the next request arrive
+			return etk::String("close");
+		}
+		return g_answerOk;
+	});
+	enet::HttpFuture future = enet::HttpClient::request(server.createRequest("/first"));
+	EXPECT_EQ(future.get().getStatus() == enet::HttpResponse::status::done, true);
+	// A GET is sent again on a new connection
+	future = enet::HttpClient::request(server.createRequest("/second"));
+	EXPECT_EQ(future.get().getStatus() == enet::HttpResponse::status::done, true);
+	EXPECT_EQ(future.get().getBodyString(), "ok");
+	EXPECT_EQ(server.getNumberConnection(), 2);
+	// A POST is not sent again
+	future = enet::HttpClient::request(server.createRequest("/third", enet::HTTPReqType::HTTP_POST));
+	EXPECT_EQ(future.get().getStatus() == enet::HttpResponse::status::closed, true);
+	EXPECT_EQ(server.getNumberConnection(), 2);
+	enet::httpAsync::stop();
+}
+
+TEST(httpAsync, chunked) {
+	enet::init(0, null);
+	ScriptServer server([](size_t _connectionId, size_t _requestId, const etk::String& _request) {
+		return etk::String("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n");
+	});
+	for (size_t iii=0; iii<2; ++iii) {
+		enet::HttpFuture future = enet::HttpClient::request(server.createRequest("/plop"));
+		EXPECT_EQ(future.get().getStatus() == enet::HttpResponse::status::done, true);
+		EXPECT_EQ(future.get().getBodyString(), "hello world");
+	}
+	EXPECT_EQ(server.getNumberConnection(), 1);
+	enet::httpAsync::stop();
+}
+
+TEST(httpAsync, timeOut) {
+	enet::init(0, null);
+	ScriptServer server([](size_t _connectionId, size_t _requestId, const etk::String& _request) {
+		// never answer
+		return etk::String("");
+	});
+	echrono::Steady start = echrono::Steady::now();
+	enet::HttpFuture future = enet::HttpClient::request(server.createRequest("/plop"), "", echrono::milliseconds(200));
+	EXPECT_EQ(future.get().getStatus() == enet::HttpResponse::status::timeOut, true);
+	EXPECT_EQ(echrono::Steady::now() - start < echrono::seconds(5), true);
+	EXPECT_EQ(enet::httpAsync::getNumberInProgress(), 0);
+	enet::httpAsync::stop();
+}
+
+TEST(httpAsync, hostQueue) {
+	enet::init(0, null);
+	enet::httpAsync::setMaxConnectionPerHost(1);
+	ScriptServer server(answerOk);
+	etk::Vector<enet::HttpFuture> list;
+	for (size_t iii=0; iii<5; ++iii) {
+		list.pushBack(enet::HttpClient::request(server.createRequest("/plop" + etk::toString(iii))));
+	}
+	for (auto &it : list) {
+		EXPECT_EQ(it.get().getStatus() == enet::HttpResponse::status::done, true);
+		EXPECT_EQ(it.get().getBodyString(), "ok");
+	}
+	// The requests wait the only connection of the host
+	EXPECT_EQ(server.getNumberConnection(), 1);
+	enet::httpAsync::setMaxConnectionPerHost(64);
+	enet::httpAsync::stop();
+}
+
+TEST(httpAsync, maxSize) {
+	enet::init(0, null);
+	enet::httpAsync::setMaxHeaderSize(1024);
+	enet::httpAsync::setMaxBodySize(10);
+	ScriptServer server([](size_t _connectionId, size_t _requestId, const etk::String& _request) {
+		if (_request.find("/length") != etk::String::npos) {
+			return etk::String("HTTP/1.1 200 OK\r\nContent-Length: 20\r\n\r\n01234567890123456789");
+		}
+		if (_request.find("/chunked") != etk::String::npos) {
+			return etk::String("HTTP/1.1 200 OK\r\nTransfer-Encoding: chunked\r\n\r\n5\r\n01234\r\n5\r\n56789\r\n5\r\n01234\r\n0\r\n\r\n");
+		}
+		if (_request.find("/close") != etk::String::npos) {
+			return etk::String("HTTP/1.1 200 OK\r\nConnection: close\r\n\r\n01234567890123456789");
+		}
+		if (_request.find("/header") != etk::String::npos) {
+			etk::String value;
+			for (size_t iii=0; iii<200; ++iii) {
+				value += "0123456789";
+			}
+			return "HTTP/1.1 200 OK\r\nX-Big: " + value + "\r\nContent-Length: 2\r\n\r\nok";
+		}
+		return g_answerOk;
+	});
+	const char* list[] = {"/length", "/chunked", "/close", "/header"};
+	for (size_t iii=0; iii<4; ++iii) {
+		enet::HttpFuture future = enet::HttpClient::request(server.createRequest(list[iii]));
+		EXPECT_EQ(future.get().getStatus() == enet::HttpResponse::status::protocolError, true);
+	}
+	enet::HttpFuture future = enet::HttpClient::request(server.createRequest("/plop"));
+	EXPECT_EQ(future.get().getStatus() == enet::HttpResponse::status::done, true);
+	enet::httpAsync::setMaxHeaderSize(65536);
+	enet::httpAsync::setMaxBodySize(64*1024*1024);
+	enet::httpAsync::stop();
+}
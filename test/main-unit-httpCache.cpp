@@ -0,0 +1,139 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/HttpCache.hpp>
+
+static enet::HttpAnswer createAnswer(const etk::String& _cacheControl) {
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	answer.setKey(enet::HTTPHeaderId::contentType, "text/plain");
+	if (_cacheControl != "") {
+		answer.setKey(enet::HTTPHeaderId::cacheControl, _cacheControl);
+	}
+	return answer;
+}
+
+static etk::String createBody(size_t _size) {
+	etk::String out;
+	while (out.size() < _size) {
+		out += "0123456789";
+	}
+	out.resize(_size);
+	return out;
+}
+
+TEST(httpCache, key) {
+	enet::HttpCache cache;
+	enet::HttpRequest request(enet::HTTPReqType::HTTP_GET);
+	request.setUri("plop.txt");
+	EXPECT_EQ(cache.getKey(request), "plop.txt");
+	request.setQueryKey("id", "12");
+	EXPECT_EQ(cache.getKey(request), "plop.txt?id=12");
+	// The HEAD requests use the answer of the GET
+	request.setType(enet::HTTPReqType::HTTP_HEAD);
+	EXPECT_EQ(cache.getKey(request), "plop.txt?id=12");
+	cache.addVary("Accept-Encoding");
+	request.setKey(enet::HTTPHeaderId::acceptEncoding, "gzip");
+	EXPECT_EQ(cache.getKey(request), "plop.txt?id=12\ngzip");
+	// Not stored
+	request.setType(enet::HTTPReqType::HTTP_POST);
+	EXPECT_EQ(cache.getKey(request), "");
+	request.setType(enet::HTTPReqType::HTTP_GET);
+	request.setKey(enet::HTTPHeaderId::cacheControl, "no-store");
+	EXPECT_EQ(cache.getKey(request), "");
+	request.rmKey(enet::HTTPHeaderId::cacheControl);
+	request.setKey(enet::HTTPHeaderId::authorization, "Basic dXNlcjpwYXNz");
+	EXPECT_EQ(cache.getKey(request), "");
+}
+
+TEST(httpCache, timeToLive) {
+	echrono::Duration ttl;
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(createAnswer("max-age=60"), echrono::Duration(), ttl), true);
+	EXPECT_EQ(ttl.get(), echrono::seconds(60).get());
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(createAnswer("public, max-age=60, s-maxage=\"10\""), echrono::Duration(), ttl), true);
+	EXPECT_EQ(ttl.get(), echrono::seconds(10).get());
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(createAnswer(""), echrono::seconds(5), ttl), true);
+	EXPECT_EQ(ttl.get(), echrono::seconds(5).get());
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(createAnswer(""), echrono::Duration(), ttl), false);
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(createAnswer("max-age=0"), echrono::seconds(5), ttl), false);
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(createAnswer("max-age=60, No-Store"), echrono::Duration(), ttl), false);
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(createAnswer("private, max-age=60"), echrono::Duration(), ttl), false);
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(createAnswer("no-cache"), echrono::seconds(5), ttl), false);
+	enet::HttpAnswer answer = createAnswer("max-age=60");
+	answer.setKey(enet::HTTPHeaderId::setCookie, "id=12");
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(answer, echrono::Duration(), ttl), false);
+	answer = createAnswer("max-age=60");
+	answer.setErrorCode(enet::HTTPAnswerCode::c500_internalServerError);
+	EXPECT_EQ(enet::HttpCache::getTimeToLive(answer, echrono::Duration(), ttl), false);
+}
+
+TEST(httpCache, storeAndGet) {
+	enet::HttpCache cache;
+	cache.addVary("Accept-Encoding");
+	enet::HttpRequest request(enet::HTTPReqType::HTTP_GET);
+	request.setUri("plop.txt");
+	etk::String key = cache.getKey(request);
+	EXPECT_EQ(cache.get(key, request) == null, true);
+	etk::String body = "Hello";
+	EXPECT_EQ(cache.store(key, createAnswer("max-age=60"), &body[0], body.size()), true);
+	ememory::SharedPtr<enet::HttpCannedAnswer> answer = cache.get(key, request);
+	EXPECT_EQ(answer != null, true);
+	if (answer != null) {
+		EXPECT_EQ(answer->getCode() == enet::HTTPAnswerCode::c200_ok, true);
+		EXPECT_EQ(etk::String(&answer->getBody()[2], answer->getBody().size()-2), "Hello");
+	}
+	EXPECT_EQ(cache.getNumberHit(), 1);
+	EXPECT_EQ(cache.getNumberMiss(), 1);
+	// Other value of a vary key
+	request.setKey(enet::HTTPHeaderId::acceptEncoding, "gzip");
+	EXPECT_EQ(cache.get(cache.getKey(request), request) == null, true);
+	request.rmKey(enet::HTTPHeaderId::acceptEncoding);
+	// The client ask a new answer
+	request.setKey(enet::HTTPHeaderId::cacheControl, "no-cache");
+	EXPECT_EQ(cache.get(key, request) == null, true);
+	request.rmKey(enet::HTTPHeaderId::cacheControl);
+	EXPECT_EQ(cache.get(key, request) != null, true);
+	// Not stored
+	EXPECT_EQ(cache.store("other", createAnswer("no-store"), &body[0], body.size()), false);
+	enet::HttpAnswer answerVary = createAnswer("max-age=60");
+	answerVary.setKey(enet::HTTPHeaderId::vary, "Accept-Language");
+	EXPECT_EQ(cache.store("other", answerVary, &body[0], body.size()), false);
+	answerVary.setKey(enet::HTTPHeaderId::vary, "accept-encoding");
+	EXPECT_EQ(cache.store("other", answerVary, &body[0], body.size()), true);
+	// Remove all the answers of an URI
+	request.setQueryKey("id", "12");
+	EXPECT_EQ(cache.store(cache.getKey(request), createAnswer("max-age=60"), &body[0], body.size()), true);
+	EXPECT_EQ(cache.get(cache.getKey(request), request) != null, true);
+	cache.remove("plop.txt");
+	EXPECT_EQ(cache.get(cache.getKey(request), request) == null, true);
+	EXPECT_EQ(cache.get(key, request) == null, true);
+	EXPECT_EQ(cache.get("other", request) != null, true);
+	cache.clear();
+	EXPECT_EQ(cache.getSize(), 0);
+}
+
+TEST(httpCache, leastRecentlyUsed) {
+	enet::HttpCache cache(16*1024);
+	etk::String body = createBody(1000);
+	EXPECT_EQ(cache.store("first", createAnswer("max-age=60"), &body[0], body.size()), true);
+	// An answer can not use more than 1/8 of the cache
+	body = createBody(4000);
+	EXPECT_EQ(cache.store("tooBig", createAnswer("max-age=60"), &body[0], body.size()), false);
+	body = createBody(1000);
+	enet::HttpRequest request(enet::HTTPReqType::HTTP_GET);
+	for (int32_t iii=0; iii<20; ++iii) {
+		EXPECT_EQ(cache.store(etk::toString(iii), createAnswer("max-age=60"), &body[0], body.size()), true);
+		// "0" is the most recently used
+		EXPECT_EQ(cache.get("0", request) != null, true);
+		EXPECT_EQ(cache.getSize() <= 16*1024, true);
+	}
+	EXPECT_EQ(cache.get("first", request) == null, true);
+	EXPECT_EQ(cache.get("1", request) == null, true);
+	EXPECT_EQ(cache.get("19", request) != null, true);
+}
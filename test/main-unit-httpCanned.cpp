@@ -0,0 +1,99 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/HttpCanned.hpp>
+
+TEST(httpCanned, encode) {
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	answer.setKey(enet::HTTPHeaderId::contentType, "application/json");
+	answer.setKey(enet::HTTPHeaderId::connection, "close");
+	answer.setKey(enet::HTTPHeaderId::date, "Sun, 06 Nov 1994 08:49:37 GMT");
+	enet::HttpCannedAnswer canned(answer, "{\"status\":\"ok\"}");
+	EXPECT_EQ(canned.getCode() == enet::HTTPAnswerCode::c200_ok, true);
+	EXPECT_EQ(canned.isClose(), true);
+	EXPECT_EQ(canned.hasBody(), true);
+	// The connection keys and the date are added when the answer is sent
+	EXPECT_EQ(etk::String(&canned.getHead()[0], canned.getHead().size()), "HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 15\r\n");
+	EXPECT_EQ(etk::String(&canned.getBody()[0], canned.getBody().size()), "\r\n{\"status\":\"ok\"}");
+}
+
+TEST(httpCanned, noBody) {
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c304_notModified);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	enet::HttpCannedAnswer canned(answer, "not sent");
+	EXPECT_EQ(canned.isClose(), false);
+	EXPECT_EQ(canned.hasBody(), false);
+	EXPECT_EQ(etk::String(&canned.getHead()[0], canned.getHead().size()), "HTTP/1.1 304 Not Modified\r\n");
+	EXPECT_EQ(etk::String(&canned.getBody()[0], canned.getBody().size()), "\r\n");
+}
+
+TEST(httpCanned, registry) {
+	EXPECT_EQ(enet::httpCanned::get("health") == null, true);
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+	enet::httpCanned::add("health", answer, "ok");
+	ememory::SharedPtr<enet::HttpCannedAnswer> health = enet::httpCanned::get("health");
+	EXPECT_EQ(health != null, true);
+	EXPECT_EQ(health->getBody().size(), 4);
+	ememory::SharedPtr<enet::HttpCannedAnswer> notFound = enet::httpCanned::get(enet::HTTPAnswerCode::c404_notFound);
+	EXPECT_EQ(etk::String(&notFound->getHead()[0], notFound->getHead().size()), "HTTP/1.1 404 Not Found\r\nContent-Length: 0\r\n");
+	// The default answer is encoded one time
+	EXPECT_EQ(notFound == enet::httpCanned::get(enet::HTTPAnswerCode::c404_notFound), true);
+}
+
+TEST(httpCanned, date) {
+	enet::httpDate::setServerName("test");
+	char buffer[enet::httpDate::MAX_SIZE];
+	size_t size = enet::httpDate::getLines(buffer);
+	etk::String lines(buffer, size);
+	// "Date: Sun, 06 Nov 1994 08:49:37 GMT\r\nServer: test\r\n"
+	EXPECT_EQ(size, 37 + 14);
+	EXPECT_EQ(etk::start_with(lines, "Date: "), true);
+	EXPECT_EQ(etk::end_with(lines, " GMT\r\nServer: test\r\n"), true);
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+	enet::httpDate::setKeys(answer);
+	EXPECT_EQ(answer.getKey(enet::HTTPHeaderId::date).size(), 29);
+	EXPECT_EQ(answer.getKey(enet::HTTPHeaderId::server), "test");
+	enet::httpDate::setServerName("");
+	size = enet::httpDate::getLines(buffer);
+	EXPECT_EQ(size, 37);
+	enet::httpDate::setServerName("e-net (ewol network interface)");
+}
+
+TEST(httpCanned, dateBackgroundRefresh) {
+	enet::httpDate::setBackgroundRefresh(true);
+	// Already started: nothing to do
+	enet::httpDate::setBackgroundRefresh(true);
+	char buffer[enet::httpDate::MAX_SIZE];
+	size_t size = enet::httpDate::getLines(buffer);
+	EXPECT_EQ(etk::start_with(etk::String(buffer, size), "Date: "), true);
+	enet::httpDate::setBackgroundRefresh(false);
+	enet::httpDate::setBackgroundRefresh(false);
+	size = enet::httpDate::getLines(buffer);
+	EXPECT_EQ(etk::start_with(etk::String(buffer, size), "Date: "), true);
+}
+
+TEST(httpCanned, dateParse) {
+	EXPECT_EQ(enet::httpDate::format(784111777), "Sun, 06 Nov 1994 08:49:37 GMT");
+	int64_t value = 0;
+	EXPECT_EQ(enet::httpDate::parse("Sun, 06 Nov 1994 08:49:37 GMT", value), true);
+	EXPECT_EQ(value, 784111777);
+	// Obsolete formats (RFC 7231 7.1.1.1)
+	value = 0;
+	EXPECT_EQ(enet::httpDate::parse("Sunday, 06-Nov-94 08:49:37 GMT", value), true);
+	EXPECT_EQ(value, 784111777);
+	value = 0;
+	EXPECT_EQ(enet::httpDate::parse("Sun Nov  6 08:49:37 1994", value), true);
+	EXPECT_EQ(value, 784111777);
+	EXPECT_EQ(enet::httpDate::parse("Thu, 29 Feb 2024 23:59:59 GMT", value), true);
+	EXPECT_EQ(value, 1709251199);
+	EXPECT_EQ(enet::httpDate::parse("Sun, 06 Nov 1994", value), false);
+	EXPECT_EQ(enet::httpDate::parse("Sun, 06 Foo 1994 08:49:37 GMT", value), false);
+	EXPECT_EQ(enet::httpDate::parse("", value), false);
+}
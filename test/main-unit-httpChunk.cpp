@@ -0,0 +1,100 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/HttpChunk.hpp>
+extern "C" {
+	#include <string.h>
+}
+
+static const char* g_chunkedBody = "4\r\nWiki\r\n5;name=value\r\npedia\r\nE\r\n in\r\n\r\nchunks.\r\n0\r\nExpires: never\r\n\r\nGET / HTTP/1.1\r\n";
+static const char* g_decodedBody = "Wikipedia in\r\n\r\nchunks.";
+
+TEST(httpChunk, decodeAll) {
+	enet::HttpChunkDecoder decoder;
+	etk::Vector<uint8_t> data;
+	data.resize(strlen(g_chunkedBody));
+	memcpy(&data[0], g_chunkedBody, data.size());
+	size_t consumed = 0;
+	size_t bodySize = 0;
+	EXPECT_EQ(decoder.decode(&data[0], data.size(), consumed, bodySize) == enet::HttpChunkDecoder::status::done, true);
+	EXPECT_EQ(bodySize, strlen(g_decodedBody));
+	EXPECT_EQ(etk::String((const char*)&data[0], bodySize), g_decodedBody);
+	// The next message is not consumed
+	EXPECT_EQ(etk::String((const char*)&data[consumed], data.size() - consumed), "GET / HTTP/1.1\r\n");
+}
+
+TEST(httpChunk, decodeByteByByte) {
+	enet::HttpChunkDecoder decoder;
+	size_t size = strlen(g_chunkedBody);
+	etk::String body;
+	size_t iii = 0;
+	enum enet::HttpChunkDecoder::status status = enet::HttpChunkDecoder::status::incomplete;
+	while (    iii < size
+	        && status == enet::HttpChunkDecoder::status::incomplete) {
+		uint8_t value = g_chunkedBody[iii];
+		size_t consumed = 0;
+		size_t bodySize = 0;
+		status = decoder.decode(&value, 1, consumed, bodySize);
+		EXPECT_EQ(consumed, 1);
+		if (bodySize != 0) {
+			body += char(value);
+		}
+		iii++;
+	}
+	EXPECT_EQ(status == enet::HttpChunkDecoder::status::done, true);
+	EXPECT_EQ(body, g_decodedBody);
+	EXPECT_EQ(etk::String(&g_chunkedBody[iii]), "GET / HTTP/1.1\r\n");
+}
+
+TEST(httpChunk, decodeReset) {
+	enet::HttpChunkDecoder decoder;
+	uint8_t data[] = "3\r\nabc\r\n0\r\n\r\n";
+	size_t consumed = 0;
+	size_t bodySize = 0;
+	EXPECT_EQ(decoder.decode(data, 5, consumed, bodySize) == enet::HttpChunkDecoder::status::incomplete, true);
+	EXPECT_EQ(bodySize, 2);
+	decoder.reset();
+	uint8_t data2[] = "1\nz\n0\n\n";
+	EXPECT_EQ(decoder.decode(data2, 7, consumed, bodySize) == enet::HttpChunkDecoder::status::done, true);
+	EXPECT_EQ(consumed, 7);
+	EXPECT_EQ(bodySize, 1);
+	EXPECT_EQ(data2[0], 'z');
+}
+
+TEST(httpChunk, decodeError) {
+	const char* listError[] = {
+		"\r\n",
+		"x\r\n",
+		"3\r\nabcX\r\n",
+		"3\r\n\r\nabc\r\n",
+		"10000000000000000\r\n",
+		"0\r\n\rX"
+	};
+	for (auto &it : listError) {
+		enet::HttpChunkDecoder decoder;
+		etk::Vector<uint8_t> data;
+		data.resize(strlen(it));
+		memcpy(&data[0], it, data.size());
+		size_t consumed = 0;
+		size_t bodySize = 0;
+		EXPECT_EQ(decoder.decode(&data[0], data.size(), consumed, bodySize) == enet::HttpChunkDecoder::status::error, true);
+	}
+}
+
+TEST(httpChunk, chunkHeader) {
+	char buffer[20];
+	size_t size = enet::generateChunkHeader(buffer, 0);
+	EXPECT_EQ(etk::String(buffer, size), "0\r\n");
+	size = enet::generateChunkHeader(buffer, 26);
+	EXPECT_EQ(etk::String(buffer, size), "1a\r\n");
+	size = enet::generateChunkHeader(buffer, 65536);
+	EXPECT_EQ(etk::String(buffer, size), "10000\r\n");
+	size = enet::generateChunkHeader(buffer, 0xFFFFFFFFFFFFFFFFULL);
+	EXPECT_EQ(etk::String(buffer, size), "ffffffffffffffff\r\n");
+}
@@ -0,0 +1,148 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/HttpCompression.hpp>
+
+static etk::String createBody(size_t _size) {
+	etk::String out;
+	while (out.size() < _size) {
+		out += "{\"id\":" + etk::toString(out.size()) + ",\"name\":\"element\"},";
+	}
+	out.resize(_size);
+	return out;
+}
+
+static bool roundTrip(enum enet::httpCompression::encoding _encoding, const etk::String& _body) {
+	enet::HttpDeflater deflater;
+	if (deflater.init(_encoding, 6) == false) {
+		return false;
+	}
+	// Compress by part as a streamed body
+	etk::Vector<uint8_t> compressed;
+	for (size_t iii=0; iii<_body.size(); iii+=1000) {
+		if (deflater.compress(&_body[iii], etk::min(size_t(1000), _body.size()-iii), compressed, false) == false) {
+			return false;
+		}
+	}
+	if (deflater.compress(null, 0, compressed, true) == false) {
+		return false;
+	}
+	if (compressed.size() >= _body.size()) {
+		return false;
+	}
+	enet::HttpInflater inflater;
+	if (inflater.init(_body.size()) == false) {
+		return false;
+	}
+	etk::String out;
+	etk::Vector<uint8_t> data;
+	enum enet::HttpInflater::status status = enet::HttpInflater::status::incomplete;
+	for (size_t iii=0; iii<compressed.size(); iii+=100) {
+		status = inflater.decompress(&compressed[iii], etk::min(size_t(100), compressed.size()-iii), data);
+		if (status == enet::HttpInflater::status::error) {
+			return false;
+		}
+		out += etk::String((const char*)&data[0], data.size());
+	}
+	return    status == enet::HttpInflater::status::done
+	       && out == _body;
+}
+
+TEST(httpCompression, negotiate) {
+	EXPECT_EQ(enet::httpCompression::negotiate("gzip, deflate, br") == enet::httpCompression::encoding::gzip, true);
+	EXPECT_EQ(enet::httpCompression::negotiate("deflate") == enet::httpCompression::encoding::deflate, true);
+	EXPECT_EQ(enet::httpCompression::negotiate("gzip;q=0.5, deflate;q=0.8") == enet::httpCompression::encoding::deflate, true);
+	EXPECT_EQ(enet::httpCompression::negotiate("*") == enet::httpCompression::encoding::gzip, true);
+	EXPECT_EQ(enet::httpCompression::negotiate("gzip;q=0, *;q=0.1") == enet::httpCompression::encoding::deflate, true);
+	EXPECT_EQ(enet::httpCompression::negotiate("br, identity") == enet::httpCompression::encoding::identity, true);
+	EXPECT_EQ(enet::httpCompression::negotiate("") == enet::httpCompression::encoding::identity, true);
+	enum enet::httpCompression::encoding value;
+	EXPECT_EQ(enet::httpCompression::parseName("x-gzip", value), true);
+	EXPECT_EQ(value == enet::httpCompression::encoding::gzip, true);
+	EXPECT_EQ(enet::httpCompression::parseName("br", value), false);
+}
+
+TEST(httpCompression, stream) {
+	etk::String body = createBody(100000);
+	EXPECT_EQ(roundTrip(enet::httpCompression::encoding::gzip, body), true);
+	EXPECT_EQ(roundTrip(enet::httpCompression::encoding::deflate, body), true);
+}
+
+TEST(httpCompression, inflateLimit) {
+	etk::String body = createBody(100000);
+	enet::HttpDeflater deflater;
+	etk::Vector<uint8_t> compressed;
+	EXPECT_EQ(deflater.init(enet::httpCompression::encoding::gzip, 9), true);
+	EXPECT_EQ(deflater.compress(&body[0], body.size(), compressed, true), true);
+	enet::HttpInflater inflater;
+	EXPECT_EQ(inflater.init(1000), true);
+	etk::Vector<uint8_t> data;
+	EXPECT_EQ(inflater.decompress(&compressed[0], compressed.size(), data) == enet::HttpInflater::status::tooBig, true);
+	// Not compressed data
+	EXPECT_EQ(inflater.init(1000), true);
+	EXPECT_EQ(inflater.decompress(&body[0], 100, data) == enet::HttpInflater::status::error, true);
+}
+
+TEST(httpCompression, select) {
+	enet::HttpCompression compression(6, 1024);
+	enet::HttpRequest request;
+	request.setKey(enet::HTTPHeaderId::acceptEncoding, "gzip");
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+	answer.setKey(enet::HTTPHeaderId::contentType, "application/json; charset=utf-8");
+	EXPECT_EQ(compression.select(request, answer, 2000) == enet::httpCompression::encoding::gzip, true);
+	// Too small
+	EXPECT_EQ(compression.select(request, answer, 100) == enet::httpCompression::encoding::identity, true);
+	// Unknown size (streamed)
+	EXPECT_EQ(compression.select(request, answer, -1) == enet::httpCompression::encoding::gzip, true);
+	answer.setKey(enet::HTTPHeaderId::contentType, "image/png");
+	EXPECT_EQ(compression.select(request, answer, 2000) == enet::httpCompression::encoding::identity, true);
+	compression.addType("image/png");
+	EXPECT_EQ(compression.select(request, answer, 2000) == enet::httpCompression::encoding::gzip, true);
+	answer.setKey(enet::HTTPHeaderId::cacheControl, "public, no-transform");
+	EXPECT_EQ(compression.select(request, answer, 2000) == enet::httpCompression::encoding::identity, true);
+	EXPECT_EQ(compression.isCompressible("text/html"), true);
+	EXPECT_EQ(compression.isCompressible("application/vnd.api+json"), true);
+	EXPECT_EQ(compression.isCompressible("application/octet-stream"), false);
+	compression.setLevel(0);
+	answer.rmKey(enet::HTTPHeaderId::cacheControl);
+	EXPECT_EQ(compression.select(request, answer, 2000) == enet::httpCompression::encoding::identity, true);
+}
+
+TEST(httpCompression, updateHeader) {
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+	answer.setContentLength(2000);
+	answer.setKey(enet::HTTPHeaderId::vary, "Origin");
+	answer.setKey(enet::HTTPHeaderId::eTag, "\"abc\"");
+	enet::HttpCompression::updateHeader(answer, enet::httpCompression::encoding::gzip);
+	EXPECT_EQ(answer.getKey(enet::HTTPHeaderId::contentEncoding), "gzip");
+	EXPECT_EQ(answer.existKey(enet::HTTPHeaderId::contentLength), false);
+	EXPECT_EQ(answer.getKey(enet::HTTPHeaderId::vary), "Origin, Accept-Encoding");
+	EXPECT_EQ(answer.getKey(enet::HTTPHeaderId::eTag), "W/\"abc\"");
+}
+
+TEST(httpCompression, cache) {
+	enet::HttpCompression compression;
+	compression.setCacheSize(1024*1024);
+	etk::String body = createBody(10000);
+	etk::Vector<uint8_t> first;
+	etk::Vector<uint8_t> out;
+	EXPECT_EQ(compression.compress(&body[0], body.size(), enet::httpCompression::encoding::gzip, first), true);
+	// The second time the body is added in the cache
+	EXPECT_EQ(compression.compress(&body[0], body.size(), enet::httpCompression::encoding::gzip, out), true);
+	EXPECT_EQ(compression.getNumberCacheHit(), 0);
+	EXPECT_EQ(compression.compress(&body[0], body.size(), enet::httpCompression::encoding::gzip, out), true);
+	EXPECT_EQ(compression.getNumberCacheHit(), 1);
+	EXPECT_EQ(out == first, true);
+	// An other encoding is an other element
+	EXPECT_EQ(compression.compress(&body[0], body.size(), enet::httpCompression::encoding::deflate, out), true);
+	EXPECT_EQ(compression.getNumberCacheHit(), 1);
+	compression.setCacheSize(0);
+	EXPECT_EQ(compression.compress(&body[0], body.size(), enet::httpCompression::encoding::gzip, out), true);
+	EXPECT_EQ(compression.getNumberCacheHit(), 1);
+}
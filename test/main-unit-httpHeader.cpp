@@ -0,0 +1,242 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/Http.hpp>
+#include <enet/HttpParser.hpp>
+
+TEST(httpHeader, caseInsensitive) {
+	enet::HttpRequest header;
+	header.setKey("Content-Type", "text/html");
+	EXPECT_EQ(header.getKey("content-type"), "text/html");
+	EXPECT_EQ(header.getKey("CONTENT-TYPE"), "text/html");
+	EXPECT_EQ(header.existKey("Content-type"), true);
+	EXPECT_EQ(header.existKey("Content"), false);
+	header.setKey("CONTENT-TYPE", "text/plain");
+	EXPECT_EQ(header.getNumberKey(), 1);
+	EXPECT_EQ(header.getKey("Content-Type"), "text/plain");
+	// The first name is kept
+	EXPECT_EQ(header.getKeyName(0), "Content-Type");
+}
+
+TEST(httpHeader, replaceAndRemove) {
+	enet::HttpRequest header;
+	header.setKey("Host", "a");
+	header.setKey("Connection", "close");
+	header.setKey("Accept", "*/*");
+	header.setKey("Host", "www.example.com");
+	header.setKey("Connection", "");
+	EXPECT_EQ(header.getKey("Host"), "www.example.com");
+	EXPECT_EQ(header.getKey("Connection"), "");
+	EXPECT_EQ(header.existKey("Connection"), true);
+	header.rmKey("connection");
+	EXPECT_EQ(header.existKey("Connection"), false);
+	EXPECT_EQ(header.getNumberKey(), 2);
+	// Order of insertion
+	EXPECT_EQ(header.getKeyName(0), "Host");
+	EXPECT_EQ(header.getKeyName(1), "Accept");
+	header.clearKeys();
+	EXPECT_EQ(header.getNumberKey(), 0);
+	EXPECT_EQ(header.existKey("Host"), false);
+}
+
+TEST(httpHeader, manyKeys) {
+	enet::HttpRequest header;
+	size_t nbKey = enet::HttpHeader::INLINE_KEY * 2 + 3;
+	for (size_t iii=0; iii<nbKey; ++iii) {
+		header.setKey("X-Key-" + etk::toString(iii), etk::toString(iii));
+	}
+	EXPECT_EQ(header.getNumberKey(), nbKey);
+	for (size_t iii=0; iii<nbKey; ++iii) {
+		EXPECT_EQ(header.getKey("x-key-" + etk::toString(iii)), etk::toString(iii));
+	}
+	header.rmKey("X-Key-0");
+	header.rmKey("X-Key-" + etk::toString(enet::HttpHeader::INLINE_KEY));
+	EXPECT_EQ(header.getNumberKey(), nbKey - 2);
+	EXPECT_EQ(header.getKeyName(0), "X-Key-1");
+	EXPECT_EQ(header.getKey("X-Key-" + etk::toString(nbKey-1)), etk::toString(nbKey-1));
+}
+
+TEST(httpHeader, growValue) {
+	enet::HttpRequest header;
+	header.setKey("Host", "www.example.com");
+	etk::String value;
+	for (size_t iii=0; iii<200; ++iii) {
+		value += "abcdefghij";
+		header.setKey("Cookie", value);
+		EXPECT_EQ(header.getKey("Host"), "www.example.com");
+	}
+	EXPECT_EQ(header.getKey("Cookie"), value);
+	EXPECT_EQ(header.getNumberKey(), 2);
+}
+
+TEST(httpHeader, headerId) {
+	for (size_t iii=0; iii<size_t(enet::HTTPHeaderId::unknow); ++iii) {
+		etk::String name = enet::getHTTPHeaderName(enet::HTTPHeaderId(iii));
+		EXPECT_EQ(enet::getHTTPHeaderId(name.c_str(), name.size()) == enet::HTTPHeaderId(iii), true);
+		name = name.toUpper();
+		EXPECT_EQ(enet::getHTTPHeaderId(name.c_str(), name.size()) == enet::HTTPHeaderId(iii), true);
+	}
+	etk::String name = "X-Custom-Key";
+	EXPECT_EQ(enet::getHTTPHeaderId(name.c_str(), name.size()) == enet::HTTPHeaderId::unknow, true);
+	name = "Hosts";
+	EXPECT_EQ(enet::getHTTPHeaderId(name.c_str(), name.size()) == enet::HTTPHeaderId::unknow, true);
+}
+
+TEST(httpHeader, knownKey) {
+	enet::HttpRequest header;
+	header.setKey("X-Custom-Key", "1");
+	header.setKey("upgrade", "WebSocket");
+	EXPECT_EQ(header.existKey(enet::HTTPHeaderId::upgrade), true);
+	EXPECT_EQ(header.isKeyEqual(enet::HTTPHeaderId::upgrade, "websocket"), true);
+	EXPECT_EQ(header.isKeyEqual(enet::HTTPHeaderId::upgrade, "websockets"), false);
+	header.setKey(enet::HTTPHeaderId::connection, "Upgrade");
+	EXPECT_EQ(header.getKey("Connection"), "Upgrade");
+	header.rmKey("X-Custom-Key");
+	EXPECT_EQ(header.getKey(enet::HTTPHeaderId::upgrade), "WebSocket");
+	EXPECT_EQ(header.getKey(enet::HTTPHeaderId::connection), "Upgrade");
+	header.rmKey(enet::HTTPHeaderId::upgrade);
+	EXPECT_EQ(header.existKey("Upgrade"), false);
+	EXPECT_EQ(header.getKey(enet::HTTPHeaderId::connection), "Upgrade");
+}
+
+TEST(httpHeader, contentLength) {
+	enet::HttpRequest header;
+	EXPECT_EQ(header.getContentLength(), -1);
+	header.setKey("content-length", "1234");
+	EXPECT_EQ(header.getContentLength(), 1234);
+	header.setKey("Content-Length", "12a");
+	EXPECT_EQ(header.getContentLength(), -1);
+	header.setContentLength(42);
+	EXPECT_EQ(header.getKey("Content-Length"), "42");
+	EXPECT_EQ(header.getContentLength(), 42);
+	header.rmKey("Content-Length");
+	EXPECT_EQ(header.getContentLength(), -1);
+}
+
+/**
+ * @brief Parse a request and set its keys.
+ * @return The value returned by setKeys().
+ */
+static bool parseRequest(const etk::String& _data, enet::HttpRequest& _header) {
+	enet::HttpParser parser;
+	if (parser.parse(_data.c_str(), _data.size()) != enet::HttpParser::status::done) {
+		return false;
+	}
+	_header.clearKeys();
+	return _header.setKeys(_data.c_str(), parser);
+}
+
+TEST(httpHeader, duplicateContentLength) {
+	enet::HttpRequest header;
+	EXPECT_EQ(parseRequest("POST / HTTP/1.1\r\nContent-Length: 5\r\n\r\n", header), true);
+	EXPECT_EQ(header.getContentLength(), 5);
+	// Same value: accepted
+	EXPECT_EQ(parseRequest("POST / HTTP/1.1\r\nContent-Length: 5\r\ncontent-length: 5\r\n\r\n", header), true);
+	EXPECT_EQ(header.getContentLength(), 5);
+	// Different values: request smuggling
+	EXPECT_EQ(parseRequest("POST / HTTP/1.1\r\nContent-Length: 5\r\nContent-Length: 50\r\n\r\n", header), false);
+	EXPECT_EQ(parseRequest("POST / HTTP/1.1\r\nContent-Length: 50\r\nContent-Length: 5\r\n\r\n", header), false);
+}
+
+TEST(httpHeader, bodyFraming) {
+	enet::HttpRequest header;
+	EXPECT_EQ(header.isBodyFramingValid(true), true);
+	header.setKey("Content-Length", "12");
+	EXPECT_EQ(header.isBodyFramingValid(true), true);
+	header.setKey("Content-Length", "12a");
+	EXPECT_EQ(header.isBodyFramingValid(true), false);
+	EXPECT_EQ(header.isBodyFramingValid(false), false);
+	header.setKey("Content-Length", "-1");
+	EXPECT_EQ(header.isBodyFramingValid(true), false);
+	// The transfer encoding is used before the content length
+	header.setKey("Transfer-Encoding", "gzip, chunked");
+	EXPECT_EQ(header.isBodyFramingValid(true), true);
+	header.rmKey("Content-Length");
+	header.setKey("Transfer-Encoding", "gzip");
+	EXPECT_EQ(header.isBodyFramingValid(true), false);
+	// An answer can end with the connection
+	EXPECT_EQ(header.isBodyFramingValid(false), true);
+}
+
+TEST(httpHeader, protocol) {
+	for (size_t iii=0; iii<=size_t(enet::HTTPProtocol::http_3_10); ++iii) {
+		enum enet::HTTPProtocol value;
+		EXPECT_EQ(etk::from_string(value, etk::toString(enet::HTTPProtocol(iii))), true);
+		EXPECT_EQ(size_t(value), iii);
+	}
+	enum enet::HTTPProtocol value;
+	EXPECT_EQ(etk::from_string(value, "HTTP/1.1"), true);
+	EXPECT_EQ(value == enet::HTTPProtocol::http_1_1, true);
+	EXPECT_EQ(etk::toString(enet::HTTPProtocol::http_2_10), "HTTP/2.10");
+	EXPECT_EQ(etk::from_string(value, "HTTP/0.0"), false);
+	EXPECT_EQ(etk::from_string(value, "HTTP/1.01"), false);
+	EXPECT_EQ(etk::from_string(value, "HTTP/1.11"), false);
+	EXPECT_EQ(etk::from_string(value, "HTTP/4.0"), false);
+	EXPECT_EQ(etk::from_string(value, "HTTPS/1.1"), false);
+}
+
+TEST(httpHeader, reqType) {
+	enum enet::HTTPReqType value;
+	EXPECT_EQ(etk::from_string(value, "OPTIONS"), true);
+	EXPECT_EQ(value == enet::HTTPReqType::HTTP_OPTIONS, true);
+	EXPECT_EQ(etk::toString(enet::HTTPReqType::HTTP_DELETE), "DELETE");
+	EXPECT_EQ(etk::from_string(value, "GETS"), false);
+	EXPECT_EQ(etk::from_string(value, "get"), false);
+}
+
+TEST(httpHeader, answerCode) {
+	enum enet::HTTPAnswerCode value;
+	EXPECT_EQ(etk::from_string(value, "404"), true);
+	EXPECT_EQ(value == enet::HTTPAnswerCode::c404_notFound, true);
+	EXPECT_EQ(etk::from_string(value, "418"), false);
+	EXPECT_EQ(etk::from_string(value, "20"), false);
+	EXPECT_EQ(etk::String(enet::getHTTPAnswerReason(enet::HTTPAnswerCode::c429_tooManyRequests)), "Too Many Requests");
+	EXPECT_EQ(enet::getHTTPAnswerReason(enet::HTTPAnswerCode::c000_unknow) == null, true);
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c503_serviceUnavailable);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	EXPECT_EQ(answer.generate(), "HTTP/1.1 503 Service Unavailable\r\n\r\n");
+}
+
+TEST(httpHeader, generate) {
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+	answer.setProtocol(enet::HTTPProtocol::http_1_1);
+	answer.setKey(enet::HTTPHeaderId::contentType, "application/json");
+	answer.setContentLength(2);
+	etk::Vector<char> buffer;
+	buffer.pushBack('#');
+	// The header is added at the end of the buffer
+	answer.generate(buffer);
+	EXPECT_EQ(etk::String(&buffer[0], buffer.size()), "#HTTP/1.1 200 OK\r\nContent-Type: application/json\r\nContent-Length: 2\r\n\r\n");
+	EXPECT_EQ(answer.generate(), etk::String(&buffer[1], buffer.size()-1));
+	enet::HttpRequest request(enet::HTTPReqType::HTTP_POST);
+	request.setUri("/api");
+	request.setProtocol(enet::HTTPProtocol::http_1_1);
+	request.setKey(enet::HTTPHeaderId::host, "127.0.0.1");
+	EXPECT_EQ(request.generate(), "POST /api HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n");
+	request.setQueryKey("a", "b");
+	EXPECT_EQ(request.generate(), "POST /api?a=b HTTP/1.1\r\nHost: 127.0.0.1\r\n\r\n");
+}
+
+TEST(httpHeader, copy) {
+	enet::HttpAnswer answer(enet::HTTPAnswerCode::c404_notFound);
+	answer.setKey(enet::HTTPHeaderId::connection, "close");
+	for (size_t iii=0; iii<enet::HttpHeader::INLINE_KEY + 4; ++iii) {
+		answer.setKey("X-Key-" + etk::toString(iii), etk::toString(iii));
+	}
+	enet::HttpAnswer copy(enet::HTTPAnswerCode::c200_ok);
+	copy.setKey(enet::HTTPHeaderId::contentLength, "12");
+	copy = answer;
+	EXPECT_EQ(copy.getErrorCode() == enet::HTTPAnswerCode::c404_notFound, true);
+	EXPECT_EQ(copy.getNumberKey(), answer.getNumberKey());
+	EXPECT_EQ(copy.existKey(enet::HTTPHeaderId::contentLength), false);
+	EXPECT_EQ(copy.getContentLength(), -1);
+	EXPECT_EQ(copy.isKeyEqual(enet::HTTPHeaderId::connection, "close"), true);
+	EXPECT_EQ(copy.getKey("x-key-27"), "27");
+	EXPECT_EQ(copy.generate(), answer.generate());
+}
@@ -0,0 +1,163 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/Http.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <poll.h>
+	#include <unistd.h>
+}
+
+/**
+ * @brief HttpServer on one side of a socket pair that answer "ok" to all the requests, the test is the remote.
+ */
+class KeepAliveTest {
+	public:
+		int32_t m_sockets[2]; //!< [0]: server side, [1]: remote side
+		enet::HttpServer* m_server; //!< Server under test
+	public:
+		KeepAliveTest(int32_t _maxRequest=100, echrono::Duration _idleTimeOut=echrono::seconds(10)) :
+		  m_server(null) {
+			socketpair(AF_UNIX, SOCK_STREAM, 0, m_sockets);
+			m_server = ETK_NEW(enet::HttpServer, enet::Tcp(m_sockets[0], "test"));
+			m_server->setMaxRequest(_maxRequest);
+			m_server->setIdleTimeOut(_idleTimeOut);
+			m_server->connectHeader([&](const enet::HttpRequest& _request) {
+				enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+				answer.setProtocol(_request.getProtocol());
+				answer.setKey("X-Uri", _request.getUri());
+				m_server->setHeader(answer, "ok");
+			});
+			m_server->start();
+		}
+		~KeepAliveTest() {
+			m_server->stop();
+			ETK_DELETE(enet::HttpServer, m_server);
+			close(m_sockets[1]);
+		}
+		void send(const etk::String& _data) {
+			::send(m_sockets[1], _data.c_str(), _data.size(), 0);
+		}
+		/**
+		 * @brief Read the answers of the server.
+		 * @param[in] _count Number of answer to wait ("ok" body).
+		 * @return The data received.
+		 */
+		etk::String read(size_t _count) {
+			etk::String out;
+			while (count(out, "\r\n\r\nok") < _count) {
+				struct pollfd element;
+				element.fd = m_sockets[1];
+				element.events = POLLIN;
+				element.revents = 0;
+				if (poll(&element, 1, 2000) <= 0) {
+					break;
+				}
+				char data[4096];
+				ssize_t len = recv(m_sockets[1], data, sizeof(data), 0);
+				if (len <= 0) {
+					break;
+				}
+				out += etk::String(data, len);
+			}
+			return out;
+		}
+		/**
+		 * @brief Check if the server closed the connection (no more data and end of the stream).
+		 */
+		bool isClosed() {
+			struct pollfd element;
+			element.fd = m_sockets[1];
+			element.events = POLLIN;
+			element.revents = 0;
+			if (poll(&element, 1, 2000) <= 0) {
+				return false;
+			}
+			char data[16];
+			return recv(m_sockets[1], data, sizeof(data), 0) == 0;
+		}
+		static size_t count(const etk::String& _data, const etk::String& _value) {
+			size_t out = 0;
+			size_t pos = _data.find(_value);
+			while (pos != etk::String::npos) {
+				out++;
+				pos = _data.find(_value, pos + _value.size());
+			}
+			return out;
+		}
+};
+
+TEST(httpKeepAlive, pipelining) {
+	KeepAliveTest test(100, echrono::milliseconds(300));
+	// Two requests in the same write: read in one time by the server
+	test.send("GET /first HTTP/1.1\r\n\r\nGET /second HTTP/1.1\r\n\r\n");
+	etk::String result = test.read(2);
+	EXPECT_EQ(KeepAliveTest::count(result, "HTTP/1.1 200"), 2);
+	// The answers are sent in the order of the requests
+	size_t first = result.find("X-Uri: /first\r\n");
+	size_t second = result.find("X-Uri: /second\r\n");
+	EXPECT_EQ(first != etk::String::npos, true);
+	EXPECT_EQ(second != etk::String::npos, true);
+	EXPECT_EQ(first < second, true);
+	EXPECT_EQ(result.find("Connection: close") == etk::String::npos, true);
+	// The connection is still usable
+	test.send("GET /third HTTP/1.1\r\n\r\n");
+	result = test.read(1);
+	EXPECT_EQ(result.find("X-Uri: /third\r\n") != etk::String::npos, true);
+	// The counter is updated after the answer: read it when the server closed the idle connection
+	EXPECT_EQ(test.isClosed(), true);
+	EXPECT_EQ(test.m_server->getNumberRequest(), 3);
+}
+
+TEST(httpKeepAlive, connectionClose) {
+	KeepAliveTest test;
+	test.send("GET /plop HTTP/1.1\r\nConnection: close\r\n\r\n");
+	etk::String result = test.read(1);
+	EXPECT_EQ(result.find("HTTP/1.1 200") == 0, true);
+	EXPECT_EQ(result.find("Connection: close\r\n") != etk::String::npos, true);
+	EXPECT_EQ(test.isClosed(), true);
+}
+
+TEST(httpKeepAlive, http10) {
+	{
+		// HTTP/1.0 without "Connection: keep-alive": one request per connection
+		KeepAliveTest test;
+		test.send("GET /plop HTTP/1.0\r\n\r\n");
+		etk::String result = test.read(1);
+		EXPECT_EQ(result.find("HTTP/1.0 200") == 0, true);
+		EXPECT_EQ(result.find("Connection: close\r\n") != etk::String::npos, true);
+		EXPECT_EQ(test.isClosed(), true);
+	}
+	{
+		KeepAliveTest test(100, echrono::milliseconds(300));
+		test.send("GET /plop HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+		etk::String result = test.read(1);
+		EXPECT_EQ(result.find("Connection: keep-alive\r\n") != etk::String::npos, true);
+		test.send("GET /plop HTTP/1.0\r\nConnection: keep-alive\r\n\r\n");
+		result = test.read(1);
+		EXPECT_EQ(result.find("HTTP/1.0 200") == 0, true);
+		EXPECT_EQ(test.isClosed(), true);
+		EXPECT_EQ(test.m_server->getNumberRequest(), 2);
+	}
+}
+
+TEST(httpKeepAlive, maxRequest) {
+	KeepAliveTest test(2);
+	test.send("GET /first HTTP/1.1\r\n\r\n");
+	etk::String result = test.read(1);
+	EXPECT_EQ(result.find("Connection: close") == etk::String::npos, true);
+	test.send("GET /second HTTP/1.1\r\n\r\n");
+	result = test.read(1);
+	// The last request of the connection
+	EXPECT_EQ(result.find("X-Uri: /second\r\n") != etk::String::npos, true);
+	EXPECT_EQ(result.find("Connection: close\r\n") != etk::String::npos, true);
+	EXPECT_EQ(test.isClosed(), true);
+	EXPECT_EQ(test.m_server->getNumberRequest(), 2);
+}
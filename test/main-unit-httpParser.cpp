@@ -0,0 +1,87 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/HttpParser.hpp>
+
+static const char* g_request = "GET /plop.html?a=b HTTP/1.1\r\n"
+                               "Host: example.com\r\n"
+                               "User-Agent:  e-net  \r\n"
+                               "Empty:\r\n"
+                               "\r\n"
+                               "BODY";
+
+TEST(httpParser, request) {
+	enet::HttpParser parser;
+	etk::String data = g_request;
+	EXPECT_EQ(parser.parse(data.c_str(), data.size()) == enet::HttpParser::status::done, true);
+	EXPECT_EQ(parser.isAnswer(), false);
+	EXPECT_EQ(enet::HttpParser::extract(data.c_str(), parser.getMethod()), "GET");
+	EXPECT_EQ(enet::HttpParser::extract(data.c_str(), parser.getUri()), "/plop.html?a=b");
+	EXPECT_EQ(enet::HttpParser::extract(data.c_str(), parser.getProtocol()), "HTTP/1.1");
+	EXPECT_EQ(parser.getNumberField(), 3);
+	EXPECT_EQ(enet::HttpParser::extract(data.c_str(), parser.getField(1).m_key), "User-Agent");
+	EXPECT_EQ(enet::HttpParser::extract(data.c_str(), parser.getField(1).m_value), "e-net");
+	EXPECT_EQ(parser.getField(2).m_value.m_size, 0);
+	EXPECT_EQ(parser.findField(data.c_str(), "host"), 0);
+	EXPECT_EQ(parser.findField(data.c_str(), "Content-Length"), -1);
+	EXPECT_EQ(data.size() - parser.getHeaderSize(), 4);
+}
+
+TEST(httpParser, splitRead) {
+	etk::String data = g_request;
+	// Give the data byte per byte: the result must be the same.
+	enet::HttpParser parser;
+	size_t iii = 1;
+	for (; iii<=data.size(); ++iii) {
+		enum enet::HttpParser::status ret = parser.parse(data.c_str(), iii);
+		if (ret != enet::HttpParser::status::incomplete) {
+			EXPECT_EQ(ret == enet::HttpParser::status::done, true);
+			break;
+		}
+	}
+	EXPECT_EQ(iii, data.size() - 4);
+	EXPECT_EQ(parser.getNumberField(), 3);
+	EXPECT_EQ(enet::HttpParser::extract(data.c_str(), parser.getField(0).m_value), "example.com");
+}
+
+TEST(httpParser, answer) {
+	enet::HttpParser parser;
+	etk::String data = "HTTP/1.0 404 Not Found\nContent-Length: 0\n\n";
+	EXPECT_EQ(parser.parse(data.c_str(), data.size()) == enet::HttpParser::status::done, true);
+	EXPECT_EQ(parser.isAnswer(), true);
+	EXPECT_EQ(enet::HttpParser::extract(data.c_str(), parser.getProtocol()), "HTTP/1.0");
+	EXPECT_EQ(enet::HttpParser::extract(data.c_str(), parser.getCode()), "404");
+	EXPECT_EQ(enet::HttpParser::extract(data.c_str(), parser.getReason()), "Not Found");
+	EXPECT_EQ(parser.getNumberField(), 1);
+	EXPECT_EQ(parser.getHeaderSize(), data.size());
+}
+
+TEST(httpParser, malformed) {
+	enet::HttpParser parser;
+	etk::String data = "GET / HTTP/1.1\r\n folded: value\r\n\r\n";
+	EXPECT_EQ(parser.parse(data.c_str(), data.size()) == enet::HttpParser::status::error, true);
+	parser.reset();
+	data = "GET / HTTP/1.1\r\nNoColon\r\n\r\n";
+	EXPECT_EQ(parser.parse(data.c_str(), data.size()) == enet::HttpParser::status::error, true);
+	parser.reset();
+	data = "HTTP/1.1 20x OK\r\n\r\n";
+	EXPECT_EQ(parser.parse(data.c_str(), data.size()) == enet::HttpParser::status::error, true);
+	parser.reset();
+	data = "GET / HTTP/1.1\r\nBad Key: value\r\n\r\n";
+	EXPECT_EQ(parser.parse(data.c_str(), data.size()) == enet::HttpParser::status::error, true);
+	parser.reset();
+	data = "GET / HTTP/1.1\r\nKey: val\x01ue\r\n\r\n";
+	EXPECT_EQ(parser.parse(data.c_str(), data.size()) == enet::HttpParser::status::error, true);
+}
+
+TEST(httpParser, tooBig) {
+	enet::HttpParser parser(32);
+	etk::String data = "GET / HTTP/1.1\r\nHost: a-very-long-host-name.example.com\r\n\r\n";
+	EXPECT_EQ(parser.parse(data.c_str(), data.size()) == enet::HttpParser::status::error, true);
+}
@@ -0,0 +1,197 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/Http.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <poll.h>
+	#include <unistd.h>
+}
+
+/**
+ * @brief Read the data of the remote until a text is received (or the connection is closed, or 2 seconds without data).
+ */
+static etk::String readUntil(int32_t _socket, const etk::String& _end) {
+	etk::String out;
+	while (    _end == ""
+	        || out.find(_end) == etk::String::npos) {
+		struct pollfd element;
+		element.fd = _socket;
+		element.events = POLLIN;
+		element.revents = 0;
+		if (poll(&element, 1, _end == "" ? 100 : 2000) <= 0) {
+			break;
+		}
+		char data[4096];
+		ssize_t len = recv(_socket, data, sizeof(data), 0);
+		if (len <= 0) {
+			break;
+		}
+		out += etk::String(data, len);
+	}
+	return out;
+}
+
+/**
+ * @brief HttpServer on one side of a socket pair, the test is the remote.
+ */
+class WriterTest {
+	public:
+		int32_t m_sockets[2]; //!< [0]: server side, [1]: remote side
+		enet::HttpServer* m_server; //!< Server under test
+	public:
+		WriterTest(enet::Http::ObserverRequest _observer) :
+		  m_server(null) {
+			socketpair(AF_UNIX, SOCK_STREAM, 0, m_sockets);
+			m_server = ETK_NEW(enet::HttpServer, enet::Tcp(m_sockets[0], "test"));
+			m_server->connectHeader(_observer);
+			m_server->start();
+		}
+		~WriterTest() {
+			m_server->stop();
+			ETK_DELETE(enet::HttpServer, m_server);
+			close(m_sockets[1]);
+		}
+		void send(const etk::String& _data) {
+			::send(m_sockets[1], _data.c_str(), _data.size(), 0);
+		}
+};
+
+TEST(httpResponseWriter, chunked) {
+	enet::HttpServer* server = null;
+	WriterTest test([&](const enet::HttpRequest& _request) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		enet::HttpResponseWriter writer = server->beginResponse(answer);
+		EXPECT_EQ(writer.writeChunk("hello"), 5);
+		EXPECT_EQ(writer.writeChunk(" world"), 6);
+		EXPECT_EQ(writer.finish(), true);
+		EXPECT_EQ(writer.isFinished(), true);
+		EXPECT_EQ(writer.writeChunk("plop"), -1);
+	});
+	server = test.m_server;
+	test.send("GET /plop HTTP/1.1\r\n\r\n");
+	etk::String result = readUntil(test.m_sockets[1], "0\r\n\r\n");
+	EXPECT_EQ(result.find("Transfer-Encoding: chunked\r\n") != etk::String::npos, true);
+	EXPECT_EQ(result.find("\r\n\r\n5\r\nhello\r\n6\r\n world\r\n0\r\n\r\n") != etk::String::npos, true);
+}
+
+TEST(httpResponseWriter, contentLength) {
+	enet::HttpServer* server = null;
+	WriterTest test([&](const enet::HttpRequest& _request) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		answer.setContentLength(5);
+		enet::HttpResponseWriter writer = server->beginResponse(answer);
+		// More data than the "Content-Length": nothing written
+		EXPECT_EQ(writer.writeChunk("hello world"), -1);
+		EXPECT_EQ(writer.writeChunk("hel"), 3);
+		EXPECT_EQ(writer.writeChunk("lo!"), -1);
+		EXPECT_EQ(writer.writeChunk("lo"), 2);
+		EXPECT_EQ(writer.writeChunk("!"), -1);
+		EXPECT_EQ(writer.finish(), true);
+	});
+	server = test.m_server;
+	test.send("GET /plop HTTP/1.1\r\n\r\n");
+	etk::String result = readUntil(test.m_sockets[1], "hello");
+	EXPECT_EQ(result.find("Content-Length: 5\r\n") != etk::String::npos, true);
+	EXPECT_EQ(result.find("Transfer-Encoding") == etk::String::npos, true);
+	EXPECT_EQ(result.extract(result.size() - 9), "\r\n\r\nhello");
+}
+
+TEST(httpResponseWriter, contentLengthNotReached) {
+	enet::HttpServer* server = null;
+	WriterTest test([&](const enet::HttpRequest& _request) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		answer.setContentLength(10);
+		enet::HttpResponseWriter writer = server->beginResponse(answer);
+		EXPECT_EQ(writer.writeChunk("hello"), 5);
+		// The remote wait 5 more byte: the connection is closed
+		EXPECT_EQ(writer.finish(), false);
+	});
+	server = test.m_server;
+	test.send("GET /plop HTTP/1.1\r\n\r\n");
+	// Read up to the close of the connection
+	etk::String result = readUntil(test.m_sockets[1], "\r\n\r\nhello!");
+	EXPECT_EQ(result.extract(result.size() - 9), "\r\n\r\nhello");
+}
+
+TEST(httpResponseWriter, headNoBody) {
+	enet::HttpServer* server = null;
+	WriterTest test([&](const enet::HttpRequest& _request) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		enet::HttpResponseWriter writer = server->beginResponse(answer);
+		// The data are dropped (the remote does not wait a body)
+		EXPECT_EQ(writer.writeChunk("hello"), 5);
+		EXPECT_EQ(writer.finish(), true);
+	});
+	server = test.m_server;
+	test.send("HEAD /plop HTTP/1.1\r\n\r\n");
+	etk::String result = readUntil(test.m_sockets[1], "\r\n\r\n");
+	// Nothing after the header
+	result += readUntil(test.m_sockets[1], "");
+	EXPECT_EQ(result.find("HTTP/1.1 200") == 0, true);
+	EXPECT_EQ(result.find("Transfer-Encoding") == etk::String::npos, true);
+	EXPECT_EQ(result.find("hello") == etk::String::npos, true);
+	EXPECT_EQ(result.extract(result.size() - 4), "\r\n\r\n");
+}
+
+TEST(httpResponseWriter, noContent) {
+	enet::HttpServer* server = null;
+	WriterTest test([&](const enet::HttpRequest& _request) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c204_noContent);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		enet::HttpResponseWriter writer = server->beginResponse(answer);
+		EXPECT_EQ(writer.writeChunk("hello"), 5);
+		EXPECT_EQ(writer.finish(), true);
+	});
+	server = test.m_server;
+	test.send("GET /plop HTTP/1.1\r\n\r\n");
+	etk::String result = readUntil(test.m_sockets[1], "\r\n\r\n");
+	result += readUntil(test.m_sockets[1], "");
+	EXPECT_EQ(result.find("HTTP/1.1 204") == 0, true);
+	EXPECT_EQ(result.find("hello") == etk::String::npos, true);
+}
+
+TEST(httpResponseWriter, spaceTimeOut) {
+	int32_t nbFull = 0;
+	int32_t nbByte = 0;
+	bool canWrite = false;
+	enet::HttpServer* server = null;
+	WriterTest test([&](const enet::HttpRequest& _request) {
+		enet::HttpAnswer answer(enet::HTTPAnswerCode::c200_ok);
+		answer.setProtocol(enet::HTTPProtocol::http_1_1);
+		enet::HttpResponseWriter writer = server->beginResponse(answer);
+		writer.setSpaceTimeOut(echrono::milliseconds(0));
+		// The remote does not read: the socket become full, then nothing is written
+		for (size_t iii=0; iii<1000000; ++iii) {
+			int32_t len = writer.writeChunk("0123456789abcdef");
+			if (len == 0) {
+				nbFull++;
+				break;
+			}
+			nbByte += len;
+		}
+		// Wait the remote
+		canWrite = writer.canWrite(echrono::seconds(5));
+		writer.clearSpaceTimeOut();
+		EXPECT_EQ(writer.finish(), true);
+	});
+	server = test.m_server;
+	test.send("GET /plop HTTP/1.1\r\n\r\n");
+	ethread::sleepMilliSeconds(100);
+	etk::String result = readUntil(test.m_sockets[1], "\r\n0\r\n\r\n");
+	EXPECT_EQ(nbFull, 1);
+	EXPECT_EQ(nbByte > 0, true);
+	EXPECT_EQ(canWrite, true);
+	EXPECT_EQ(result.extract(result.size() - 7), "\r\n0\r\n\r\n");
+}
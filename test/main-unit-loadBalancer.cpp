@@ -0,0 +1,124 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/LoadBalancer.hpp>
+#include <enet/enet.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	#include <unistd.h>
+	#include <string.h>
+}
+
+/**
+ * @brief Create a socket on 127.0.0.1 with a free port.
+ * @param[in] _listen Listen on the socket (the connections are accepted by the system).
+ * @param[out] _port Port selected by the system.
+ * @return The socket.
+ */
+static int32_t createSocket(bool _listen, uint16_t& _port) {
+	int32_t socketId = socket(AF_INET, SOCK_STREAM, 0);
+	struct sockaddr_in address;
+	memset(&address, 0, sizeof(address));
+	address.sin_family = AF_INET;
+	address.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+	socklen_t size = sizeof(address);
+	bind(socketId, (struct sockaddr*)&address, sizeof(address));
+	if (_listen == true) {
+		listen(socketId, 16);
+	}
+	getsockname(socketId, (struct sockaddr*)&address, &size);
+	_port = ntohs(address.sin_port);
+	return socketId;
+}
+
+TEST(loadBalancer, avoidSlowEndpoint) {
+	etk::Vector<etk::String> list;
+	list.pushBack("127.0.0.1:1000");
+	list.pushBack("127.0.0.1:1001");
+	enet::LoadBalancer balancer(list);
+	EXPECT_EQ(balancer.size(), 2);
+	balancer.report("127.0.0.1:1000", true, echrono::milliseconds(100));
+	balancer.report("127.0.0.1:1001", true, echrono::milliseconds(1));
+	for (size_t iii=0; iii<20; ++iii) {
+		EXPECT_EQ(balancer.select(), "127.0.0.1:1001");
+	}
+}
+
+TEST(loadBalancer, ejection) {
+	etk::Vector<etk::String> list;
+	list.pushBack("127.0.0.1:1000");
+	list.pushBack("127.0.0.1:1001");
+	list.pushBack("127.0.0.1:1002");
+	enet::LoadBalancer balancer(list);
+	balancer.setEjection(2, echrono::seconds(60));
+	balancer.report("127.0.0.1:1001", false, echrono::milliseconds(1));
+	EXPECT_EQ(balancer.isEjected("127.0.0.1:1001"), false);
+	balancer.report("127.0.0.1:1001", false, echrono::milliseconds(1));
+	EXPECT_EQ(balancer.isEjected("127.0.0.1:1001"), true);
+	for (size_t iii=0; iii<20; ++iii) {
+		EXPECT_NE(balancer.select(), "127.0.0.1:1001");
+	}
+}
+
+TEST(loadBalancer, allEjected) {
+	etk::Vector<etk::String> list;
+	list.pushBack("127.0.0.1:1000");
+	enet::LoadBalancer balancer(list);
+	balancer.setEjection(1, echrono::seconds(60));
+	balancer.report("127.0.0.1:1000", false, echrono::milliseconds(1));
+	EXPECT_EQ(balancer.isEjected("127.0.0.1:1000"), true);
+	EXPECT_EQ(balancer.select(), "127.0.0.1:1000");
+}
+
+TEST(loadBalancer, unknownLatency) {
+	etk::Vector<etk::String> list;
+	list.pushBack("127.0.0.1:1000");
+	list.pushBack("127.0.0.1:1001");
+	enet::LoadBalancer balancer(list);
+	balancer.report("127.0.0.1:1000", true, echrono::milliseconds(1));
+	// "127.0.0.1:1001" has no report: its cost is the average latency (not 0), it does not get all the selections
+	size_t nbKnown = 0;
+	for (size_t iii=0; iii<50; ++iii) {
+		if (balancer.select() == "127.0.0.1:1000") {
+			nbKnown++;
+		}
+	}
+	EXPECT_EQ(nbKnown != 0, true);
+	EXPECT_EQ(nbKnown != 50, true);
+}
+
+TEST(loadBalancer, connectTryOtherEndpoint) {
+	enet::init(0, null);
+	uint16_t portDown = 0;
+	uint16_t portUp = 0;
+	// Nothing listen on this port: the connection is refused
+	int32_t socketDown = createSocket(false, portDown);
+	int32_t socketUp = createSocket(true, portUp);
+	etk::String nameDown = "127.0.0.1:" + etk::toString(portDown);
+	etk::String nameUp = "127.0.0.1:" + etk::toString(portUp);
+	etk::Vector<etk::String> list;
+	list.pushBack(nameDown);
+	list.pushBack(nameUp);
+	enet::LoadBalancer balancer(list);
+	// The endpoint down is the fastest: it is selected first
+	balancer.report(nameDown, true, echrono::milliseconds(1));
+	balancer.report(nameUp, true, echrono::milliseconds(10));
+	for (size_t iii=0; iii<2; ++iii) {
+		enet::Tcp connection = balancer.connect();
+		EXPECT_EQ(connection.getConnectionStatus() == enet::Tcp::status::link, true);
+		EXPECT_EQ(connection.getName(), nameUp);
+		balancer.release(connection);
+	}
+	EXPECT_EQ(balancer.isEjected(nameDown), false);
+	close(socketDown);
+	close(socketUp);
+}
@@ -0,0 +1,32 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/RateLimiter.hpp>
+
+TEST(rateLimiter, burst) {
+	enet::RateLimiter limiter(0.001f, 3);
+	EXPECT_EQ(limiter.check("127.0.0.1:2563"), true);
+	EXPECT_EQ(limiter.check("127.0.0.1:2564"), true);
+	EXPECT_EQ(limiter.check("127.0.0.1:2565"), true);
+	EXPECT_EQ(limiter.check("127.0.0.1:2566"), false);
+	EXPECT_EQ(limiter.getNumberReject(), 1);
+}
+
+TEST(rateLimiter, independentRemote) {
+	enet::RateLimiter limiter(0.001f, 1);
+	EXPECT_EQ(limiter.check("192.168.1.1:80"), true);
+	EXPECT_EQ(limiter.check("192.168.1.1:80"), false);
+	EXPECT_EQ(limiter.check("192.168.1.2:80"), true);
+}
+
+TEST(rateLimiter, keyWithoutPort) {
+	EXPECT_EQ(enet::RateLimiter::getKey("10.0.0.1:1234"), enet::RateLimiter::getKey("10.0.0.1:4321"));
+	EXPECT_EQ(enet::RateLimiter::getKey("10.0.0.1:1234"), enet::RateLimiter::getKey("10.0.0.1"));
+	EXPECT_NE(enet::RateLimiter::getKey("10.0.0.1:1234"), enet::RateLimiter::getKey("10.0.0.2:1234"));
+}
@@ -0,0 +1,111 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/Resolver.hpp>
+#include <ethread/tools.hpp>
+
+static int32_t g_nbCall = 0;
+
+static bool stubResolver(const etk::String& _hostname, etk::Vector<enet::Address>& _result) {
+	g_nbCall++;
+	if (_hostname == "unknow.example.com") {
+		return false;
+	}
+	enet::Address address;
+	address.setIpV4(192, 168, 1, 42);
+	_result.pushBack(address);
+	return true;
+}
+
+TEST(resolver, positiveCache) {
+	enet::resolver::clear();
+	enet::resolver::setResolveFunction(stubResolver);
+	g_nbCall = 0;
+	etk::Vector<enet::Address> list;
+	EXPECT_EQ(enet::resolver::resolve("plop.example.com", 80, list), true);
+	EXPECT_EQ(list.size(), 1);
+	EXPECT_EQ(list[0].getPort(), 80);
+	EXPECT_EQ(list[0].getName(), "192.168.1.42:80");
+	EXPECT_EQ(enet::resolver::resolve("plop.example.com", 8080, list), true);
+	EXPECT_EQ(list[0].getPort(), 8080);
+	EXPECT_EQ(g_nbCall, 1);
+	enet::resolver::setResolveFunction(null);
+}
+
+TEST(resolver, negativeCache) {
+	enet::resolver::clear();
+	enet::resolver::setResolveFunction(stubResolver);
+	g_nbCall = 0;
+	etk::Vector<enet::Address> list;
+	EXPECT_EQ(enet::resolver::resolve("unknow.example.com", 80, list), false);
+	EXPECT_EQ(enet::resolver::resolve("unknow.example.com", 80, list), false);
+	EXPECT_EQ(list.size(), 0);
+	EXPECT_EQ(g_nbCall, 1);
+	enet::resolver::setResolveFunction(null);
+}
+
+TEST(resolver, expire) {
+	enet::resolver::clear();
+	enet::resolver::setResolveFunction(stubResolver);
+	enet::resolver::setTimeToLive(echrono::seconds(0), echrono::seconds(0));
+	g_nbCall = 0;
+	etk::Vector<enet::Address> list;
+	EXPECT_EQ(enet::resolver::resolve("plop.example.com", 80, list), true);
+	EXPECT_EQ(enet::resolver::resolve("plop.example.com", 80, list), true);
+	EXPECT_EQ(g_nbCall, 2);
+	enet::resolver::setTimeToLive(echrono::seconds(60), echrono::seconds(5));
+	enet::resolver::setResolveFunction(null);
+}
+
+TEST(resolver, backgroundRefresh) {
+	enet::resolver::clear();
+	enet::resolver::setResolveFunction(stubResolver);
+	enet::resolver::setTimeToLive(echrono::seconds(1), echrono::seconds(5));
+	g_nbCall = 0;
+	enet::resolver::setBackgroundRefresh(true);
+	// Already started: nothing to do
+	enet::resolver::setBackgroundRefresh(true);
+	etk::Vector<enet::Address> list;
+	EXPECT_EQ(enet::resolver::resolve("plop.example.com", 80, list), true);
+	// The used entry is resolved again by the thread before it expire
+	ethread::sleepMilliSeconds(1100);
+	enet::resolver::setBackgroundRefresh(false);
+	enet::resolver::setBackgroundRefresh(false);
+	EXPECT_EQ(g_nbCall >= 2, true);
+	int32_t nbCall = g_nbCall;
+	EXPECT_EQ(enet::resolver::resolve("plop.example.com", 80, list), true);
+	EXPECT_EQ(g_nbCall, nbCall);
+	enet::resolver::setTimeToLive(echrono::seconds(60), echrono::seconds(5));
+	enet::resolver::setResolveFunction(null);
+}
+
+TEST(resolver, maxSize) {
+	enet::resolver::clear();
+	enet::resolver::setResolveFunction(stubResolver);
+	enet::resolver::setMaxSize(2);
+	g_nbCall = 0;
+	etk::Vector<enet::Address> list;
+	EXPECT_EQ(enet::resolver::resolve("a.example.com", 80, list), true);
+	ethread::sleepMilliSeconds(2);
+	EXPECT_EQ(enet::resolver::resolve("b.example.com", 80, list), true);
+	ethread::sleepMilliSeconds(2);
+	EXPECT_EQ(enet::resolver::resolve("a.example.com", 80, list), true);
+	EXPECT_EQ(g_nbCall, 2);
+	ethread::sleepMilliSeconds(2);
+	// The cache is full: the least recently used entry ("b") is removed
+	EXPECT_EQ(enet::resolver::resolve("c.example.com", 80, list), true);
+	EXPECT_EQ(g_nbCall, 3);
+	EXPECT_EQ(enet::resolver::resolve("a.example.com", 80, list), true);
+	EXPECT_EQ(g_nbCall, 3);
+	EXPECT_EQ(enet::resolver::resolve("b.example.com", 80, list), true);
+	EXPECT_EQ(g_nbCall, 4);
+	enet::resolver::setMaxSize(1024);
+	enet::resolver::setResolveFunction(null);
+	enet::resolver::clear();
+}
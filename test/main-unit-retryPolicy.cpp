@@ -0,0 +1,52 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/RetryPolicy.hpp>
+
+TEST(retryPolicy, delayRange) {
+	enet::RetryPolicy policy(10, echrono::milliseconds(100), echrono::seconds(1));
+	echrono::Duration delay(0);
+	for (size_t iii=0; iii<100; ++iii) {
+		echrono::Duration previous = delay;
+		delay = policy.getNextDelay(previous);
+		EXPECT_EQ(delay >= echrono::milliseconds(100), true);
+		EXPECT_EQ(delay <= echrono::seconds(1), true);
+		if (previous.get() != 0) {
+			EXPECT_EQ(delay.get() <= previous.get() * 3, true);
+		}
+	}
+}
+
+TEST(retryPolicy, maxAttempt) {
+	enet::RetryPolicy policy(3, echrono::milliseconds(1), echrono::milliseconds(1));
+	enet::RetryPolicy::Sequence sequence(policy);
+	EXPECT_EQ(sequence.getAttempt(), 1);
+	EXPECT_EQ(sequence.retry(), true);
+	EXPECT_EQ(sequence.retry(), true);
+	EXPECT_EQ(sequence.getAttempt(), 3);
+	EXPECT_EQ(sequence.retry(), false);
+}
+
+TEST(retryPolicy, maxElapsed) {
+	enet::RetryPolicy policy(100, echrono::milliseconds(50), echrono::milliseconds(50), echrono::milliseconds(10));
+	enet::RetryPolicy::Sequence sequence(policy);
+	EXPECT_EQ(sequence.retry(), false);
+}
+
+TEST(retryPolicy, budget) {
+	enet::RetryPolicy policy;
+	policy.setBudget(0.5f, 2.0f);
+	EXPECT_EQ(policy.acquireRetry(), true);
+	EXPECT_EQ(policy.acquireRetry(), true);
+	EXPECT_EQ(policy.acquireRetry(), false);
+	policy.reportSuccess();
+	EXPECT_EQ(policy.acquireRetry(), false);
+	policy.reportSuccess();
+	EXPECT_EQ(policy.acquireRetry(), true);
+}
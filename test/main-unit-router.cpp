@@ -0,0 +1,122 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/Router.hpp>
+
+static int32_t g_routeId = -1;
+static etk::String g_uri; //!< The parameters are positions in the URI: it must exist while they are used
+
+static enet::Router::Observer createObserver(int32_t _id) {
+	return [=](enet::HttpServer* _interface, const enet::HttpRequest& _request, const enet::Router::Match& _match) {
+		g_routeId = _id;
+	};
+}
+
+/**
+ * @brief Get the id of the route of an URI (-1 if none).
+ */
+static int32_t findRoute(const enet::Router& _router, enum enet::HTTPReqType _type, const etk::String& _uri, enet::Router::Match& _match) {
+	g_routeId = -1;
+	g_uri = _uri;
+	const enet::Router::Observer* observer = _router.find(_type, g_uri, _match);
+	if (observer == null) {
+		return -1;
+	}
+	enet::HttpRequest request(_type);
+	(*observer)(null, request, _match);
+	return g_routeId;
+}
+
+TEST(router, staticPath) {
+	enet::Router router;
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "/", createObserver(0)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "/users", createObserver(1)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "/user", createObserver(2)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "/user/list", createObserver(3)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "/uploads", createObserver(4)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_POST, "/user", createObserver(5)), true);
+	enet::Router::Match match;
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "", match), 0);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "/", match), 0);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "users", match), 1);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "/user", match), 2);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/list", match), 3);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "uploads", match), 4);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_POST, "user", match), 5);
+	EXPECT_EQ(match.size(), 0);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "use", match), -1);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/lis", match), -1);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/lists", match), -1);
+	// HEAD use the GET route
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_HEAD, "users", match), 1);
+	// Path without the method
+	etk::String allow;
+	EXPECT_EQ(router.find(enet::HTTPReqType::HTTP_DELETE, "user", match, &allow) == null, true);
+	EXPECT_EQ(allow, "GET, HEAD, POST");
+	EXPECT_EQ(router.find(enet::HTTPReqType::HTTP_DELETE, "plop", match, &allow) == null, true);
+	EXPECT_EQ(allow, "");
+}
+
+TEST(router, parameter) {
+	enet::Router router;
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "user/:id", createObserver(0)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "user/:id/files/:file", createObserver(1)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "user/me", createObserver(2)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "user/:id/profile", createObserver(3)), true);
+	// Same position, other name
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "user/:name/list", createObserver(4)), false);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "user/:/list", createObserver(4)), false);
+	enet::Router::Match match;
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "/user/1234", match), 0);
+	EXPECT_EQ(match.size(), 1);
+	EXPECT_EQ(match.get("id"), "1234");
+	EXPECT_EQ(match.getName(0), "id");
+	EXPECT_EQ(match.getSpan(0).m_offset, 6);
+	EXPECT_EQ(match.getSpan(0).m_size, 4);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/1234/files/plop.txt", match), 1);
+	EXPECT_EQ(match.get("id"), "1234");
+	EXPECT_EQ(match.get("file"), "plop.txt");
+	EXPECT_EQ(match.exist("plop"), false);
+	EXPECT_EQ(match.get("plop"), "");
+	// Static has the priority
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/me", match), 2);
+	EXPECT_EQ(match.size(), 0);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/me/profile", match), 3);
+	EXPECT_EQ(match.get("id"), "me");
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/mex", match), 0);
+	EXPECT_EQ(match.get("id"), "mex");
+	// Empty parameter
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/", match), -1);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/12/files/", match), -1);
+}
+
+TEST(router, wildcard) {
+	enet::Router router;
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "static/*path", createObserver(0)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "static/index.html", createObserver(1)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "user/:id/*path", createObserver(2)), true);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "other/*path/plop", createObserver(3)), false);
+	EXPECT_EQ(router.add(enet::HTTPReqType::HTTP_GET, "static/*file", createObserver(3)), false);
+	enet::Router::Match match;
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "static/js/app.js", match), 0);
+	EXPECT_EQ(match.get("path"), "js/app.js");
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "static/", match), 0);
+	EXPECT_EQ(match.get("path"), "");
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "static/index.html", match), 1);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "static/index.htm", match), 0);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "static", match), -1);
+	EXPECT_EQ(findRoute(router, enet::HTTPReqType::HTTP_GET, "user/12/a/b", match), 2);
+	EXPECT_EQ(match.size(), 2);
+	EXPECT_EQ(match.get("id"), "12");
+	EXPECT_EQ(match.get("path"), "a/b");
+	// WebSocket
+	etk::Vector<etk::String> protocols;
+	EXPECT_EQ(router.checkUri("static/plop", protocols), "OK");
+	EXPECT_EQ(router.checkUri("plop", protocols), "CLOSE");
+}
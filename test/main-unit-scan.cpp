@@ -0,0 +1,75 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/scan.hpp>
+
+static const char* g_listImplementation[] = {"scalar", "sse2", "avx2"};
+
+static void checkAllImplementation(const char* _data, size_t _size, size_t _findChar, size_t _endLine, size_t _spaceOrEndLine, size_t _invalidToken, size_t _invalidValue) {
+	for (auto &it : g_listImplementation) {
+		if (enet::scan::setImplementation(it) == false) {
+			// not supported by the CPU
+			continue;
+		}
+		EXPECT_EQ(enet::scan::findChar(_data, _size, ':'), _findChar);
+		EXPECT_EQ(enet::scan::findEndLine(_data, _size), _endLine);
+		EXPECT_EQ(enet::scan::findSpaceOrEndLine(_data, _size), _spaceOrEndLine);
+		EXPECT_EQ(enet::scan::findInvalidToken(_data, _size), _invalidToken);
+		EXPECT_EQ(enet::scan::findInvalidValue(_data, _size), _invalidValue);
+	}
+}
+
+TEST(scan, notFound) {
+	char data[100];
+	for (size_t iii=0; iii<sizeof(data); ++iii) {
+		data[iii] = 'a';
+	}
+	for (size_t iii=0; iii<sizeof(data); ++iii) {
+		checkAllImplementation(data, iii, iii, iii, iii, iii, iii);
+	}
+}
+
+TEST(scan, allPosition) {
+	// Check the position in all the part of the vectors and in the scalar end.
+	char data[100];
+	for (size_t pos=0; pos<sizeof(data); ++pos) {
+		for (size_t iii=0; iii<sizeof(data); ++iii) {
+			data[iii] = 'a';
+		}
+		data[pos] = ':';
+		checkAllImplementation(data, sizeof(data), pos, sizeof(data), sizeof(data), pos, sizeof(data));
+		data[pos] = '\n';
+		checkAllImplementation(data, sizeof(data), sizeof(data), pos, pos, pos, pos);
+		data[pos] = ' ';
+		checkAllImplementation(data, sizeof(data), sizeof(data), sizeof(data), pos, pos, sizeof(data));
+	}
+}
+
+TEST(scan, allCharacter) {
+	// All the implementation must classify all the bytes the same way.
+	char data[64];
+	for (size_t value=0; value<256; ++value) {
+		for (size_t iii=0; iii<sizeof(data); ++iii) {
+			data[iii] = 'a';
+		}
+		data[37] = char(value);
+		enet::scan::setImplementation("scalar");
+		size_t token = enet::scan::findInvalidToken(data, sizeof(data));
+		size_t control = enet::scan::findInvalidValue(data, sizeof(data));
+		size_t endLine = enet::scan::findEndLine(data, sizeof(data));
+		size_t space = enet::scan::findSpaceOrEndLine(data, sizeof(data));
+		size_t find = enet::scan::findChar(data, sizeof(data), ':');
+		checkAllImplementation(data, sizeof(data), find, endLine, space, token, control);
+	}
+	enet::scan::setImplementation("scalar");
+	EXPECT_EQ(enet::scan::findInvalidToken("Content-Length", 14), 14);
+	EXPECT_EQ(enet::scan::findInvalidToken("Content Length", 14), 7);
+	EXPECT_EQ(enet::scan::findInvalidValue("text/html;\tq=0.9\xC3\xA9", 18), 18);
+	EXPECT_EQ(enet::scan::findInvalidValue("text\x01", 5), 4);
+}
@@ -0,0 +1,99 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/StaticFiles.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <sys/stat.h>
+	#include <stdio.h>
+	#include <unistd.h>
+}
+
+TEST(staticFiles, range) {
+	int64_t start = -1;
+	int64_t stop = -1;
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=0-99", 1000, start, stop) == enet::StaticFiles::range::partial, true);
+	EXPECT_EQ(start, 0);
+	EXPECT_EQ(stop, 99);
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=900-", 1000, start, stop) == enet::StaticFiles::range::partial, true);
+	EXPECT_EQ(start, 900);
+	EXPECT_EQ(stop, 999);
+	// The last byte is limited to the size of the file
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=500-5000", 1000, start, stop) == enet::StaticFiles::range::partial, true);
+	EXPECT_EQ(stop, 999);
+	// Suffix
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=-100", 1000, start, stop) == enet::StaticFiles::range::partial, true);
+	EXPECT_EQ(start, 900);
+	EXPECT_EQ(stop, 999);
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=-5000", 1000, start, stop) == enet::StaticFiles::range::partial, true);
+	EXPECT_EQ(start, 0);
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=1000-", 1000, start, stop) == enet::StaticFiles::range::unsatisfiable, true);
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=-0", 1000, start, stop) == enet::StaticFiles::range::unsatisfiable, true);
+	// Ignored: the full file is sent
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=0-9,20-29", 1000, start, stop) == enet::StaticFiles::range::full, true);
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=99-0", 1000, start, stop) == enet::StaticFiles::range::full, true);
+	EXPECT_EQ(enet::StaticFiles::parseRange("items=0-9", 1000, start, stop) == enet::StaticFiles::range::full, true);
+	EXPECT_EQ(enet::StaticFiles::parseRange("bytes=a-9", 1000, start, stop) == enet::StaticFiles::range::full, true);
+}
+
+TEST(staticFiles, eTag) {
+	EXPECT_EQ(enet::StaticFiles::matchETag("\"5a-3e8\"", "\"5a-3e8\""), true);
+	EXPECT_EQ(enet::StaticFiles::matchETag("\"xx\", W/\"5a-3e8\"", "\"5a-3e8\""), true);
+	EXPECT_EQ(enet::StaticFiles::matchETag("*", "\"5a-3e8\""), true);
+	EXPECT_EQ(enet::StaticFiles::matchETag("\"5a-3e9\"", "\"5a-3e8\""), false);
+	EXPECT_EQ(enet::StaticFiles::matchETag("", "\"5a-3e8\""), false);
+}
+
+TEST(staticFiles, type) {
+	enet::StaticFiles files("/tmp");
+	EXPECT_EQ(files.getType("index.html"), "text/html; charset=utf-8");
+	EXPECT_EQ(files.getType("js/APP.JS"), "application/javascript");
+	EXPECT_EQ(files.getType("data.bin"), "application/octet-stream");
+	EXPECT_EQ(files.getType("dir.v2/README"), "application/octet-stream");
+	files.addType("BIN", "application/x-test");
+	EXPECT_EQ(files.getType("data.bin"), "application/x-test");
+}
+
+TEST(staticFiles, prefix) {
+	mkdir("/tmp/enet-test-static", 0755);
+	mkdir("/tmp/enet-test-static/foo", 0755);
+	// "/staticfoo/x" would give the path "foo/x" without the check of the end of the prefix
+	const char* listFile[] = {"/tmp/enet-test-static/x", "/tmp/enet-test-static/foo/x"};
+	for (size_t iii=0; iii<2; ++iii) {
+		FILE* file = fopen(listFile[iii], "w");
+		EXPECT_EQ(file != null, true);
+		fputs("plop", file);
+		fclose(file);
+	}
+	int sockets[2];
+	EXPECT_EQ(socketpair(AF_UNIX, SOCK_STREAM, 0, sockets), 0);
+	enet::HttpServer server(enet::Tcp(sockets[0], "test"));
+	enet::StaticFiles files("/tmp/enet-test-static", "static");
+	files.setMaxAge(echrono::seconds(60));
+	const char* list[] = {"/static/x", "static/x", "/staticfoo/x", "/static", "/stati", "/x"};
+	bool result[] = {true, true, false, false, false, false};
+	for (size_t iii=0; iii<6; ++iii) {
+		enet::HttpRequest request(enet::HTTPReqType::HTTP_GET);
+		request.setUri(list[iii]);
+		EXPECT_EQ(files.process(&server, request), result[iii]);
+	}
+	char data[4096];
+	ssize_t len = recv(sockets[1], data, sizeof(data), MSG_DONTWAIT);
+	EXPECT_EQ(len > 0, true);
+	etk::String answer(data, len > 0 ? len : 0);
+	EXPECT_EQ(answer.find("HTTP/1.1 200") == 0, true);
+	EXPECT_EQ(answer.find("Cache-Control: public, max-age=60\r\n") != etk::String::npos, true);
+	server.stop();
+	close(sockets[1]);
+	unlink("/tmp/enet-test-static/x");
+	unlink("/tmp/enet-test-static/foo/x");
+	rmdir("/tmp/enet-test-static/foo");
+	rmdir("/tmp/enet-test-static");
+}
@@ -0,0 +1,235 @@
+/** @file
+ * @author Edouard DUPIN
+ * @copyright 2018, Edouard DUPIN, all right reserved
+ * @license MPL v2.0 (see license file)
+ */
+
+#include <etk/types.hpp>
+#include <test-debug/debug.hpp>
+#include <etest/etest.hpp>
+#include <enet/enet.hpp>
+#include <enet/TcpClient.hpp>
+#include <enet/Resolver.hpp>
+#include <enet/RetryPolicy.hpp>
+#include <ethread/tools.hpp>
+extern "C" {
+	#include <sys/types.h>
+	#include <sys/socket.h>
+	#include <netinet/in.h>
+	#include <arpa/inet.h>
+	#include <poll.h>
+	#include <unistd.h>
+	#include <string.h>
+}
+
+/**
+ * @brief Listening socket on a loopback IP (the connections are accepted by the system).
+ */
+class Listener {
+	public:
+		int32_t m_socket; //!< Listening socket
+		uint16_t m_port; //!< Port selected by the system
+	public:
+		/**
+		 * @brief Contructor
+		 * @param[in] _ip Loopback IP to listen on.
+		 * @param[in] _port Port to listen on (0: free port selected by the system).
+		 * @param[in] _backlog Size of the accept queue.
+		 */
+		Listener(const char* _ip="127.0.0.1", uint16_t _port=0, int32_t _backlog=64) :
+		  m_socket(-1),
+		  m_port(0) {
+			m_socket = socket(AF_INET, SOCK_STREAM, 0);
+			struct sockaddr_in address;
+			memset(&address, 0, sizeof(address));
+			address.sin_family = AF_INET;
+			address.sin_addr.s_addr = inet_addr(_ip);
+			address.sin_port = htons(_port);
+			socklen_t size = sizeof(address);
+			if (    bind(m_socket, (struct sockaddr*)&address, sizeof(address)) != 0
+			     || listen(m_socket, _backlog) != 0
+			     || getsockname(m_socket, (struct sockaddr*)&address, &size) != 0) {
+				TEST_ERROR("Can not create the test listener: " << strerror(errno));
+				return;
+			}
+			m_port = ntohs(address.sin_port);
+		}
+		~Listener() {
+			close(m_socket);
+		}
+		/**
+		 * @brief Accept a connection and read its data.
+		 * @return The received data ("" on time out).
+		 */
+		etk::String receive() {
+			struct pollfd element;
+			element.fd = m_socket;
+			element.events = POLLIN;
+			element.revents = 0;
+			if (poll(&element, 1, 2000) <= 0) {
+				return "";
+			}
+			int32_t socketId = accept(m_socket, null, null);
+			if (socketId < 0) {
+				return "";
+			}
+			etk::String out;
+			element.fd = socketId;
+			if (poll(&element, 1, 2000) > 0) {
+				char data[256];
+				ssize_t len = recv(socketId, data, sizeof(data), 0);
+				if (len > 0) {
+					out = etk::String(data, len);
+				}
+			}
+			close(socketId);
+			return out;
+		}
+};
+
+/**
+ * @brief Test resolver: "single.test" and "::1" are 127.0.0.1, "race.test" is 127.0.0.2 (nothing listen on it)
+ * then 127.0.0.1, "dead.test" is only 127.0.0.2.
+ */
+static bool testResolver(const etk::String& _hostname, etk::Vector<enet::Address>& _result) {
+	enet::Address address;
+	address.setIpV4(127, 0, 0, 2);
+	if (_hostname == "dead.test") {
+		_result.pushBack(address);
+		return true;
+	}
+	if (_hostname == "race.test") {
+		_result.pushBack(address);
+	} else if (    _hostname != "single.test"
+	            && _hostname != "::1") {
+		return false;
+	}
+	address.setIpV4(127, 0, 0, 1);
+	_result.pushBack(address);
+	return true;
+}
+
+TEST(tcpClient, fastOpen) {
+	enet::init(0, null);
+	enet::resolver::clear();
+	enet::resolver::setResolveFunction(testResolver);
+	Listener listener;
+	EXPECT_EQ(listener.m_port != 0, true);
+	bool fastOpen[2] = {false, true};
+	for (size_t iii=0; iii<2; ++iii) {
+		enet::setTcpFastOpen(fastOpen[iii]);
+		for (auto &host : {"single.test", "race.test"}) {
+			enet::RetryPolicy policy(1);
+			enet::Tcp connection = enet::connectTcpClient(host, listener.m_port, policy, echrono::seconds(2));
+			EXPECT_EQ(connection.getConnectionStatus() == enet::Tcp::status::link, true);
+			// With TCP fast open the handshake can be done with the first write
+			EXPECT_EQ(connection.write("plop", 4), 4);
+			EXPECT_EQ(listener.receive(), "plop");
+		}
+	}
+	enet::setTcpFastOpen(false);
+	enet::resolver::setResolveFunction(null);
+	enet::resolver::clear();
+}
+
+TEST(tcpClient, connectMany) {
+	enet::init(0, null);
+	enet::resolver::clear();
+	enet::resolver::setResolveFunction(testResolver);
+	Listener listener;
+	etk::String port = etk::toString(listener.m_port);
+	etk::Vector<etk::String> list;
+	list.pushBack("single.test:" + port);
+	// The IPv6 address is given to the resolver without the brackets
+	list.pushBack("[::1]:" + port);
+	list.pushBack("race.test:" + port);
+	list.pushBack("dead.test:" + port);
+	list.pushBack("unknown.test:" + port);
+	etk::Vector<etk::String> errors;
+	etk::Vector<enet::Tcp> result = enet::connectMany(list, echrono::seconds(2), 2, errors);
+	EXPECT_EQ(result.size(), 5);
+	EXPECT_EQ(errors.size(), 5);
+	for (size_t iii=0; iii<3; ++iii) {
+		EXPECT_EQ(result[iii].getConnectionStatus() == enet::Tcp::status::link, true);
+		EXPECT_EQ(errors[iii], "");
+		EXPECT_EQ(result[iii].getName(), list[iii]);
+	}
+	EXPECT_EQ(result[3].getConnectionStatus() == enet::Tcp::status::link, false);
+	EXPECT_EQ(errors[3] != "", true);
+	EXPECT_EQ(result[4].getConnectionStatus() == enet::Tcp::status::link, false);
+	EXPECT_EQ(errors[4], "no such host: unknown.test");
+	enet::resolver::setResolveFunction(null);
+	enet::resolver::clear();
+}
+
+/**
+ * @brief Test resolver: "slow.test" is 127.0.0.2 (the SYN are dropped) then 127.0.0.1.
+ */
+static bool slowResolver(const etk::String& _hostname, etk::Vector<enet::Address>& _result) {
+	if (_hostname != "slow.test") {
+		return false;
+	}
+	enet::Address address;
+	address.setIpV4(127, 0, 0, 2);
+	_result.pushBack(address);
+	address.setIpV4(127, 0, 0, 1);
+	_result.pushBack(address);
+	return true;
+}
+
+TEST(tcpClient, happyEyeballs) {
+	enet::init(0, null);
+	enet::resolver::clear();
+	enet::resolver::setResolveFunction(slowResolver);
+	// Fill the accept queue of 127.0.0.2: the next connections wait without answer
+	Listener full("127.0.0.2", 0, 0);
+	EXPECT_EQ(full.m_port != 0, true);
+	etk::Vector<int32_t> pending;
+	for (size_t iii=0; iii<4; ++iii) {
+		int32_t socketId = socket(AF_INET, SOCK_STREAM | SOCK_NONBLOCK, 0);
+		struct sockaddr_in address;
+		memset(&address, 0, sizeof(address));
+		address.sin_family = AF_INET;
+		address.sin_addr.s_addr = inet_addr("127.0.0.2");
+		address.sin_port = htons(full.m_port);
+		connect(socketId, (struct sockaddr*)&address, sizeof(address));
+		pending.pushBack(socketId);
+	}
+	ethread::sleepMilliSeconds(50);
+	Listener listener("127.0.0.1", full.m_port);
+	EXPECT_EQ(listener.m_port, full.m_port);
+	echrono::Steady start = echrono::Steady::now();
+	enet::RetryPolicy policy(1);
+	enet::Tcp connection = enet::connectTcpClient("slow.test", full.m_port, policy, echrono::seconds(5));
+	echrono::Duration delay = echrono::Steady::now() - start;
+	EXPECT_EQ(connection.getConnectionStatus() == enet::Tcp::status::link, true);
+	// The second address is tried after the attempt delay, without waiting the time out of the first one
+	EXPECT_EQ(delay >= echrono::milliseconds(90), true);
+	EXPECT_EQ(delay < echrono::seconds(2), true);
+	EXPECT_EQ(connection.write("plop", 4), 4);
+	EXPECT_EQ(listener.receive(), "plop");
+	for (auto &it : pending) {
+		close(it);
+	}
+	enet::resolver::setResolveFunction(null);
+	enet::resolver::clear();
+}
+
+TEST(tcpClient, config) {
+	enet::init(0, null);
+	enet::resolver::clear();
+	enet::resolver::setResolveFunction(testResolver);
+	Listener listener;
+	etk::String port = etk::toString(listener.m_port);
+	const char* list[] = {"single.test:", "[::1]:"};
+	for (size_t iii=0; iii<2; ++iii) {
+		// The IPv6 address is given to the resolver without the brackets
+		enet::RetryPolicy policy(1);
+		enet::Tcp connection = enet::connectTcpClient(list[iii] + port, policy, echrono::seconds(2));
+		EXPECT_EQ(connection.getConnectionStatus() == enet::Tcp::status::link, true);
+		connection = enet::connectTcpClient(list[iii] + port, 1, echrono::seconds(2));
+		EXPECT_EQ(connection.getConnectionStatus() == enet::Tcp::status::link, true);
+	}
+	enet::resolver::setResolveFunction(null);
+	enet::resolver::clear();
+}